@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdio>
 #include "pixel.h"
+#include "gradient_lut.h"
 
 namespace agge {
 template <typename PixelT>
@@ -10,11 +11,14 @@ class blender_linear_gradient {
   typedef uint8_t cover_type;
 
  public:
-  blender_linear_gradient(float sx, float sy, float ex, float ey, pixel32_rgba sc, pixel32_rgba ec);
+  blender_linear_gradient(float sx, float sy, float ex, float ey, const gradient_lut& lut);
   void operator()(pixel* pixels, int x, int y, count_t n, const cover_type* covers) const;
-  bool gradient(float factor, pixel32_rgba& c) const;
+  uint8_t get_index(int x, int y) const;
   bool get_color(int x, int y, pixel32_rgba& c) const;
 
+ private:
+  void get_indices(uint8_t* indices, int x, int y, count_t n) const;
+
  private:
   float _sx;
   float _sy;
@@ -23,78 +27,100 @@ class blender_linear_gradient {
   float _dx;
   float _dy;
   float _dot_product_1;
-  float _xw;
-  float _yw;
-  pixel32_rgba _sc;
-  pixel32_rgba _ec;
+  const gradient_lut& _lut;
 };
 
 template <typename PixelT>
-inline blender_linear_gradient<PixelT>::blender_linear_gradient(float sx, float sy, float ex, float ey, 
-    pixel32_rgba sc, pixel32_rgba ec) : _sx(sx), _sy(sy), _ex(ex), _ey(ey), _sc(sc), _ec(ec) {
+inline blender_linear_gradient<PixelT>::blender_linear_gradient(float sx, float sy, float ex,
+                                                                float ey, const gradient_lut& lut)
+    : _sx(sx), _sy(sy), _ex(ex), _ey(ey), _lut(lut) {
   if(sx == ex && sy == ey) {
     assert(!"invalid params");
     _ex = _sx + 1;
     _ey = _sy + 1;
   }
 
-  _dx = ex - sx;
-  _dy = ey - sy;
+  _dx = _ex - _sx;
+  _dy = _ey - _sy;
   _dot_product_1 = 1/(_dx * _dx + _dy * _dy);
 }
 
 template <typename PixelT>
-inline bool blender_linear_gradient<PixelT>::gradient(float factor, pixel32_rgba& c) const {
-  if(factor <= 0) {
-    c = _sc;
-  } else if(factor >= 1.0f) {
-    c = _ec;
-  } else {
-    c.r = _sc.r + (_ec.r - _sc.r) * factor;
-    c.g = _sc.g + (_ec.g - _sc.g) * factor;
-    c.b = _sc.b + (_ec.b - _sc.b) * factor;
-    c.a = _sc.a + (_ec.a - _sc.a) * factor;
-  }
-
-  return true;
-}
-
-template <typename PixelT>
-inline bool blender_linear_gradient<PixelT>::get_color(int x, int y, pixel32_rgba& c) const {
-  if(_sx == _ex && _sy == _ey) {
-    c = _sc;
-    return true;
-  } else if(_sx == _ex) {
-    return this->gradient((y - _sy)/_dy, c);
+inline uint8_t blender_linear_gradient<PixelT>::get_index(int x, int y) const {
+  if(_sx == _ex) {
+    return gradient_lut::index((y - _sy)/_dy);
   } else if(_sy == _ey) {
-    return this->gradient((x - _sx)/_dx, c);
+    return gradient_lut::index((x - _sx)/_dx);
   } else {
     //https://github.com/SFML/SFML/wiki/Source:-Color-Gradient
     if(x < _sx || y < _sy) {
-      c = _sc;
+      return 0;
     } else if(x > _ex || y > _ey) {
-      c = _ec;
+      return gradient_lut::size - 1;
     } else {
       float dot_product = (x - _sx) * _dx + (y - _sy) * _dy;
-      float factor = dot_product * _dot_product_1;
 
-      return this->gradient(factor, c);
+      return gradient_lut::index(dot_product * _dot_product_1);
     }
   }
+}
+
+template <typename PixelT>
+inline bool blender_linear_gradient<PixelT>::get_color(int x, int y, pixel32_rgba& c) const {
+  c = _lut[this->get_index(x, y)];
 
   return true;
 }
 
+/*
+ * the factor is linear in x, so a span evaluates it once and then adds the step of one pixel;
+ * a vertical gradient has the same color in the whole span.
+ */
+template <typename PixelT>
+inline void blender_linear_gradient<PixelT>::get_indices(uint8_t* indices, int x, int y,
+                                                         count_t n) const {
+  if(_sx == _ex) {
+    ::memset(indices, this->get_index(x, y), n);
+  } else if(_sy == _ey) {
+    float step = 255 / _dx;
+    float f = (x - _sx) * step;
+
+    for (; n; --n, ++indices, f += step) {
+      *indices = gradient_lut::index255(f);
+    }
+  } else if(y < _sy) {
+    ::memset(indices, 0, n);
+  } else {
+    float step = _dx * _dot_product_1 * 255;
+    float f = ((x - _sx) * _dx + (y - _sy) * _dy) * _dot_product_1 * 255;
+    bool after_end = y > _ey;
+
+    for (; n; --n, ++indices, ++x, f += step) {
+      if(x < _sx) {
+        *indices = 0;
+      } else if(after_end || x > _ex) {
+        *indices = gradient_lut::size - 1;
+      } else {
+        *indices = gradient_lut::index255(f);
+      }
+    }
+  }
+}
+
 template <typename PixelT>
 inline void blender_linear_gradient<PixelT>::operator()(pixel* pixels, int x, int y,
                                                         count_t n, const cover_type* covers) const {
-  pixel32_rgba p(0, 0, 0, 0);
+  uint8_t indices[64];
 
-  for (; n; --n, ++pixels, ++covers) {
-    if(this->get_color(x++, y, p)) {
-      uint8_t a = (*covers * p.a) >> 8;
-      pixel_blend<PixelT, pixel32_rgba>(*pixels, p, a);
-    }
+  while (n) {
+    count_t chunk = n < sizeof(indices) ? n : sizeof(indices);
+
+    this->get_indices(indices, x, y, chunk);
+    gradient_span_blender<PixelT>::blend(pixels, _lut, indices, covers, chunk);
+    pixels += chunk;
+    covers += chunk;
+    x += chunk;
+    n -= chunk;
   }
 }
 }  // namespace agge
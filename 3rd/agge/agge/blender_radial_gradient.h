@@ -1,6 +1,8 @@
 #pragma once
 
+#include <math.h>
 #include "pixel.h"
+#include "gradient_lut.h"
 
 namespace agge {
 template <typename PixelT>
@@ -10,69 +12,96 @@ class blender_radial_gradient {
   typedef uint8_t cover_type;
 
  public:
-  blender_radial_gradient(float cx, float cy, float inr, float outr, pixel32_rgba sc, pixel32_rgba ec);
+  blender_radial_gradient(float cx, float cy, float inr, float outr, const gradient_lut& lut);
   void operator()(pixel* pixels, int x, int y, count_t n, const cover_type* covers) const;
-  bool gradient(float factor, pixel32_rgba& c) const;
+  uint8_t get_index(int x, int y) const;
   bool get_color(int x, int y, pixel32_rgba& c) const;
 
+ private:
+  void get_indices(uint8_t* indices, int x, int y, count_t n) const;
+
  private:
   float _cx;
   float _cy;
   float _inr;
   float _outr;
-  pixel32_rgba _sc;
-  pixel32_rgba _ec;
+  /* squared radiuses: inside the inner or outside the outer circle needs no sqrt */
+  float _inr2;
+  float _outr2;
+  float _scale;
+  const gradient_lut& _lut;
 };
 
 template <typename PixelT>
-inline blender_radial_gradient<PixelT>::blender_radial_gradient(float cx, float cy, float inr, float outr, 
-    pixel32_rgba sc, pixel32_rgba ec) : _cx(cx), _cy(cy), _inr(inr), _outr(outr), _sc(sc), _ec(ec) {
+inline blender_radial_gradient<PixelT>::blender_radial_gradient(float cx, float cy, float inr,
+                                                                float outr, const gradient_lut& lut)
+    : _cx(cx), _cy(cy), _inr(inr), _outr(outr), _lut(lut) {
+  _inr2 = inr > 0 ? inr * inr : -1;
+  _outr2 = outr > 0 ? outr * outr : 0;
+  _scale = outr > inr ? 255 / (outr - inr) : 0;
 }
 
 template <typename PixelT>
-inline bool blender_radial_gradient<PixelT>::gradient(float factor, pixel32_rgba& c) const {
-  if(factor <= 0) {
-    c = _sc;
-  } else if(factor >= 1.0f) {
-    c = _ec;
+inline uint8_t blender_radial_gradient<PixelT>::get_index(int x, int y) const {
+  float dx = x - _cx;
+  float dy = y - _cy;
+  float d2 = dx * dx + dy * dy;
+
+  if(d2 <= _inr2) {
+    return 0;
+  } else if(d2 >= _outr2) {
+    return gradient_lut::size - 1;
   } else {
-    c.r = _sc.r + (_ec.r - _sc.r) * factor;
-    c.g = _sc.g + (_ec.g - _sc.g) * factor;
-    c.b = _sc.b + (_ec.b - _sc.b) * factor;
-    c.a = _sc.a + (_ec.a - _sc.a) * factor;
+    return gradient_lut::index255((sqrtf(d2) - _inr) * _scale);
   }
+}
+
+template <typename PixelT>
+inline bool blender_radial_gradient<PixelT>::get_color(int x, int y, pixel32_rgba& c) const {
+  c = _lut[this->get_index(x, y)];
 
   return true;
 }
 
 template <typename PixelT>
-inline bool blender_radial_gradient<PixelT>::get_color(int x, int y, pixel32_rgba& c) const {
-  float dx = x - _cx;
+inline void blender_radial_gradient<PixelT>::get_indices(uint8_t* indices, int x, int y,
+                                                         count_t n) const {
   float dy = y - _cy;
-  float r = sqrt(dx * dx + dy * dy);
+  float dy2 = dy * dy;
+  float dx = x - _cx;
 
-  if(r <= _inr) {
-    c = _sc;
-  } else if(r >= _outr) {
-    c = _ec;
-  } else {
-    float factor = (r - _inr)/(_outr - _inr);
-    this->gradient(factor, c);
+  if(dy2 >= _outr2 && dy2 > _inr2) {
+    ::memset(indices, gradient_lut::size - 1, n);
+    return;
   }
 
-  return true;
+  for (; n; --n, ++indices, dx += 1) {
+    float d2 = dx * dx + dy2;
+
+    if(d2 <= _inr2) {
+      *indices = 0;
+    } else if(d2 >= _outr2) {
+      *indices = gradient_lut::size - 1;
+    } else {
+      *indices = gradient_lut::index255((sqrtf(d2) - _inr) * _scale);
+    }
+  }
 }
 
 template <typename PixelT>
 inline void blender_radial_gradient<PixelT>::operator()(pixel* pixels, int x, int y,
                                                         count_t n, const cover_type* covers) const {
-  pixel32_rgba p(0, 0, 0, 0);
+  uint8_t indices[64];
 
-  for (; n; --n, ++pixels, ++covers) {
-    if(this->get_color(x++, y, p)) {
-      uint8_t a = (*covers * p.a) >> 8;
-      pixel_blend<PixelT, pixel32_rgba>(*pixels, p, a);
-    }
+  while (n) {
+    count_t chunk = n < sizeof(indices) ? n : sizeof(indices);
+
+    this->get_indices(indices, x, y, chunk);
+    gradient_span_blender<PixelT>::blend(pixels, _lut, indices, covers, chunk);
+    pixels += chunk;
+    covers += chunk;
+    x += chunk;
+    n -= chunk;
   }
 }
 }  // namespace agge
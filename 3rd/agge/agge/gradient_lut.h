@@ -0,0 +1,184 @@
+#pragma once
+
+#include <string.h>
+#include "pixel.h"
+
+namespace agge {
+/*
+ * The colors of a two stop gradient sampled at 256 positions: lut[i] is the color at factor
+ * i/255, interpolated the same way the gradient blenders used to interpolate every pixel. The
+ * colors are straight (not premultiplied), because pixel_blend takes the color and the alpha
+ * separately and the alpha is scaled by the cover anyway.
+ */
+class gradient_lut {
+ public:
+  enum { size = 256 };
+
+ public:
+  gradient_lut() {
+  }
+  gradient_lut(pixel32_rgba sc, pixel32_rgba ec) {
+    init(sc, ec);
+  }
+
+  void init(pixel32_rgba sc, pixel32_rgba ec);
+  bool match(pixel32_rgba sc, pixel32_rgba ec) const;
+
+  const pixel32_rgba& operator[](int i) const {
+    return _colors[i];
+  }
+
+  /* maps a factor to an index: <= 0 is the start color, >= 1 is the end color */
+  static uint8_t index(float factor) {
+    return index255(factor * 255);
+  }
+  static uint8_t index255(float factor255) {
+    if (factor255 <= 0) {
+      return 0;
+    } else if (factor255 >= 255) {
+      return 255;
+    } else {
+      return (uint8_t)(factor255 + 0.5f);
+    }
+  }
+
+ private:
+  pixel32_rgba _sc;
+  pixel32_rgba _ec;
+  pixel32_rgba _colors[size];
+};
+
+inline void gradient_lut::init(pixel32_rgba sc, pixel32_rgba ec) {
+  _sc = sc;
+  _ec = ec;
+
+  for (int i = 0; i < size; i++) {
+    float factor = i / 255.0f;
+    pixel32_rgba& c = _colors[i];
+
+    c.r = sc.r + (ec.r - sc.r) * factor;
+    c.g = sc.g + (ec.g - sc.g) * factor;
+    c.b = sc.b + (ec.b - sc.b) * factor;
+    c.a = sc.a + (ec.a - sc.a) * factor;
+  }
+}
+
+inline bool gradient_lut::match(pixel32_rgba sc, pixel32_rgba ec) const {
+  return memcmp(&_sc, &sc, sizeof(sc)) == 0 && memcmp(&_ec, &ec, sizeof(ec)) == 0;
+}
+
+/*
+ * Keeps the LUTs of the last N gradients, so the same gradient drawn by several widgets (or in
+ * every frame) builds its LUT once. The least recently used LUT is replaced, so a LUT returned
+ * by get stays valid until N other gradients are requested.
+ */
+template <int N>
+class gradient_lut_cache : noncopyable {
+ public:
+  gradient_lut_cache() : _n(0), _clock(0) {
+  }
+
+  const gradient_lut& get(pixel32_rgba sc, pixel32_rgba ec);
+
+ private:
+  int _n;
+  uint32_t _clock;
+  uint32_t _used[N];
+  gradient_lut _luts[N];
+};
+
+template <int N>
+inline const gradient_lut& gradient_lut_cache<N>::get(pixel32_rgba sc, pixel32_rgba ec) {
+  int slot = 0;
+
+  for (int i = 0; i < _n; i++) {
+    if (_luts[i].match(sc, ec)) {
+      _used[i] = ++_clock;
+      return _luts[i];
+    }
+  }
+
+  if (_n < N) {
+    slot = _n++;
+  } else {
+    for (int i = 1; i < N; i++) {
+      if (_used[i] < _used[slot]) {
+        slot = i;
+      }
+    }
+  }
+
+  _luts[slot].init(sc, ec);
+  _used[slot] = ++_clock;
+
+  return _luts[slot];
+}
+
+/*
+ * Blends a span of LUT colors (indices[i] is the color of pixels[i]) with the covers. Same
+ * result as pixel_blend for every pixel.
+ */
+template <typename PixelT, bool Packed = sizeof(PixelT) == 4>
+struct gradient_span_blender {
+  static void blend(PixelT* pixels, const gradient_lut& lut, const uint8_t* indices,
+                    const uint8_t* covers, count_t n) {
+    for (; n; --n, ++pixels, ++indices, ++covers) {
+      const pixel32_rgba& c = lut[*indices];
+      pixel_blend<PixelT, pixel32_rgba>(*pixels, c, (*covers * c.a) >> 8);
+    }
+  }
+};
+
+/*
+ * 32 bits targets blend two channels per multiply (SWAR): the color is packed in the byte order
+ * of the target, the even and the odd bytes are blended as two 16 bits lanes, which can not
+ * overflow (s * a + t * (255 - a) <= 255 * 255), and the alpha byte of the target is kept as
+ * pixel_blend does. Works on either endianness, only the position of the alpha byte matters.
+ */
+template <typename PixelT>
+struct gradient_span_blender<PixelT, true> {
+  static uint32_t pack(const pixel32_rgba& c) {
+    uint32_t v = 0;
+    PixelT p(c.r, c.g, c.b, c.a);
+
+    memcpy(&v, (const void*)&p, sizeof(v));
+    return v;
+  }
+
+  static uint32_t blend_pixel(uint32_t t, uint32_t s, uint32_t a, uint32_t alpha_mask) {
+    uint32_t ma = 0xff - a;
+    uint32_t lo = (((s & 0x00ff00ff) * a + (t & 0x00ff00ff) * ma) >> 8) & 0x00ff00ff;
+    uint32_t hi = (((s >> 8) & 0x00ff00ff) * a + ((t >> 8) & 0x00ff00ff) * ma) & 0xff00ff00;
+
+    return ((lo | hi) & ~alpha_mask) | (t & alpha_mask);
+  }
+
+  static void blend(PixelT* pixels, const gradient_lut& lut, const uint8_t* indices,
+                    const uint8_t* covers, count_t n) {
+    const uint32_t alpha_mask = pack(pixel32_rgba(0, 0, 0, 0xff));
+    uint32_t s = 0;
+    uint32_t sa = 0;
+    int last = -1;
+
+    for (; n; --n, ++pixels, ++indices, ++covers) {
+      uint32_t t = 0;
+      uint32_t a = 0;
+
+      if (*indices != last) {
+        const pixel32_rgba& c = lut[*indices];
+
+        last = *indices;
+        s = pack(c) & ~alpha_mask;
+        sa = c.a;
+      }
+
+      a = (*covers * sa) >> 8;
+      if (a > 0x01) {
+        memcpy(&t, (const void*)pixels, sizeof(t));
+        t = a > 0xf4 ? (s | (t & alpha_mask)) : blend_pixel(t, s, a, alpha_mask);
+        memcpy((void*)pixels, &t, sizeof(t));
+      }
+    }
+  }
+};
+}  // namespace agge
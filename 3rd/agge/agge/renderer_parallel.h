@@ -0,0 +1,97 @@
+#pragma once
+
+#include "renderer.h"
+
+namespace agge
+{
+	// Runs a kernel on parallelism() threads (the calling thread included) and returns when all of them
+	// are done. The threads are provided by the user of agge.
+	class parallel
+	{
+	public:
+		struct kernel_function
+		{
+			virtual void operator ()(count_t threadid) = 0;
+		};
+
+	public:
+		virtual ~parallel() { }
+
+		virtual count_t parallelism() const = 0;
+		virtual void call(kernel_function &kernel) = 0;
+	};
+
+
+	// Renders the scanlines of a sorted mask on several threads: thread N renders the scanlines
+	// min_y + N, min_y + N + parallelism, ... Each thread has its own scanline cache and writes its own
+	// rows, the mask and the blender are only read, so the output is identical to the one of renderer.
+	class renderer_parallel : noncopyable
+	{
+	public:
+		explicit renderer_parallel(parallel &parallel_);
+		~renderer_parallel();
+
+		template <typename BitmapT, typename MaskT, typename BlenderT, typename AlphaFn>
+		void operator ()(BitmapT &bitmap_, const rect_i *window, const MaskT &mask, const BlenderT &blender, const AlphaFn &alpha);
+
+	private:
+		template <typename BitmapT, typename MaskT, typename BlenderT, typename AlphaFn>
+		class kernel;
+
+	private:
+		parallel &_parallel;
+		const count_t _parallelism;
+		raw_memory_object *_scanline_caches;
+	};
+
+
+	template <typename BitmapT, typename MaskT, typename BlenderT, typename AlphaFn>
+	class renderer_parallel::kernel : public parallel::kernel_function, noncopyable
+	{
+	public:
+		kernel(raw_memory_object *scanline_caches, count_t parallelism, BitmapT &bitmap_, const rect_i *window,
+				const MaskT &mask, const BlenderT &blender, const AlphaFn &alpha)
+			: _scanline_caches(scanline_caches), _parallelism(parallelism), _bitmap(bitmap_), _window(window),
+				_mask(mask), _blender(blender), _alpha(alpha)
+		{	}
+
+		virtual void operator ()(count_t threadid)
+		{
+			typedef renderer::adapter<BitmapT, BlenderT> rendition_adapter;
+
+			rendition_adapter ra(_bitmap, _window, _blender);
+			scanline_adapter<rendition_adapter> scanline(ra, _scanline_caches[threadid], _mask.width());
+
+			render(scanline, _mask, _alpha, threadid, _parallelism);
+		}
+
+	private:
+		raw_memory_object *_scanline_caches;
+		const count_t _parallelism;
+		BitmapT &_bitmap;
+		const rect_i *_window;
+		const MaskT &_mask;
+		const BlenderT &_blender;
+		const AlphaFn &_alpha;
+	};
+
+
+
+	inline renderer_parallel::renderer_parallel(parallel &parallel_)
+		: _parallel(parallel_), _parallelism(parallel_.parallelism()),
+			_scanline_caches(new raw_memory_object[parallel_.parallelism()])
+	{	}
+
+	inline renderer_parallel::~renderer_parallel()
+	{	delete []_scanline_caches;	}
+
+	template <typename BitmapT, typename MaskT, typename BlenderT, typename AlphaFn>
+	void renderer_parallel::operator ()(BitmapT &bitmap_, const rect_i *window, const MaskT &mask,
+		const BlenderT &blender, const AlphaFn &alpha)
+	{
+		kernel<BitmapT, MaskT, BlenderT, AlphaFn> k(_scanline_caches, _parallelism, bitmap_, window, mask, blender,
+			alpha);
+
+		_parallel.call(k);
+	}
+}
@@ -16,6 +16,7 @@
 #include <agge/stroke_features.h>
 #include <agge/blenders_generic.h>
 #include <agge/vector_rasterizer.h>
+#include <agge/renderer_parallel.h>
 #include <agge/nanovg_image_blender.h>
 #include <agge/blender_linear_gradient.h>
 #include <agge/blender_radial_gradient.h>
@@ -27,6 +28,15 @@ agge::rect<T> mkrect(T x1, T y1, T x2, T y2) {
   return r;
 }
 
+/*
+ * image id = (generation << AGGENVG_SLOT_BITS) | (slot + 1), so looking up a texture is an
+ * index into the slot array, and an id of a deleted (or evicted) texture never matches the
+ * texture which reuses its slot later.
+ */
+#define AGGENVG_SLOT_BITS 16
+#define AGGENVG_SLOT_MASK ((1 << AGGENVG_SLOT_BITS) - 1)
+#define AGGENVG_MAX_GENERATION 0x7fff
+
 struct AGGENVGtexture {
   int id;
   int tex;
@@ -35,9 +45,41 @@ struct AGGENVGtexture {
   int type;
   int flags;
   const uint8_t* data;
+
+  /*generation of the slot, next free slot when the slot is free*/
+  int generation;
+  int nextFree;
+  /*pixel bytes referenced and the last frame the texture was drawn in*/
+  uint32_t bytes;
+  uint32_t lastUsed;
 };
 typedef struct AGGENVGtexture AGGENVGtexture;
 
+class AGGENVGparallel : public agge::parallel {
+ public:
+  AGGENVGparallel(uint32_t parallelism, NVGaggeParallelFunc run, void* runCtx)
+      : n(parallelism), run(run), runCtx(runCtx) {
+  }
+
+  virtual agge::count_t parallelism() const {
+    return this->n;
+  }
+
+  virtual void call(kernel_function& kernel) {
+    this->run(this->runCtx, AGGENVGparallel::runKernel, &kernel, this->n);
+  }
+
+ private:
+  static void runKernel(void* ctx, uint32_t index) {
+    kernel_function* kernel = (kernel_function*)ctx;
+    (*kernel)(index);
+  }
+
+  uint32_t n;
+  NVGaggeParallelFunc run;
+  void* runCtx;
+};
+
 struct AGGENVGcontext {
   AGGENVGcontext() {
     this->w = 0;
@@ -46,7 +88,15 @@ struct AGGENVGcontext {
     this->textures = NULL;
     this->ntextures = 0;
     this->ctextures = 0;
-    this->textureId = 0;
+    this->freeTexture = -1;
+    this->frame = 0;
+    this->textureBytes = 0;
+    this->maxTextureBytes = 0;
+    this->onEvict = NULL;
+    this->onEvictCtx = NULL;
+    this->parallel = NULL;
+    this->renParallel = NULL;
+    this->parallelMinRows = 0;
 
     this->line_style.set_cap(agge::caps::butt());
     this->line_style.set_join(agge::joins::bevel());
@@ -55,13 +105,28 @@ struct AGGENVGcontext {
   ~AGGENVGcontext() {
     free(this->textures);
     this->textures = NULL;
+    this->setParallel(NULL);
+  }
+
+  void setParallel(AGGENVGparallel* parallel) {
+    delete this->renParallel;
+    delete this->parallel;
+    this->parallel = parallel;
+    this->renParallel = parallel != NULL ? new agge::renderer_parallel(*parallel) : NULL;
   }
 
   int ntextures;
   int ctextures;
-  int textureId;
+  int freeTexture;
   AGGENVGtexture* textures;
 
+  /*texture budget*/
+  uint32_t frame;
+  uint32_t textureBytes;
+  uint32_t maxTextureBytes;
+  NVGaggeEvictFunc onEvict;
+  void* onEvictCtx;
+
   /*fill/stroke color*/
   uint8_t r;
   uint8_t g;
@@ -77,8 +142,14 @@ struct AGGENVGcontext {
 
   /*agge related*/
   agge::renderer ren;
+  /*render the scanlines on several threads when the mask has at least parallelMinRows rows*/
+  AGGENVGparallel* parallel;
+  agge::renderer_parallel* renParallel;
+  uint32_t parallelMinRows;
   agge::stroke line_style;
   agge::rasterizer<agge::clipper<int> > ras;
+  /*LUTs of the recent gradients, shared by the fills with the same colors*/
+  agge::gradient_lut_cache<8> gradients;
 };
 
 static int aggenvg__maxi(int a, int b) {
@@ -86,17 +157,18 @@ static int aggenvg__maxi(int a, int b) {
 }
 
 static AGGENVGtexture* aggenvg__allocTexture(AGGENVGcontext* agge) {
-  int i;
+  int slot;
+  int generation;
   AGGENVGtexture* tex = NULL;
 
-  for (i = 0; i < agge->ntextures; i++) {
-    if (agge->textures[i].id == 0) {
-      tex = &agge->textures[i];
-      break;
-    }
-  }
+  if (agge->freeTexture >= 0) {
+    slot = agge->freeTexture;
+    tex = &agge->textures[slot];
+    agge->freeTexture = tex->nextFree;
+    generation = tex->generation;
+  } else {
+    if (agge->ntextures >= AGGENVG_SLOT_MASK) return NULL;
 
-  if (tex == NULL) {
     if (agge->ntextures + 1 > agge->ctextures) {
       AGGENVGtexture* textures;
       int ctextures =
@@ -106,31 +178,95 @@ static AGGENVGtexture* aggenvg__allocTexture(AGGENVGcontext* agge) {
       agge->textures = textures;
       agge->ctextures = ctextures;
     }
-    tex = &agge->textures[agge->ntextures++];
+    slot = agge->ntextures++;
+    tex = &agge->textures[slot];
+    generation = 1;
   }
 
   memset(tex, 0, sizeof(*tex));
-  tex->id = ++agge->textureId;
+  tex->generation = generation;
+  tex->id = (generation << AGGENVG_SLOT_BITS) | (slot + 1);
+  tex->lastUsed = agge->frame;
 
   return tex;
 }
 
 static AGGENVGtexture* aggenvg__findTexture(AGGENVGcontext* agge, int id) {
-  int i;
-  for (i = 0; i < agge->ntextures; i++)
-    if (agge->textures[i].id == id) return &agge->textures[i];
-  return NULL;
+  int slot = (id & AGGENVG_SLOT_MASK) - 1;
+
+  if (slot < 0 || slot >= agge->ntextures) return NULL;
+  if (agge->textures[slot].id != id) return NULL;
+
+  return &agge->textures[slot];
 }
 
 static int aggenvg__deleteTexture(AGGENVGcontext* agge, int id) {
-  int i;
-  for (i = 0; i < agge->ntextures; i++) {
-    if (agge->textures[i].id == id) {
-      memset(&agge->textures[i], 0, sizeof(agge->textures[i]));
-      return 1;
+  int slot;
+  AGGENVGtexture* tex = aggenvg__findTexture(agge, id);
+  if (tex == NULL) return 0;
+
+  slot = (int)(tex - agge->textures);
+  agge->textureBytes -= tex->bytes;
+
+  tex->id = 0;
+  tex->data = NULL;
+  tex->bytes = 0;
+  tex->generation = tex->generation < AGGENVG_MAX_GENERATION ? tex->generation + 1 : 1;
+  tex->nextFree = agge->freeTexture;
+  agge->freeTexture = slot;
+
+  return 1;
+}
+
+static uint32_t aggenvg__textureBytes(int type, int w, int h) {
+  switch (type) {
+    case NVG_TEXTURE_RGBA:
+    case NVG_TEXTURE_BGRA: {
+      return w * h * 4;
+    }
+    case NVG_TEXTURE_RGB:
+    case NVG_TEXTURE_BGR: {
+      return w * h * 3;
+    }
+    case NVG_TEXTURE_RGB565:
+    case NVG_TEXTURE_BGR565: {
+      return w * h * 2;
+    }
+    default: {
+      return w * h;
     }
   }
-  return 0;
+}
+
+/*
+ * evict the least recently used textures until the pixels they reference fit in the budget.
+ * textures drawn in the current frame are kept, their pixels may still be in use by the caller.
+ */
+static void aggenvg__evictTextures(AGGENVGcontext* agge) {
+  while (agge->textureBytes > agge->maxTextureBytes) {
+    int i;
+    int id;
+    const uint8_t* data;
+    AGGENVGtexture* victim = NULL;
+
+    for (i = 0; i < agge->ntextures; i++) {
+      AGGENVGtexture* iter = agge->textures + i;
+      if (iter->id == 0 || iter->lastUsed == agge->frame) continue;
+
+      if (victim == NULL || (agge->frame - iter->lastUsed) > (agge->frame - victim->lastUsed)) {
+        victim = iter;
+      }
+    }
+
+    if (victim == NULL) break;
+
+    id = victim->id;
+    data = victim->data;
+    if (agge->onEvict != NULL) {
+      agge->onEvict(agge->onEvictCtx, id, data);
+    }
+    aggenvg__deleteTexture(agge, id);
+  }
 }
 
 static int aggenvg__renderCreate(void* uptr) {
@@ -150,6 +286,8 @@ static int aggenvg__renderCreateTexture(void* uptr, int type, int w, int h, int
   tex->type = type;
   tex->data = data;
   tex->flags = imageFlags;
+  tex->bytes = aggenvg__textureBytes(type, w, h);
+  agge->textureBytes += tex->bytes;
 
   return tex->id;
 }
@@ -196,7 +334,12 @@ static void aggenvg__renderCancel(void* uptr) {
 }
 
 static void aggenvg__renderFlush(void* uptr) {
-  NVG_NOTUSED(uptr);
+  AGGENVGcontext* agge = (AGGENVGcontext*)uptr;
+
+  if (agge->maxTextureBytes > 0) {
+    aggenvg__evictTextures(agge);
+  }
+  agge->frame++;
 }
 
 static void prepareRasterizer(AGGENVGcontext* agge, NVGscissor* scissor, NVGpaint* paint) {
@@ -223,15 +366,27 @@ static agge::pixel32_rgba to_pixel32_rgba(NVGcolor rgba) {
   return agge::pixel32_rgba(rgba.r * 255, rgba.g * 255, rgba.b * 255, rgba.a * 255);
 }
 
+template <typename BitmapT, typename BlenderT>
+static void aggenvg__render(AGGENVGcontext* agge, BitmapT& surface, const BlenderT& color) {
+  agge::rasterizer<agge::clipper<int> >& ras = agge->ras;
+
+  if (agge->renParallel != NULL && (uint32_t)(ras.height()) >= agge->parallelMinRows) {
+    (*agge->renParallel)(surface, 0, ras, color, agge::winding<>());
+  } else {
+    agge->ren(surface, 0, ras, color, agge::winding<>());
+  }
+}
+
 template <typename PixelT>
 void renderPaint(AGGENVGcontext* agge, NVGpaint* paint) {
-  agge::renderer& ren = agge->ren;
-  agge::rasterizer<agge::clipper<int> >& ras = agge->ras;
   agge::bitmap<PixelT, agge::raw_bitmap> surface(agge->w, agge->h, agge->stride, agge->data);
 
   if (paint->image > 0) {
     float invxform[6];
     AGGENVGtexture* tex = aggenvg__findTexture(agge, paint->image);
+    if (tex == NULL) return;
+
+    tex->lastUsed = agge->frame;
     nvgTransformInverse(invxform, paint->xform);
 
     switch (tex->type) {
@@ -239,28 +394,28 @@ void renderPaint(AGGENVGcontext* agge, NVGpaint* paint) {
         typedef agge::bitmap<agge::pixel32_rgba, agge::raw_bitmap> rgba_bitmap_t;
         rgba_bitmap_t src(tex->width, tex->height, tex->width*4, (uint8_t*)(tex->data));
         agge::nanovg_image_blender<PixelT, rgba_bitmap_t> color(&src, (float*)invxform);
-        ren(surface, 0, ras, color, agge::winding<>());
+        aggenvg__render(agge, surface, color);
         break;
       }
       case NVG_TEXTURE_BGRA: {
         typedef agge::bitmap<agge::pixel32_bgra, agge::raw_bitmap> bgra_bitmap_t;
         bgra_bitmap_t src(tex->width, tex->height, tex->width*4, (uint8_t*)(tex->data));
         agge::nanovg_image_blender<PixelT, bgra_bitmap_t> color(&src, (float*)invxform);
-        ren(surface, 0, ras, color, agge::winding<>());
+        aggenvg__render(agge, surface, color);
         break;
       }
       case NVG_TEXTURE_BGR565: {
         typedef agge::bitmap<agge::pixel16_bgr565, agge::raw_bitmap> bgr565_bitmap_t;
         bgr565_bitmap_t src(tex->width, tex->height, tex->width*2, (uint8_t*)(tex->data));
         agge::nanovg_image_blender<PixelT, bgr565_bitmap_t> color(&src, (float*)invxform);
-        ren(surface, 0, ras, color, agge::winding<>());
+        aggenvg__render(agge, surface, color);
         break;
       }
       case NVG_TEXTURE_RGB: {
         typedef agge::bitmap<agge::pixel24_rgb, agge::raw_bitmap> rgb_bitmap_t;
         rgb_bitmap_t src(tex->width, tex->height, tex->width*3, (uint8_t*)(tex->data));
         agge::nanovg_image_blender<PixelT, rgb_bitmap_t> color(&src, (float*)invxform);
-        ren(surface, 0, ras, color, agge::winding<>());
+        aggenvg__render(agge, surface, color);
         break;
       }
       default: {
@@ -271,7 +426,7 @@ void renderPaint(AGGENVGcontext* agge, NVGpaint* paint) {
   } else {
     if(memcmp(&(paint->innerColor), &(paint->outerColor), sizeof(paint->outerColor)) == 0) {
       agge::blender_solid_color_rgb<PixelT> color(agge->r, agge->g, agge->b, agge->a);
-      ren(surface, 0, ras, color, agge::winding<>());
+      aggenvg__render(agge, surface, color);
     } else if(paint->radius == 0) {
       const float large = 1e5;
       float dx = paint->xform[2];
@@ -283,9 +438,9 @@ void renderPaint(AGGENVGcontext* agge, NVGpaint* paint) {
       float ey = sy + d * dy;
       agge::pixel32_rgba ic = to_pixel32_rgba(paint->innerColor);
       agge::pixel32_rgba oc = to_pixel32_rgba(paint->outerColor);
-      agge::blender_linear_gradient<PixelT> color(sx, sy, ex, ey, ic, oc);
+      agge::blender_linear_gradient<PixelT> color(sx, sy, ex, ey, agge->gradients.get(ic, oc));
 
-      ren(surface, 0, ras, color, agge::winding<>());
+      aggenvg__render(agge, surface, color);
     } else {
       float cx = paint->xform[4];
       float cy = paint->xform[5];
@@ -294,9 +449,9 @@ void renderPaint(AGGENVGcontext* agge, NVGpaint* paint) {
       
       agge::pixel32_rgba ic = to_pixel32_rgba(paint->innerColor);
       agge::pixel32_rgba oc = to_pixel32_rgba(paint->outerColor);
-      agge::blender_radial_gradient<PixelT> color(cx, cy, inr, outr, ic, oc);
+      agge::blender_radial_gradient<PixelT> color(cx, cy, inr, outr, agge->gradients.get(ic, oc));
 
-      ren(surface, 0, ras, color, agge::winding<>());
+      aggenvg__render(agge, surface, color);
     }
   }
 }
@@ -312,6 +467,11 @@ void renderFill(void* uptr, NVGpaint* paint, NVGcompositeOperationState composit
 
   for (int i = 0; i < npaths; i++) {
     const NVGpath* p = paths + i;
+    /* an empty path (e.g. a lone move_to) must not close from the previous start point */
+    if (p->nfill < 1) {
+      continue;
+    }
+
     for (int j = 0; j < p->nfill; j++) {
       const NVGvertex* v = p->fill + j;
       if (j == 0) {
@@ -450,6 +610,44 @@ error:
   return NULL;
 }
 
+void nvgAggeSetTextureBudget(NVGcontext* ctx, uint32_t maxBytes, NVGaggeEvictFunc onEvict,
+                             void* onEvictCtx) {
+  NVGparams* params = nvgGetParams(ctx);
+  AGGENVGcontext* agge = (AGGENVGcontext*)(params->userPtr);
+
+  agge->maxTextureBytes = maxBytes;
+  agge->onEvict = onEvict;
+  agge->onEvictCtx = onEvictCtx;
+}
+
+uint32_t nvgAggeGetTextureBytes(NVGcontext* ctx) {
+  NVGparams* params = nvgGetParams(ctx);
+  AGGENVGcontext* agge = (AGGENVGcontext*)(params->userPtr);
+
+  return agge->textureBytes;
+}
+
+const uint8_t* nvgAggeGetTextureData(NVGcontext* ctx, int image) {
+  NVGparams* params = nvgGetParams(ctx);
+  AGGENVGcontext* agge = (AGGENVGcontext*)(params->userPtr);
+  AGGENVGtexture* tex = aggenvg__findTexture(agge, image);
+
+  return tex != NULL ? tex->data : NULL;
+}
+
+void nvgAggeSetParallel(NVGcontext* ctx, uint32_t parallelism, uint32_t minRows,
+                        NVGaggeParallelFunc run, void* runCtx) {
+  NVGparams* params = nvgGetParams(ctx);
+  AGGENVGcontext* agge = (AGGENVGcontext*)(params->userPtr);
+
+  if (parallelism > 1 && run != NULL) {
+    agge->setParallel(new AGGENVGparallel(parallelism, run, runCtx));
+  } else {
+    agge->setParallel(NULL);
+  }
+  agge->parallelMinRows = minRows;
+}
+
 void nvgDeleteAGGE(NVGcontext* ctx) {
   nvgDeleteInternal(ctx);
 }
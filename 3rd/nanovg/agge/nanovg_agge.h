@@ -15,11 +15,40 @@
 extern "C" {
 #endif
 
+/*
+ * called when a texture is evicted to keep the referenced pixels within the budget,
+ * the owner of the pixels (image_manager in awtk) can release them.
+ */
+typedef void (*NVGaggeEvictFunc)(void* ctx, int image, const uint8_t* data);
+
+/*runs task(taskCtx, index) for index in [0, n) concurrently and returns when all of them are done*/
+typedef void (*NVGaggeTaskFunc)(void* taskCtx, uint32_t index);
+typedef void (*NVGaggeParallelFunc)(void* ctx, NVGaggeTaskFunc task, void* taskCtx, uint32_t n);
+
 NVGcontext* nvgCreateAGGE(uint32_t w, uint32_t h, uint32_t stride, enum NVGtexture format, uint8_t* data);
 void nvgReinitAgge(NVGcontext* ctx, uint32_t w, uint32_t h, uint32_t stride, enum NVGtexture format,
                    uint8_t* data);
 void nvgDeleteAGGE(NVGcontext* ctx);
 
+/*
+ * textures only reference the pixels passed to nvgCreateImageRaw. when the pixels referenced by
+ * all textures exceed maxBytes(0 for no limit), nvgEndFrame evicts the least recently drawn
+ * textures(except the ones drawn in the current frame) and calls onEvict for each of them.
+ */
+void nvgAggeSetTextureBudget(NVGcontext* ctx, uint32_t maxBytes, NVGaggeEvictFunc onEvict,
+                             void* onEvictCtx);
+uint32_t nvgAggeGetTextureBytes(NVGcontext* ctx);
+/*return NULL if the image is deleted or evicted*/
+const uint8_t* nvgAggeGetTextureData(NVGcontext* ctx, int image);
+
+/*
+ * render the scanlines of fills/strokes covering at least minRows rows on parallelism threads
+ * through run(the calling thread is one of them). the output is identical to the serial one.
+ * parallelism <= 1 renders on the calling thread only.
+ */
+void nvgAggeSetParallel(NVGcontext* ctx, uint32_t parallelism, uint32_t minRows,
+                        NVGaggeParallelFunc run, void* runCtx);
+
 #ifdef __cplusplus
 }
 #endif
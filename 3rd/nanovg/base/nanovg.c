@@ -1046,6 +1046,27 @@ void nvgResetScissor(NVGcontext* ctx)
 	state->scissor.extent[1] = -1.0f;
 }
 
+int nvgIsRectVisible(NVGcontext* ctx, float x, float y, float w, float h)
+{
+	NVGstate* state = nvg__getState(ctx);
+	float* xform = state->xform;
+	float* sxform = state->scissor.xform;
+	float hw = w*0.5f, hh = h*0.5f;
+	float cx, cy, ex, ey, sex, sey;
+
+	if (state->scissor.extent[0] < 0) return 1;
+
+	// Bounds of the rect and of the scissor in the device space.
+	nvgTransformPoint(&cx, &cy, xform, x+hw, y+hh);
+	ex = hw*nvg__absf(xform[0]) + hh*nvg__absf(xform[2]);
+	ey = hw*nvg__absf(xform[1]) + hh*nvg__absf(xform[3]);
+	sex = state->scissor.extent[0]*nvg__absf(sxform[0]) + state->scissor.extent[1]*nvg__absf(sxform[2]);
+	sey = state->scissor.extent[0]*nvg__absf(sxform[1]) + state->scissor.extent[1]*nvg__absf(sxform[3]);
+
+	// One pixel more for the antialiasing fringe.
+	return nvg__absf(cx - sxform[4]) < ex + sex + 1.0f && nvg__absf(cy - sxform[5]) < ey + sey + 1.0f;
+}
+
 // Global composite operation.
 void nvgGlobalCompositeOperation(NVGcontext* ctx, int op)
 {
@@ -2506,6 +2527,125 @@ void nvgStroke(NVGcontext* ctx)
 	}
 }
 
+struct NVGretainedPath {
+	NVGpoint* points;
+	int npoints;
+	int cpoints;
+	NVGpath* paths;
+	int npaths;
+	int cpaths;
+	float bounds[4];
+	float xform[6];
+	int valid;
+};
+
+NVGretainedPath* nvgCreateRetainedPath(void)
+{
+	NVGretainedPath* rp = (NVGretainedPath*)malloc(sizeof(NVGretainedPath));
+	if (rp == NULL) return NULL;
+	memset(rp, 0, sizeof(NVGretainedPath));
+
+	return rp;
+}
+
+void nvgDeleteRetainedPath(NVGretainedPath* rp)
+{
+	if (rp == NULL) return;
+	if (rp->points != NULL) free(rp->points);
+	if (rp->paths != NULL) free(rp->paths);
+	free(rp);
+}
+
+int nvgRetainPath(NVGcontext* ctx, NVGretainedPath* rp)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGpathCache* cache = ctx->cache;
+	int i;
+
+	rp->valid = 0;
+	nvg__flattenPaths(ctx);
+
+	if (cache->npoints > rp->cpoints) {
+		NVGpoint* points = (NVGpoint*)realloc(rp->points, sizeof(NVGpoint)*cache->npoints);
+		if (points == NULL) return 0;
+		rp->points = points;
+		rp->cpoints = cache->npoints;
+	}
+	if (cache->npaths > rp->cpaths) {
+		NVGpath* paths = (NVGpath*)realloc(rp->paths, sizeof(NVGpath)*cache->npaths);
+		if (paths == NULL) return 0;
+		rp->paths = paths;
+		rp->cpaths = cache->npaths;
+	}
+
+	if (cache->npoints > 0)
+		memcpy(rp->points, cache->points, sizeof(NVGpoint)*cache->npoints);
+	for (i = 0; i < cache->npaths; i++) {
+		NVGpath* path = &rp->paths[i];
+		*path = cache->paths[i];
+		// Vertices are generated again on every fill/stroke.
+		path->fill = NULL;
+		path->nfill = 0;
+		path->stroke = NULL;
+		path->nstroke = 0;
+	}
+
+	rp->npoints = cache->npoints;
+	rp->npaths = cache->npaths;
+	memcpy(rp->bounds, cache->bounds, sizeof(rp->bounds));
+	memcpy(rp->xform, state->xform, sizeof(rp->xform));
+	rp->valid = 1;
+
+	return 1;
+}
+
+int nvgReusePath(NVGcontext* ctx, NVGretainedPath* rp)
+{
+	NVGstate* state = nvg__getState(ctx);
+	NVGpathCache* cache = ctx->cache;
+	float* t = state->xform;
+	float dx, dy;
+	int i;
+
+	if (rp == NULL || !rp->valid) return 0;
+	if (t[0] != rp->xform[0] || t[1] != rp->xform[1] || t[2] != rp->xform[2] || t[3] != rp->xform[3])
+		return 0;
+
+	if (rp->npoints > cache->cpoints) {
+		NVGpoint* points = (NVGpoint*)realloc(cache->points, sizeof(NVGpoint)*rp->npoints);
+		if (points == NULL) return 0;
+		cache->points = points;
+		cache->cpoints = rp->npoints;
+	}
+	if (rp->npaths > cache->cpaths) {
+		NVGpath* paths = (NVGpath*)realloc(cache->paths, sizeof(NVGpath)*rp->npaths);
+		if (paths == NULL) return 0;
+		cache->paths = paths;
+		cache->cpaths = rp->npaths;
+	}
+
+	ctx->ncommands = 0;
+	dx = t[4] - rp->xform[4];
+	dy = t[5] - rp->xform[5];
+	for (i = 0; i < rp->npoints; i++) {
+		NVGpoint* pt = &cache->points[i];
+		*pt = rp->points[i];
+		pt->x += dx;
+		pt->y += dy;
+	}
+	if (rp->npaths > 0)
+		memcpy(cache->paths, rp->paths, sizeof(NVGpath)*rp->npaths);
+
+	cache->npoints = rp->npoints;
+	cache->npaths = rp->npaths;
+	cache->bounds[0] = rp->bounds[0] + dx;
+	cache->bounds[1] = rp->bounds[1] + dy;
+	cache->bounds[2] = rp->bounds[2] + dx;
+	cache->bounds[3] = rp->bounds[3] + dy;
+
+	return 1;
+}
+
 #ifdef WITH_NANOVG_GPU
 // Add fonts
 int nvgCreateFont(NVGcontext* ctx, const char* name, const char* path)
@@ -441,6 +441,10 @@ void nvgIntersectScissor(NVGcontext* ctx, float x, float y, float w, float h);
 // Reset and disables scissoring.
 void nvgResetScissor(NVGcontext* ctx);
 
+// Returns 1 if the rectangle, in the current transform space, may be visible inside the scissor
+// (or if no scissor is set), 0 if it is completely outside of the scissor.
+int nvgIsRectVisible(NVGcontext* ctx, float x, float y, float w, float h);
+
 //
 // Paths
 //
@@ -508,6 +512,31 @@ void nvgFill(NVGcontext* ctx);
 // Fills the current path with current stroke style.
 void nvgStroke(NVGcontext* ctx);
 
+//
+// Retained paths
+//
+// A retained path keeps the flattened points of a path (in device space), so that a shape which
+// is drawn every frame does not need to be tessellated again. As long as the current transform
+// differs from the one used when the path was retained only by translation, the points are
+// translated and the curves are not flattened again.
+
+typedef struct NVGretainedPath NVGretainedPath;
+
+// Creates an empty retained path.
+NVGretainedPath* nvgCreateRetainedPath(void);
+
+// Deletes a retained path.
+void nvgDeleteRetainedPath(NVGretainedPath* rp);
+
+// Flattens the current path with the current transform and saves the result to rp.
+// Returns 1 on success.
+int nvgRetainPath(NVGcontext* ctx, NVGretainedPath* rp);
+
+// Replaces the current path with the retained path, translated to the current transform.
+// nvgFill() and nvgStroke() then use it directly. Returns 0 (and leaves the current path
+// untouched) if rp is empty or the transform changed other than by translation.
+int nvgReusePath(NVGcontext* ctx, NVGretainedPath* rp);
+
 
 //
 // Text
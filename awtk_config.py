@@ -64,6 +64,7 @@ NANOVG_BACKEND_PROJS=[];
 COMMON_CCFLAGS=' -DTK_ROOT=\\\"'+TK_ROOT+'\\\" ' 
 COMMON_CCFLAGS=COMMON_CCFLAGS+' -DWITH_STB_FONT '
 #COMMON_CCFLAGS=COMMON_CCFLAGS+' -DENABLE_PERFORMANCE_PROFILE=1 '
+#COMMON_CCFLAGS=COMMON_CCFLAGS+' -DTK_PERF_TRACE_FILE=\\\"perf_trace.json\\\" '
 #COMMON_CCFLAGS=COMMON_CCFLAGS+' -DWITH_FT_FONT '
 COMMON_CCFLAGS=COMMON_CCFLAGS+' -DSTBTT_STATIC -DSTB_IMAGE_STATIC -DWITH_STB_IMAGE '
 COMMON_CCFLAGS=COMMON_CCFLAGS+' -DWITH_VGCANVAS -DWITH_UNICODE_BREAK -DWITH_DESKTOP_STYLE '
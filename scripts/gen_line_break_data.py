@@ -0,0 +1,143 @@
+#!/usr/bin/python
+# -*- coding: utf-8 -*-
+
+# 根据3rd/libunibreak中的数据生成src/base/line_break_data.inc。
+#
+# 每个字符的换行属性(LBP_*)和分词属性(WBP_*)组合成一个字符类别，
+# BMP中的字符通过两级表查找类别，其它字符通过二分查找区间表(每项为起始字符<<8|类别)。
+#
+# Usage: ./scripts/gen_line_break_data.py
+
+import os
+import re
+
+ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+UNIBREAK_DIR = os.path.join(ROOT, '3rd/libunibreak')
+OUTPUT = os.path.join(ROOT, 'src/base/line_break_data.inc')
+
+BLOCK_BITS = 6
+BLOCK_SIZE = 1 << BLOCK_BITS
+BMP_SIZE = 0x10000
+MAX_CHAR = 0x110000
+
+LB_DEFAULT = 'LBP_XX'
+WB_DEFAULT = 'WBP_Any'
+WB_EXT_PICT = 'WBP_EXT_PICT'
+
+RANGE_RE = re.compile(r'\{\s*(0x[0-9A-Fa-f]+)\s*,\s*(0x[0-9A-Fa-f]+)\s*(?:,\s*(\w+)\s*)?\}')
+
+
+def load_ranges(name, default):
+  with open(os.path.join(UNIBREAK_DIR, name), 'r') as f:
+    text = f.read()
+
+  ranges = []
+  for m in RANGE_RE.finditer(text):
+    if int(m.group(1), 16) >= MAX_CHAR:
+      continue
+    ranges.append((int(m.group(1), 16), int(m.group(2), 16), m.group(3) or default))
+
+  ranges.sort()
+  for i in range(1, len(ranges)):
+    assert ranges[i - 1][1] < ranges[i][0], name + ': overlapped ranges'
+
+  return ranges
+
+
+def fill(ranges, default):
+  props = [default] * MAX_CHAR
+  for (start, end, prop) in ranges:
+    for c in range(start, end + 1):
+      props[c] = prop
+  return props
+
+
+def main():
+  lb = fill(load_ranges('linebreakdata.c', None), LB_DEFAULT)
+  wb = fill(load_ranges('wordbreakdata.inc', None), WB_DEFAULT)
+
+  # 分词算法只对WBP_Any(WB3c)检查Extended_Pictographic，用一个额外的类别区分。
+  for (start, end, prop) in load_ranges('emojidata.inc', 'EP'):
+    for c in range(start, end + 1):
+      if wb[c] == WB_DEFAULT:
+        wb[c] = WB_EXT_PICT
+
+  classes = [(LB_DEFAULT, WB_DEFAULT)]
+  class_ids = {classes[0]: 0}
+  ids = [0] * MAX_CHAR
+  for c in range(MAX_CHAR):
+    key = (lb[c], wb[c])
+    if key not in class_ids:
+      class_ids[key] = len(classes)
+      classes.append(key)
+    ids[c] = class_ids[key]
+  assert len(classes) <= 256
+
+  blocks = []
+  block_ids = {}
+  index = []
+  for i in range(0, BMP_SIZE, BLOCK_SIZE):
+    block = tuple(ids[i:i + BLOCK_SIZE])
+    if block not in block_ids:
+      block_ids[block] = len(blocks)
+      blocks.append(block)
+    index.append(block_ids[block])
+  assert len(blocks) <= 256
+
+  ranges = []
+  for c in range(BMP_SIZE, MAX_CHAR):
+    if not ranges or ranges[-1][1] != ids[c]:
+      ranges.append((c, ids[c]))
+
+  lb_samples = {}
+  wb_samples = {}
+  for c in range(MAX_CHAR):
+    lb_samples.setdefault(lb[c], c)
+    wb_samples.setdefault(wb[c], c)
+
+  out = []
+  out.append('/*此文件由scripts/gen_line_break_data.py根据3rd/libunibreak中的数据生成，请不要手工修改。*/\n')
+  out.append('#define BREAK_CLASS_BLOCK_BITS %d\n' % BLOCK_BITS)
+  out.append('#define BREAK_CLASS_BLOCK_MASK 0x%x\n\n' % (BLOCK_SIZE - 1))
+
+  out.append('static const break_class_t s_break_classes[%d] = {\n' % len(classes))
+  for (l, w) in classes:
+    out.append('    {%s, %s},\n' % (l, w))
+  out.append('};\n\n')
+
+  out.append('static const uint8_t s_break_class_index[%d] = {\n' % len(index))
+  for i in range(0, len(index), 16):
+    out.append('    ' + ', '.join(str(x) for x in index[i:i + 16]) + ',\n')
+  out.append('};\n\n')
+
+  out.append('static const uint8_t s_break_class_blocks[%d][%d] = {\n' % (len(blocks), BLOCK_SIZE))
+  for block in blocks:
+    out.append('    {\n')
+    for i in range(0, BLOCK_SIZE, 16):
+      out.append('        ' + ', '.join(str(x) for x in block[i:i + 16]) + ',\n')
+    out.append('    },\n')
+  out.append('};\n\n')
+
+  out.append('static const uint32_t s_break_class_ranges[%d] = {\n' % len(ranges))
+  for i in range(0, len(ranges), 8):
+    out.append('    ' + ', '.join('0x%08x' % ((start << 8) | cls) for (start, cls) in ranges[i:i + 8]) + ',\n')
+  out.append('};\n\n')
+
+  out.append('static const break_sample_t s_line_break_samples[%d] = {\n' % len(lb_samples))
+  for (prop, c) in sorted(lb_samples.items(), key=lambda x: x[1]):
+    out.append('    {%s, 0x%04X},\n' % (prop, c))
+  out.append('};\n\n')
+
+  out.append('static const break_sample_t s_word_break_samples[%d] = {\n' % len(wb_samples))
+  for (prop, c) in sorted(wb_samples.items(), key=lambda x: x[1]):
+    out.append('    {%s, 0x%04X},\n' % (prop, c))
+  out.append('};\n')
+
+  with open(OUTPUT, 'w') as f:
+    f.write(''.join(out))
+
+  print('classes=%d blocks=%d ranges=%d' % (len(classes), len(blocks), len(ranges)))
+
+
+if __name__ == '__main__':
+  main()
@@ -21,6 +21,7 @@
 
 #ifndef TK_BASE_H
 #define TK_BASE_H
+#include "base/asset_bundle.h"
 #include "base/assets_manager.h"
 #include "base/awtk_config_sample.h"
 #include "base/bitmap.h"
@@ -79,6 +80,7 @@
 #include "base/widget_animator.h"
 #include "base/widget_animator_factory.h"
 #include "base/widget_animator_manager.h"
+#include "base/widget_atoms.h"
 #include "base/widget_consts.h"
 #include "base/widget_factory.h"
 #include "base/widget_pool.h"
@@ -24,6 +24,7 @@
 #include "base/idle.h"
 #include "base/timer.h"
 #include "tkc/time_now.h"
+#include "tkc/perf_trace.h"
 #include "base/locale_info.h"
 #include "tkc/platform.h"
 #include "base/main_loop.h"
@@ -35,6 +36,7 @@
 #include "base/assets_manager.h"
 #include "base/widget_pool.h"
 #include "base/widget_animator_manager.h"
+#include "font_loader/font_loader_sdf.h"
 #include "font_loader/font_loader_bitmap.h"
 #include "base/window_animator_factory.h"
 #include "window_animators/window_animator_builtins.h"
@@ -69,6 +71,10 @@ static ret_t tk_add_font(const asset_info_t* res) {
 #ifdef WITH_BITMAP_FONT
     font_manager_add_font(font_manager(), font_bitmap_create(res->name, res->data, res->size));
 #endif
+  } else if (res->subtype == ASSET_TYPE_FONT_SDF) {
+#ifdef WITH_SDF_FONT
+    font_manager_add_font(font_manager(), font_sdf_create(res->name, res->data, res->size));
+#endif /*WITH_SDF_FONT*/
   } else if (res->subtype == ASSET_TYPE_FONT_TTF) {
 #ifdef WITH_TRUETYPE_FONT
     font_manager_add_font(font_manager(), font_truetype_create(res->name, res->data, res->size));
@@ -129,6 +135,8 @@ ret_t tk_init_internal(void) {
 
 #ifdef WITH_TRUETYPE_FONT
   font_loader = font_loader_truetype();
+#elif defined(WITH_SDF_FONT)
+  font_loader = font_loader_sdf();
 #elif defined(WITH_BITMAP_FONT)
   font_loader = font_loader_bitmap();
 #endif /*WITH_TRUETYPE_FONT*/
@@ -136,7 +144,11 @@ ret_t tk_init_internal(void) {
 #ifdef WITH_WIDGET_POOL
   return_value_if_fail(widget_pool_set(widget_pool_create(WITH_WIDGET_POOL)) == RET_OK, RET_FAIL);
 #endif /*WITH_WIDGET_POOL*/
+#ifdef ENABLE_PERFORMANCE_PROFILE
+  return_value_if_fail(perf_trace_init(TK_PERF_TRACE_CAPACITY) == RET_OK, RET_FAIL);
+#endif /*ENABLE_PERFORMANCE_PROFILE*/
   return_value_if_fail(timer_init(time_now_ms) == RET_OK, RET_FAIL);
+  eval_cache_init();
   return_value_if_fail(idle_manager_set(idle_manager_create()) == RET_OK, RET_FAIL);
   return_value_if_fail(input_method_set(input_method_create()) == RET_OK, RET_FAIL);
   return_value_if_fail(widget_factory_set(widget_factory_create()) == RET_OK, RET_FAIL);
@@ -240,6 +252,15 @@ ret_t tk_deinit_internal(void) {
   assets_manager_destroy(assets_manager());
   assets_manager_set(NULL);
 
+#ifdef ENABLE_PERFORMANCE_PROFILE
+#ifdef TK_PERF_TRACE_FILE
+  perf_trace_save(TK_PERF_TRACE_FILE);
+#endif /*TK_PERF_TRACE_FILE*/
+  perf_trace_deinit();
+#endif /*ENABLE_PERFORMANCE_PROFILE*/
+
+  atom_deinit();
+  eval_cache_deinit();
   system_info_deinit();
 
   return RET_OK;
@@ -23,6 +23,7 @@
 #define TK_TKC_H
 
 #include "tkc/darray.h"
+#include "tkc/atom.h"
 #include "tkc/buffer.h"
 #include "tkc/color.h"
 #include "tkc/color_parser.h"
@@ -33,8 +34,10 @@
 #include "tkc/func_call_parser.h"
 #include "tkc/matrix.h"
 #include "tkc/mem.h"
+#include "tkc/mmap.h"
 #include "tkc/mutex.h"
 #include "tkc/path.h"
+#include "tkc/perf_trace.h"
 #include "tkc/platform.h"
 #include "tkc/rect.h"
 #include "tkc/str.h"
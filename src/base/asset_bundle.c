@@ -0,0 +1,125 @@
+/**
+ * File:   asset_bundle.c
+ * Author: AWTK Develop Team
+ * Brief:  all assets packed in one memory mapped file
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "base/asset_bundle.h"
+
+static ret_t asset_bundle_check(asset_bundle_t* bundle) {
+  uint32_t i = 0;
+  uint32_t size = bundle->map->size;
+  const asset_bundle_header_t* header = bundle->header;
+  uint32_t data_start = sizeof(asset_bundle_header_t);
+
+  return_value_if_fail(size >= sizeof(asset_bundle_header_t), RET_BAD_PARAMS);
+  return_value_if_fail(header->magic == ASSET_BUNDLE_MAGIC, RET_BAD_PARAMS);
+  return_value_if_fail(header->version == ASSET_BUNDLE_VERSION, RET_BAD_PARAMS);
+  return_value_if_fail(header->size == size, RET_BAD_PARAMS);
+  return_value_if_fail(header->nr <= (size - data_start) / sizeof(asset_bundle_entry_t),
+                       RET_BAD_PARAMS);
+
+  data_start += header->nr * sizeof(asset_bundle_entry_t);
+  for (i = 0; i < header->nr; i++) {
+    const asset_bundle_entry_t* iter = bundle->entries + i;
+
+    return_value_if_fail(iter->offset >= data_start && iter->offset <= size, RET_BAD_PARAMS);
+    return_value_if_fail(size - iter->offset >= sizeof(asset_info_t), RET_BAD_PARAMS);
+    return_value_if_fail(size - iter->offset - sizeof(asset_info_t) >= iter->size,
+                         RET_BAD_PARAMS);
+  }
+
+  return RET_OK;
+}
+
+asset_bundle_t* asset_bundle_open(const char* filename) {
+  mmap_t* map = NULL;
+  asset_bundle_t* bundle = NULL;
+  return_value_if_fail(filename != NULL, NULL);
+
+  map = mmap_create(filename);
+  return_value_if_fail(map != NULL, NULL);
+
+  bundle = TKMEM_ZALLOC(asset_bundle_t);
+  goto_error_if_fail(bundle != NULL);
+
+  bundle->map = map;
+  bundle->header = (const asset_bundle_header_t*)(map->data);
+  bundle->entries = (const asset_bundle_entry_t*)(bundle->header + 1);
+  goto_error_if_fail(asset_bundle_check(bundle) == RET_OK);
+
+  return bundle;
+error:
+  log_warn("invalid asset bundle: %s\n", filename);
+  mmap_destroy(map);
+  TKMEM_FREE(bundle);
+
+  return NULL;
+}
+
+const asset_info_t* asset_bundle_find(asset_bundle_t* bundle, asset_type_t type, const char* key) {
+  int32_t low = 0;
+  int32_t mid = 0;
+  int32_t high = 0;
+  int32_t result = 0;
+  const asset_bundle_entry_t* iter = NULL;
+  return_value_if_fail(bundle != NULL && key != NULL, NULL);
+
+  high = bundle->header->nr - 1;
+  while (low <= high) {
+    mid = low + ((high - low) >> 1);
+    iter = bundle->entries + mid;
+
+    result = (int32_t)(iter->type) - (int32_t)type;
+    if (result == 0) {
+      result = strcmp(iter->key, key);
+    }
+
+    if (result == 0) {
+      return (const asset_info_t*)((const uint8_t*)(bundle->map->data) + iter->offset);
+    } else if (result < 0) {
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+
+  return NULL;
+}
+
+bool_t asset_bundle_has(asset_bundle_t* bundle, const asset_info_t* info) {
+  const uint8_t* p = (const uint8_t*)info;
+  const uint8_t* start = NULL;
+  return_value_if_fail(bundle != NULL && info != NULL, FALSE);
+
+  start = (const uint8_t*)(bundle->map->data);
+
+  return p >= start && p < (start + bundle->map->size);
+}
+
+ret_t asset_bundle_close(asset_bundle_t* bundle) {
+  return_value_if_fail(bundle != NULL, RET_BAD_PARAMS);
+
+  mmap_destroy(bundle->map);
+  memset(bundle, 0x00, sizeof(asset_bundle_t));
+  TKMEM_FREE(bundle);
+
+  return RET_OK;
+}
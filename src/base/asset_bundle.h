@@ -0,0 +1,130 @@
+/**
+ * File:   asset_bundle.h
+ * Author: AWTK Develop Team
+ * Brief:  all assets packed in one memory mapped file
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_ASSET_BUNDLE_H
+#define TK_ASSET_BUNDLE_H
+
+#include "tkc/mmap.h"
+#include "base/assets_manager.h"
+
+BEGIN_C_DECLS
+
+#define ASSET_BUNDLE_MAGIC 0x444e4241 /*"ABND"*/
+#define ASSET_BUNDLE_VERSION 1
+#define ASSET_BUNDLE_DEFAULT_NAME "assets.bundle"
+
+/*key of image is "ratio/name", such as "x2/earth", "xx/earth" and "svg/earth".*/
+#define ASSET_BUNDLE_KEY_LEN 47
+
+/**
+ * @class asset_bundle_header_t
+ * 资源包的文件头。
+ */
+typedef struct _asset_bundle_header_t {
+  uint32_t magic;
+  uint32_t version;
+  /*number of entries*/
+  uint32_t nr;
+  /*total size of the bundle file*/
+  uint32_t size;
+} asset_bundle_header_t;
+
+/**
+ * @class asset_bundle_entry_t
+ * 资源包的索引项。
+ *
+ * 索引项紧跟在文件头之后，按(type, key)排序，查找时使用二分查找。
+ * offset指向一个完整的asset\_info\_t(is\_in\_rom为TRUE)，数据紧跟其后。
+ */
+typedef struct _asset_bundle_entry_t {
+  uint16_t type;
+  uint8_t subtype;
+  uint8_t reserved;
+  uint32_t offset;
+  uint32_t size;
+  char key[ASSET_BUNDLE_KEY_LEN + 1];
+} asset_bundle_entry_t;
+
+/**
+ * @class asset_bundle_t
+ * 资源包。
+ *
+ * 把全部资源打包到一个文件中(由resgen生成)，运行时把该文件映射到内存，
+ * 返回的asset\_info\_t直接指向映射的内存，无需拷贝，也不需要逐个打开资源文件。
+ *
+ * 资源包的结构如下：
+ *
+ * ```
+ * asset_bundle_header_t
+ * asset_bundle_entry_t[nr]   (按type和key排序)
+ * asset_info_t + data        (8字节对齐)
+ * ...
+ * ```
+ */
+typedef struct _asset_bundle_t {
+  mmap_t* map;
+  const asset_bundle_header_t* header;
+  const asset_bundle_entry_t* entries;
+} asset_bundle_t;
+
+/**
+ * @method asset_bundle_open
+ * 打开资源包。
+ * @annotation ["constructor"]
+ * @param {const char*} filename 资源包的文件名。
+ *
+ * @return {asset_bundle_t*} 返回资源包对象，失败返回NULL。
+ */
+asset_bundle_t* asset_bundle_open(const char* filename);
+
+/**
+ * @method asset_bundle_find
+ * 在资源包中查找资源。
+ * @param {asset_bundle_t*} bundle 资源包对象。
+ * @param {asset_type_t} type 资源的类型。
+ * @param {const char*} key 资源的键值(图片为"ratio/name"，其它资源为名称)。
+ *
+ * @return {const asset_info_t*} 返回资源，不存在返回NULL。
+ */
+const asset_info_t* asset_bundle_find(asset_bundle_t* bundle, asset_type_t type, const char* key);
+
+/**
+ * @method asset_bundle_has
+ * 检查资源是否位于资源包中。
+ * @param {asset_bundle_t*} bundle 资源包对象。
+ * @param {const asset_info_t*} info 资源。
+ *
+ * @return {bool_t} 返回TRUE表示是，否则表示否。
+ */
+bool_t asset_bundle_has(asset_bundle_t* bundle, const asset_info_t* info);
+
+/**
+ * @method asset_bundle_close
+ * 关闭资源包。从资源包中获取的资源将全部失效。
+ * @param {asset_bundle_t*} bundle 资源包对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t asset_bundle_close(asset_bundle_t* bundle);
+
+END_C_DECLS
+
+#endif /*TK_ASSET_BUNDLE_H*/
@@ -25,6 +25,7 @@
 #include "base/enums.h"
 #include "base/locale_info.h"
 #include "base/system_info.h"
+#include "base/asset_bundle.h"
 #include "base/assets_manager.h"
 
 static ret_t asset_info_unref(asset_info_t* info);
@@ -48,7 +49,29 @@ static locale_info_t* assets_manager_get_locale_info(assets_manager_t* am) {
   return am->locale_info != NULL ? am->locale_info : locale_info();
 }
 
+static system_info_t* assets_manager_get_system_info(assets_manager_t* am) {
+  return_value_if_fail(am != NULL, NULL);
+
+  return am->system_info != NULL ? am->system_info : system_info();
+}
+
+static const char* assets_manager_get_ratio(assets_manager_t* am) {
+  float_t dpr = assets_manager_get_system_info(am)->device_pixel_ratio;
+
+  if (dpr >= 3) {
+    return "x3";
+  } else if (dpr >= 2) {
+    return "x2";
+  } else {
+    return "x1";
+  }
+}
+
 #if defined(AWTK_WEB)
+static asset_bundle_t* assets_manager_get_bundle(assets_manager_t* am) {
+  return am->bundle;
+}
+
 asset_info_t* assets_manager_load(assets_manager_t* am, asset_type_t type, const char* name) {
   asset_info_t* info = TKMEM_ALLOC(sizeof(asset_info_t));
   return_value_if_fail(info != NULL, NULL);
@@ -66,12 +89,6 @@ asset_info_t* assets_manager_load(assets_manager_t* am, asset_type_t type, const
 #elif defined(WITH_FS_RES)
 #include "tkc/fs.h"
 
-static system_info_t* assets_manager_get_system_info(assets_manager_t* am) {
-  return_value_if_fail(am != NULL, NULL);
-
-  return am->system_info != NULL ? am->system_info : system_info();
-}
-
 static const char* assets_manager_get_res_root(assets_manager_t* am) {
   if (am->res_root != NULL) {
     return am->res_root;
@@ -101,17 +118,9 @@ static asset_info_t* load_asset(uint16_t type, uint16_t subtype, uint32_t size,
 static ret_t build_path(assets_manager_t* am, char* path, uint32_t size, bool_t ratio_sensitive,
                         const char* subpath, const char* name, const char* extname) {
   const char* res_root = assets_manager_get_res_root(am);
-  system_info_t* sysinfo = assets_manager_get_system_info(am);
-
-  float_t dpr = sysinfo->device_pixel_ratio;
 
   if (ratio_sensitive) {
-    const char* ratio = "x1";
-    if (dpr >= 3) {
-      ratio = "x3";
-    } else if (dpr >= 2) {
-      ratio = "x2";
-    }
+    const char* ratio = assets_manager_get_ratio(am);
 
     return_value_if_fail(path_build(path, size, res_root, subpath, ratio, name, NULL) == RET_OK,
                          RET_FAIL);
@@ -226,6 +235,8 @@ static uint16_t subtype_from_extname(const char* extname) {
     subtype = ASSET_TYPE_IMAGE_JPG;
   } else if (tk_str_ieq(extname, "ttf")) {
     subtype = ASSET_TYPE_FONT_TTF;
+  } else if (tk_str_ieq(extname, ".sdf")) {
+    subtype = ASSET_TYPE_FONT_SDF;
   } else {
     log_debug("not supported %s\n", extname);
   }
@@ -256,6 +267,10 @@ asset_info_t* assets_manager_load_asset(assets_manager_t* am, asset_type_t type,
       if ((info = try_load_assets(am, name, ".bin", type, ASSET_TYPE_FONT_BMP)) != NULL) {
         break;
       }
+
+      if ((info = try_load_assets(am, name, ".sdf", type, ASSET_TYPE_FONT_SDF)) != NULL) {
+        break;
+      }
       break;
     }
     case ASSET_TYPE_SCRIPT: {
@@ -341,6 +356,21 @@ asset_info_t* assets_manager_load_asset(assets_manager_t* am, asset_type_t type,
   return info;
 }
 
+static asset_bundle_t* assets_manager_get_bundle(assets_manager_t* am) {
+  if (am->bundle == NULL && !am->bundle_probed) {
+    char path[MAX_PATH + 1];
+    const char* res_root = assets_manager_get_res_root(am);
+
+    am->bundle_probed = TRUE;
+    if (path_build(path, MAX_PATH, res_root, "assets", ASSET_BUNDLE_DEFAULT_NAME, NULL) == RET_OK &&
+        file_exist(path)) {
+      am->bundle = asset_bundle_open(path);
+    }
+  }
+
+  return am->bundle;
+}
+
 asset_info_t* assets_manager_load(assets_manager_t* am, asset_type_t type, const char* name) {
   if (strncmp(name, STR_SCHEMA_FILE, strlen(STR_SCHEMA_FILE)) == 0) {
     return assets_manager_load_file(am, type, name + strlen(STR_SCHEMA_FILE));
@@ -349,6 +379,10 @@ asset_info_t* assets_manager_load(assets_manager_t* am, asset_type_t type, const
   }
 }
 #else
+static asset_bundle_t* assets_manager_get_bundle(assets_manager_t* am) {
+  return am->bundle;
+}
+
 asset_info_t* assets_manager_load(assets_manager_t* am, asset_type_t type, const char* name) {
   (void)type;
   (void)name;
@@ -356,6 +390,35 @@ asset_info_t* assets_manager_load(assets_manager_t* am, asset_type_t type, const
 }
 #endif /*WITH_FS_RES*/
 
+static const asset_info_t* assets_manager_load_from_bundle(assets_manager_t* am,
+                                                           asset_type_t type, const char* name) {
+  const asset_info_t* info = NULL;
+  asset_bundle_t* bundle = assets_manager_get_bundle(am);
+
+  if (bundle == NULL || strncmp(name, STR_SCHEMA_FILE, strlen(STR_SCHEMA_FILE)) == 0) {
+    return NULL;
+  }
+
+  if (type == ASSET_TYPE_IMAGE) {
+    uint32_t i = 0;
+    char key[ASSET_BUNDLE_KEY_LEN + 1];
+    const char* ratios[] = {assets_manager_get_ratio(am), "xx", "svg"};
+
+    for (i = 0; i < ARRAY_SIZE(ratios) && info == NULL; i++) {
+      tk_snprintf(key, sizeof(key), "%s/%s", ratios[i], name);
+      info = asset_bundle_find(bundle, type, key);
+    }
+  } else {
+    info = asset_bundle_find(bundle, type, name);
+  }
+
+  if (info != NULL) {
+    assets_manager_add(am, info);
+  }
+
+  return info;
+}
+
 assets_manager_t* assets_manager(void) {
   return s_assets_manager;
 }
@@ -422,6 +485,37 @@ ret_t assets_manager_set_res_root(assets_manager_t* am, const char* res_root) {
   return_value_if_fail(am != NULL, RET_BAD_PARAMS);
 
   am->res_root = tk_str_copy(am->res_root, res_root);
+  if (am->bundle == NULL) {
+    am->bundle_probed = FALSE;
+  }
+
+  return RET_OK;
+}
+
+ret_t assets_manager_set_bundle(assets_manager_t* am, const char* filename) {
+  asset_bundle_t* bundle = NULL;
+  return_value_if_fail(am != NULL, RET_BAD_PARAMS);
+
+  if (filename != NULL) {
+    bundle = asset_bundle_open(filename);
+    return_value_if_fail(bundle != NULL, RET_FAIL);
+  }
+
+  if (am->bundle != NULL) {
+    int32_t i = 0;
+    const asset_info_t** all = (const asset_info_t**)(am->assets.elms);
+
+    for (i = (int32_t)(am->assets.size) - 1; i >= 0; i--) {
+      if (asset_bundle_has(am->bundle, all[i])) {
+        darray_remove_index(&(am->assets), i);
+      }
+    }
+
+    asset_bundle_close(am->bundle);
+  }
+
+  am->bundle = bundle;
+  am->bundle_probed = TRUE;
 
   return RET_OK;
 }
@@ -477,6 +571,10 @@ static const asset_info_t* assets_manager_ref_impl(assets_manager_t* am, asset_t
                                                    const char* name) {
   const asset_info_t* info = assets_manager_find_in_cache(am, type, name);
 
+  if (info == NULL) {
+    info = assets_manager_load_from_bundle(am, type, name);
+  }
+
   if (info == NULL) {
     info = assets_manager_load(am, type, name);
   } else {
@@ -563,6 +661,10 @@ ret_t assets_manager_deinit(assets_manager_t* am) {
 
   TKMEM_FREE(am->res_root);
   darray_deinit(&(am->assets));
+  if (am->bundle != NULL) {
+    asset_bundle_close(am->bundle);
+    am->bundle = NULL;
+  }
 
   return RET_OK;
 }
@@ -27,6 +27,9 @@
 
 BEGIN_C_DECLS
 
+struct _asset_bundle_t;
+typedef struct _asset_bundle_t asset_bundle_t;
+
 /**
  * @enum asset_type_t
  * @prefix ASSET_TYPE_
@@ -96,7 +99,8 @@ typedef enum _asset_type_t {
 typedef enum _asset_font_type_t {
   ASSET_TYPE_FONT_NONE,
   ASSET_TYPE_FONT_TTF,
-  ASSET_TYPE_FONT_BMP
+  ASSET_TYPE_FONT_BMP,
+  ASSET_TYPE_FONT_SDF
 } asset_font_type_t;
 
 /**
@@ -236,6 +240,9 @@ typedef struct _asset_info_t {
  *  ui      UI描述数据。
  * ```
  *
+ *如果资源目录下存在assets/assets.bundle(由resgen生成的资源包)，则优先从资源包中加载资源。
+ *资源包被映射到内存中，加载资源时不需要拷贝数据，也不需要逐个打开资源文件。
+ *
  */
 struct _assets_manager_t {
   darray_t assets;
@@ -244,6 +251,8 @@ struct _assets_manager_t {
   char* res_root;
   locale_info_t* locale_info;
   system_info_t* system_info;
+  asset_bundle_t* bundle;
+  bool_t bundle_probed;
 };
 
 /**
@@ -296,6 +305,19 @@ assets_manager_t* assets_manager_init(assets_manager_t* am, uint32_t init_nr);
  */
 ret_t assets_manager_set_res_root(assets_manager_t* am, const char* res_root);
 
+/**
+ * @method assets_manager_set_bundle
+ * 设置资源包(由resgen生成)。设置之后，优先从资源包中加载资源。
+ *
+ * > 缓存中来自旧资源包的资源会被清除，调用者需要确保不再使用它们。
+ *
+ * @param {assets_manager_t*} am asset manager对象。
+ * @param {const char*} filename 资源包的文件名。为NULL时关闭当前的资源包。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t assets_manager_set_bundle(assets_manager_t* am, const char* filename);
+
 /**
  * @method assets_manager_set_system_info
  * 设置system_info对象。
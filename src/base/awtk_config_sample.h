@@ -34,6 +34,11 @@
  * #define WITH_BITMAP_FONT 1
  */
 
+/**
+ * 如果需要支持距离场(SDF)字体，请定义本宏。一份字体数据可以绘制任意大小的文字。
+ * #define WITH_SDF_FONT 1
+ */
+
 /**
  * 如果支持png/jpeg图片，请定义本宏
  *
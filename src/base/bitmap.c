@@ -356,6 +356,75 @@ ret_t bitmap_init(bitmap_t* bitmap, uint32_t w, uint32_t h, bitmap_format_t form
   return bitmap->data != NULL ? RET_OK : RET_OOM;
 }
 
+static void bitmap_calc_span(const uint8_t* a, uint32_t w, bitmap_span_t* span) {
+  uint32_t x = 0;
+  uint32_t start = 0;
+  uint32_t end = w;
+
+  memset(span, 0x00, sizeof(bitmap_span_t));
+  while (start < w && a[start * 4] <= 8) {
+    start++;
+  }
+
+  while (end > start && a[(end - 1) * 4] <= 8) {
+    end--;
+  }
+
+  span->start = start;
+  span->end = end;
+  span->opaque_start = start;
+  span->opaque_end = start;
+
+  for (x = start; x < end; x++) {
+    if (a[x * 4] == 0xff) {
+      uint32_t run = x;
+
+      while (x < end && a[x * 4] == 0xff) {
+        x++;
+      }
+
+      if ((x - run) > (uint32_t)(span->opaque_end - span->opaque_start)) {
+        span->opaque_start = run;
+        span->opaque_end = x;
+      }
+    }
+  }
+}
+
+ret_t bitmap_calc_spans(bitmap_t* bitmap, bitmap_span_t* spans) {
+  uint32_t y = 0;
+  uint32_t a_index = 0;
+  uint32_t line_length = 0;
+  const uint8_t* data = NULL;
+  return_value_if_fail(bitmap != NULL && bitmap->data != NULL && spans != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(bitmap->w <= 0xffff, RET_BAD_PARAMS);
+
+  switch (bitmap->format) {
+    case BITMAP_FMT_RGBA8888:
+    case BITMAP_FMT_BGRA8888: {
+      a_index = 3;
+      break;
+    }
+    case BITMAP_FMT_ABGR8888:
+    case BITMAP_FMT_ARGB8888: {
+      a_index = 0;
+      break;
+    }
+    default: {
+      return RET_NOT_IMPL;
+    }
+  }
+
+  data = bitmap->data + a_index;
+  line_length = bitmap_get_line_length(bitmap);
+  for (y = 0; y < bitmap->h; y++) {
+    bitmap_calc_span(data, bitmap->w, spans + y);
+    data += line_length;
+  }
+
+  return RET_OK;
+}
+
 ret_t bitmap_set_line_length(bitmap_t* bitmap, uint32_t line_length) {
   uint32_t bpp = bitmap_get_bpp(bitmap);
   return_value_if_fail(bitmap != NULL, RET_BAD_PARAMS);
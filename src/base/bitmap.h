@@ -122,9 +122,49 @@ typedef enum _bitmap_flag_t {
    * @const BITMAP_FLAG_PREMULTI_ALPHA
    * 预乘alpha。
    */
-  BITMAP_FLAG_PREMULTI_ALPHA = 16
+  BITMAP_FLAG_PREMULTI_ALPHA = 16,
+  /**
+   * @const BITMAP_FLAG_SMOOTH
+   * 缩放显示时使用平滑算法(IMAGE\_QUALITY\_SMOOTH)。
+   */
+  BITMAP_FLAG_SMOOTH = 32,
+  /**
+   * @const BITMAP_FLAG_SPANS
+   * 位图资源的图片数据后面附带了每一行的透明/不透明范围(bitmap\_span\_t)，由image\_gen生成。
+   */
+  BITMAP_FLAG_SPANS = 64
 } bitmap_flag_t;
 
+/**
+ * @class bitmap_span_t
+ * 图片中一行的透明/不透明范围。
+ *
+ * [start, end)之外的像素是透明的(alpha<=8)，[opaque\_start, opaque\_end)之间的像素是完全不透明的，
+ * 其它像素需要混合。贴图时可以跳过透明的像素，直接拷贝不透明的像素。
+ */
+typedef struct _bitmap_span_t {
+  /**
+   * @property {uint16_t} start
+   * 第一个不透明的像素。
+   */
+  uint16_t start;
+  /**
+   * @property {uint16_t} opaque_start
+   * 最长的一段完全不透明的像素的开始位置。
+   */
+  uint16_t opaque_start;
+  /**
+   * @property {uint16_t} opaque_end
+   * 最长的一段完全不透明的像素的结束位置(不包括)。
+   */
+  uint16_t opaque_end;
+  /**
+   * @property {uint16_t} end
+   * 最后一个不透明的像素的下一个位置。
+   */
+  uint16_t end;
+} bitmap_span_t;
+
 /**
  * @class bitmap_t
  * @annotation ["scriptable"]
@@ -191,6 +231,9 @@ struct _bitmap_t {
   /*destroy时是否需要释放bitmap本身的内存*/
   bool_t should_free_handle;
 
+  /*每一行的透明/不透明范围(可以为NULL)，由image_manager或位图资源提供，bitmap不负责释放*/
+  const bitmap_span_t* spans;
+
   /* 显示特定的数据，如OpenGL texture ID，agg/agge中图片等。*/
   void* specific;
   /*specific_destroy的上下文*/
@@ -296,6 +339,16 @@ ret_t bitmap_init_from_rgba(bitmap_t* bitmap, uint32_t w, uint32_t h, bitmap_for
  */
 ret_t bitmap_init(bitmap_t* bitmap, uint32_t w, uint32_t h, bitmap_format_t format, uint8_t* data);
 
+/**
+ * @method bitmap_calc_spans
+ * 计算每一行的透明/不透明范围(目前只支持带alpha通道的32位格式)。
+ * @param {bitmap_t*} bitmap bitmap对象。
+ * @param {bitmap_span_t*} spans 返回每一行的范围(个数为图片的高度)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t bitmap_calc_spans(bitmap_t* bitmap, bitmap_span_t* spans);
+
 /**
  * @method bitmap_destroy
  * 销毁图片。
@@ -413,6 +466,25 @@ typedef enum _image_draw_type_t {
   IMAGE_DRAW_PATCH3_Y_SCALE_X
 } image_draw_type_t;
 
+/**
+ * @enum image_quality_t
+ * @prefix IMAGE_QUALITY_
+ * @annotation ["scriptable"]
+ * 图片缩放显示时的质量。
+ */
+typedef enum _image_quality_t {
+  /**
+   * @const IMAGE_QUALITY_NEAREST
+   * 取最近的像素，速度最快，缩放时有锯齿。
+   */
+  IMAGE_QUALITY_NEAREST = 0,
+  /**
+   * @const IMAGE_QUALITY_SMOOTH
+   * 平滑缩放。放大时使用双线性插值，缩小时对覆盖的像素求平均。
+   */
+  IMAGE_QUALITY_SMOOTH
+} image_quality_t;
+
 #ifndef BITMAP_ALIGN_SIZE
 #define BITMAP_ALIGN_SIZE 32
 #endif /*BITMAP_ALIGN_SIZE*/
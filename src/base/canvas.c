@@ -24,7 +24,7 @@
 #include "tkc/utf8.h"
 #include "tkc/utils.h"
 #include "base/canvas.h"
-#include "tkc/time_now.h"
+#include "base/text_run.h"
 #include "tkc/color_parser.h"
 #include "base/wuxiaolin.inc"
 #include "base/system_info.h"
@@ -214,6 +214,12 @@ ret_t canvas_set_global_alpha(canvas_t* c, uint8_t alpha) {
   return RET_OK;
 }
 
+ret_t canvas_set_image_quality(canvas_t* c, image_quality_t quality) {
+  return_value_if_fail(c != NULL, RET_BAD_PARAMS);
+
+  return lcd_set_image_quality(c->lcd, quality);
+}
+
 ret_t canvas_set_font(canvas_t* c, const char* name, font_size_t size) {
   return_value_if_fail(c != NULL && c->lcd != NULL, RET_BAD_PARAMS);
 
@@ -241,21 +247,13 @@ ret_t canvas_set_text_align(canvas_t* c, align_h_t align_h, align_v_t align_v) {
 }
 
 static float_t canvas_measure_text_default(canvas_t* c, const wchar_t* str, uint32_t nr) {
-  glyph_t g;
-  float_t w = 0;
-  uint32_t i = 0;
+  const text_run_t* run = NULL;
   return_value_if_fail(c != NULL && str != NULL && c->font != NULL, 0);
 
-  for (i = 0; i < nr; i++) {
-    wchar_t chr = str[i];
-    if (chr == ' ') {
-      w += 4;
-    } else if (font_get_glyph(c->font, chr, c->font_size, &g) == RET_OK) {
-      w += g.advance + 1;
-    }
-  }
+  run = font_get_text_run(c->font, c->font_size, str, nr);
+  return_value_if_fail(run != NULL, 0);
 
-  return w;
+  return run->w;
 }
 
 float_t canvas_measure_text(canvas_t* c, const wchar_t* str, uint32_t nr) {
@@ -268,6 +266,16 @@ float_t canvas_measure_text(canvas_t* c, const wchar_t* str, uint32_t nr) {
   }
 }
 
+float_t canvas_get_kerning(canvas_t* c, wchar_t c1, wchar_t c2) {
+  return_value_if_fail(c != NULL && c->lcd != NULL, 0);
+
+  if (c->lcd->measure_text != NULL) {
+    return 0;
+  }
+
+  return font_get_kerning(c->font, c->font_size, c1, c2);
+}
+
 float_t canvas_measure_utf8(canvas_t* c, const char* str) {
   wstr_t s;
   float_t ret = 0;
@@ -290,6 +298,7 @@ ret_t canvas_begin_frame(canvas_t* c, rect_t* dirty_rect, lcd_draw_mode_t draw_m
   c->oy = 0;
 
   canvas_set_global_alpha(c, 0xff);
+  canvas_set_image_quality(c, IMAGE_QUALITY_NEAREST);
   ret = lcd_begin_frame(c->lcd, dirty_rect, draw_mode);
   if (c->lcd->support_dirty_rect && dirty_rect != NULL) {
     if (draw_mode == LCD_DRAW_NORMAL && c->lcd->type == LCD_VGCANVAS) {
@@ -525,36 +534,31 @@ ret_t canvas_draw_char(canvas_t* c, wchar_t chr, xy_t x, xy_t y) {
 static ret_t canvas_draw_text_impl(canvas_t* c, const wchar_t* str, uint32_t nr, xy_t x, xy_t y) {
   glyph_t g;
   uint32_t i = 0;
-  xy_t left = x;
-  uint32_t start_time = time_now_ms();
+  int32_t line_x = 0;
+  const text_run_t* run = NULL;
   font_size_t font_size = c->font_size;
 
+  run = font_get_text_run(c->font, font_size, str, nr);
+  return_value_if_fail(run != NULL, RET_BAD_PARAMS);
+
   y -= font_size * 1 / 3;
-  for (i = 0; i < nr; i++) {
-    wchar_t chr = str[i];
-    if (chr == ' ') {
-      x += 4;
-    } else if (chr == '\r') {
-      if (str[i + 1] != '\n') {
+  for (i = 0; i < run->size; i++) {
+    const glyph_pos_t* iter = run->glyphs + i;
+    wchar_t chr = iter->c;
+
+    if (chr == '\r' || chr == '\n') {
+      if (chr == '\n' || i + 1 == run->size || str[i + 1] != '\n') {
         y += font_size;
-        x = left;
+        line_x = iter->x + iter->advance;
       }
-    } else if (chr == '\r') {
-      y += font_size;
-      x = left;
-    } else if (font_get_glyph(c->font, chr, c->font_size, &g) == RET_OK) {
-      xy_t xx = x + g.x;
+    } else if (chr != ' ' && font_get_glyph(c->font, chr, font_size, &g) == RET_OK) {
+      xy_t xx = x + iter->x - line_x + g.x;
       xy_t yy = y + font_size + g.y;
 
       canvas_draw_glyph(c, &g, xx, yy);
-      x += g.advance + 1;
-    } else {
-      x += 4;
     }
   }
 
-  y = time_now_ms() - start_time;
-
   return RET_OK;
 }
 
@@ -581,9 +585,37 @@ ret_t canvas_draw_utf8(canvas_t* c, const char* str, xy_t x, xy_t y) {
   return ret;
 }
 
+/*
+ * 平滑缩放时把完整的映射关系交给lcd，只裁剪输出。如果按裁剪后的整数区域重新计算缩放比例，
+ * 局部刷新和整体刷新的取样位置不同，会出现接缝。
+ */
+static ret_t canvas_draw_image_smooth(canvas_t* c, bitmap_t* img, rect_t* s, rect_t* d) {
+  draw_image_info_t info;
+  lcd_t* lcd = c->lcd;
+
+  if (lcd->draw_image_smooth == NULL || (s->w == d->w && s->h == d->h) ||
+      (lcd->image_quality != IMAGE_QUALITY_SMOOTH && !(img->flags & BITMAP_FLAG_SMOOTH))) {
+    return RET_NOT_IMPL;
+  }
+
+  if (s->x < 0 || s->y < 0 || (s->x + s->w) > img->w || (s->y + s->h) > img->h) {
+    return RET_NOT_IMPL;
+  }
+
+  memset(&info, 0x00, sizeof(info));
+  info.img = img;
+  info.src = *s;
+  info.dst = *d;
+  info.clip = rect_init(c->clip_left, c->clip_top, c->clip_right - c->clip_left + 1,
+                        c->clip_bottom - c->clip_top + 1);
+
+  return lcd_draw_image_smooth(lcd, &info);
+}
+
 static ret_t canvas_do_draw_image(canvas_t* c, bitmap_t* img, rect_t* s, rect_t* d) {
   rect_t src;
   rect_t dst;
+  ret_t ret = RET_OK;
 
   xy_t x = d->x;
   xy_t y = d->y;
@@ -595,6 +627,11 @@ static ret_t canvas_do_draw_image(canvas_t* c, bitmap_t* img, rect_t* s, rect_t*
     return RET_OK;
   }
 
+  ret = canvas_draw_image_smooth(c, img, s, d);
+  if (ret != RET_NOT_IMPL) {
+    return ret;
+  }
+
   dst.x = tk_max(x, c->clip_left);
   dst.y = tk_max(y, c->clip_top);
   dst.w = tk_min(x2, c->clip_right) - dst.x + 1;
@@ -1114,14 +1151,26 @@ ret_t canvas_draw_image_scale_down(canvas_t* c, bitmap_t* img, rect_t* src, rect
 }
 
 ret_t canvas_draw_image_matrix(canvas_t* c, bitmap_t* img, matrix_t* matrix) {
-  draw_image_info_t info;
+  rect_t r;
   return_value_if_fail(c != NULL && img != NULL && matrix != NULL && c->lcd != NULL,
                        RET_BAD_PARAMS);
 
+  r = rect_init(0, 0, img->w, img->h);
+
+  return canvas_draw_image_matrix_ex(c, img, &r, &r, matrix);
+}
+
+ret_t canvas_draw_image_matrix_ex(canvas_t* c, bitmap_t* img, rect_t* src, rect_t* dst,
+                                  matrix_t* matrix) {
+  draw_image_info_t info;
+  return_value_if_fail(c != NULL && img != NULL && src != NULL && dst != NULL && matrix != NULL &&
+                           c->lcd != NULL,
+                       RET_BAD_PARAMS);
+
   info.img = img;
   info.matrix = *matrix;
-  info.src = rect_init(0, 0, img->w, img->h);
-  info.dst = rect_init(0, 0, img->w, img->h);
+  info.src = *src;
+  info.dst = *dst;
   info.clip = rect_init(c->clip_left, c->clip_top, c->clip_right - c->clip_left,
                         c->clip_bottom - c->clip_top);
 
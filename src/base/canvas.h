@@ -231,6 +231,19 @@ ret_t canvas_set_stroke_color_str(canvas_t* c, const char* color);
  */
 ret_t canvas_set_global_alpha(canvas_t* c, uint8_t alpha);
 
+/**
+ * @method canvas_set_image_quality
+ * 设置缩放图片时的质量。
+ *
+ * > 图片设置了BITMAP\_FLAG\_SMOOTH标志时，总是使用平滑缩放。
+ *
+ * @param {canvas_t*} c canvas对象。
+ * @param {image_quality_t} quality 质量。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t canvas_set_image_quality(canvas_t* c, image_quality_t quality);
+
 /**
  * @method canvas_translate
  * 平移原点坐标。
@@ -364,6 +377,20 @@ ret_t canvas_set_text_align(canvas_t* c, align_h_t align_h, align_v_t align_v);
  */
 float_t canvas_measure_text(canvas_t* c, const wchar_t* str, uint32_t nr);
 
+/**
+ * @method canvas_get_kerning
+ * 获取两个相邻字符之间的字距调整(kerning)。
+ *
+ * > 逐个字符测量文本时(如编辑器)，把它加到前一个字符的宽度上，结果与canvas\_measure\_text一致。
+ *
+ * @param {canvas_t*} c canvas对象。
+ * @param {wchar_t} c1 前一个字符。
+ * @param {wchar_t} c2 后一个字符。
+ *
+ * @return {float_t} 返回字距调整的值(通常为负数)。
+ */
+float_t canvas_get_kerning(canvas_t* c, wchar_t c1, wchar_t c2);
+
 /**
  * @method canvas_measure_utf8
  * 计算文本所占的宽度。
@@ -524,6 +551,8 @@ ret_t canvas_draw_image_scale_down(canvas_t* c, bitmap_t* img, rect_t* src, rect
 ret_t canvas_draw_line(canvas_t* c, xy_t x1, xy_t y1, xy_t x2, xy_t y2);
 ret_t canvas_draw_char(canvas_t* c, wchar_t chr, xy_t x, xy_t y);
 ret_t canvas_draw_image_matrix(canvas_t* c, bitmap_t* img, matrix_t* matrix);
+ret_t canvas_draw_image_matrix_ex(canvas_t* c, bitmap_t* img, rect_t* src, rect_t* dst,
+                                  matrix_t* matrix);
 ret_t canvas_set_fps(canvas_t* c, bool_t show_fps, uint32_t fps);
 ret_t canvas_set_font_manager(canvas_t* c, font_manager_t* font_manager);
 
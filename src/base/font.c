@@ -21,13 +21,28 @@
 
 #include "tkc/mem.h"
 #include "base/font.h"
+#include "base/text_run.h"
 
 ret_t font_get_glyph(font_t* f, wchar_t chr, font_size_t font_size, glyph_t* g) {
   return_value_if_fail(f != NULL && f->get_glyph != NULL && g != NULL, RET_BAD_PARAMS);
 
+  g->format = GLYPH_FMT_ALPHA;
+
   return f->get_glyph(f, chr, font_size, g);
 }
 
+int32_t font_get_kerning(font_t* f, font_size_t font_size, wchar_t c1, wchar_t c2) {
+  if (f == NULL || f->get_kerning == NULL || c1 == 0 || c2 == 0) {
+    return 0;
+  }
+
+  if (c1 == ' ' || c1 == '\r' || c1 == '\n' || c2 == ' ' || c2 == '\r' || c2 == '\n') {
+    return 0;
+  }
+
+  return f->get_kerning(f, font_size, c1, c2);
+}
+
 int32_t font_get_baseline(font_t* f, font_size_t font_size) {
   if (f != NULL && f->get_baseline != NULL) {
     return f->get_baseline(f, font_size);
@@ -45,6 +60,11 @@ bool_t font_match(font_t* f, const char* name, font_size_t font_size) {
 ret_t font_destroy(font_t* f) {
   return_value_if_fail(f != NULL && f->destroy != NULL, RET_BAD_PARAMS);
 
+  if (f->text_runs != NULL) {
+    text_run_cache_destroy(f->text_runs);
+    f->text_runs = NULL;
+  }
+
   return f->destroy(f);
 }
 
@@ -70,3 +90,100 @@ ret_t glyph_destroy(glyph_t* g) {
 
   return RET_OK;
 }
+
+#define GLYPH_SDF_AT(row, x) (((row) != NULL && (x) >= 0 && (x) < bw) ? (row)[x] : 0)
+
+static ret_t glyph_get_sdf_line(glyph_t* g, uint32_t y, uint8_t* alphas) {
+  uint32_t i = 0;
+  int32_t bw = g->data[0];
+  int32_t bh = g->data[1];
+  int32_t spread = g->data[2];
+  const uint8_t* d = g->data + 4;
+  /*目标像素的中心映射到距离场中的坐标，16位小数的定点数。*/
+  int32_t dx = (bw << 16) / g->w;
+  int32_t dy = (bh << 16) / g->h;
+  int32_t u = dx / 2 - 0x8000;
+  int32_t v = y * dy + dy / 2 - 0x8000;
+  int32_t y0 = v >> 16;
+  int32_t fy = (v >> 12) & 0x0f;
+  const uint8_t* r0 = (y0 >= 0 && y0 < bh) ? d + y0 * bw : NULL;
+  const uint8_t* r1 = (y0 + 1 >= 0 && y0 + 1 < bh) ? d + (y0 + 1) * bw : NULL;
+  /*距离每变化1，覆盖率变化spread*scale*255/127，这里乘以256以保留精度。*/
+  int32_t gain = tk_min(spread * 255 * 256 * g->w / (127 * tk_max(bw, 1)), 0xffff);
+
+  for (i = 0; i < g->w; i++, u += dx) {
+    int32_t x0 = u >> 16;
+    int32_t fx = (u >> 12) & 0x0f;
+    int32_t a = GLYPH_SDF_AT(r0, x0);
+    int32_t b = GLYPH_SDF_AT(r0, x0 + 1);
+    int32_t c = GLYPH_SDF_AT(r1, x0);
+    int32_t e = GLYPH_SDF_AT(r1, x0 + 1);
+    int32_t top = a * 16 + (b - a) * fx;
+    int32_t bottom = c * 16 + (e - c) * fx;
+    int32_t dist = top * 16 + (bottom - top) * fy - 128 * 256;
+    int32_t alpha = 128 + ((dist * gain) >> 16);
+
+    alphas[i] = alpha < 0 ? 0 : (alpha > 0xff ? 0xff : alpha);
+  }
+
+  return RET_OK;
+}
+
+ret_t glyph_get_line(glyph_t* g, uint32_t y, uint8_t* alphas) {
+  uint32_t i = 0;
+  const uint8_t* p = NULL;
+  return_value_if_fail(g != NULL && g->data != NULL && alphas != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(g->w > 0 && y < g->h, RET_BAD_PARAMS);
+
+  switch (g->format) {
+    case GLYPH_FMT_ALPHA: {
+      memcpy(alphas, g->data + y * g->w, g->w);
+      break;
+    }
+    case GLYPH_FMT_ALPHA1:
+    case GLYPH_FMT_ALPHA2:
+    case GLYPH_FMT_ALPHA4: {
+      uint32_t bpp = 1 << (g->format - GLYPH_FMT_ALPHA1);
+      uint32_t mask = (1 << bpp) - 1;
+      uint32_t stride = (g->w * bpp + 7) >> 3;
+
+      p = g->data + y * stride;
+      for (i = 0; i < g->w; i++) {
+        uint32_t bit = i * bpp;
+        uint32_t v = (p[bit >> 3] >> (8 - bpp - (bit & 7))) & mask;
+        alphas[i] = v * 0xff / mask;
+      }
+      break;
+    }
+    case GLYPH_FMT_RLE: {
+      uint32_t row = 0;
+      uint32_t x = 0;
+
+      p = g->data;
+      while (row <= y) {
+        uint32_t n = (*p & 0x0f) + 1;
+        uint8_t a = (*p >> 4) * 0x11;
+
+        if (row == y) {
+          memset(alphas + x, a, n);
+        }
+
+        p++;
+        x += n;
+        if (x >= g->w) {
+          x = 0;
+          row++;
+        }
+      }
+      break;
+    }
+    case GLYPH_FMT_SDF: {
+      return glyph_get_sdf_line(g, y, alphas);
+    }
+    default: {
+      return RET_NOT_IMPL;
+    }
+  }
+
+  return RET_OK;
+}
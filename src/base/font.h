@@ -29,6 +29,49 @@ BEGIN_C_DECLS
 struct _font_t;
 typedef struct _font_t font_t;
 
+struct _text_run_cache_t;
+typedef struct _text_run_cache_t text_run_cache_t;
+
+/**
+ * @enum glyph_format_t
+ * @prefix GLYPH_FMT_
+ * 字模数据的格式。
+ */
+typedef enum _glyph_format_t {
+  /**
+   * @const GLYPH_FMT_ALPHA
+   * 每个像素占用1个字节(8位alpha)。
+   */
+  GLYPH_FMT_ALPHA = 0,
+  /**
+   * @const GLYPH_FMT_ALPHA1
+   * 每个像素占用1位，高位在前，每行按字节对齐。
+   */
+  GLYPH_FMT_ALPHA1,
+  /**
+   * @const GLYPH_FMT_ALPHA2
+   * 每个像素占用2位，高位在前，每行按字节对齐。
+   */
+  GLYPH_FMT_ALPHA2,
+  /**
+   * @const GLYPH_FMT_ALPHA4
+   * 每个像素占用4位，高位在前，每行按字节对齐。
+   */
+  GLYPH_FMT_ALPHA4,
+  /**
+   * @const GLYPH_FMT_RLE
+   * 游程编码。每个字节的高4位为alpha(0-15)，低4位为重复次数减1，游程不跨行。
+   */
+  GLYPH_FMT_RLE,
+  /**
+   * @const GLYPH_FMT_SDF
+   * 有向距离场。data的前4个字节依次为距离场的宽度、高度、范围(spread)和保留字节，
+   * 后面是宽度x高度个字节的距离(128为边缘，大于128在字的内部)。
+   * glyph的w/h为缩放后的大小，绘制时从距离场采样。
+   */
+  GLYPH_FMT_SDF
+} glyph_format_t;
+
 /**
  * @class glyph_t
  * 代表一个字符的字模。
@@ -66,6 +109,12 @@ typedef struct _glyph_t {
    * 占位宽度。
    */
   uint32_t advance;
+  /**
+   * @property {uint8_t} format
+   * @annotation ["readable"]
+   * 数据格式(参考glyph\_format\_t)。
+   */
+  uint8_t format;
   /**
    * @property {const uint8_t*} data
    * @annotation ["readable"]
@@ -103,9 +152,25 @@ glyph_t* glyph_clone(glyph_t* g);
  */
 ret_t glyph_destroy(glyph_t* g);
 
+/**
+ * @method glyph_get_line
+ * 把指定行的字模数据解码为8位alpha。
+ *
+ * > 供没有直接处理压缩格式的LCD使用，lcd\_mem直接绘制压缩的字模，不需要解码。
+ * > GLYPH\_FMT\_SDF格式的字模按缩放后的大小(g->w)从距离场采样。
+ *
+ * @param {glyph_t*} g glyph对象。
+ * @param {uint32_t} y 行号。
+ * @param {uint8_t*} alphas 用于返回alpha的缓冲区(至少g->w个字节)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t glyph_get_line(glyph_t* g, uint32_t y, uint8_t* alphas);
+
 typedef int32_t (*font_get_baseline_t)(font_t* f, font_size_t font_size);
 typedef bool_t (*font_match_t)(font_t* f, const char* name, font_size_t font_size);
 typedef ret_t (*font_get_glyph_t)(font_t* f, wchar_t chr, font_size_t font_size, glyph_t* g);
+typedef int32_t (*font_get_kerning_t)(font_t* f, font_size_t font_size, wchar_t c1, wchar_t c2);
 
 typedef ret_t (*font_destroy_t)(font_t* f);
 
@@ -119,7 +184,11 @@ struct _font_t {
   font_match_t match;
   font_get_baseline_t get_baseline;
   font_get_glyph_t get_glyph;
+  font_get_kerning_t get_kerning;
   font_destroy_t destroy;
+
+  /*排版结果的缓存(参考text_run.h)，由font_destroy释放。*/
+  text_run_cache_t* text_runs;
 };
 
 /**
@@ -157,6 +226,21 @@ bool_t font_match(font_t* font, const char* font_name, font_size_t font_size);
  */
 ret_t font_get_glyph(font_t* font, wchar_t chr, font_size_t font_size, glyph_t* glyph);
 
+/**
+ * @method font_get_kerning
+ * 获取两个相邻字符之间的字距调整(kerning)。
+ *
+ * > 空格和换行符不参与字距调整。字体不支持时返回0。
+ *
+ * @param {font_t*} font font对象。
+ * @param {font_size_t} font_size 字体大小。
+ * @param {wchar_t} c1 前一个字符。
+ * @param {wchar_t} c2 后一个字符。
+ *
+ * @return {int32_t} 返回需要加到前一个字符占位宽度上的值(通常为负数)。
+ */
+int32_t font_get_kerning(font_t* font, font_size_t font_size, wchar_t c1, wchar_t c2);
+
 /**
  * @method font_destroy
  * 销毁font对象。
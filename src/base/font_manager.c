@@ -123,15 +123,15 @@ font_t* font_manager_get_font(font_manager_t* fm, const char* name, font_size_t
 }
 
 ret_t font_manager_unload_font(font_manager_t* fm, const char* name, font_size_t size) {
-  font_t* font = NULL;
+  font_cmp_info_t info;
 
   name = system_info_fix_font_name(name);
   return_value_if_fail(fm != NULL, RET_FAIL);
 
-  font = font_manager_lookup(fm, name, size);
-  return_value_if_fail(font != NULL, RET_NOT_FOUND);
+  info.name = name;
+  info.size = size;
 
-  return darray_remove(&(fm->fonts), font);
+  return darray_remove(&(fm->fonts), &info);
 }
 
 ret_t font_manager_deinit(font_manager_t* fm) {
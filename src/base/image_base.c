@@ -22,6 +22,7 @@
 #include "tkc/mem.h"
 #include "tkc/utils.h"
 #include "base/image_base.h"
+#include "base/widget_atoms.h"
 
 ret_t image_base_on_event(widget_t* widget, event_t* e) {
   uint16_t type = e->type;
@@ -126,6 +127,54 @@ ret_t image_base_set_prop(widget_t* widget, const char* name, const value_t* v)
   return RET_NOT_FOUND;
 }
 
+ret_t image_base_get_prop_atom(widget_t* widget, atom_t atom, value_t* v) {
+  image_base_t* image = IMAGE_BASE(widget);
+  return_value_if_fail(image != NULL && v != NULL, RET_BAD_PARAMS);
+
+  switch (atom) {
+    case WIDGET_ATOM_SCALE_X: {
+      value_set_float(v, image->scale_x);
+      return RET_OK;
+    }
+    case WIDGET_ATOM_SCALE_Y: {
+      value_set_float(v, image->scale_y);
+      return RET_OK;
+    }
+    case WIDGET_ATOM_ROTATION: {
+      value_set_float(v, image->rotation);
+      return RET_OK;
+    }
+    default:
+      break;
+  }
+
+  return RET_NOT_FOUND;
+}
+
+ret_t image_base_set_prop_atom(widget_t* widget, atom_t atom, const value_t* v) {
+  image_base_t* image = IMAGE_BASE(widget);
+  return_value_if_fail(image != NULL && v != NULL, RET_BAD_PARAMS);
+
+  switch (atom) {
+    case WIDGET_ATOM_SCALE_X: {
+      image->scale_x = value_float(v);
+      return RET_OK;
+    }
+    case WIDGET_ATOM_SCALE_Y: {
+      image->scale_y = value_float(v);
+      return RET_OK;
+    }
+    case WIDGET_ATOM_ROTATION: {
+      image->rotation = value_float(v);
+      return RET_OK;
+    }
+    default:
+      break;
+  }
+
+  return RET_NOT_FOUND;
+}
+
 ret_t image_base_on_destroy(widget_t* widget) {
   image_base_t* image = IMAGE_BASE(widget);
   return_value_if_fail(image != NULL, RET_BAD_PARAMS);
@@ -248,3 +297,49 @@ ret_t image_transform(widget_t* widget, canvas_t* c) {
 
   return RET_OK;
 }
+
+ret_t image_transform_draw(widget_t* widget, canvas_t* c, bitmap_t* img, rect_t* src) {
+  matrix_t m;
+  matrix_t t;
+  rect_t dst;
+  ret_t ret = RET_OK;
+  float_t anchor_x = 0;
+  float_t anchor_y = 0;
+  float_t ratio = 1;
+  vgcanvas_t* vg = NULL;
+  image_base_t* image_base = IMAGE_BASE(widget);
+  return_value_if_fail(image_base != NULL && c != NULL && img != NULL && src != NULL,
+                       RET_BAD_PARAMS);
+
+  anchor_x = image_base->anchor_x * widget->w;
+  anchor_y = image_base->anchor_y * widget->h;
+  ratio = c->lcd->ratio > 0 ? c->lcd->ratio : 1;
+
+  /*与image_transform+vgcanvas_draw_icon相同：图片按原始大小居中显示，再绕锚点旋转和缩放。*/
+  matrix_init(&m);
+  matrix_multiply(&m, matrix_set(&t, 1, 0, 0, 1, c->ox + anchor_x, c->oy + anchor_y));
+  matrix_rotate(&m, image_base->rotation);
+  matrix_scale(&m, image_base->scale_x, image_base->scale_y);
+  matrix_multiply(&m, matrix_set(&t, 1, 0, 0, 1, (widget->w - src->w / ratio) * 0.5f - anchor_x,
+                                 (widget->h - src->h / ratio) * 0.5f - anchor_y));
+  matrix_scale(&m, 1 / ratio, 1 / ratio);
+
+  /*LCD可以直接做仿射变换时(如lcd_mem)，不需要经过vgcanvas。*/
+  dst = rect_init(0, 0, src->w, src->h);
+  ret = canvas_draw_image_matrix_ex(c, img, src, &dst, &m);
+  if (ret != RET_NOT_IMPL) {
+    return ret;
+  }
+
+  vg = canvas_get_vgcanvas(c);
+  if (vg == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  vgcanvas_save(vg);
+  image_transform(widget, c);
+  vgcanvas_draw_icon(vg, img, src->x, src->y, src->w, src->h, 0, 0, widget->w, widget->h);
+  vgcanvas_restore(vg);
+
+  return RET_OK;
+}
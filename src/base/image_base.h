@@ -216,8 +216,11 @@ ret_t image_base_on_destroy(widget_t* widget);
 ret_t image_base_on_event(widget_t* widget, event_t* e);
 ret_t image_base_get_prop(widget_t* widget, const char* name, value_t* v);
 ret_t image_base_set_prop(widget_t* widget, const char* name, const value_t* v);
+ret_t image_base_get_prop_atom(widget_t* widget, atom_t atom, value_t* v);
+ret_t image_base_set_prop_atom(widget_t* widget, atom_t atom, const value_t* v);
 bool_t image_need_transform(widget_t* widget);
 ret_t image_transform(widget_t* widget, canvas_t* c);
+ret_t image_transform_draw(widget_t* widget, canvas_t* c, bitmap_t* img, rect_t* src);
 
 #define IMAGE_BASE(widget) ((image_base_t*)(image_base_cast(WIDGET(widget))))
 
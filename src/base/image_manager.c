@@ -22,12 +22,16 @@
 #include "tkc/mem.h"
 #include "tkc/utils.h"
 #include "tkc/time_now.h"
+#include "base/theme.h"
 #include "base/locale_info.h"
+#include "base/system_info.h"
 #include "base/image_manager.h"
 
 typedef struct _bitmap_cache_t {
   bitmap_t image;
   char* name;
+  /*image_manager计算的每一行的透明/不透明范围*/
+  bitmap_span_t* spans;
   uint32_t access_count;
   uint32_t created_time;
   uint32_t last_access_time;
@@ -49,6 +53,7 @@ static ret_t bitmap_cache_destroy(bitmap_cache_t* cache) {
   return_value_if_fail(cache != NULL, RET_BAD_PARAMS);
 
   bitmap_destroy(&(cache->image));
+  TKMEM_FREE(cache->spans);
   TKMEM_FREE(cache->name);
   TKMEM_FREE(cache);
 
@@ -82,6 +87,26 @@ image_manager_t* image_manager_init(image_manager_t* imm) {
   return imm;
 }
 
+static ret_t bitmap_cache_calc_spans(bitmap_cache_t* cache) {
+  bitmap_t* image = &(cache->image);
+
+  if (image->spans != NULL || image->data == NULL || image->h == 0 ||
+      (image->flags & BITMAP_FLAG_OPAQUE) || bitmap_get_bpp(image) != 4) {
+    return RET_OK;
+  }
+
+  cache->spans = TKMEM_ZALLOCN(bitmap_span_t, image->h);
+  return_value_if_fail(cache->spans != NULL, RET_OOM);
+
+  if (bitmap_calc_spans(image, cache->spans) == RET_OK) {
+    image->spans = cache->spans;
+  } else {
+    TKMEM_FREE(cache->spans);
+  }
+
+  return RET_OK;
+}
+
 ret_t image_manager_add(image_manager_t* imm, const char* name, const bitmap_t* image) {
   bitmap_cache_t* cache = NULL;
   return_value_if_fail(imm != NULL && name != NULL && image != NULL, RET_BAD_PARAMS);
@@ -96,6 +121,7 @@ ret_t image_manager_add(image_manager_t* imm, const char* name, const bitmap_t*
   cache->name = tk_strdup(name);
   cache->image.name = cache->name;
   cache->last_access_time = cache->created_time;
+  bitmap_cache_calc_spans(cache);
 
   return darray_push(&(imm->images), cache);
 }
@@ -178,6 +204,10 @@ static ret_t image_manager_get_bitmap_impl(image_manager_t* imm, const char* nam
     image->name = res->name;
     image->data = header->data;
     image->image_manager = imm;
+    if (header->flags & BITMAP_FLAG_SPANS) {
+      uint32_t size = header->w * header->h * bitmap_get_bpp(image);
+      image->spans = (const bitmap_span_t*)(header->data + size);
+    }
 #if defined(WITH_NANOVG_GPU) || defined(WITH_NANOVG_SOFT)
     image_manager_add(imm, name, image);
 #endif
@@ -195,55 +225,154 @@ static ret_t image_manager_get_bitmap_impl(image_manager_t* imm, const char* nam
   }
 }
 
+static uint32_t image_name_hash(const char* name) {
+  uint32_t hash = 5381;
+
+  while (*name) {
+    hash = ((hash << 5) + hash) + (uint8_t)(*name++);
+  }
+
+  return hash;
+}
+
+static ret_t image_name_entry_reset(image_name_entry_t* entry) {
+  TKMEM_FREE(entry->name);
+  TKMEM_FREE(entry->real_name);
+  entry->name = NULL;
+  entry->real_name = NULL;
+
+  return RET_OK;
+}
+
+static ret_t image_manager_clear_names(image_manager_t* imm) {
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(imm->names); i++) {
+    image_name_entry_reset(imm->names + i);
+  }
+
+  return RET_OK;
+}
+
+static ret_t image_manager_check_name_stamp(image_manager_t* imm) {
+  image_name_stamp_t stamp;
+  theme_t* t = theme();
+  locale_info_t* li = locale_info();
+  system_info_t* info = system_info();
+
+  memset(&stamp, 0x00, sizeof(stamp));
+  if (li != NULL) {
+    memcpy(stamp.country, li->country, sizeof(stamp.country));
+    memcpy(stamp.language, li->language, sizeof(stamp.language));
+  }
+
+  if (info != NULL) {
+    stamp.lcd_w = info->lcd_w;
+    stamp.lcd_h = info->lcd_h;
+    stamp.lcd_orientation = info->lcd_orientation;
+    stamp.device_pixel_ratio = info->device_pixel_ratio;
+  }
+  stamp.theme_data = t != NULL ? t->data : NULL;
+
+  if (memcmp(&stamp, &(imm->name_stamp), sizeof(stamp)) != 0) {
+    image_manager_clear_names(imm);
+    imm->name_stamp = stamp;
+  }
+
+  return RET_OK;
+}
+
+static const char* image_manager_find_real_name(image_manager_t* imm, const char* name) {
+  image_name_entry_t* entry = imm->names + image_name_hash(name) % ARRAY_SIZE(imm->names);
+
+  image_manager_check_name_stamp(imm);
+  if (entry->name != NULL && strcmp(entry->name, name) == 0) {
+    return entry->real_name;
+  }
+
+  return NULL;
+}
+
+static ret_t image_manager_set_real_name(image_manager_t* imm, const char* name,
+                                         const char* real_name) {
+  image_name_entry_t* entry = imm->names + image_name_hash(name) % ARRAY_SIZE(imm->names);
+
+  image_name_entry_reset(entry);
+  entry->name = tk_strdup(name);
+  entry->real_name = tk_strdup(real_name);
+  if (entry->name == NULL || entry->real_name == NULL) {
+    image_name_entry_reset(entry);
+    return RET_OOM;
+  }
+
+  return RET_OK;
+}
+
 typedef struct _imm_expr_info_t {
   image_manager_t* imm;
   bitmap_t* image;
+  const char* exprs;
 } imm_expr_info_t;
 
 static ret_t image_manager_on_expr_result(void* ctx, const void* data) {
   imm_expr_info_t* info = (imm_expr_info_t*)ctx;
   const char* name = (const char*)data;
+  ret_t ret = image_manager_get_bitmap_impl(info->imm, name, info->image);
 
-  return image_manager_get_bitmap_impl(info->imm, name, info->image);
+  if (ret == RET_OK) {
+    image_manager_set_real_name(info->imm, info->exprs, name);
+  }
+
+  return ret;
 }
 
 ret_t image_manager_get_bitmap_exprs(image_manager_t* imm, const char* exprs, bitmap_t* image) {
-  imm_expr_info_t ctx = {imm, image};
+  imm_expr_info_t ctx = {imm, image, exprs};
 
   return system_info_eval_exprs(system_info(), exprs, image_manager_on_expr_result, &ctx);
 }
 
-ret_t image_manager_get_bitmap(image_manager_t* imm, const char* name, bitmap_t* image) {
-  return_value_if_fail(imm != NULL && name != NULL && image != NULL, RET_BAD_PARAMS);
-
-  if (strstr(name, TK_LOCALE_MAGIC) != NULL) {
-    char locale[TK_NAME_LEN + 1];
-    char real_name[TK_NAME_LEN + 1];
-    const char* language = locale_info()->language;
-    const char* country = locale_info()->country;
-
-    tk_snprintf(locale, sizeof(locale) - 1, "%s_%s", language, country);
-    tk_replace_locale(name, real_name, locale);
+static ret_t image_manager_get_bitmap_locale(image_manager_t* imm, const char* name,
+                                            bitmap_t* image) {
+  uint32_t i = 0;
+  char locale[TK_NAME_LEN + 1];
+  char real_name[TK_NAME_LEN + 1];
+  const char* language = locale_info()->language;
+  const char* country = locale_info()->country;
+  const char* locales[] = {locale, language, ""};
+
+  tk_snprintf(locale, sizeof(locale) - 1, "%s_%s", language, country);
+  for (i = 0; i < ARRAY_SIZE(locales); i++) {
+    tk_replace_locale(name, real_name, locales[i]);
     if (image_manager_get_bitmap_impl(imm, real_name, image) == RET_OK) {
+      image_manager_set_real_name(imm, name, real_name);
       return RET_OK;
     }
+  }
 
-    tk_replace_locale(name, real_name, language);
-    if (image_manager_get_bitmap_impl(imm, real_name, image) == RET_OK) {
-      return RET_OK;
-    }
+  return RET_FAIL;
+}
 
-    tk_replace_locale(name, real_name, "");
-    if (image_manager_get_bitmap_impl(imm, real_name, image) == RET_OK) {
-      return RET_OK;
-    }
+ret_t image_manager_get_bitmap(image_manager_t* imm, const char* name, bitmap_t* image) {
+  const char* real_name = NULL;
+  bool_t has_locale = FALSE;
+  return_value_if_fail(imm != NULL && name != NULL && image != NULL, RET_BAD_PARAMS);
 
-    return RET_FAIL;
-  } else if (strchr(name, '$') != NULL || strchr(name, ',') != NULL) {
-    return image_manager_get_bitmap_exprs(imm, name, image);
-  } else {
+  has_locale = strstr(name, TK_LOCALE_MAGIC) != NULL;
+  if (!has_locale && strchr(name, '$') == NULL && strchr(name, ',') == NULL) {
     return image_manager_get_bitmap_impl(imm, name, image);
   }
+
+  real_name = image_manager_find_real_name(imm, name);
+  if (real_name != NULL && image_manager_get_bitmap_impl(imm, real_name, image) == RET_OK) {
+    return RET_OK;
+  }
+
+  if (has_locale) {
+    return image_manager_get_bitmap_locale(imm, name, image);
+  } else {
+    return image_manager_get_bitmap_exprs(imm, name, image);
+  }
 }
 
 ret_t image_manager_set_assets_manager(image_manager_t* imm, assets_manager_t* am) {
@@ -277,6 +406,7 @@ ret_t image_manager_deinit(image_manager_t* imm) {
   return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
 
   darray_deinit(&(imm->images));
+  image_manager_clear_names(imm);
 
   return RET_OK;
 }
@@ -30,6 +30,7 @@ BEGIN_C_DECLS
 
 /**
  * 但没有文件系统时，图片被转成位图，直接编译到程序中。bitmap_header_t用来描述该位图的信息。
+ * flags中有BITMAP_FLAG_SPANS时，图片数据后面是每一行的透明/不透明范围(bitmap_span_t)。
  */
 typedef struct _bitmap_header_t {
   uint16_t w;
@@ -39,10 +40,39 @@ typedef struct _bitmap_header_t {
   uint8_t data[4];
 } bitmap_header_t;
 
+#ifndef TK_IMAGE_NAME_CACHE_SIZE
+#define TK_IMAGE_NAME_CACHE_SIZE 32
+#endif /*TK_IMAGE_NAME_CACHE_SIZE*/
+
+/**
+ * 图片名称的解析结果(包含$locale$或表达式的名称，解析为实际的资源名称)。
+ */
+typedef struct _image_name_entry_t {
+  char* name;
+  char* real_name;
+} image_name_entry_t;
+
+/**
+ * 图片名称的解析结果所依赖的环境，任何一项变化时，清除全部解析结果。
+ */
+typedef struct _image_name_stamp_t {
+  char country[3];
+  char language[3];
+  uint32_t lcd_w;
+  uint32_t lcd_h;
+  uint32_t lcd_orientation;
+  float_t device_pixel_ratio;
+  const void* theme_data;
+} image_name_stamp_t;
+
 /**
  * @class image_manager_t
  * @annotation ["scriptable"]
  * 图片管理器。负责加载，解码和缓存图片。
+ *
+ * 包含$locale$或表达式的图片名称，解析后的实际名称会被缓存起来(以名称的hash值为索引)，
+ * 绘制时再次获取同一图片，无需重复替换locale或计算表达式。
+ * 语言、屏幕大小/方向、device\_pixel\_ratio或主题变化时，缓存自动失效。
  */
 struct _image_manager_t {
   /**
@@ -58,6 +88,10 @@ struct _image_manager_t {
    * 资源管理器。
    */
   assets_manager_t* assets_manager;
+
+  /*private*/
+  image_name_stamp_t name_stamp;
+  image_name_entry_t names[TK_IMAGE_NAME_CACHE_SIZE];
 };
 
 /**
@@ -61,3 +61,13 @@ ret_t input_engine_input(input_engine_t* engine, int key) {
 
   return ret;
 }
+
+ret_t input_engine_next_page(input_engine_t* engine) {
+  return_value_if_fail(engine != NULL, RET_BAD_PARAMS);
+
+  if (engine->next_page == NULL || engine->keys.size == 0) {
+    return RET_DONE;
+  }
+
+  return engine->next_page(engine);
+}
@@ -31,10 +31,16 @@ typedef struct _input_engine_t input_engine_t;
 
 typedef ret_t (*input_engine_reset_input_t)(input_engine_t* engine);
 typedef ret_t (*input_engine_input_t)(input_engine_t* engine, int key);
+typedef ret_t (*input_engine_next_page_t)(input_engine_t* engine);
 
 #define TK_IM_MAX_INPUT_CHARS 15
 #define TK_IM_MAX_CANDIDATE_CHARS 127
 
+/*每页最多的候选字/词个数(不含按键组合本身)。*/
+#ifndef TK_IM_CANDIDATES_PAGE_SIZE
+#define TK_IM_CANDIDATES_PAGE_SIZE 10
+#endif /*TK_IM_CANDIDATES_PAGE_SIZE*/
+
 /**
  * @class input_engine_t
  * 输入法引擎接口。
@@ -63,7 +69,7 @@ struct _input_engine_t {
   /**
    * @property {char*} candidates
    * @annotation ["private"]
-   * 当前按键组合对应的候选字列表。
+   * 当前按键组合对应的候选字列表(当前页)。
    */
   char candidates[TK_IM_MAX_CANDIDATE_CHARS + 1];
   /**
@@ -76,6 +82,7 @@ struct _input_engine_t {
   /*具体实现需要实现的函数*/
   input_engine_input_t input;
   input_engine_reset_input_t reset_input;
+  input_engine_next_page_t next_page;
 };
 
 /**
@@ -116,6 +123,18 @@ ret_t input_engine_reset_input(input_engine_t* engine);
  */
 ret_t input_engine_input(input_engine_t* engine, int key);
 
+/**
+ * @method input_engine_next_page
+ * 把下一页候选字放到candidates中。
+ *
+ * > 输入按键时只生成第一页候选字，候选字控件滚动到后面时再调用本函数获取后面的候选字。
+ *
+ * @param {input_engine_t*} engine 输入法引擎对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，返回RET_DONE表示没有更多的候选字，否则表示失败。
+ */
+ret_t input_engine_next_page(input_engine_t* engine);
+
 END_C_DECLS
 
 #endif /*TK_INPUT_ENGINE_H*/
@@ -133,16 +133,37 @@ ret_t input_method_dispatch_key(input_method_t* im, uint32_t key) {
   return input_method_dispatch_key_only(im, key);
 }
 
-ret_t input_method_dispatch_candidates(input_method_t* im, const char* strs, uint32_t nr) {
+static ret_t input_method_dispatch_candidates_ex(input_method_t* im, const char* strs,
+                                                 uint32_t nr, bool_t append) {
   im_candidates_event_t ce;
 
   ce.e = event_init(EVT_IM_SHOW_CANDIDATES, im);
   ce.candidates_nr = nr;
   ce.candidates = strs;
+  ce.append = append;
 
   return input_method_dispatch(im, (event_t*)(&ce));
 }
 
+ret_t input_method_dispatch_candidates(input_method_t* im, const char* strs, uint32_t nr) {
+  return input_method_dispatch_candidates_ex(im, strs, nr, FALSE);
+}
+
+ret_t input_method_next_candidates_page(input_method_t* im) {
+  ret_t ret = RET_DONE;
+  return_value_if_fail(im != NULL, RET_BAD_PARAMS);
+
+  if (im->engine != NULL) {
+    ret = input_engine_next_page(im->engine);
+    if (ret == RET_OK) {
+      input_method_dispatch_candidates_ex(im, (const char*)(im->engine->candidates),
+                                          im->engine->candidates_nr, TRUE);
+    }
+  }
+
+  return ret;
+}
+
 ret_t input_method_commit_text_ex(input_method_t* im, bool_t replace, const char* text) {
   im_commit_event_t e;
   return_value_if_fail(im != NULL && text != NULL, RET_BAD_PARAMS);
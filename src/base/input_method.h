@@ -156,6 +156,13 @@ typedef struct _im_candidates_event_t {
    * 可选的文本的个数。
    */
   uint32_t candidates_nr;
+
+  /**
+   * @property {bool_t} append
+   * @annotation ["readable"]
+   * 是否追加到已经显示的候选字后面(获取下一页候选字时为TRUE)。
+   */
+  bool_t append;
 } im_candidates_event_t;
 
 /**
@@ -368,6 +375,18 @@ ret_t input_method_dispatch_key(input_method_t* im, uint32_t key);
  */
 ret_t input_method_dispatch_candidates(input_method_t* im, const char* strs, uint32_t nr);
 
+/**
+ * @method input_method_next_candidates_page
+ * 从输入法引擎获取下一页候选字，并请求追加显示。
+ *
+ * > 候选字控件滚动到接近末尾时调用。
+ *
+ * @param {input_method_t*} im 输入法对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，返回RET_DONE表示没有更多的候选字，否则表示失败。
+ */
+ret_t input_method_next_candidates_page(input_method_t* im);
+
 /**
  * @method input_method_create
  * 创建输入法对象。在具体实现中实现。
@@ -20,61 +20,126 @@
  */
 
 #include "tkc/utils.h"
+#include "tkc/perf_trace.h"
 #include "base/widget.h"
 #include "base/layout.h"
 #include "base/self_layouter_factory.h"
 #include "base/children_layouter_factory.h"
 
+static layout_stat_t s_layout_stat;
+static uint32_t s_layout_full;
+
 ret_t widget_layout(widget_t* widget) {
+  /*显式布局遍历整个子树，被移动过的下层控件也会恢复到布局的位置。*/
+  s_layout_full++;
   widget_layout_self(widget);
   widget_layout_children(widget);
+  s_layout_full--;
 
   return RET_OK;
 }
 
-ret_t widget_layout_self(widget_t* widget) {
+static ret_t widget_get_layout_area(widget_t* parent, rect_t* r) {
   value_t v;
-  rect_t r = {0, 0, 0, 0};
-  widget_t* parent = NULL;
-  return_value_if_fail(widget != NULL && widget->parent != NULL, RET_BAD_PARAMS);
 
-  parent = widget->parent;
   if (widget_get_prop(parent, WIDGET_PROP_LAYOUT_W, &v) == RET_OK) {
-    r.w = value_int(&v);
+    r->w = value_int(&v);
   } else {
-    r.w = parent->w;
+    r->w = parent->w;
   }
 
   if (widget_get_prop(parent, WIDGET_PROP_LAYOUT_H, &v) == RET_OK) {
-    r.h = value_int(&v);
+    r->h = value_int(&v);
   } else {
-    r.h = parent->h;
+    r->h = parent->h;
+  }
+
+  return RET_OK;
+}
+
+/*
+ * 如果可用区域的大小没变，控件没有被移动/缩放过，布局参数也没有修改，
+ * 可缓存的布局器的结果和上次完全相同，直接跳过。
+ */
+static ret_t widget_layout_self_in(widget_t* widget, rect_t* r) {
+  ret_t ret = RET_OK;
+  bool_t cacheable = widget->self_layout != NULL && widget->self_layout->vt->cacheable;
+
+  if (cacheable && !(widget->need_relayout) && widget->layout_w == r->w &&
+      widget->layout_h == r->h) {
+    s_layout_stat.self_skipped++;
+    return RET_OK;
   }
 
-  return self_layouter_layout(widget->self_layout, widget, &r);
+  ret = self_layouter_layout(widget->self_layout, widget, r);
+  s_layout_stat.self_layouts++;
+
+  widget->layout_w = r->w;
+  widget->layout_h = r->h;
+  widget->need_relayout = FALSE;
+
+  return ret;
+}
+
+ret_t widget_layout_self(widget_t* widget) {
+  rect_t r = {0, 0, 0, 0};
+  return_value_if_fail(widget != NULL && widget->parent != NULL, RET_BAD_PARAMS);
+
+  if (widget->self_layout == NULL) {
+    return RET_FAIL;
+  }
+
+  widget_get_layout_area(widget->parent, &r);
+
+  return widget_layout_self_in(widget, &r);
+}
+
+ret_t widget_layout_children_if_needed(widget_t* widget) {
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  if (widget->need_relayout_children || s_layout_full > 0) {
+    return widget_layout_children(widget);
+  }
+
+  s_layout_stat.children_skipped++;
+
+  return RET_OK;
 }
 
 ret_t widget_layout_children_default(widget_t* widget) {
   if (widget->children_layout != NULL) {
     return children_layouter_layout(widget->children_layout, widget);
-  } else {
+  } else if (widget->children != NULL) {
+    rect_t r = {0, 0, 0, 0};
+
+    /*所有子控件的可用区域相同，只需要获取一次。*/
+    widget_get_layout_area(widget, &r);
     WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
-    widget_layout(iter);
+    if (iter->self_layout != NULL) {
+      widget_layout_self_in(iter, &r);
+    }
+    widget_layout_children_if_needed(iter);
     WIDGET_FOR_EACH_CHILD_END()
-
-    return RET_OK;
   }
+
+  return RET_OK;
 }
 
 ret_t widget_layout_children(widget_t* widget) {
+  ret_t ret = RET_OK;
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
+  PERF_TRACE_BEGIN("layout", widget->vt->type, widget->name);
+  s_layout_stat.children_layouts++;
   widget->need_relayout_children = FALSE;
   if (widget->vt->on_layout_children != NULL) {
-    return widget->vt->on_layout_children(widget);
+    ret = widget->vt->on_layout_children(widget);
   } else {
-    return widget_layout_children_default(widget);
+    ret = widget_layout_children_default(widget);
   }
+  PERF_TRACE_END("layout", widget->vt->type);
+
+  return ret;
 }
 
 ret_t widget_set_self_layout(widget_t* widget, const char* params) {
@@ -82,6 +147,7 @@ ret_t widget_set_self_layout(widget_t* widget, const char* params) {
   self_layouter_destroy(widget->self_layout);
 
   widget->self_layout = self_layouter_create(params);
+  widget_set_need_relayout(widget);
 
   return RET_OK;
 }
@@ -91,6 +157,8 @@ ret_t widget_set_children_layout(widget_t* widget, const char* params) {
   children_layouter_destroy(widget->children_layout);
 
   widget->children_layout = children_layouter_create(params);
+  widget_set_need_relayout(widget);
+  widget_set_need_relayout_children(widget);
 
   return RET_OK;
 }
@@ -114,7 +182,8 @@ ret_t widget_layout_floating_children(widget_t* widget) {
     for (i = 0; i < n; i++) {
       widget_t* iter = children[i];
       if (iter->floating) {
-        widget_layout(iter);
+        widget_layout_self(iter);
+        widget_layout_children_if_needed(iter);
       }
     }
   }
@@ -157,3 +226,13 @@ ret_t widget_get_children_for_layout(widget_t* widget, darray_t* result, bool_t
 
   return RET_OK;
 }
+
+layout_stat_t widget_layout_stat(void) {
+  return s_layout_stat;
+}
+
+ret_t widget_layout_stat_reset(void) {
+  memset(&s_layout_stat, 0x00, sizeof(s_layout_stat));
+
+  return RET_OK;
+}
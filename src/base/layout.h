@@ -27,10 +27,28 @@
 
 BEGIN_C_DECLS
 
+/*布局的统计数据，用于性能分析。*/
+typedef struct _layout_stat_t {
+  /*执行自身布局的次数。*/
+  uint32_t self_layouts;
+  /*可用区域和布局参数都没有变化，跳过自身布局的次数。*/
+  uint32_t self_skipped;
+  /*布局子控件的次数。*/
+  uint32_t children_layouts;
+  /*子控件不需要重新布局，跳过的次数。*/
+  uint32_t children_skipped;
+} layout_stat_t;
+
 ret_t widget_layout_self(widget_t* widget);
 ret_t widget_layout_children(widget_t* widget);
 ret_t widget_layout_children_default(widget_t* widget);
 
+/*只有need_relayout_children为TRUE或者在widget_layout中时才布局子控件。*/
+ret_t widget_layout_children_if_needed(widget_t* widget);
+
+layout_stat_t widget_layout_stat(void);
+ret_t widget_layout_stat_reset(void);
+
 ret_t widget_layout_floating_children(widget_t* widget);
 ret_t widget_get_children_for_layout(widget_t* widget, darray_t* result, bool_t keep_disable,
                                      bool_t keep_invisible);
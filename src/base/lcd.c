@@ -20,6 +20,7 @@
  */
 
 #include "base/lcd.h"
+#include "tkc/perf_trace.h"
 #include "base/system_info.h"
 
 ret_t lcd_begin_frame(lcd_t* lcd, rect_t* dirty_rect, lcd_draw_mode_t draw_mode) {
@@ -62,6 +63,14 @@ ret_t lcd_set_global_alpha(lcd_t* lcd, uint8_t alpha) {
   return RET_OK;
 }
 
+ret_t lcd_set_image_quality(lcd_t* lcd, image_quality_t quality) {
+  return_value_if_fail(lcd != NULL, RET_BAD_PARAMS);
+
+  lcd->image_quality = quality;
+
+  return RET_OK;
+}
+
 ret_t lcd_set_text_color(lcd_t* lcd, color_t color) {
   return_value_if_fail(lcd != NULL, RET_BAD_PARAMS);
 
@@ -190,6 +199,16 @@ ret_t lcd_draw_image_matrix(lcd_t* lcd, draw_image_info_t* info) {
   return RET_NOT_IMPL;
 }
 
+ret_t lcd_draw_image_smooth(lcd_t* lcd, draw_image_info_t* info) {
+  return_value_if_fail(lcd != NULL && info != NULL, RET_BAD_PARAMS);
+
+  if (lcd->draw_image_smooth != NULL) {
+    return lcd->draw_image_smooth(lcd, info);
+  }
+
+  return RET_NOT_IMPL;
+}
+
 ret_t lcd_draw_glyph(lcd_t* lcd, glyph_t* glyph, rect_t* src, xy_t x, xy_t y) {
   return_value_if_fail(lcd != NULL && lcd->draw_glyph != NULL && glyph != NULL && src != NULL,
                        RET_BAD_PARAMS);
@@ -212,31 +231,41 @@ ret_t lcd_draw_text(lcd_t* lcd, const wchar_t* str, uint32_t nr, xy_t x, xy_t y)
 }
 
 ret_t lcd_end_frame(lcd_t* lcd) {
+  ret_t ret = RET_OK;
   return_value_if_fail(lcd != NULL && lcd->end_frame != NULL, RET_BAD_PARAMS);
 
-  return_value_if_fail(lcd->end_frame(lcd) == RET_OK, RET_FAIL);
+  PERF_TRACE_BEGIN("lcd", "end_frame", NULL);
+  ret = lcd->end_frame(lcd);
+  PERF_TRACE_END("lcd", "end_frame");
+  return_value_if_fail(ret == RET_OK, RET_FAIL);
 
   return RET_OK;
 }
 
 ret_t lcd_swap(lcd_t* lcd) {
+  ret_t ret = RET_OK;
   return_value_if_fail(lcd != NULL, RET_BAD_PARAMS);
 
   if (lcd->swap != NULL) {
-    return lcd->swap(lcd);
+    PERF_TRACE_BEGIN("lcd", "swap", NULL);
+    ret = lcd->swap(lcd);
+    PERF_TRACE_END("lcd", "swap");
   }
 
-  return RET_OK;
+  return ret;
 }
 
 ret_t lcd_flush(lcd_t* lcd) {
+  ret_t ret = RET_OK;
   return_value_if_fail(lcd != NULL, RET_BAD_PARAMS);
 
   if (lcd->flush != NULL) {
-    return lcd->flush(lcd);
+    PERF_TRACE_BEGIN("lcd", "flush", NULL);
+    ret = lcd->flush(lcd);
+    PERF_TRACE_END("lcd", "flush");
   }
 
-  return RET_OK;
+  return ret;
 }
 
 ret_t lcd_sync(lcd_t* lcd) {
@@ -277,6 +306,16 @@ ret_t lcd_take_snapshot(lcd_t* lcd, bitmap_t* img, bool_t auto_rotate) {
   return lcd->take_snapshot(lcd, img, auto_rotate);
 }
 
+ret_t lcd_bind_snapshot(lcd_t* lcd, bitmap_t* img) {
+  return_value_if_fail(lcd != NULL, RET_BAD_PARAMS);
+
+  if (lcd->bind_snapshot == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  return lcd->bind_snapshot(lcd, img);
+}
+
 bitmap_format_t lcd_get_desired_bitmap_format(lcd_t* lcd) {
   return_value_if_fail(lcd != NULL && lcd->get_desired_bitmap_format != NULL, BITMAP_FMT_BGR565);
 
@@ -67,8 +67,10 @@ typedef ret_t (*lcd_draw_text_t)(lcd_t* lcd, const wchar_t* str, uint32_t nr, xy
 
 typedef ret_t (*lcd_draw_image_t)(lcd_t* lcd, bitmap_t* img, rect_t* src, rect_t* dst);
 typedef ret_t (*lcd_draw_image_matrix_t)(lcd_t* lcd, draw_image_info_t* info);
+typedef ret_t (*lcd_draw_image_smooth_t)(lcd_t* lcd, draw_image_info_t* info);
 typedef vgcanvas_t* (*lcd_get_vgcanvas_t)(lcd_t* lcd);
 typedef ret_t (*lcd_take_snapshot_t)(lcd_t* lcd, bitmap_t* img, bool_t auto_rotate);
+typedef ret_t (*lcd_bind_snapshot_t)(lcd_t* lcd, bitmap_t* img);
 typedef bitmap_format_t (*lcd_get_desired_bitmap_format_t)(lcd_t* lcd);
 
 typedef wh_t (*lcd_get_width_t)(lcd_t* lcd);
@@ -162,6 +164,7 @@ struct _lcd_t {
   lcd_stroke_rect_t stroke_rect;
   lcd_draw_image_t draw_image;
   lcd_draw_image_matrix_t draw_image_matrix;
+  lcd_draw_image_smooth_t draw_image_smooth;
   lcd_draw_glyph_t draw_glyph;
   lcd_draw_text_t draw_text;
   lcd_measure_text_t measure_text;
@@ -175,6 +178,7 @@ struct _lcd_t {
   lcd_end_frame_t end_frame;
   lcd_get_vgcanvas_t get_vgcanvas;
   lcd_take_snapshot_t take_snapshot;
+  lcd_bind_snapshot_t bind_snapshot; /*可选*/
   lcd_get_desired_bitmap_format_t get_desired_bitmap_format;
   lcd_resize_t resize;
   lcd_destroy_t destroy;
@@ -197,6 +201,12 @@ struct _lcd_t {
    * 全局alpha
    */
   uint8_t global_alpha;
+  /**
+   * @property {uint8_t} image_quality
+   * @annotation ["readable"]
+   * 缩放图片时的质量(image_quality_t)
+   */
+  uint8_t image_quality;
   /**
    * @property {color_t} text_color
    * @annotation ["readable"]
@@ -316,6 +326,16 @@ ret_t lcd_resize(lcd_t* lcd, wh_t w, wh_t h, uint32_t line_length);
  */
 ret_t lcd_set_global_alpha(lcd_t* lcd, uint8_t alpha);
 
+/**
+ * @method lcd_set_image_quality
+ * 设置缩放图片时的质量。
+ * @param {lcd_t*} lcd lcd对象。
+ * @param {image_quality_t} quality 质量。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t lcd_set_image_quality(lcd_t* lcd, image_quality_t quality);
+
 /**
  * @method lcd_set_text_color
  * 设置文本颜色。
@@ -497,6 +517,19 @@ ret_t lcd_draw_image(lcd_t* lcd, bitmap_t* img, rect_t* src, rect_t* dst);
  */
 ret_t lcd_draw_image_matrix(lcd_t* lcd, draw_image_info_t* info);
 
+/**
+ * @method lcd_draw_image_smooth
+ * 平滑缩放并绘制图片。
+ *
+ * > info->src和info->dst是完整(没有裁剪)的映射关系，只绘制info->clip内的部分，
+ * > 这样局部刷新和整体刷新时的取样位置相同。info->matrix不使用。
+ * @param {lcd_t*} lcd lcd对象。
+ * @param {draw_image_info_t*} info 绘制参数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，不支持时返回RET_NOT_IMPL。
+ */
+ret_t lcd_draw_image_smooth(lcd_t* lcd, draw_image_info_t* info);
+
 /**
  * @method lcd_get_vgcanvas
  * 获取矢量图canvas。
@@ -517,6 +550,20 @@ vgcanvas_t* lcd_get_vgcanvas(lcd_t* lcd);
  */
 ret_t lcd_take_snapshot(lcd_t* lcd, bitmap_t* img, bool_t auto_rotate);
 
+/**
+ * @method lcd_bind_snapshot
+ * 绑定快照图片，之后的绘制直接输出到快照图片中，不需要再调用lcd\_take\_snapshot拷贝(可选)。
+ *
+ * > 快照图片的宽度、高度、格式和line\_length必须和framebuffer一致。
+ * 图片没有数据时，由LCD分配内存(调用者负责释放)，以后可以重复使用。
+ *
+ * @param {lcd_t*} lcd lcd对象。
+ * @param {bitmap_t*} img 快照图片，为NULL时解除绑定。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败(如LCD不支持)。
+ */
+ret_t lcd_bind_snapshot(lcd_t* lcd, bitmap_t* img);
+
 /**
  * @method lcd_get_desired_bitmap_format
  * 获取期望的位图格式。绘制期望的位图格式可以提高绘制性能。
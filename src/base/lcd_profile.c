@@ -256,6 +256,21 @@ static ret_t lcd_profile_draw_image_matrix(lcd_t* lcd, draw_image_info_t* info)
   return ret;
 }
 
+static ret_t lcd_profile_draw_image_smooth(lcd_t* lcd, draw_image_info_t* info) {
+  ret_t ret = RET_OK;
+
+  uint32_t cost = 0;
+  uint32_t start = time_now_ms();
+  lcd_profile_t* profile = LCD_PROFILE(lcd);
+  ret = lcd_draw_image_smooth(profile->impl, info);
+  cost = time_now_ms() - start;
+
+  profile->draw_image_times++;
+  profile->draw_image_cost += cost;
+
+  return ret;
+}
+
 static vgcanvas_t* lcd_profile_get_vgcanvas(lcd_t* lcd) {
   lcd_profile_t* profile = LCD_PROFILE(lcd);
 
@@ -274,6 +289,12 @@ static ret_t lcd_profile_take_snapshot(lcd_t* lcd, bitmap_t* img, bool_t auto_ro
   return ret;
 }
 
+static ret_t lcd_profile_bind_snapshot(lcd_t* lcd, bitmap_t* img) {
+  lcd_profile_t* profile = LCD_PROFILE(lcd);
+
+  return lcd_bind_snapshot(profile->impl, img);
+}
+
 static bitmap_format_t lcd_profile_get_desired_bitmap_format(lcd_t* lcd) {
   lcd_profile_t* profile = LCD_PROFILE(lcd);
 
@@ -428,6 +449,10 @@ lcd_t* lcd_profile_create(lcd_t* impl) {
     lcd->draw_image_matrix = lcd_profile_draw_image_matrix;
   }
 
+  if (impl->draw_image_smooth != NULL) {
+    lcd->draw_image_smooth = lcd_profile_draw_image_smooth;
+  }
+
   if (impl->get_vgcanvas != NULL) {
     lcd->get_vgcanvas = lcd_profile_get_vgcanvas;
   }
@@ -436,6 +461,10 @@ lcd_t* lcd_profile_create(lcd_t* impl) {
     lcd->take_snapshot = lcd_profile_take_snapshot;
   }
 
+  if (impl->bind_snapshot != NULL) {
+    lcd->bind_snapshot = lcd_profile_bind_snapshot;
+  }
+
   if (impl->get_desired_bitmap_format != NULL) {
     lcd->get_desired_bitmap_format = lcd_profile_get_desired_bitmap_format;
   }
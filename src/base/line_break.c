@@ -25,21 +25,63 @@
 
 #include "linebreak.h"
 #include "wordbreak.h"
+#include "linebreakdef.h"
+#include "wordbreakdef.h"
 
-break_type_t line_break_check(wchar_t c1, wchar_t c2) {
-  int ret = 0;
-  static bool_t inited = FALSE;
-  if (!inited) {
-    inited = TRUE;
-    init_linebreak();
-  }
+/*
+ * 两个字符之间能否换行/分词只取决于它们的类别，所以先把每个字符映射到类别(两级表)，
+ * 再查类别对的结果表。结果表在第一次使用时用libunibreak计算，保证与逐对调用libunibreak一致。
+ */
 
-  if (c1 == ' ') {
-    return LINE_BREAK_ALLOW;
-  }
+/*分词规则WB3c只对Extended_Pictographic的字符生效，用一个额外的类别区分。*/
+#define WBP_EXT_PICT (WBP_Any + 1)
+#define LINE_BREAK_CLASS_NR (LBP_XX + 1)
+#define WORD_BREAK_CLASS_NR (WBP_EXT_PICT + 1)
+
+typedef struct _break_class_t {
+  uint8_t lb;
+  uint8_t wb;
+} break_class_t;
+
+typedef struct _break_sample_t {
+  uint8_t cls;
+  uint32_t c;
+} break_sample_t;
+
+#include "line_break_data.inc"
+
+static bool_t s_break_inited = FALSE;
+static uint8_t s_line_breaks[LINE_BREAK_CLASS_NR][LINE_BREAK_CLASS_NR];
+static uint8_t s_word_breaks[WORD_BREAK_CLASS_NR][WORD_BREAK_CLASS_NR];
+
+static const break_class_t* break_class_get(wchar_t c) {
+  uint32_t code = (uint32_t)c;
+
+  if (code < 0x10000) {
+    uint32_t block = s_break_class_index[code >> BREAK_CLASS_BLOCK_BITS];
+
+    return s_break_classes + s_break_class_blocks[block][code & BREAK_CLASS_BLOCK_MASK];
+  } else if (code < 0x110000) {
+    uint32_t low = 0;
+    uint32_t high = ARRAY_SIZE(s_break_class_ranges) - 1;
+
+    while (low < high) {
+      uint32_t mid = (low + high + 1) >> 1;
+
+      if ((s_break_class_ranges[mid] >> 8) <= code) {
+        low = mid;
+      } else {
+        high = mid - 1;
+      }
+    }
 
-  ret = is_line_breakable(c1, c2, "");
+    return s_break_classes + (s_break_class_ranges[low] & 0xff);
+  } else {
+    return s_break_classes;
+  }
+}
 
+static break_type_t line_break_from_unibreak(int ret) {
   switch (ret) {
     case LINEBREAK_MUSTBREAK: {
       return LINE_BREAK_MUST;
@@ -54,25 +96,91 @@ break_type_t line_break_check(wchar_t c1, wchar_t c2) {
   }
 }
 
+static void line_break_init(void) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+
+  if (s_break_inited) {
+    return;
+  }
+
+  init_linebreak();
+  init_wordbreak();
+
+  for (i = 0; i < ARRAY_SIZE(s_line_break_samples); i++) {
+    const break_sample_t* a = s_line_break_samples + i;
+
+    for (j = 0; j < ARRAY_SIZE(s_line_break_samples); j++) {
+      const break_sample_t* b = s_line_break_samples + j;
+      break_type_t ret = LINE_BREAK_ALLOW;
+
+      /*空格之后总是可以换行(LBP_SP只有空格一个字符)。*/
+      if (a->c != ' ') {
+        ret = line_break_from_unibreak(is_line_breakable(a->c, b->c, ""));
+      }
+
+      s_line_breaks[a->cls][b->cls] = ret;
+    }
+  }
+
+  for (i = 0; i < ARRAY_SIZE(s_word_break_samples); i++) {
+    const break_sample_t* a = s_word_break_samples + i;
+
+    for (j = 0; j < ARRAY_SIZE(s_word_break_samples); j++) {
+      utf32_t s[2];
+      char brks[2];
+      const break_sample_t* b = s_word_break_samples + j;
+
+      s[0] = a->c;
+      s[1] = b->c;
+      set_wordbreaks_utf32(s, 2, "", brks);
+      s_word_breaks[a->cls][b->cls] = brks[0] == WORDBREAK_BREAK ? LINE_BREAK_ALLOW : LINE_BREAK_NO;
+    }
+  }
+
+  s_break_inited = TRUE;
+}
+
+break_type_t line_break_check(wchar_t c1, wchar_t c2) {
+  line_break_init();
+
+  return (break_type_t)s_line_breaks[break_class_get(c1)->lb][break_class_get(c2)->lb];
+}
+
 break_type_t word_break_check(wchar_t c1, wchar_t c2) {
-  utf32_t s[2];
-  char brks[2];
-  static bool_t inited = FALSE;
+  line_break_init();
+
+  return (break_type_t)s_word_breaks[break_class_get(c1)->wb][break_class_get(c2)->wb];
+}
+
+ret_t line_break_check_str(const wchar_t* str, uint32_t size, break_type_t* line_brks,
+                           break_type_t* word_brks) {
+  uint32_t i = 0;
+  const break_class_t* cls = NULL;
+  const break_class_t* next = NULL;
+  return_value_if_fail(str != NULL || size == 0, RET_BAD_PARAMS);
 
-  if (!inited) {
-    inited = TRUE;
-    init_wordbreak();
+  if (size == 0) {
+    return RET_OK;
   }
 
-  s[0] = c1;
-  s[1] = c2;
-  set_wordbreaks_utf32(s, 2, "", brks);
+  line_break_init();
+  cls = break_class_get(str[0]);
+  for (i = 0; i < size; i++) {
+    next = break_class_get(i + 1 < size ? str[i + 1] : 0);
 
-  if (brks[0] == WORDBREAK_BREAK) {
-    return LINE_BREAK_ALLOW;
-  } else {
-    return LINE_BREAK_NO;
+    if (line_brks != NULL) {
+      line_brks[i] = (break_type_t)s_line_breaks[cls->lb][next->lb];
+    }
+
+    if (word_brks != NULL) {
+      word_brks[i] = (break_type_t)s_word_breaks[cls->wb][next->wb];
+    }
+
+    cls = next;
   }
+
+  return RET_OK;
 }
 #else
 /*FIXME:*/
@@ -95,4 +203,24 @@ break_type_t word_break_check(wchar_t c1, wchar_t c2) {
 
   return LINE_BREAK_NO;
 }
+
+ret_t line_break_check_str(const wchar_t* str, uint32_t size, break_type_t* line_brks,
+                           break_type_t* word_brks) {
+  uint32_t i = 0;
+  return_value_if_fail(str != NULL || size == 0, RET_BAD_PARAMS);
+
+  for (i = 0; i < size; i++) {
+    wchar_t next = i + 1 < size ? str[i + 1] : 0;
+
+    if (line_brks != NULL) {
+      line_brks[i] = line_break_check(str[i], next);
+    }
+
+    if (word_brks != NULL) {
+      word_brks[i] = word_break_check(str[i], next);
+    }
+  }
+
+  return RET_OK;
+}
 #endif /*WITH_UNICODE_BREAK*/
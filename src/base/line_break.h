@@ -32,6 +32,23 @@ break_type_t line_break_check(wchar_t c1, wchar_t c2);
 
 break_type_t word_break_check(wchar_t c1, wchar_t c2);
 
+/**
+ * @method line_break_check_str
+ * 一次计算字符串中每个字符与其后一个字符之间的换行类型和分词类型。
+ *
+ * > 结果与逐个调用line_break_check/word_break_check相同，但每个字符只查一次表。
+ * > line\_brks[i]/word\_brks[i]对应str[i]与str[i+1]，最后一个字符与0(字符串结束符)比较。
+ *
+ * @param {const wchar_t*} str 字符串。
+ * @param {uint32_t} size 字符串的长度。
+ * @param {break_type_t*} line_brks 用于返回换行类型(可以为NULL)，长度不小于size。
+ * @param {break_type_t*} word_brks 用于返回分词类型(可以为NULL)，长度不小于size。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t line_break_check_str(const wchar_t* str, uint32_t size, break_type_t* line_brks,
+                           break_type_t* word_brks);
+
 END_C_DECLS
 
 #endif /*TK_LINE_BREAK_H*/
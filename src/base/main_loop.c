@@ -23,6 +23,7 @@
 #include "tkc/platform.h"
 #include "base/main_loop.h"
 #include "base/window_manager.h"
+#include "base/widget_animator_manager.h"
 
 ret_t main_loop_run(main_loop_t* l) {
   return_value_if_fail(l != NULL && l->run != NULL, RET_BAD_PARAMS);
@@ -83,14 +84,60 @@ ret_t main_loop_queue_event(main_loop_t* l, const event_queue_req_t* e) {
 
 #define TK_MAX_SLEEP_TIME (1000 / TK_MAX_FPS)
 
+ret_t main_loop_set_vsync(main_loop_t* l, main_loop_wait_vsync_t wait_vsync,
+                          uint32_t frame_period) {
+  widget_animator_manager_t* am = widget_animator_manager();
+  return_value_if_fail(l != NULL, RET_BAD_PARAMS);
+
+  l->wait_vsync = wait_vsync;
+  l->frame_period = frame_period;
+  l->next_frame_time = 0;
+
+  if (am != NULL) {
+    uint32_t period = frame_period > 0 ? frame_period : TK_MAX_SLEEP_TIME;
+    widget_animator_manager_set_frame_period(am, period);
+  }
+
+  return RET_OK;
+}
+
+static bool_t main_loop_is_animating(void) {
+  window_manager_t* wm = WINDOW_MANAGER(window_manager());
+  widget_animator_manager_t* am = widget_animator_manager();
+
+  return wm->animating || (am != NULL && widget_animator_manager_is_animating(am));
+}
+
+/*
+ * 有动画时按固定的节拍(帧周期)开始每一帧，而不是每次循环都sleep相同的时间，
+ * 这样帧的间隔不受每帧绘制时间的影响。错过了节拍时立即开始下一帧，并从现在开始重新对齐。
+ */
+static uint32_t main_loop_frame_sleep_time(main_loop_t* l, uint32_t now) {
+  uint32_t period = l->frame_period > 0 ? l->frame_period : TK_MAX_SLEEP_TIME;
+  int32_t wait = (int32_t)(l->next_frame_time - now);
+
+  if (wait <= 0 || wait > (int32_t)period) {
+    wait = 0;
+    l->next_frame_time = now;
+  }
+  l->next_frame_time += period;
+
+  return wait;
+}
+
 ret_t main_loop_sleep_default(main_loop_t* l) {
   uint32_t sleep_time = 0;
   uint32_t now = time_now_ms();
   uint32_t gap = now - l->last_loop_time;
   int32_t least_sleep_time = gap > TK_MAX_SLEEP_TIME ? 0 : (TK_MAX_SLEEP_TIME - gap);
-  window_manager_t* wm = WINDOW_MANAGER(window_manager());
 
-  if (!wm->animating) {
+  if (main_loop_is_animating()) {
+    if (l->wait_vsync != NULL) {
+      l->wait_vsync(l);
+    } else {
+      sleep_time = main_loop_frame_sleep_time(l, now);
+    }
+  } else {
     int32_t next_timer = timer_next_time() - time_now_ms();
 
     if (next_timer < 0) {
@@ -98,13 +145,9 @@ ret_t main_loop_sleep_default(main_loop_t* l) {
     }
 
     sleep_time = tk_min(next_timer, TK_MAX_SLEEP_TIME);
-#ifdef WITH_SDL
-  } else if (gap <= 8) {
-    sleep_time = 8;
-#endif /*WITH_SDL*/
+    sleep_time = tk_min(least_sleep_time, sleep_time);
   }
 
-  sleep_time = tk_min(least_sleep_time, sleep_time);
   if (sleep_time > 0) {
     sleep_ms(sleep_time);
   }
@@ -37,6 +37,8 @@ typedef ret_t (*main_loop_wakeup_t)(main_loop_t* l);
 typedef ret_t (*main_loop_step_t)(main_loop_t* l);
 typedef ret_t (*main_loop_sleep_t)(main_loop_t* l);
 typedef ret_t (*main_loop_destroy_t)(main_loop_t* l);
+/*等待下一次垂直同步(阻塞)，返回时开始绘制下一帧*/
+typedef ret_t (*main_loop_wait_vsync_t)(main_loop_t* l);
 
 struct _main_loop_t {
   main_loop_run_t run;
@@ -46,10 +48,15 @@ struct _main_loop_t {
   main_loop_wakeup_t wakeup;
   main_loop_queue_event_t queue_event;
   main_loop_destroy_t destroy;
+  main_loop_wait_vsync_t wait_vsync;
 
   bool_t running;
   bool_t app_quited;
   uint32_t last_loop_time;
+  /*帧周期(毫秒)，为0时使用1000/TK_MAX_FPS*/
+  uint32_t frame_period;
+  /*private*/
+  uint32_t next_frame_time;
   widget_t* wm;
   canvas_t canvas;
   lcd_t* lcd;
@@ -69,6 +76,14 @@ ret_t main_loop_destroy(main_loop_t* l);
 ret_t main_loop_step(main_loop_t* l);
 ret_t main_loop_sleep(main_loop_t* l);
 
+/*
+ * 设置垂直同步源(如fbdev的FBIO_WAITFORVSYNC和drm的drmWaitVBlank)和显示器的刷新周期。
+ * 有动画时，主循环用wait_vsync代替sleep，让每一帧和显示器的刷新对齐。
+ * wait_vsync为NULL时，按frame_period的节拍sleep。
+ */
+ret_t main_loop_set_vsync(main_loop_t* l, main_loop_wait_vsync_t wait_vsync,
+                          uint32_t frame_period);
+
 END_C_DECLS
 
 #endif /*TK_MAIN_LOOP_H*/
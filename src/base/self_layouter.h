@@ -44,6 +44,8 @@ typedef self_layouter_t* (*self_layouter_create_t)(void);
 
 typedef struct _self_layouter_vtable_t {
   const char* type;
+  /*布局的结果只取决于布局参数、可用区域的大小和控件当前的位置/大小，可以缓存。*/
+  bool_t cacheable;
   self_layouter_to_string_t to_string;
   self_layouter_layout_t layout;
   self_layouter_get_param_t get_param;
@@ -140,6 +140,12 @@ BEGIN_C_DECLS
  */
 #define STYLE_ID_FG_IMAGE_DRAW_TYPE "fg_image_draw_type"
 
+/**
+ * @const STYLE_ID_IMAGE_QUALITY
+ * 图片缩放显示时的质量(nearest|smooth)。
+ */
+#define STYLE_ID_IMAGE_QUALITY "image_quality"
+
 /**
  * @const STYLE_ID_SPACER
  * 间距。
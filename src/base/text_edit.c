@@ -31,6 +31,8 @@
 
 #define CHAR_SPACING 1
 #define FONT_BASELINE 1.25f
+/*多行编辑器排版时每次计算换行类型的字符数。*/
+#define TEXT_EDIT_BREAK_CHUNK 64
 #define STB_TEXTEDIT_CHARTYPE wchar_t
 #define STB_TEXTEDIT_NEWLINE (wchar_t)('\n')
 #define STB_TEXTEDIT_STRING text_edit_t
@@ -86,6 +88,18 @@ typedef struct _text_edit_impl_t {
   wchar_t mask_char;
   bool_t mask;
   wstr_t tips;
+
+  /*for incremental layout of multi line edit*/
+  bool_t rows_valid;
+  uint32_t rows_text_size;
+  int32_t rows_layout_w;
+  font_size_t rows_font_size;
+  char rows_font_name[TK_NAME_LEN + 1];
+
+  bool_t dirty;
+  uint32_t dirty_start;
+  uint32_t dirty_end;
+  int32_t dirty_delta;
 } text_edit_impl_t;
 
 #define DECL_IMPL(te) text_edit_impl_t* impl = (text_edit_impl_t*)(te)
@@ -147,17 +161,34 @@ static rows_t* rows_create(uint32_t capacity) {
   return rows;
 }
 
-static row_info_t* rows_find_by_offset(rows_t* rows, uint32_t offset) {
-  uint32_t i = 0;
+/*返回offset所在的行(最后一个起始位置不大于offset的行)。*/
+static uint32_t rows_find_row(rows_t* rows, uint32_t offset) {
+  uint32_t low = 0;
+  uint32_t high = rows->size;
 
-  for (i = 0; i < rows->size; i++) {
-    row_info_t* iter = rows->info + i;
-    if (iter->offset == offset) {
-      return iter;
+  while (high - low > 1) {
+    uint32_t mid = low + ((high - low) >> 1);
+
+    if (rows->info[mid].offset <= offset) {
+      low = mid;
+    } else {
+      high = mid;
     }
   }
 
-  return NULL;
+  return low;
+}
+
+static row_info_t* rows_find_by_offset(rows_t* rows, uint32_t offset) {
+  row_info_t* iter = NULL;
+
+  if (rows->size == 0) {
+    return NULL;
+  }
+
+  iter = rows->info + rows_find_row(rows, offset);
+
+  return iter->offset == offset ? iter : NULL;
 }
 
 static ret_t rows_destroy(rows_t* rows) {
@@ -207,15 +238,22 @@ static ret_t text_edit_set_caret_pos(text_edit_impl_t* impl, uint32_t x, uint32_
   return RET_OK;
 }
 
+/*字符的占位宽度，包含字符间距和与下一个字符之间的字距调整。*/
+static uint32_t text_edit_measure_char(canvas_t* c, const wchar_t* p, wchar_t mask_char) {
+  wchar_t chr = mask_char ? mask_char : p[0];
+  wchar_t next = (mask_char && p[1]) ? mask_char : p[1];
+  int32_t w = canvas_measure_text(c, &chr, 1) + canvas_get_kerning(c, chr, next);
+
+  return tk_max(w, 0) + CHAR_SPACING;
+}
+
 static uint32_t text_edit_measure_text(canvas_t* c, wchar_t* str, wchar_t mask_char,
                                        uint32_t size) {
   uint32_t i = 0;
   uint32_t w = 0;
 
   for (i = 0; i < size; i++) {
-    wchar_t chr = mask_char ? mask_char : str[i];
-
-    w += canvas_measure_text(c, &chr, 1) + CHAR_SPACING;
+    w += text_edit_measure_char(c, str + i, mask_char);
   }
 
   return w;
@@ -266,12 +304,13 @@ static row_info_t* text_edit_multi_line_layout_line(text_edit_t* text_edit, uint
   DECL_IMPL(text_edit);
   canvas_t* c = text_edit->c;
   wstr_t* text = &(text_edit->widget->text);
-  STB_TexteditState* state = &(impl->state);
   row_info_t* row = impl->rows->info + row_num;
-  uint32_t line_height = c->font_size * FONT_BASELINE;
-  uint32_t y = line_height * row_num;
+  uint32_t brks_start = offset;
+  uint32_t brks_end = offset;
   uint32_t last_breakable_i = 0;
   uint32_t last_breakable_x = 0;
+  break_type_t line_brks[TEXT_EDIT_BREAK_CHUNK + 1];
+  break_type_t word_brks[TEXT_EDIT_BREAK_CHUNK + 1];
   text_layout_info_t* layout_info = &(impl->layout_info);
 
   memset(row, 0x00, sizeof(row_info_t));
@@ -279,14 +318,18 @@ static row_info_t* text_edit_multi_line_layout_line(text_edit_t* text_edit, uint
     wchar_t* p = text->str + i;
     break_type_t word_break = LINE_BREAK_NO;
     break_type_t line_break = LINE_BREAK_NO;
-    uint32_t char_w = canvas_measure_text(c, p, 1) + CHAR_SPACING;
-    uint32_t next_char_w = canvas_measure_text(c, p + 1, 1) + CHAR_SPACING;
+    uint32_t char_w = text_edit_measure_char(c, p, 0);
 
-    if (i == state->cursor) {
-      text_edit_set_caret_pos(impl, x, y, c->font_size);
+    if (i >= brks_end) {
+      /*多算一个字符，保证每块最后一个字符与后面字符之间的结果正确。*/
+      uint32_t size = tk_min(text->size - i, TEXT_EDIT_BREAK_CHUNK + 1);
+
+      line_break_check_str(p, size, line_brks, word_brks);
+      brks_start = i;
+      brks_end = i + tk_min(size, TEXT_EDIT_BREAK_CHUNK);
     }
 
-    line_break = line_break_check(*p, p[1]);
+    line_break = line_brks[i - brks_start];
     if (line_break == LINE_BREAK_MUST) {
       i++;
       break;
@@ -302,7 +345,7 @@ static row_info_t* text_edit_multi_line_layout_line(text_edit_t* text_edit, uint
       }
 
       x += char_w;
-      word_break = word_break_check(*p, p[1]);
+      word_break = word_brks[i - brks_start];
       if (word_break == LINE_BREAK_ALLOW && line_break == LINE_BREAK_ALLOW) {
         last_breakable_x = x;
         last_breakable_i = i;
@@ -312,14 +355,9 @@ static row_info_t* text_edit_multi_line_layout_line(text_edit_t* text_edit, uint
     }
   }
 
-  if (i == state->cursor && state->cursor == text->size) {
-    text_edit_set_caret_pos(impl, x, y, c->font_size);
-  }
-
   row->text_w = x;
   row->offset = offset;
   row->length = i - offset;
-  layout_info->virtual_h = tk_max(y, layout_info->widget_h);
 
   return row;
 }
@@ -334,37 +372,214 @@ static row_info_t* text_edit_layout_line(text_edit_t* text_edit, uint32_t row_nu
   }
 }
 
-ret_t text_edit_layout(text_edit_t* text_edit) {
-  uint32_t i = 0;
-  uint32_t offset = 0;
+static uint32_t text_edit_layout_rows(text_edit_t* text_edit, uint32_t row_num,
+                                      uint32_t offset) {
+  uint32_t i = row_num;
   DECL_IMPL(text_edit);
   uint32_t max_rows = impl->rows->capacity;
   uint32_t size = text_edit->widget->text.size;
-  text_layout_info_t* layout_info = &(impl->layout_info);
 
-  impl->caret.x = 0;
-  impl->caret.y = 0;
-  impl->rows->size = 0;
+  while ((offset < size || size == 0) && i < max_rows) {
+    row_info_t* iter = text_edit_layout_line(text_edit, i, offset);
+    if (iter == NULL || iter->length == 0) {
+      break;
+    }
+    offset += iter->length;
+    i++;
+  }
+
+  return i;
+}
 
-  if (text_edit->c == NULL) {
+/*该行是否以换行符结束(新段落的开始)，后面的修改不会影响这样的行。*/
+static bool_t text_edit_row_is_paragraph_end(text_edit_t* text_edit, row_info_t* row) {
+  wstr_t* text = &(text_edit->widget->text);
+  uint32_t end = row->offset + row->length;
+  wchar_t c = text->str[end - 1];
+
+  if (c != '\r' && c != STB_TEXTEDIT_NEWLINE) {
+    return FALSE;
+  }
+
+  return line_break_check(c, end < text->size ? text->str[end] : 0) == LINE_BREAK_MUST;
+}
+
+/*
+ * 增量排版：只从被修改段落的第一行开始重新排版，当新行的起始位置与修改区域之后的某个旧行
+ * (平移修改引起的长度变化后)重合时，后面的行和原来完全一样，平移后直接复用，不再测量字符宽度。
+ */
+static ret_t text_edit_layout_dirty_rows(text_edit_t* text_edit) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t nr = 0;
+  uint32_t first = 0;
+  uint32_t offset = 0;
+  int64_t old_end = 0;
+  DECL_IMPL(text_edit);
+  rows_t* rows = impl->rows;
+  row_info_t* old_rows = NULL;
+  int32_t delta = impl->dirty_delta;
+  uint32_t size = text_edit->widget->text.size;
+
+  if (rows->size == 0) {
+    rows->size = text_edit_layout_rows(text_edit, 0, 0);
     return RET_OK;
   }
 
-  widget_prepare_text_style(text_edit->widget, text_edit->c);
-  widget_get_text_layout_info(text_edit->widget, layout_info);
-  while ((offset < size || size == 0) && i < max_rows) {
-    row_info_t* iter = text_edit_layout_line(text_edit, i, offset);
+  first = rows_find_row(rows, impl->dirty_start);
+  while (first > 0) {
+    row_info_t* prev = rows->info + first - 1;
+    if (rows->info[first].offset < impl->dirty_start &&
+        text_edit_row_is_paragraph_end(text_edit, prev)) {
+      break;
+    }
+    first--;
+  }
+
+  nr = rows->size - first;
+  old_rows = TKMEM_ZALLOCN(row_info_t, nr);
+  return_value_if_fail(old_rows != NULL, RET_OOM);
+  memcpy(old_rows, rows->info + first, nr * sizeof(row_info_t));
+
+  i = first;
+  offset = old_rows[0].offset;
+  old_end = (int64_t)(impl->dirty_end) - delta;
+  while (offset < size && i < rows->capacity) {
+    row_info_t* iter = NULL;
+
+    while (j < nr && (old_rows[j].offset < old_end ||
+                      (int64_t)(old_rows[j].offset) + delta < (int64_t)offset)) {
+      j++;
+    }
+
+    if (j < nr && (int64_t)(old_rows[j].offset) + delta == (int64_t)offset) {
+      uint32_t k = 0;
+      uint32_t n = tk_min(nr - j, rows->capacity - i);
+
+      for (k = 0; k < n; k++) {
+        iter = rows->info + i + k;
+        *iter = old_rows[j + k];
+        iter->offset += delta;
+      }
+
+      i += n;
+      j = nr;
+      offset = iter->offset + iter->length;
+      continue;
+    }
+
+    iter = text_edit_layout_line(text_edit, i, offset);
     if (iter == NULL || iter->length == 0) {
       break;
     }
     offset += iter->length;
     i++;
   }
-  impl->rows->size = i;
+  rows->size = i;
+
+  TKMEM_FREE(old_rows);
 
   return RET_OK;
 }
 
+static ret_t text_edit_multi_line_update_caret(text_edit_t* text_edit) {
+  uint32_t x = 0;
+  uint32_t y = 0;
+  DECL_IMPL(text_edit);
+  canvas_t* c = text_edit->c;
+  rows_t* rows = impl->rows;
+  uint32_t cursor = impl->state.cursor;
+  wstr_t* text = &(text_edit->widget->text);
+  uint32_t line_height = c->font_size * FONT_BASELINE;
+  text_layout_info_t* layout_info = &(impl->layout_info);
+
+  if (rows->size > 0) {
+    uint32_t i = rows_find_row(rows, cursor);
+    row_info_t* row = rows->info + i;
+
+    y = line_height * (rows->size - 1);
+    layout_info->virtual_h = tk_max(y, layout_info->widget_h);
+
+    if (cursor <= row->offset + row->length) {
+      uint32_t k = 0;
+      for (k = row->offset; k < cursor; k++) {
+        wchar_t* p = text->str + k;
+        if (*p != '\r' && *p != STB_TEXTEDIT_NEWLINE) {
+          x += text_edit_measure_char(c, p, 0);
+        }
+      }
+
+      text_edit_set_caret_pos(impl, x, line_height * i, c->font_size);
+    }
+  } else {
+    layout_info->virtual_h = layout_info->widget_h;
+    text_edit_set_caret_pos(impl, 0, 0, c->font_size);
+  }
+
+  return RET_OK;
+}
+
+static bool_t text_edit_rows_reusable(text_edit_t* text_edit) {
+  DECL_IMPL(text_edit);
+  canvas_t* c = text_edit->c;
+  uint32_t size = text_edit->widget->text.size;
+  int32_t delta = impl->dirty ? impl->dirty_delta : 0;
+
+  return impl->rows_valid && !impl->single_line &&
+         (int64_t)(impl->rows_text_size) + delta == (int64_t)size &&
+         impl->rows_layout_w == impl->layout_info.w && impl->rows_font_size == c->font_size &&
+         tk_str_eq(impl->rows_font_name, c->font_name != NULL ? c->font_name : "");
+}
+
+/*文本编辑后重新排版，能复用的行不重新排版。*/
+static ret_t text_edit_relayout(text_edit_t* text_edit) {
+  DECL_IMPL(text_edit);
+  canvas_t* c = text_edit->c;
+  text_layout_info_t* layout_info = &(impl->layout_info);
+
+  impl->caret.x = 0;
+  impl->caret.y = 0;
+
+  if (c == NULL) {
+    impl->dirty = FALSE;
+    impl->rows_valid = FALSE;
+    impl->rows->size = 0;
+
+    return RET_OK;
+  }
+
+  widget_prepare_text_style(text_edit->widget, c);
+  widget_get_text_layout_info(text_edit->widget, layout_info);
+
+  if (!text_edit_rows_reusable(text_edit)) {
+    impl->rows->size = 0;
+    impl->rows->size = text_edit_layout_rows(text_edit, 0, 0);
+  } else if (impl->dirty) {
+    text_edit_layout_dirty_rows(text_edit);
+  }
+
+  if (!impl->single_line) {
+    text_edit_multi_line_update_caret(text_edit);
+  }
+
+  impl->dirty = FALSE;
+  impl->rows_valid = TRUE;
+  impl->rows_text_size = text_edit->widget->text.size;
+  impl->rows_layout_w = layout_info->w;
+  impl->rows_font_size = c->font_size;
+  tk_strncpy(impl->rows_font_name, c->font_name != NULL ? c->font_name : "", TK_NAME_LEN);
+
+  return RET_OK;
+}
+
+ret_t text_edit_layout(text_edit_t* text_edit) {
+  DECL_IMPL(text_edit);
+
+  impl->rows_valid = FALSE;
+
+  return text_edit_relayout(text_edit);
+}
+
 static void text_edit_layout_for_stb(StbTexteditRow* row, STB_TEXTEDIT_STRING* str, int offset) {
   DECL_IMPL(str);
   uint32_t font_size = str->c->font_size;
@@ -428,13 +643,10 @@ static ret_t text_edit_paint_tips_text(text_edit_t* text_edit, canvas_t* c) {
 
 static int32_t text_edit_calc_x(text_edit_t* text_edit, row_info_t* iter) {
   DECL_IMPL(text_edit);
-  canvas_t* c = text_edit->c;
-  widget_t* widget = text_edit->widget;
-  wstr_t* text = &(widget->text);
   text_layout_info_t* layout_info = &(impl->layout_info);
   align_h_t align_h = widget_get_text_align_h(text_edit->widget);
 
-  uint32_t row_width = text_edit_measure_text(c, text->str + iter->offset, 0, iter->length);
+  uint32_t row_width = iter->text_w;
   if (row_width < layout_info->w) {
     switch (align_h) {
       case ALIGN_H_CENTER: {
@@ -478,11 +690,12 @@ static ret_t text_edit_paint_line(text_edit_t* text_edit, canvas_t* c, row_info_
 
   for (k = 0; k < iter->length; k++) {
     uint32_t offset = iter->offset + k;
-    wchar_t chr = impl->mask ? impl->mask_char : text->str[offset];
-    uint32_t char_w = canvas_measure_text(c, &chr, 1);
+    wchar_t mask_char = impl->mask ? impl->mask_char : 0;
+    wchar_t chr = mask_char ? mask_char : text->str[offset];
+    uint32_t char_w = text_edit_measure_char(c, text->str + offset, mask_char);
 
     if ((x + char_w) < view_left) {
-      x += char_w + CHAR_SPACING;
+      x += char_w;
       continue;
     }
 
@@ -499,7 +712,7 @@ static ret_t text_edit_paint_line(text_edit_t* text_edit, canvas_t* c, row_info_
         color_t select_text_color = style_get_color(style, STYLE_ID_SELECTED_TEXT_COLOR, black);
 
         canvas_set_fill_color(c, select_bg_color);
-        canvas_fill_rect(c, rx, ry, char_w + CHAR_SPACING, c->font_size);
+        canvas_fill_rect(c, rx, ry, char_w, c->font_size);
 
         canvas_set_text_color(c, select_text_color);
       } else {
@@ -508,7 +721,7 @@ static ret_t text_edit_paint_line(text_edit_t* text_edit, canvas_t* c, row_info_
       }
 
       canvas_draw_text(c, &chr, 1, rx, ry);
-      x += char_w + CHAR_SPACING;
+      x += char_w;
     }
   }
 
@@ -611,23 +824,63 @@ ret_t text_edit_paint(text_edit_t* text_edit, canvas_t* c) {
   return RET_OK;
 }
 
+/*
+ * 记录修改区域，供增量排版使用。
+ * [dirty_start, dirty_end)是当前文本中被修改过的区域，dirty_delta是文本长度的变化。
+ */
+static ret_t text_edit_mark_dirty(text_edit_t* text_edit, uint32_t pos, int32_t delta) {
+  DECL_IMPL(text_edit);
+  uint32_t end = impl->dirty_end;
+
+  if (!impl->dirty) {
+    impl->dirty = TRUE;
+    impl->dirty_start = pos;
+    impl->dirty_end = delta > 0 ? pos + delta : pos;
+    impl->dirty_delta = delta;
+
+    return RET_OK;
+  }
+
+  if (delta > 0) {
+    end = pos <= end ? end + delta : pos + delta;
+  } else {
+    uint32_t nr = -delta;
+    end = pos + nr <= end ? end - nr : pos;
+  }
+
+  impl->dirty_start = tk_min(impl->dirty_start, pos);
+  impl->dirty_end = tk_max(end, impl->dirty_start);
+  impl->dirty_delta += delta;
+
+  return RET_OK;
+}
+
 static int text_edit_remove(STB_TEXTEDIT_STRING* str, int pos, int num) {
   wstr_t* text = &(str->widget->text);
-  wstr_remove(text, pos, num);
+  uint32_t size = text->size;
+
+  if (wstr_remove(text, pos, num) == RET_OK) {
+    text_edit_mark_dirty(str, pos, (int32_t)(text->size) - (int32_t)size);
+  }
 
   return TRUE;
 }
 
 static int text_edit_get_char_width(STB_TEXTEDIT_STRING* str, int pos, int offset) {
+  DECL_IMPL(str);
   wstr_t* text = &(str->widget->text);
+  wchar_t mask_char = impl->mask ? impl->mask_char : 0;
 
-  return canvas_measure_text(str->c, text->str + pos + offset, 1) + CHAR_SPACING;
+  return text_edit_measure_char(str->c, text->str + pos + offset, mask_char);
 }
 
 static int text_edit_insert(STB_TEXTEDIT_STRING* str, int pos, STB_TEXTEDIT_CHARTYPE* newtext,
                             int num) {
   wstr_t* text = &(str->widget->text);
-  wstr_insert(text, pos, newtext, num);
+
+  if (wstr_insert(text, pos, newtext, num) == RET_OK) {
+    text_edit_mark_dirty(str, pos, num);
+  }
 
   return TRUE;
 }
@@ -717,6 +970,7 @@ ret_t text_edit_set_max_rows(text_edit_t* text_edit, uint32_t max_rows) {
 
   if (impl->rows == NULL) {
     impl->rows = rows_create(max_rows);
+    impl->rows_valid = FALSE;
   }
 
   return RET_OK;
@@ -751,7 +1005,7 @@ ret_t text_edit_click(text_edit_t* text_edit, xy_t x, xy_t y) {
 
   point = text_edit_normalize_point(text_edit, x, y);
   stb_textedit_click(text_edit, &(impl->state), point.x, point.y);
-  text_edit_layout(text_edit);
+  text_edit_relayout(text_edit);
 
   return RET_OK;
 }
@@ -763,7 +1017,7 @@ ret_t text_edit_drag(text_edit_t* text_edit, xy_t x, xy_t y) {
 
   point = text_edit_normalize_point(text_edit, x, y);
   stb_textedit_drag(text_edit, &(impl->state), point.x, point.y);
-  text_edit_layout(text_edit);
+  text_edit_relayout(text_edit);
 
   return RET_OK;
 }
@@ -865,7 +1119,7 @@ ret_t text_edit_key_down(text_edit_t* text_edit, key_event_t* evt) {
       }
     }
 
-    text_edit_layout(text_edit);
+    text_edit_relayout(text_edit);
 
     return RET_OK;
   }
@@ -875,7 +1129,7 @@ ret_t text_edit_key_down(text_edit_t* text_edit, key_event_t* evt) {
   }
 
   stb_textedit_key(text_edit, state, key);
-  text_edit_layout(text_edit);
+  text_edit_relayout(text_edit);
 
   return RET_OK;
 }
@@ -919,6 +1173,7 @@ ret_t text_edit_cut(text_edit_t* text_edit) {
 
   if (text_edit_copy(text_edit) == RET_OK) {
     stb_textedit_cut(text_edit, &(impl->state));
+    text_edit_relayout(text_edit);
   }
 
   return RET_OK;
@@ -929,7 +1184,7 @@ ret_t text_edit_paste(text_edit_t* text_edit, wchar_t* str, uint32_t size) {
   return_value_if_fail(text_edit != NULL && str != NULL, RET_BAD_PARAMS);
 
   stb_textedit_paste(text_edit, &(impl->state), str, size);
-  text_edit_layout(text_edit);
+  text_edit_relayout(text_edit);
 
   return RET_OK;
 }
@@ -1012,7 +1267,7 @@ ret_t text_edit_set_select(text_edit_t* text_edit, uint32_t start, uint32_t end)
   impl->state.select_end = tk_min(end, text_edit->widget->text.size);
   ;
 
-  text_edit_layout(text_edit);
+  text_edit_relayout(text_edit);
 
   return RET_OK;
 }
@@ -74,6 +74,19 @@ text_edit_t* text_edit_create(widget_t* widget, bool_t single_line);
  */
 ret_t text_edit_set_canvas(text_edit_t* text_edit, canvas_t* c);
 
+/**
+ * @method text_edit_layout
+ * 重新排版全部文本。
+ *
+ * > 通过text_edit编辑文本时只重新排版被修改的段落。
+ * > 在text_edit之外直接修改了控件的文本后，需要调用本函数重新排版。
+ *
+ * @param {text_edit_t*} text_edit text_edit对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t text_edit_layout(text_edit_t* text_edit);
+
 /**
  * @method text_edit_click
  * 处理点击事件。
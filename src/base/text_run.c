@@ -0,0 +1,282 @@
+/**
+ * File:   text_run.c
+ * Author: AWTK Develop Team
+ * Brief:  positioned glyphs of a text run
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "base/text_run.h"
+
+#ifndef TK_TEXT_RUN_CACHE_SIZE
+#define TK_TEXT_RUN_CACHE_SIZE 32
+#endif /*TK_TEXT_RUN_CACHE_SIZE*/
+
+/*只缓存长度在此范围内的字符串，单个字符和很长的文本直接排版。*/
+#define TEXT_RUN_CACHE_MIN_CHARS 2
+#define TEXT_RUN_CACHE_MAX_CHARS 256
+
+typedef struct _text_run_cache_item_t {
+  uint32_t hash;
+  uint32_t last_access;
+  wchar_t* str;
+  text_run_t run;
+} text_run_cache_item_t;
+
+struct _text_run_cache_t {
+  uint32_t access;
+  uint32_t tmp_capacity;
+  text_run_t tmp;
+  text_run_cache_item_t items[TK_TEXT_RUN_CACHE_SIZE];
+};
+
+static bool_t text_run_is_combining_mark(wchar_t c) {
+  return (c >= 0x0300 && c <= 0x036f) || (c >= 0x1ab0 && c <= 0x1aff) ||
+         (c >= 0x1dc0 && c <= 0x1dff) || (c >= 0x20d0 && c <= 0x20ff) ||
+         (c >= 0xfe20 && c <= 0xfe2f);
+}
+
+static ret_t text_run_shape(text_run_t* run, font_t* font, font_size_t font_size,
+                            const wchar_t* str, uint32_t nr) {
+  glyph_t g;
+  int32_t x = 0;
+  uint32_t i = 0;
+  int32_t mark_x = 0;
+  wchar_t prev = 0;
+  glyph_pos_t* prev_glyph = NULL;
+  uint32_t cluster = 0;
+
+  for (i = 0; i < nr; i++) {
+    wchar_t chr = str[i];
+    glyph_pos_t* iter = run->glyphs + i;
+
+    iter->c = chr;
+    if (i > 0 && text_run_is_combining_mark(chr) &&
+        font_get_glyph(font, chr, font_size, &g) == RET_OK) {
+      /*组合字符不占位置，画在前一个字符的后面(字体中组合字符的字模通常向左偏移)。*/
+      iter->x = mark_x;
+      iter->advance = 0;
+      iter->cluster = cluster;
+      continue;
+    }
+
+    cluster = i;
+    iter->cluster = i;
+    if (chr == '\r' || chr == '\n') {
+      prev = 0;
+      iter->advance = 0;
+    } else if (chr != ' ' && font_get_glyph(font, chr, font_size, &g) == RET_OK) {
+      int32_t kerning = font_get_kerning(font, font_size, prev, chr);
+
+      if (kerning != 0 && prev_glyph != NULL) {
+        x += kerning;
+        prev_glyph->advance += kerning;
+      }
+
+      prev = chr;
+      iter->advance = g.advance + TEXT_RUN_LETTER_SPACING;
+    } else {
+      prev = 0;
+      iter->advance = TEXT_RUN_SPACE_W;
+    }
+
+    iter->x = x;
+    x += iter->advance;
+    mark_x = x - (prev != 0 ? TEXT_RUN_LETTER_SPACING : 0);
+    prev_glyph = iter;
+  }
+
+  run->w = x;
+  run->size = nr;
+  run->font_size = font_size;
+
+  return RET_OK;
+}
+
+ret_t text_run_init(text_run_t* run, font_t* font, font_size_t font_size, const wchar_t* str,
+                    uint32_t nr) {
+  return_value_if_fail(run != NULL && font != NULL && (str != NULL || nr == 0), RET_BAD_PARAMS);
+
+  memset(run, 0x00, sizeof(text_run_t));
+  if (nr > 0) {
+    run->glyphs = TKMEM_ZALLOCN(glyph_pos_t, nr);
+    return_value_if_fail(run->glyphs != NULL, RET_OOM);
+  }
+
+  return text_run_shape(run, font, font_size, str, nr);
+}
+
+int32_t text_run_get_x(const text_run_t* run, uint32_t offset) {
+  return_value_if_fail(run != NULL, 0);
+
+  if (offset >= run->size) {
+    return run->w;
+  }
+
+  return run->glyphs[run->glyphs[offset].cluster].x;
+}
+
+uint32_t text_run_hit_test(const text_run_t* run, int32_t x) {
+  uint32_t i = 0;
+  uint32_t ret = 0;
+  int32_t min_d = 0x7fffffff;
+  return_value_if_fail(run != NULL, 0);
+
+  for (i = 0; i <= run->size; i++) {
+    int32_t d = 0;
+
+    if (i < run->size && run->glyphs[i].cluster != i) {
+      continue;
+    }
+
+    d = tk_abs(text_run_get_x(run, i) - x);
+    if (d < min_d) {
+      min_d = d;
+      ret = i;
+    }
+  }
+
+  return ret;
+}
+
+ret_t text_run_deinit(text_run_t* run) {
+  return_value_if_fail(run != NULL, RET_BAD_PARAMS);
+
+  TKMEM_FREE(run->glyphs);
+  memset(run, 0x00, sizeof(text_run_t));
+
+  return RET_OK;
+}
+
+static uint32_t text_run_hash(font_size_t font_size, const wchar_t* str, uint32_t nr) {
+  uint32_t i = 0;
+  uint32_t hash = 5381 + font_size;
+
+  for (i = 0; i < nr; i++) {
+    hash = ((hash << 5) + hash) + (uint32_t)(str[i]);
+  }
+
+  return hash;
+}
+
+static text_run_cache_item_t* text_run_cache_find(text_run_cache_t* cache, uint32_t hash,
+                                                  font_size_t font_size, const wchar_t* str,
+                                                  uint32_t nr) {
+  uint32_t i = 0;
+
+  for (i = 0; i < TK_TEXT_RUN_CACHE_SIZE; i++) {
+    text_run_cache_item_t* iter = cache->items + i;
+
+    if (iter->str != NULL && iter->hash == hash && iter->run.size == nr &&
+        iter->run.font_size == font_size && memcmp(iter->str, str, nr * sizeof(wchar_t)) == 0) {
+      return iter;
+    }
+  }
+
+  return NULL;
+}
+
+static text_run_cache_item_t* text_run_cache_get_empty(text_run_cache_t* cache) {
+  uint32_t i = 0;
+  text_run_cache_item_t* item = cache->items;
+
+  for (i = 0; i < TK_TEXT_RUN_CACHE_SIZE; i++) {
+    text_run_cache_item_t* iter = cache->items + i;
+
+    if (iter->str == NULL) {
+      return iter;
+    }
+
+    if (iter->last_access < item->last_access) {
+      item = iter;
+    }
+  }
+
+  TKMEM_FREE(item->run.glyphs);
+  memset(item, 0x00, sizeof(text_run_cache_item_t));
+
+  return item;
+}
+
+static const text_run_t* text_run_cache_shape_tmp(text_run_cache_t* cache, font_t* font,
+                                                  font_size_t font_size, const wchar_t* str,
+                                                  uint32_t nr) {
+  text_run_t* run = &(cache->tmp);
+
+  if (nr > cache->tmp_capacity) {
+    glyph_pos_t* glyphs = TKMEM_REALLOCT(glyph_pos_t, run->glyphs, nr);
+    return_value_if_fail(glyphs != NULL, NULL);
+
+    run->glyphs = glyphs;
+    cache->tmp_capacity = nr;
+  }
+
+  text_run_shape(run, font, font_size, str, nr);
+
+  return run;
+}
+
+const text_run_t* font_get_text_run(font_t* font, font_size_t font_size, const wchar_t* str,
+                                    uint32_t nr) {
+  uint32_t hash = 0;
+  text_run_cache_t* cache = NULL;
+  text_run_cache_item_t* item = NULL;
+  return_value_if_fail(font != NULL && (str != NULL || nr == 0), NULL);
+
+  if (font->text_runs == NULL) {
+    font->text_runs = TKMEM_ZALLOC(text_run_cache_t);
+    return_value_if_fail(font->text_runs != NULL, NULL);
+  }
+
+  cache = font->text_runs;
+  if (nr < TEXT_RUN_CACHE_MIN_CHARS || nr > TEXT_RUN_CACHE_MAX_CHARS) {
+    return text_run_cache_shape_tmp(cache, font, font_size, str, nr);
+  }
+
+  hash = text_run_hash(font_size, str, nr);
+  item = text_run_cache_find(cache, hash, font_size, str, nr);
+
+  if (item == NULL) {
+    /*字符串和排版结果放在同一块内存中。*/
+    uint8_t* mem = TKMEM_ALLOC(nr * (sizeof(glyph_pos_t) + sizeof(wchar_t)));
+    return_value_if_fail(mem != NULL, text_run_cache_shape_tmp(cache, font, font_size, str, nr));
+
+    item = text_run_cache_get_empty(cache);
+    item->hash = hash;
+    item->run.glyphs = (glyph_pos_t*)mem;
+    item->str = (wchar_t*)(mem + nr * sizeof(glyph_pos_t));
+    memcpy(item->str, str, nr * sizeof(wchar_t));
+    text_run_shape(&(item->run), font, font_size, str, nr);
+  }
+
+  item->last_access = ++cache->access;
+
+  return &(item->run);
+}
+
+ret_t text_run_cache_destroy(text_run_cache_t* cache) {
+  uint32_t i = 0;
+  return_value_if_fail(cache != NULL, RET_BAD_PARAMS);
+
+  for (i = 0; i < TK_TEXT_RUN_CACHE_SIZE; i++) {
+    TKMEM_FREE(cache->items[i].run.glyphs);
+  }
+  TKMEM_FREE(cache->tmp.glyphs);
+  TKMEM_FREE(cache);
+
+  return RET_OK;
+}
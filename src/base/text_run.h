@@ -0,0 +1,173 @@
+/**
+ * File:   text_run.h
+ * Author: AWTK Develop Team
+ * Brief:  positioned glyphs of a text run
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_TEXT_RUN_H
+#define TK_TEXT_RUN_H
+
+#include "base/font.h"
+
+BEGIN_C_DECLS
+
+/*空格和缺少字模的字符的占位宽度。*/
+#define TEXT_RUN_SPACE_W 4
+
+/*字符之间的间距。*/
+#define TEXT_RUN_LETTER_SPACING 1
+
+/**
+ * @class glyph_pos_t
+ * 排版后的一个字符。
+ */
+typedef struct _glyph_pos_t {
+  /**
+   * @property {wchar_t} c
+   * @annotation ["readable"]
+   * 字符。
+   */
+  wchar_t c;
+  /**
+   * @property {uint32_t} cluster
+   * @annotation ["readable"]
+   * 所在簇的第一个字符在字符串中的位置。组合字符(如重音符号)和它前面的字符属于同一个簇，
+   * 光标只能停在簇的边界上。
+   */
+  uint32_t cluster;
+  /**
+   * @property {int32_t} x
+   * @annotation ["readable"]
+   * 相对于文本起点的位置(已经包含了前面字符的字距调整)。
+   */
+  int32_t x;
+  /**
+   * @property {int32_t} advance
+   * @annotation ["readable"]
+   * 占位宽度(包含字符间距和与下一个字符之间的字距调整，组合字符为0)。
+   */
+  int32_t advance;
+} glyph_pos_t;
+
+/**
+ * @class text_run_t
+ * 用同一字体和大小排版的一段文本。
+ *
+ * 把字符串转换成定位好的字符数组，处理了字距调整(kerning)和组合字符，并记录每个字符所在的簇。
+ * canvas绘制和测量文本都使用它。
+ *
+ * > 每个输入字符对应一个glyph\_pos\_t，目前不支持连字(ligature)。
+ */
+typedef struct _text_run_t {
+  /**
+   * @property {font_size_t} font_size
+   * @annotation ["readable"]
+   * 字体大小。
+   */
+  font_size_t font_size;
+  /**
+   * @property {uint32_t} size
+   * @annotation ["readable"]
+   * 字符数。
+   */
+  uint32_t size;
+  /**
+   * @property {int32_t} w
+   * @annotation ["readable"]
+   * 总宽度。
+   */
+  int32_t w;
+  /**
+   * @property {glyph_pos_t*} glyphs
+   * @annotation ["readable"]
+   * 排版后的字符。
+   */
+  glyph_pos_t* glyphs;
+} text_run_t;
+
+/**
+ * @method text_run_init
+ * 排版一段文本。
+ *
+ * @param {text_run_t*} run text_run对象。
+ * @param {font_t*} font 字体。
+ * @param {font_size_t} font_size 字体大小。
+ * @param {const wchar_t*} str 字符串。
+ * @param {uint32_t} nr 字符数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t text_run_init(text_run_t* run, font_t* font, font_size_t font_size, const wchar_t* str,
+                    uint32_t nr);
+
+/**
+ * @method text_run_get_x
+ * 获取光标在指定字符之前时的x坐标。
+ *
+ * @param {const text_run_t*} run text_run对象。
+ * @param {uint32_t} offset 字符在字符串中的位置(在簇的中间时取簇的起点)。
+ *
+ * @return {int32_t} 返回x坐标。
+ */
+int32_t text_run_get_x(const text_run_t* run, uint32_t offset);
+
+/**
+ * @method text_run_hit_test
+ * 查找离指定x坐标最近的光标位置。
+ *
+ * @param {const text_run_t*} run text_run对象。
+ * @param {int32_t} x x坐标。
+ *
+ * @return {uint32_t} 返回字符在字符串中的位置(总是簇的边界)。
+ */
+uint32_t text_run_hit_test(const text_run_t* run, int32_t x);
+
+/**
+ * @method text_run_deinit
+ * 释放text_run对象的资源。
+ *
+ * @param {text_run_t*} run text_run对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t text_run_deinit(text_run_t* run);
+
+/**
+ * @method font_get_text_run
+ * 获取排版好的文本。
+ *
+ * 每个字体缓存最近使用过的一些字符串的排版结果，重复绘制和测量同一字符串时不需要再逐个查找字模。
+ *
+ * > 返回的对象由字体管理，在下一次对该字体调用本函数之前有效。
+ *
+ * @param {font_t*} font 字体。
+ * @param {font_size_t} font_size 字体大小。
+ * @param {const wchar_t*} str 字符串。
+ * @param {uint32_t} nr 字符数。
+ *
+ * @return {const text_run_t*} 返回排版的结果。
+ */
+const text_run_t* font_get_text_run(font_t* font, font_size_t font_size, const wchar_t* str,
+                                    uint32_t nr);
+
+/*private*/
+ret_t text_run_cache_destroy(text_run_cache_t* cache);
+
+END_C_DECLS
+
+#endif /*TK_TEXT_RUN_H*/
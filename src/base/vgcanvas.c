@@ -148,6 +148,62 @@ ret_t vgcanvas_close_path(vgcanvas_t* vg) {
   return vg->vt->close_path(vg);
 }
 
+vgcanvas_path_t* vgcanvas_path_create(void) {
+  return TKMEM_ZALLOC(vgcanvas_path_t);
+}
+
+ret_t vgcanvas_path_reset(vgcanvas_path_t* path) {
+  return_value_if_fail(path != NULL, RET_BAD_PARAMS);
+
+  path->key_size = 0;
+
+  return RET_OK;
+}
+
+ret_t vgcanvas_path_destroy(vgcanvas_path_t* path) {
+  return_value_if_fail(path != NULL, RET_BAD_PARAMS);
+
+  if (path->impl != NULL && path->destroy_impl != NULL) {
+    path->destroy_impl(path->impl);
+  }
+  TKMEM_FREE(path);
+
+  return RET_OK;
+}
+
+ret_t vgcanvas_retain_path(vgcanvas_t* vg, vgcanvas_path_t* path, const void* key, uint32_t size) {
+  ret_t ret = RET_OK;
+  return_value_if_fail(vg != NULL && path != NULL && key != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(size > 0 && size <= sizeof(path->key), RET_BAD_PARAMS);
+
+  path->key_size = 0;
+  if (vg->vt->retain_path == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  ret = vg->vt->retain_path(vg, path);
+  if (ret == RET_OK) {
+    memcpy(path->key, key, size);
+    path->key_size = size;
+  }
+
+  return ret;
+}
+
+ret_t vgcanvas_reuse_path(vgcanvas_t* vg, vgcanvas_path_t* path, const void* key, uint32_t size) {
+  return_value_if_fail(vg != NULL && path != NULL && key != NULL, RET_BAD_PARAMS);
+
+  if (vg->vt->reuse_path == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  if (path->key_size != size || memcmp(path->key, key, size) != 0) {
+    return RET_NOT_FOUND;
+  }
+
+  return vg->vt->reuse_path(vg, path);
+}
+
 ret_t vgcanvas_transform(vgcanvas_t* vg, float_t a, float_t b, float_t c, float_t d, float_t e,
                          float_t f) {
   return_value_if_fail(vg != NULL && vg->vt->transform != NULL, RET_BAD_PARAMS);
@@ -433,6 +489,26 @@ ret_t vgcanvas_reinit(vgcanvas_t* vg, uint32_t w, uint32_t h, uint32_t stride,
   return RET_NOT_IMPL;
 }
 
+ret_t vgcanvas_set_render_threads(vgcanvas_t* vg, uint32_t threads) {
+  return_value_if_fail(vg != NULL, RET_BAD_PARAMS);
+
+  if (vg->vt->set_render_threads == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  return vg->vt->set_render_threads(vg, threads);
+}
+
+bool_t vgcanvas_is_rect_visible(vgcanvas_t* vg, float_t x, float_t y, float_t w, float_t h) {
+  return_value_if_fail(vg != NULL, FALSE);
+
+  if (vg->vt->is_rect_visible == NULL) {
+    return TRUE;
+  }
+
+  return vg->vt->is_rect_visible(vg, x, y, w, h);
+}
+
 vgcanvas_t* vgcanvas_cast(vgcanvas_t* vg) {
   return vg;
 }
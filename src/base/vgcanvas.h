@@ -40,6 +40,9 @@ typedef struct _framebuffer_object_t {
 struct _vgcanvas_t;
 typedef struct _vgcanvas_t vgcanvas_t;
 
+struct _vgcanvas_path_t;
+typedef struct _vgcanvas_path_t vgcanvas_path_t;
+
 typedef ret_t (*vgcanvas_reinit_t)(vgcanvas_t* vg, uint32_t w, uint32_t h, uint32_t stride,
                                    bitmap_format_t format, void* data);
 typedef ret_t (*vgcanvas_begin_frame_t)(vgcanvas_t* vg, rect_t* dirty_rect);
@@ -65,6 +68,8 @@ typedef ret_t (*vgcanvas_rounded_rect_t)(vgcanvas_t* vg, float_t x, float_t y, f
                                          float_t r);
 typedef ret_t (*vgcanvas_ellipse_t)(vgcanvas_t* vg, float_t x, float_t y, float_t rx, float_t ry);
 typedef ret_t (*vgcanvas_close_path_t)(vgcanvas_t* vg);
+typedef ret_t (*vgcanvas_retain_path_t)(vgcanvas_t* vg, vgcanvas_path_t* path);
+typedef ret_t (*vgcanvas_reuse_path_t)(vgcanvas_t* vg, vgcanvas_path_t* path);
 
 typedef ret_t (*vgcanvas_rotate_t)(vgcanvas_t* vg, float_t rad);
 typedef ret_t (*vgcanvas_scale_t)(vgcanvas_t* vg, float_t x, float_t y);
@@ -125,6 +130,10 @@ typedef ret_t (*vgcanvas_destroy_fbo_t)(vgcanvas_t* vg, framebuffer_object_t* fb
 typedef ret_t (*vgcanvas_bind_fbo_t)(vgcanvas_t* vg, framebuffer_object_t* fbo);
 typedef ret_t (*vgcanvas_unbind_fbo_t)(vgcanvas_t* vg, framebuffer_object_t* fbo);
 
+typedef ret_t (*vgcanvas_set_render_threads_t)(vgcanvas_t* vg, uint32_t threads);
+typedef bool_t (*vgcanvas_is_rect_visible_t)(vgcanvas_t* vg, float_t x, float_t y, float_t w,
+                                             float_t h);
+
 typedef ret_t (*vgcanvas_destroy_t)(vgcanvas_t* vg);
 
 typedef struct _vgcanvas_vtable_t {
@@ -146,6 +155,8 @@ typedef struct _vgcanvas_vtable_t {
   vgcanvas_ellipse_t ellipse;
   vgcanvas_rounded_rect_t rounded_rect;
   vgcanvas_close_path_t close_path;
+  vgcanvas_retain_path_t retain_path;
+  vgcanvas_reuse_path_t reuse_path;
 
   vgcanvas_scale_t scale;
   vgcanvas_rotate_t rotate;
@@ -189,6 +200,8 @@ typedef struct _vgcanvas_vtable_t {
   vgcanvas_destroy_fbo_t destroy_fbo;
   vgcanvas_bind_fbo_t bind_fbo;
   vgcanvas_unbind_fbo_t unbind_fbo;
+  vgcanvas_set_render_threads_t set_render_threads;
+  vgcanvas_is_rect_visible_t is_rect_visible;
 
   vgcanvas_destroy_t destroy;
 } vgcanvas_vtable_t;
@@ -358,6 +371,66 @@ struct _vgcanvas_t {
   const vgcanvas_vtable_t* vt;
 };
 
+#ifndef TK_VGCANVAS_PATH_KEY_SIZE
+#define TK_VGCANVAS_PATH_KEY_SIZE 32
+#endif /*TK_VGCANVAS_PATH_KEY_SIZE*/
+
+/**
+ * @class vgcanvas_path_t
+ * 缓存的路径。
+ *
+ * 保存路径在当前变换下细分(flatten)之后的顶点。控件每帧绘制相同的路径(如圆弧、圆角矩形和矢量图)时，
+ * 如果路径的参数(key)没有变化，而且变换只有平移发生了变化，直接平移缓存的顶点，不需要重新生成和细分曲线。
+ *
+ * 示例：
+ *
+ * ```c
+ *   vgcanvas_begin_path(vg);
+ *   if (vgcanvas_reuse_path(vg, path, &key, sizeof(key)) != RET_OK) {
+ *     vgcanvas_arc(vg, cx, cy, r, start, end, FALSE);
+ *     vgcanvas_retain_path(vg, path, &key, sizeof(key));
+ *   }
+ *   vgcanvas_stroke(vg);
+ * ```
+ */
+struct _vgcanvas_path_t {
+  /*private*/
+  void* impl;
+  tk_destroy_t destroy_impl;
+  uint32_t key_size;
+  uint8_t key[TK_VGCANVAS_PATH_KEY_SIZE];
+};
+
+/**
+ * @method vgcanvas_path_create
+ * 创建缓存的路径对象。
+ * @annotation ["constructor"]
+ *
+ * @return {vgcanvas_path_t*} 返回路径对象。
+ */
+vgcanvas_path_t* vgcanvas_path_create(void);
+
+/**
+ * @method vgcanvas_path_reset
+ * 清除缓存的内容，下次需要重新生成路径。
+ *
+ * @param {vgcanvas_path_t*} path 路径对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t vgcanvas_path_reset(vgcanvas_path_t* path);
+
+/**
+ * @method vgcanvas_path_destroy
+ * 销毁缓存的路径对象。
+ * @annotation ["deconstructor"]
+ *
+ * @param {vgcanvas_path_t*} path 路径对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t vgcanvas_path_destroy(vgcanvas_path_t* path);
+
 /**
  * @method vgcanvas_create
  * 创建vgcanvas。
@@ -399,6 +472,36 @@ vgcanvas_t* vgcanvas_cast(vgcanvas_t* vg);
 ret_t vgcanvas_reinit(vgcanvas_t* vg, uint32_t w, uint32_t h, uint32_t stride,
                       bitmap_format_t format, void* data);
 
+/**
+ * @method vgcanvas_set_render_threads
+ * 设置软件渲染时光栅化使用的线程数(包括调用者所在的线程)。
+ *
+ * 覆盖行数较多的填充和描边(如全屏的背景、渐变和SVG)，按扫描线分给多个线程渲染，结果与单线程渲染完全一致。
+ * 硬件渲染和不支持线程的平台返回RET_NOT_IMPL。
+ *
+ * @param {vgcanvas_t*} vg vgcanvas对象。
+ * @param {uint32_t} threads 线程数，0或1表示只在调用者所在的线程渲染。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t vgcanvas_set_render_threads(vgcanvas_t* vg, uint32_t threads);
+
+/**
+ * @method vgcanvas_is_rect_visible
+ * 判断矩形(当前变换下的坐标)是否可能在裁剪区之内。
+ *
+ * 用于在生成路径之前剔除裁剪区之外的图形。不支持时总是返回TRUE。
+ *
+ * @param {vgcanvas_t*} vg vgcanvas对象。
+ * @param {float_t} x x坐标。
+ * @param {float_t} y y坐标。
+ * @param {float_t} w 宽度。
+ * @param {float_t} h 高度。
+ *
+ * @return {bool_t} 返回FALSE表示矩形完全在裁剪区之外。
+ */
+bool_t vgcanvas_is_rect_visible(vgcanvas_t* vg, float_t x, float_t y, float_t w, float_t h);
+
 /**
  * @method vgcanvas_reset
  * 重置状态。
@@ -712,6 +815,34 @@ ret_t vgcanvas_set_transform(vgcanvas_t* vg, float_t a, float_t b, float_t c, fl
  */
 ret_t vgcanvas_clip_rect(vgcanvas_t* vg, float_t x, float_t y, float_t w, float_t h);
 
+/**
+ * @method vgcanvas_retain_path
+ * 把当前路径细分之后保存到path中，并记录生成路径的参数key。
+ * 需要在vgcanvas\_fill/vgcanvas\_stroke之前调用。
+ *
+ * @param {vgcanvas_t*} vg vgcanvas对象。
+ * @param {vgcanvas_path_t*} path 路径对象。
+ * @param {const void*} key 生成路径的参数(按字节比较，不能超过TK\_VGCANVAS\_PATH\_KEY\_SIZE)。
+ * @param {uint32_t} size key的长度。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，不支持时返回RET_NOT_IMPL。
+ */
+ret_t vgcanvas_retain_path(vgcanvas_t* vg, vgcanvas_path_t* path, const void* key, uint32_t size);
+
+/**
+ * @method vgcanvas_reuse_path
+ * 用缓存的路径替换当前路径。
+ * 只有key相同，并且当前的变换相对保存时只有平移发生了变化时才能重用，此时不需要再生成路径。
+ *
+ * @param {vgcanvas_t*} vg vgcanvas对象。
+ * @param {vgcanvas_path_t*} path 路径对象。
+ * @param {const void*} key 生成路径的参数。
+ * @param {uint32_t} size key的长度。
+ *
+ * @return {ret_t} 返回RET_OK表示重用成功，否则需要重新生成路径。
+ */
+ret_t vgcanvas_reuse_path(vgcanvas_t* vg, vgcanvas_path_t* path, const void* key, uint32_t size);
+
 /**
  * @method vgcanvas_fill
  * 填充多边形。
@@ -27,11 +27,13 @@
 #include "base/keys.h"
 #include "base/enums.h"
 #include "tkc/time_now.h"
+#include "tkc/perf_trace.h"
 #include "base/idle.h"
 #include "base/widget.h"
 #include "base/layout.h"
 #include "base/main_loop.h"
 #include "base/widget_pool.h"
+#include "base/widget_atoms.h"
 #include "base/system_info.h"
 #include "base/widget_vtable.h"
 #include "base/style_mutable.h"
@@ -79,6 +81,7 @@ ret_t widget_move(widget_t* widget, xy_t x, xy_t y) {
     widget_invalidate_force(widget, NULL);
     widget->x = x;
     widget->y = y;
+    widget->need_relayout = TRUE;
     widget_invalidate_force(widget, NULL);
 
     e.type = EVT_MOVE;
@@ -98,6 +101,7 @@ ret_t widget_resize(widget_t* widget, wh_t w, wh_t h) {
     widget_invalidate_force(widget, NULL);
     widget->w = w;
     widget->h = h;
+    widget->need_relayout = TRUE;
     widget_invalidate_force(widget, NULL);
     widget_set_need_relayout_children(widget);
 
@@ -120,6 +124,7 @@ ret_t widget_move_resize(widget_t* widget, xy_t x, xy_t y, wh_t w, wh_t h) {
     widget->y = y;
     widget->w = w;
     widget->h = h;
+    widget->need_relayout = TRUE;
     widget_invalidate_force(widget, NULL);
     widget_set_need_relayout_children(widget);
 
@@ -403,10 +408,22 @@ ret_t widget_set_enable(widget_t* widget, bool_t enable) {
   return RET_OK;
 }
 
+/*可见性和floating会影响父控件的children_layout。*/
+static ret_t widget_on_layout_attr_changed(widget_t* widget) {
+  if (widget->parent != NULL && widget->parent->children_layout != NULL) {
+    widget_set_need_relayout(widget);
+  }
+
+  return RET_OK;
+}
+
 ret_t widget_set_floating(widget_t* widget, bool_t floating) {
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
-  widget->floating = floating;
+  if (widget->floating != floating) {
+    widget->floating = floating;
+    widget_on_layout_attr_changed(widget);
+  }
 
   return RET_OK;
 }
@@ -522,7 +539,7 @@ ret_t widget_add_child(widget_t* widget, widget_t* child) {
 
   child->parent = widget;
   if (!widget_is_window_manager(widget)) {
-    widget_set_need_relayout_children(widget);
+    widget_set_need_relayout(child);
   }
 
   if (widget->children == NULL) {
@@ -548,7 +565,7 @@ ret_t widget_remove_child(widget_t* widget, widget_t* child) {
   return_value_if_fail(widget != NULL && child != NULL, RET_BAD_PARAMS);
 
   if (!widget_is_window_manager(widget)) {
-    widget_set_need_relayout_children(widget);
+    widget_set_need_relayout(child);
   }
 
   widget_invalidate_force(child, NULL);
@@ -703,6 +720,7 @@ static ret_t widget_set_visible_self(widget_t* widget, bool_t visible) {
     widget->visible = visible;
     widget_update_style(widget);
     widget_invalidate_force(widget, NULL);
+    widget_on_layout_attr_changed(widget);
   }
 
   return RET_OK;
@@ -729,6 +747,11 @@ static ret_t widget_set_visible_recursive(widget_t* widget, bool_t visible) {
 
 ret_t widget_set_visible(widget_t* widget, bool_t visible, bool_t recursive) {
   if (recursive) {
+    return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+    if (widget->visible != visible) {
+      widget_on_layout_attr_changed(widget);
+    }
+
     return widget_set_visible_recursive(widget, visible);
   } else {
     return widget_set_visible_self(widget, visible);
@@ -961,8 +984,12 @@ ret_t widget_fill_rect(widget_t* widget, canvas_t* c, rect_t* r, bool_t bg,
 
   if (image_name != NULL && r->w > 0 && r->h > 0) {
     if (widget_load_image(widget, image_name, &img) == RET_OK) {
+      image_quality_t quality = style_get_int(style, STYLE_ID_IMAGE_QUALITY, IMAGE_QUALITY_NEAREST);
+
       draw_type = (image_draw_type_t)style_get_int(style, draw_type_key, draw_type);
+      canvas_set_image_quality(c, quality);
       canvas_draw_image_ex(c, &img, draw_type, r);
+      canvas_set_image_quality(c, IMAGE_QUALITY_NEAREST);
     }
   }
 
@@ -1096,72 +1123,145 @@ ret_t widget_paint(widget_t* widget, canvas_t* c) {
     widget_layout_children(widget);
   }
 
+  PERF_TRACE_BEGIN("paint", widget->vt->type, widget->name);
   canvas_save(c);
   widget_paint_impl(widget, c);
   canvas_restore(c);
+  PERF_TRACE_END("paint", widget->vt->type);
 
   widget->dirty = FALSE;
 
   return RET_OK;
 }
 
-ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v) {
+/*先按原子调用set_prop_atom，不支持时再按名称调用set_prop*/
+static ret_t widget_vt_set_prop(widget_t* widget, atom_t atom, const char* name,
+                                const value_t* v) {
+  ret_t ret = RET_NOT_FOUND;
+
+  if (widget->vt->set_prop_atom != NULL && atom != ATOM_NONE) {
+    ret = widget->vt->set_prop_atom(widget, atom, v);
+  }
+
+  if (ret == RET_NOT_FOUND && widget->vt->set_prop != NULL) {
+    ret = widget->vt->set_prop(widget, name, v);
+  }
+
+  return ret;
+}
+
+static ret_t widget_vt_get_prop(widget_t* widget, atom_t atom, const char* name, value_t* v) {
+  ret_t ret = RET_NOT_FOUND;
+
+  if (widget->vt->get_prop_atom != NULL && atom != ATOM_NONE) {
+    ret = widget->vt->get_prop_atom(widget, atom, v);
+  }
+
+  if (ret == RET_NOT_FOUND && widget->vt->get_prop != NULL) {
+    ret = widget->vt->get_prop(widget, name, v);
+  }
+
+  return ret;
+}
+
+/*
+ * 在widget_atoms_init之前用atom_from_str创建的原子是动态原子，注册静态原子之后，
+ * 同一个名称对应静态原子，这里转换过来，否则switch匹配不到。
+ */
+static atom_t widget_atom_canonical(atom_t atom, const char* name) {
+  return atom < ATOM_STATIC_MAX ? atom : atom_find(name);
+}
+
+static ret_t widget_set_prop_impl(widget_t* widget, atom_t atom, const char* name,
+                                  const value_t* v) {
   ret_t ret = RET_OK;
   prop_change_event_t e;
-  return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
-  return_value_if_fail(widget->vt != NULL, RET_BAD_PARAMS);
 
   e.value = v;
   e.name = name;
   e.e = event_init(EVT_PROP_WILL_CHANGE, widget);
   widget_dispatch(widget, (event_t*)&e);
 
-  if (tk_str_eq(name, WIDGET_PROP_X)) {
-    widget->x = (wh_t)value_int(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_Y)) {
-    widget->y = (wh_t)value_int(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_W)) {
-    widget->w = (wh_t)value_int(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_H)) {
-    widget->h = (wh_t)value_int(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_OPACITY)) {
-    widget->opacity = (uint8_t)value_int(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_VISIBLE)) {
-    widget->visible = value_bool(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_SENSITIVE)) {
-    widget->sensitive = value_bool(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_FLOATING)) {
-    widget->floating = value_bool(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_STYLE)) {
-    const char* name = value_str(v);
-    return widget_use_style(widget, name);
-  } else if (tk_str_eq(name, WIDGET_PROP_ENABLE)) {
-    widget->enable = value_bool(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_NAME)) {
-    widget_set_name(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_TEXT)) {
-    wstr_from_value(&(widget->text), v);
-  } else if (tk_str_eq(name, WIDGET_PROP_TR_TEXT)) {
-    widget_set_tr_text(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_ANIMATION)) {
-    widget_set_animation(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_SELF_LAYOUT)) {
-    widget_set_self_layout(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_LAYOUT) || tk_str_eq(name, WIDGET_PROP_CHILDREN_LAYOUT)) {
-    widget_set_children_layout(widget, value_str(v));
-  } else {
-    ret = RET_NOT_FOUND;
+  switch (atom) {
+    case WIDGET_ATOM_X: {
+      widget->x = (wh_t)value_int(v);
+      break;
+    }
+    case WIDGET_ATOM_Y: {
+      widget->y = (wh_t)value_int(v);
+      break;
+    }
+    case WIDGET_ATOM_W: {
+      widget->w = (wh_t)value_int(v);
+      break;
+    }
+    case WIDGET_ATOM_H: {
+      widget->h = (wh_t)value_int(v);
+      break;
+    }
+    case WIDGET_ATOM_OPACITY: {
+      widget->opacity = (uint8_t)value_int(v);
+      break;
+    }
+    case WIDGET_ATOM_VISIBLE: {
+      widget->visible = value_bool(v);
+      break;
+    }
+    case WIDGET_ATOM_SENSITIVE: {
+      widget->sensitive = value_bool(v);
+      break;
+    }
+    case WIDGET_ATOM_FLOATING: {
+      widget->floating = value_bool(v);
+      break;
+    }
+    case WIDGET_ATOM_STYLE: {
+      return widget_use_style(widget, value_str(v));
+    }
+    case WIDGET_ATOM_ENABLE: {
+      widget->enable = value_bool(v);
+      break;
+    }
+    case WIDGET_ATOM_NAME: {
+      widget_set_name(widget, value_str(v));
+      break;
+    }
+    case WIDGET_ATOM_TEXT: {
+      wstr_from_value(&(widget->text), v);
+      break;
+    }
+    case WIDGET_ATOM_TR_TEXT: {
+      widget_set_tr_text(widget, value_str(v));
+      break;
+    }
+    case WIDGET_ATOM_ANIMATION: {
+      widget_set_animation(widget, value_str(v));
+      break;
+    }
+    case WIDGET_ATOM_SELF_LAYOUT: {
+      widget_set_self_layout(widget, value_str(v));
+      break;
+    }
+    case WIDGET_ATOM_LAYOUT:
+    case WIDGET_ATOM_CHILDREN_LAYOUT: {
+      widget_set_children_layout(widget, value_str(v));
+      break;
+    }
+    default: {
+      ret = RET_NOT_FOUND;
+      break;
+    }
   }
 
-  if (widget->vt->set_prop) {
-    ret_t ret1 = widget->vt->set_prop(widget, name, v);
+  if (widget->vt->set_prop != NULL || widget->vt->set_prop_atom != NULL) {
+    ret_t ret1 = widget_vt_set_prop(widget, atom, name, v);
     if (ret == RET_NOT_FOUND) {
       ret = ret1;
     }
   }
 
   if (ret == RET_NOT_FOUND) {
-    if (tk_str_eq(name, WIDGET_PROP_FOCUS)) {
+    if (atom == WIDGET_ATOM_FOCUS) {
       widget_set_focused(widget, value_bool(v));
       ret = RET_OK;
     } else if (tk_str_start_with(name, "style:")) {
@@ -1183,66 +1283,108 @@ ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v) {
   return ret;
 }
 
-ret_t widget_get_prop(widget_t* widget, const char* name, value_t* v) {
-  ret_t ret = RET_OK;
+ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v) {
   return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
   return_value_if_fail(widget->vt != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_X)) {
-    value_set_int32(v, widget->x);
-  } else if (tk_str_eq(name, WIDGET_PROP_Y)) {
-    value_set_int32(v, widget->y);
-  } else if (tk_str_eq(name, WIDGET_PROP_W)) {
-    value_set_int32(v, widget->w);
-  } else if (tk_str_eq(name, WIDGET_PROP_H)) {
-    value_set_int32(v, widget->h);
-  } else if (tk_str_eq(name, WIDGET_PROP_OPACITY)) {
-    value_set_int32(v, widget->opacity);
-  } else if (tk_str_eq(name, WIDGET_PROP_VISIBLE)) {
-    value_set_bool(v, widget->visible);
-  } else if (tk_str_eq(name, WIDGET_PROP_SENSITIVE)) {
-    value_set_bool(v, widget->sensitive);
-  } else if (tk_str_eq(name, WIDGET_PROP_FLOATING)) {
-    value_set_bool(v, widget->floating);
-  } else if (tk_str_eq(name, WIDGET_PROP_STYLE)) {
-    value_set_str(v, widget->style);
-  } else if (tk_str_eq(name, WIDGET_PROP_ENABLE)) {
-    value_set_bool(v, widget->enable);
-  } else if (tk_str_eq(name, WIDGET_PROP_NAME)) {
-    value_set_str(v, widget->name);
-  } else if (tk_str_eq(name, WIDGET_PROP_TEXT)) {
-    value_set_wstr(v, widget->text.str);
-  } else if (tk_str_eq(name, WIDGET_PROP_ANIMATION)) {
-    value_set_str(v, widget->animation);
-  } else if (tk_str_eq(name, WIDGET_PROP_SELF_LAYOUT)) {
-    if (widget->self_layout != NULL) {
-      value_set_str(v, self_layouter_to_string(widget->self_layout));
-    } else {
-      ret = RET_NOT_FOUND;
+  return widget_set_prop_impl(widget, widget_atom_find(name), name, v);
+}
+
+ret_t widget_set_prop_atom(widget_t* widget, atom_t atom, const value_t* v) {
+  const char* name = atom_to_str(atom);
+  return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(widget->vt != NULL, RET_BAD_PARAMS);
+
+  return widget_set_prop_impl(widget, widget_atom_canonical(atom, name), name, v);
+}
+
+static ret_t widget_get_prop_impl(widget_t* widget, atom_t atom, const char* name, value_t* v) {
+  ret_t ret = RET_OK;
+
+  switch (atom) {
+    case WIDGET_ATOM_X: {
+      value_set_int32(v, widget->x);
+      break;
     }
-  } else if (tk_str_eq(name, WIDGET_PROP_CHILDREN_LAYOUT)) {
-    if (widget->children_layout != NULL) {
-      value_set_str(v, children_layouter_to_string(widget->children_layout));
-    } else {
-      ret = RET_NOT_FOUND;
+    case WIDGET_ATOM_Y: {
+      value_set_int32(v, widget->y);
+      break;
     }
-  } else {
-    if (widget->vt->get_prop) {
-      ret = widget->vt->get_prop(widget, name, v);
-    } else {
-      ret = RET_NOT_FOUND;
+    case WIDGET_ATOM_W: {
+      value_set_int32(v, widget->w);
+      break;
+    }
+    case WIDGET_ATOM_H: {
+      value_set_int32(v, widget->h);
+      break;
+    }
+    case WIDGET_ATOM_OPACITY: {
+      value_set_int32(v, widget->opacity);
+      break;
+    }
+    case WIDGET_ATOM_VISIBLE: {
+      value_set_bool(v, widget->visible);
+      break;
+    }
+    case WIDGET_ATOM_SENSITIVE: {
+      value_set_bool(v, widget->sensitive);
+      break;
+    }
+    case WIDGET_ATOM_FLOATING: {
+      value_set_bool(v, widget->floating);
+      break;
+    }
+    case WIDGET_ATOM_STYLE: {
+      value_set_str(v, widget->style);
+      break;
+    }
+    case WIDGET_ATOM_ENABLE: {
+      value_set_bool(v, widget->enable);
+      break;
+    }
+    case WIDGET_ATOM_NAME: {
+      value_set_str(v, widget->name);
+      break;
+    }
+    case WIDGET_ATOM_TEXT: {
+      value_set_wstr(v, widget->text.str);
+      break;
+    }
+    case WIDGET_ATOM_ANIMATION: {
+      value_set_str(v, widget->animation);
+      break;
+    }
+    case WIDGET_ATOM_SELF_LAYOUT: {
+      if (widget->self_layout != NULL) {
+        value_set_str(v, self_layouter_to_string(widget->self_layout));
+      } else {
+        ret = RET_NOT_FOUND;
+      }
+      break;
+    }
+    case WIDGET_ATOM_CHILDREN_LAYOUT: {
+      if (widget->children_layout != NULL) {
+        value_set_str(v, children_layouter_to_string(widget->children_layout));
+      } else {
+        ret = RET_NOT_FOUND;
+      }
+      break;
+    }
+    default: {
+      ret = widget_vt_get_prop(widget, atom, name, v);
+      break;
     }
   }
 
   /*default*/
   if (ret == RET_NOT_FOUND) {
-    if (tk_str_eq(name, WIDGET_PROP_LAYOUT_W)) {
+    if (atom == WIDGET_ATOM_LAYOUT_W) {
       value_set_int32(v, widget->w);
       ret = RET_OK;
-    } else if (tk_str_eq(name, WIDGET_PROP_LAYOUT_H)) {
+    } else if (atom == WIDGET_ATOM_LAYOUT_H) {
       value_set_int32(v, widget->h);
       ret = RET_OK;
-    } else if (tk_str_eq(name, WIDGET_PROP_STATE_FOR_STYLE)) {
+    } else if (atom == WIDGET_ATOM_STATE_FOR_STYLE) {
       value_set_str(v, widget_get_state_for_style(widget, FALSE, FALSE));
       ret = RET_OK;
     }
@@ -1257,6 +1399,21 @@ ret_t widget_get_prop(widget_t* widget, const char* name, value_t* v) {
   return ret;
 }
 
+ret_t widget_get_prop(widget_t* widget, const char* name, value_t* v) {
+  return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(widget->vt != NULL, RET_BAD_PARAMS);
+
+  return widget_get_prop_impl(widget, widget_atom_find(name), name, v);
+}
+
+ret_t widget_get_prop_atom(widget_t* widget, atom_t atom, value_t* v) {
+  const char* name = atom_to_str(atom);
+  return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(widget->vt != NULL, RET_BAD_PARAMS);
+
+  return widget_get_prop_impl(widget, widget_atom_canonical(atom, name), name, v);
+}
+
 ret_t widget_set_prop_str(widget_t* widget, const char* name, const char* str) {
   value_t v;
   value_set_str(&v, str);
@@ -2091,6 +2248,8 @@ widget_t* widget_init(widget_t* widget, widget_t* parent, const widget_vtable_t*
   widget->h = h;
   widget->vt = vt;
   widget->dirty = TRUE;
+  widget->need_relayout = TRUE;
+  widget->need_relayout_children = TRUE;
   widget->opacity = 0xff;
   widget->enable = TRUE;
   widget->visible = TRUE;
@@ -2766,6 +2925,20 @@ ret_t widget_set_need_relayout_children(widget_t* widget) {
   return RET_OK;
 }
 
+ret_t widget_set_need_relayout(widget_t* widget) {
+  widget_t* iter = NULL;
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  /*上层控件只重新布局脏的子树，窗口由窗口管理器负责布局。*/
+  widget->need_relayout = TRUE;
+  for (iter = widget->parent; iter != NULL && !widget_is_window_manager(iter);
+       iter = iter->parent) {
+    iter->need_relayout_children = TRUE;
+  }
+
+  return RET_OK;
+}
+
 static ret_t widget_ensure_style_mutable(widget_t* widget) {
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
@@ -23,6 +23,7 @@
 #define TK_WIDGET_H
 
 #include "tkc/str.h"
+#include "tkc/atom.h"
 #include "tkc/mem.h"
 #include "tkc/wstr.h"
 #include "tkc/value.h"
@@ -69,6 +70,8 @@ typedef ret_t (*widget_on_layout_children_t)(widget_t* widget);
 typedef ret_t (*widget_get_prop_t)(widget_t* widget, const char* name, value_t* v);
 typedef ret_t (*widget_get_prop_default_value_t)(widget_t* widget, const char* name, value_t* v);
 typedef ret_t (*widget_set_prop_t)(widget_t* widget, const char* name, const value_t* v);
+typedef ret_t (*widget_get_prop_atom_t)(widget_t* widget, atom_t atom, value_t* v);
+typedef ret_t (*widget_set_prop_atom_t)(widget_t* widget, atom_t atom, const value_t* v);
 typedef widget_t* (*widget_find_target_t)(widget_t* widget, xy_t x, xy_t y);
 typedef widget_t* (*widget_create_t)(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h);
 typedef ret_t (*widget_on_destroy_t)(widget_t* widget);
@@ -140,6 +143,12 @@ struct _widget_vtable_t {
   widget_get_prop_t get_prop;
   widget_get_prop_default_value_t get_prop_default_value;
   widget_set_prop_t set_prop;
+  /**
+   * 按原子(WIDGET_ATOM_XXX)获取/设置属性(可选)。
+   * 不支持的属性返回RET_NOT_FOUND，然后再调用get_prop/set_prop。
+   */
+  widget_get_prop_atom_t get_prop_atom;
+  widget_set_prop_atom_t set_prop_atom;
   widget_on_keyup_t on_keyup;
   widget_on_keydown_t on_keydown;
   widget_on_paint_background_t on_paint_background;
@@ -321,6 +330,12 @@ struct _widget_t {
    * 标识控件是否需要重新layout子控件。
    */
   uint8_t need_relayout_children : 1;
+  /**
+   * @property {bool_t} need_relayout
+   * @annotation ["readable"]
+   * 标识控件自身是否需要重新layout(被移动/缩放过或者布局参数有变化)。
+   */
+  uint8_t need_relayout : 1;
   /**
    * @property {uint16_t} can_not_destroy
    * @annotation ["readable"]
@@ -417,6 +432,18 @@ struct _widget_t {
    * 控件布局器。请参考[控件布局参数](https://github.com/zlgopen/awtk/blob/master/docs/layout.md)
    */
   self_layouter_t* self_layout;
+  /**
+   * @property {wh_t} layout_w
+   * @annotation ["private"]
+   * 上次layout自身时可用区域的宽度。
+   */
+  wh_t layout_w;
+  /**
+   * @property {wh_t} layout_h
+   * @annotation ["private"]
+   * 上次layout自身时可用区域的高度。
+   */
+  wh_t layout_h;
   /**
    * @property {object_t*} custom_props
    * @annotation ["readable"]
@@ -1170,6 +1197,18 @@ ret_t widget_dispatch(widget_t* widget, event_t* e);
  */
 ret_t widget_get_prop(widget_t* widget, const char* name, value_t* v);
 
+/**
+ * @method widget_get_prop_atom
+ * 获取控件指定属性的值(用原子表示属性名，省去了字符串比较)。
+ * 原子可以用widget\_atom\_from\_str获取。
+ * @param {widget_t*} widget 控件对象。
+ * @param {atom_t} atom 属性名的原子。
+ * @param {value_t*} v 返回属性的值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_get_prop_atom(widget_t* widget, atom_t atom, value_t* v);
+
 /**
  * @method widget_get_prop_default_value
  * 获取控件指定属性的缺省值(在持久化控件时，无需保存缺省值)。
@@ -1192,6 +1231,18 @@ ret_t widget_get_prop_default_value(widget_t* widget, const char* name, value_t*
  */
 ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v);
 
+/**
+ * @method widget_set_prop_atom
+ * 设置控件指定属性的值(用原子表示属性名，省去了字符串比较)。
+ * 原子可以用widget\_atom\_from\_str获取，适合动画等需要反复设置同一属性的场景。
+ * @param {widget_t*} widget 控件对象。
+ * @param {atom_t} atom 属性名的原子。
+ * @param {value_t*} v 属性的值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_set_prop_atom(widget_t* widget, atom_t atom, const value_t* v);
+
 /**
  * @method widget_set_prop_str
  * 设置字符串格式的属性。
@@ -1831,6 +1882,8 @@ ret_t widget_update_style_recursive(widget_t* widget);
 /**
  * @method widget_layout
  * 布局当前控件及子控件。
+ *
+ * > 会遍历整个子树，可用区域、位置和布局参数都没有变化的控件跳过自身布局的计算。
  * @annotation ["scriptable"]
  * @param {widget_t*} widget widget对象。
  *
@@ -1945,6 +1998,7 @@ bool_t widget_is_instance_of(widget_t* widget, const widget_vtable_t* vt);
 TK_EXTERN_VTABLE(widget);
 
 ret_t widget_set_need_relayout_children(widget_t* widget);
+ret_t widget_set_need_relayout(widget_t* widget);
 ret_t widget_ensure_visible_in_viewport(widget_t* widget);
 
 /*public for test*/
@@ -41,6 +41,62 @@ ret_t widget_animator_manager_time_elapse(widget_animator_manager_t* am, uint32_
   return RET_OK;
 }
 
+ret_t widget_animator_manager_tick(widget_animator_manager_t* am, uint32_t now) {
+  uint32_t elapsed_time = 0;
+  return_value_if_fail(am != NULL, RET_BAD_PARAMS);
+
+  am->frame_clock = TRUE;
+  if (am->last_dispatch_time == 0) {
+    am->last_dispatch_time = now;
+  }
+
+  elapsed_time = now - am->last_dispatch_time;
+  if (elapsed_time == 0) {
+    return RET_OK;
+  }
+
+  /*只统计上一帧结束时仍在播放动画的时间段，空闲之后开始的动画不算丢帧*/
+  if (am->animating) {
+    am->frames++;
+    if (am->frame_period > 0) {
+      uint32_t nr = (elapsed_time + am->frame_period / 2) / am->frame_period;
+      if (nr > 1) {
+        am->dropped_frames += nr - 1;
+      }
+    }
+  }
+
+  am->last_dispatch_time = now;
+  widget_animator_manager_time_elapse(am, elapsed_time);
+  am->animating = widget_animator_manager_is_animating(am);
+
+  return RET_OK;
+}
+
+ret_t widget_animator_manager_set_frame_period(widget_animator_manager_t* am,
+                                               uint32_t frame_period) {
+  return_value_if_fail(am != NULL, RET_BAD_PARAMS);
+
+  am->frame_period = frame_period;
+
+  return RET_OK;
+}
+
+bool_t widget_animator_manager_is_animating(widget_animator_manager_t* am) {
+  widget_animator_t* iter = NULL;
+  return_value_if_fail(am != NULL, FALSE);
+
+  iter = am->first;
+  while (iter != NULL) {
+    if (iter->state == ANIMATOR_RUNNING) {
+      return TRUE;
+    }
+    iter = iter->next;
+  }
+
+  return FALSE;
+}
+
 widget_animator_manager_t* widget_animator_manager(void) {
   return s_animator_manager;
 }
@@ -62,6 +118,12 @@ static ret_t widget_animator_manager_on_timer(const timer_info_t* info) {
   uint32_t last_dispatch_time = am->last_dispatch_time ? am->last_dispatch_time : info->now;
   uint32_t elapsed_time = info->now - last_dispatch_time;
 
+  if (am->frame_clock) {
+    /*已经由帧时钟驱动，再用定时器更新会导致一帧内更新多次*/
+    am->timer_id = TK_INVALID_ID;
+    return RET_REMOVE;
+  }
+
   widget_animator_manager_time_elapse(am, elapsed_time);
 
   am->last_dispatch_time = info->now;
@@ -73,6 +135,7 @@ widget_animator_manager_t* widget_animator_manager_init(widget_animator_manager_
   return_value_if_fail(am != NULL, NULL);
 
   am->time_scale = 1;
+  am->frame_period = 1000 / TK_MAX_FPS;
   am->timer_id = timer_add(widget_animator_manager_on_timer, am, 1000 / 60);
 
   return am;
@@ -97,7 +160,10 @@ ret_t widget_animator_manager_reset(widget_animator_manager_t* am) {
 ret_t widget_animator_manager_deinit(widget_animator_manager_t* am) {
   return_value_if_fail(am != NULL, RET_BAD_PARAMS);
 
-  timer_remove(am->timer_id);
+  if (am->timer_id != TK_INVALID_ID) {
+    timer_remove(am->timer_id);
+    am->timer_id = TK_INVALID_ID;
+  }
 
   return RET_OK;
 }
@@ -37,9 +37,30 @@ struct _widget_animator_manager_t {
    */
   float_t time_scale;
 
+  /**
+   * @property {uint32_t} frame_period
+   * 帧周期(毫秒)，用于统计丢帧，缺省为1000/TK_MAX_FPS。
+   */
+  uint32_t frame_period;
+
+  /**
+   * @property {uint32_t} frames
+   * 有动画播放时帧时钟的帧数。
+   */
+  uint32_t frames;
+
+  /**
+   * @property {uint32_t} dropped_frames
+   * 有动画播放时丢掉的帧数(两次tick之间超过一个帧周期的部分)。
+   */
+  uint32_t dropped_frames;
+
   /*private*/
   uint32_t timer_id;
   uint32_t last_dispatch_time;
+  /*由帧时钟(widget_animator_manager_tick)驱动时，不再使用定时器*/
+  bool_t frame_clock;
+  bool_t animating;
   widget_animator_t* first;
 };
 
@@ -217,6 +238,40 @@ ret_t widget_animator_manager_set_time_scale(widget_animator_manager_t* am, widg
  */
 ret_t widget_animator_manager_time_elapse(widget_animator_manager_t* am, uint32_t delta_time);
 
+/**
+ * @method widget_animator_manager_tick
+ * 帧时钟。主循环在绘制之前调用，每帧只更新一次全部动画。
+ * 第一次调用之后，不再用定时器更新动画(没有调用本函数的主循环仍然由定时器驱动)。
+ *
+ * @param {widget_animator_manager_t*} am 控件动画管理器。
+ * @param {uint32_t} now 当前时间(毫秒)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_animator_manager_tick(widget_animator_manager_t* am, uint32_t now);
+
+/**
+ * @method widget_animator_manager_set_frame_period
+ * 设置帧周期(一般为显示器的刷新周期)，用于统计丢帧。
+ *
+ * @param {widget_animator_manager_t*} am 控件动画管理器。
+ * @param {uint32_t} frame_period 帧周期(毫秒)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_animator_manager_set_frame_period(widget_animator_manager_t* am,
+                                               uint32_t frame_period);
+
+/**
+ * @method widget_animator_manager_is_animating
+ * 是否有正在播放的动画。
+ *
+ * @param {widget_animator_manager_t*} am 控件动画管理器。
+ *
+ * @return {bool_t} 返回TRUE表示有正在播放的动画。
+ */
+bool_t widget_animator_manager_is_animating(widget_animator_manager_t* am);
+
 END_C_DECLS
 
 #endif /*TK_ANIMATOR_MANAGER_H*/
@@ -0,0 +1,79 @@
+/**
+ * File:   widget_atoms.c
+ * Author: AWTK Develop Team
+ * Brief:  atoms of widget property names
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#include "base/widget_atoms.h"
+
+static const char* s_widget_atoms[WIDGET_ATOM_NR] = {
+    NULL,
+    WIDGET_PROP_X,
+    WIDGET_PROP_Y,
+    WIDGET_PROP_W,
+    WIDGET_PROP_H,
+    WIDGET_PROP_OPACITY,
+    WIDGET_PROP_VISIBLE,
+    WIDGET_PROP_SENSITIVE,
+    WIDGET_PROP_FLOATING,
+    WIDGET_PROP_STYLE,
+    WIDGET_PROP_ENABLE,
+    WIDGET_PROP_NAME,
+    WIDGET_PROP_TEXT,
+    WIDGET_PROP_TR_TEXT,
+    WIDGET_PROP_ANIMATION,
+    WIDGET_PROP_SELF_LAYOUT,
+    WIDGET_PROP_LAYOUT,
+    WIDGET_PROP_CHILDREN_LAYOUT,
+    WIDGET_PROP_FOCUS,
+    WIDGET_PROP_LAYOUT_W,
+    WIDGET_PROP_LAYOUT_H,
+    WIDGET_PROP_STATE_FOR_STYLE,
+    WIDGET_PROP_VALUE,
+    WIDGET_PROP_XOFFSET,
+    WIDGET_PROP_YOFFSET,
+    WIDGET_PROP_SCALE_X,
+    WIDGET_PROP_SCALE_Y,
+    WIDGET_PROP_ROTATION,
+};
+
+ret_t widget_atoms_init(void) {
+  uint32_t i = 0;
+
+  if (atom_to_str(WIDGET_ATOM_NR - 1) != NULL) {
+    return RET_OK;
+  }
+
+  for (i = 1; i < WIDGET_ATOM_NR; i++) {
+    return_value_if_fail(atom_add_static(s_widget_atoms[i], i) == RET_OK, RET_FAIL);
+  }
+
+  return RET_OK;
+}
+
+atom_t widget_atom_find(const char* name) {
+  widget_atoms_init();
+
+  return atom_find(name);
+}
+
+atom_t widget_atom_from_str(const char* name) {
+  widget_atoms_init();
+
+  return atom_from_str(name);
+}
@@ -0,0 +1,105 @@
+/**
+ * File:   widget_atoms.h
+ * Author: AWTK Develop Team
+ * Brief:  atoms of widget property names
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_WIDGET_ATOMS_H
+#define TK_WIDGET_ATOMS_H
+
+#include "tkc/atom.h"
+#include "base/widget_consts.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @enum widget_atom_t
+ * @prefix WIDGET_ATOM_
+ * 常用控件属性名的静态原子，可以在switch语句中使用。
+ */
+typedef enum _widget_atom_t {
+  WIDGET_ATOM_NONE = ATOM_NONE,
+  WIDGET_ATOM_X,
+  WIDGET_ATOM_Y,
+  WIDGET_ATOM_W,
+  WIDGET_ATOM_H,
+  WIDGET_ATOM_OPACITY,
+  WIDGET_ATOM_VISIBLE,
+  WIDGET_ATOM_SENSITIVE,
+  WIDGET_ATOM_FLOATING,
+  WIDGET_ATOM_STYLE,
+  WIDGET_ATOM_ENABLE,
+  WIDGET_ATOM_NAME,
+  WIDGET_ATOM_TEXT,
+  WIDGET_ATOM_TR_TEXT,
+  WIDGET_ATOM_ANIMATION,
+  WIDGET_ATOM_SELF_LAYOUT,
+  WIDGET_ATOM_LAYOUT,
+  WIDGET_ATOM_CHILDREN_LAYOUT,
+  WIDGET_ATOM_FOCUS,
+  WIDGET_ATOM_LAYOUT_W,
+  WIDGET_ATOM_LAYOUT_H,
+  WIDGET_ATOM_STATE_FOR_STYLE,
+  WIDGET_ATOM_VALUE,
+  WIDGET_ATOM_XOFFSET,
+  WIDGET_ATOM_YOFFSET,
+  WIDGET_ATOM_SCALE_X,
+  WIDGET_ATOM_SCALE_Y,
+  WIDGET_ATOM_ROTATION,
+  WIDGET_ATOM_NR
+} widget_atom_t;
+
+/**
+ * @class widget_atoms_t
+ * @annotation ["fake"]
+ * 控件属性名的原子。
+ */
+
+/**
+ * @method widget_atoms_init
+ * 注册控件属性名的静态原子(可以重复调用)。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_atoms_init(void);
+
+/**
+ * @method widget_atom_find
+ * 查找属性名对应的原子(不存在时不会创建)。
+ * @annotation ["static"]
+ * @param {const char*} name 属性名。
+ *
+ * @return {atom_t} 返回原子，不存在返回ATOM_NONE。
+ */
+atom_t widget_atom_find(const char* name);
+
+/**
+ * @method widget_atom_from_str
+ * 获取属性名对应的原子，如果不存在则创建一个新的原子。
+ * 适用于需要反复设置同一属性的场景(如动画)，先获取原子，再调用widget\_set\_prop\_atom。
+ * @annotation ["static"]
+ * @param {const char*} name 属性名。
+ *
+ * @return {atom_t} 返回原子，失败返回ATOM_NONE。
+ */
+atom_t widget_atom_from_str(const char* name);
+
+END_C_DECLS
+
+#endif /*TK_WIDGET_ATOMS_H*/
@@ -146,6 +146,149 @@ static widget_t* window_manager_find_prev_window(widget_t* widget) {
   return NULL;
 }
 
+static ret_t window_manager_forget_snapshot(window_manager_t* wm, widget_t* win) {
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(wm->snapshots); i++) {
+    if (wm->snapshots[i].win == win) {
+      wm->snapshots[i].win = NULL;
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t window_manager_destroy_snapshots(window_manager_t* wm) {
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(wm->snapshots); i++) {
+    window_snapshot_t* iter = wm->snapshots + i;
+
+    if (iter->img.data != NULL) {
+      bitmap_destroy(&(iter->img));
+    }
+    memset(iter, 0x00, sizeof(window_snapshot_t));
+  }
+
+  return RET_OK;
+}
+
+#ifndef WITH_NANOVG_GPU
+static bool_t window_manager_is_widget_clean(widget_t* widget) {
+  /*没有self_layout的控件，need_relayout不会被清除*/
+  if (widget->dirty || widget->need_relayout_children ||
+      (widget->need_relayout && widget->self_layout != NULL)) {
+    return FALSE;
+  }
+
+  WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+  if (!window_manager_is_widget_clean(iter)) {
+    return FALSE;
+  }
+  WIDGET_FOR_EACH_CHILD_END();
+
+  return TRUE;
+}
+
+static ret_t window_manager_on_snapshot_destroy(bitmap_t* img) {
+  uint32_t i = 0;
+  window_manager_t* wm = WINDOW_MANAGER(window_manager());
+
+  if (wm == NULL || wm->widget.destroying) {
+    return RET_OK;
+  }
+
+  for (i = 0; i < ARRAY_SIZE(wm->snapshots); i++) {
+    window_snapshot_t* iter = wm->snapshots + i;
+
+    if (iter->in_use && iter->img.data == img->data) {
+      iter->in_use = FALSE;
+      break;
+    }
+  }
+
+  return RET_OK;
+}
+
+/*
+ * 从缓存中取一个快照并绑定到LCD上，窗口直接绘制到快照中，不需要分配内存和拷贝。
+ * win不为空且win的快照还有效时，cached为TRUE，不需要重新绘制win。
+ * 需要旋转或LCD不支持时返回NULL，使用lcd_take_snapshot。
+ */
+static window_snapshot_t* window_manager_bind_snapshot(window_manager_t* wm, widget_t* win,
+                                                       bool_t auto_rotate, bool_t* cached) {
+  uint32_t i = 0;
+  window_snapshot_t* s = NULL;
+  lcd_t* lcd = wm->canvas->lcd;
+
+  *cached = FALSE;
+  if (auto_rotate && system_info()->lcd_orientation != LCD_ORIENTATION_0) {
+    return NULL;
+  }
+
+  for (i = 0; i < ARRAY_SIZE(wm->snapshots) && win != NULL; i++) {
+    window_snapshot_t* iter = wm->snapshots + i;
+
+    if (!iter->in_use && iter->win == win && window_manager_is_widget_clean(win)) {
+      s = iter;
+      *cached = TRUE;
+      break;
+    }
+  }
+
+  /*优先使用没有缓存窗口的快照*/
+  for (i = 0; i < ARRAY_SIZE(wm->snapshots) && s == NULL; i++) {
+    window_snapshot_t* iter = wm->snapshots + i;
+
+    if (!iter->in_use && iter->img.data != NULL && iter->win == NULL) {
+      s = iter;
+    }
+  }
+
+  for (i = 0; i < ARRAY_SIZE(wm->snapshots) && s == NULL; i++) {
+    if (!wm->snapshots[i].in_use) {
+      s = wm->snapshots + i;
+    }
+  }
+
+  if (s == NULL) {
+    return NULL;
+  }
+
+  if (s->img.data == NULL || lcd_bind_snapshot(lcd, &(s->img)) != RET_OK) {
+    /*LCD的大小可能变了，重新分配*/
+    if (s->img.data != NULL) {
+      bitmap_destroy(&(s->img));
+      memset(&(s->img), 0x00, sizeof(bitmap_t));
+    }
+
+    *cached = FALSE;
+    if (lcd_bind_snapshot(lcd, &(s->img)) != RET_OK) {
+      return NULL;
+    }
+  }
+
+  if (!(*cached)) {
+    s->win = NULL;
+  }
+  s->in_use = TRUE;
+
+  return s;
+}
+
+static ret_t window_manager_unbind_snapshot(window_manager_t* wm, window_snapshot_t* s,
+                                            bitmap_t* img) {
+  lcd_bind_snapshot(wm->canvas->lcd, NULL);
+
+  *img = s->img;
+  img->destroy = window_manager_on_snapshot_destroy;
+  img->should_free_data = FALSE;
+  img->should_free_handle = FALSE;
+
+  return RET_OK;
+}
+#endif /*WITH_NANOVG_GPU*/
+
 ret_t window_manager_snap_curr_window(widget_t* widget, widget_t* curr_win, bitmap_t* img,
                                       framebuffer_object_t* fbo, bool_t auto_rotate) {
   canvas_t* c = NULL;
@@ -153,6 +296,8 @@ ret_t window_manager_snap_curr_window(widget_t* widget, widget_t* curr_win, bitm
   vgcanvas_t* vg = NULL;
 #else
   rect_t r = {0};
+  bool_t cached = FALSE;
+  window_snapshot_t* s = NULL;
 #endif /*WITH_NANOVG_GPU*/
 
   window_manager_t* wm = WINDOW_MANAGER(widget);
@@ -172,13 +317,19 @@ ret_t window_manager_snap_curr_window(widget_t* widget, widget_t* curr_win, bitm
   ENSURE(vgcanvas_unbind_fbo(vg, fbo) == RET_OK);
   fbo_to_img(fbo, img);
 #else
+  s = window_manager_bind_snapshot(wm, NULL, auto_rotate, &cached);
   r = rect_init(curr_win->x, curr_win->y, curr_win->w, curr_win->h);
   ENSURE(canvas_begin_frame(c, &r, LCD_DRAW_OFFLINE) == RET_OK);
   canvas_set_clip_rect(c, &r);
   ENSURE(widget_on_paint_background(widget, c) == RET_OK);
   ENSURE(widget_paint(curr_win, c) == RET_OK);
   ENSURE(canvas_end_frame(c) == RET_OK);
-  ENSURE(lcd_take_snapshot(c->lcd, img, auto_rotate) == RET_OK);
+
+  if (s != NULL) {
+    window_manager_unbind_snapshot(wm, s, img);
+  } else {
+    ENSURE(lcd_take_snapshot(c->lcd, img, auto_rotate) == RET_OK);
+  }
 #endif
 
   return RET_OK;
@@ -191,6 +342,8 @@ ret_t window_manager_snap_prev_window(widget_t* widget, widget_t* prev_win, bitm
   vgcanvas_t* vg = NULL;
 #else
   rect_t r = {0};
+  bool_t cached = FALSE;
+  window_snapshot_t* s = NULL;
 #endif /*WITH_NANOVG_GPU*/
 
   window_manager_t* wm = WINDOW_MANAGER(widget);
@@ -222,17 +375,41 @@ ret_t window_manager_snap_prev_window(widget_t* widget, widget_t* prev_win, bitm
   ENSURE(vgcanvas_unbind_fbo(vg, fbo) == RET_OK);
   fbo_to_img(fbo, img);
 #else
-  r = rect_init(prev_win->x, prev_win->y, prev_win->w, prev_win->h);
-  ENSURE(canvas_begin_frame(c, &r, LCD_DRAW_OFFLINE) == RET_OK);
-  canvas_set_clip_rect(c, &r);
-  ENSURE(widget_on_paint_background(widget, c) == RET_OK);
-  window_manager_paint_system_bar(widget, c);
-  ENSURE(widget_paint(prev_win, c) == RET_OK);
-  if (dialog_highlighter != NULL) {
-    dialog_highlighter_prepare(dialog_highlighter, c);
+  /*有高亮效果时，快照会被修改，不缓存*/
+  s = window_manager_bind_snapshot(wm, dialog_highlighter == NULL ? prev_win : NULL, auto_rotate,
+                                   &cached);
+  if (s == NULL) {
+    r = rect_init(prev_win->x, prev_win->y, prev_win->w, prev_win->h);
+  } else if (cached) {
+    /*窗口没有变化，只需要更新system_bar*/
+    widget_t* system_bar = wm->system_bar;
+    r = system_bar != NULL ? rect_init(system_bar->x, system_bar->y, system_bar->w, system_bar->h)
+                           : rect_init(0, 0, 0, 0);
+  } else {
+    /*快照的内存是重复使用的，窗口之外的区域也要绘制*/
+    r = rect_init(0, 0, widget->w, widget->h);
+  }
+
+  if (r.w > 0 && r.h > 0) {
+    ENSURE(canvas_begin_frame(c, &r, LCD_DRAW_OFFLINE) == RET_OK);
+    canvas_set_clip_rect(c, &r);
+    ENSURE(widget_on_paint_background(widget, c) == RET_OK);
+    window_manager_paint_system_bar(widget, c);
+    if (!cached) {
+      ENSURE(widget_paint(prev_win, c) == RET_OK);
+    }
+    if (dialog_highlighter != NULL) {
+      dialog_highlighter_prepare(dialog_highlighter, c);
+    }
+    ENSURE(canvas_end_frame(c) == RET_OK);
+  }
+
+  if (s != NULL) {
+    window_manager_unbind_snapshot(wm, s, img);
+    s->win = dialog_highlighter == NULL ? prev_win : NULL;
+  } else {
+    ENSURE(lcd_take_snapshot(c->lcd, img, auto_rotate) == RET_OK);
   }
-  ENSURE(canvas_end_frame(c) == RET_OK);
-  ENSURE(lcd_take_snapshot(c->lcd, img, auto_rotate) == RET_OK);
 #endif /*WITH_NANOVG_GPU*/
 
   if (dialog_highlighter != NULL) {
@@ -776,6 +953,7 @@ ret_t window_manager_on_paint_children(widget_t* widget, canvas_t* c) {
     WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
     if (i >= start && iter->visible) {
       if (is_normal_window(iter)) {
+        window_manager_forget_snapshot(wm, iter);
         widget_paint(iter, c);
 
         if (!has_fullscreen_win) {
@@ -807,6 +985,8 @@ ret_t window_manager_on_paint_children(widget_t* widget, canvas_t* c) {
 static ret_t wm_on_remove_child(widget_t* widget, widget_t* window) {
   widget_t* top = window_manager_get_top_main_window(widget);
 
+  window_manager_forget_snapshot(WINDOW_MANAGER(widget), window);
+
   if (top != NULL) {
     rect_t r;
     r = rect_init(window->x, window->y, window->w, window->h);
@@ -842,6 +1022,7 @@ static ret_t window_manager_on_destroy(widget_t* widget) {
   window_manager_t* wm = WINDOW_MANAGER(widget);
 
   TKMEM_FREE(wm->cursor);
+  window_manager_destroy_snapshots(wm);
 
   return RET_OK;
 }
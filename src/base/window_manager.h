@@ -30,6 +30,18 @@
 
 BEGIN_C_DECLS
 
+#ifndef TK_WINDOW_SNAPSHOTS_NR
+#define TK_WINDOW_SNAPSHOTS_NR 3
+#endif /*TK_WINDOW_SNAPSHOTS_NR*/
+
+/*窗口动画使用的快照，动画结束后保留下来，下次动画时重复使用*/
+typedef struct _window_snapshot_t {
+  bitmap_t img;
+  /*快照中的窗口，窗口没有变化时可以直接使用快照，不需要重新绘制*/
+  widget_t* win;
+  bool_t in_use;
+} window_snapshot_t;
+
 /**
  * @class window_manager_t
  * @parent widget_t
@@ -73,6 +85,8 @@ typedef struct _window_manager_t {
 
   dialog_highlighter_t* dialog_highlighter;
   widget_t* prev_win;
+
+  window_snapshot_t snapshots[TK_WINDOW_SNAPSHOTS_NR];
 } window_manager_t;
 
 /**
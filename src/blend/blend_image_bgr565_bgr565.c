@@ -18,7 +18,9 @@
  * 2018-10-10 Generated by gen.sh(DONT MODIFY IT)
  *
  */
+#include "tkc/mem.h"
 #include "tkc/rect.h"
+#include "tkc/matrix.h"
 #include "base/pixel.h"
 #include "base/bitmap.h"
 #include "base/pixel_pack_unpack.h"
@@ -72,3 +74,52 @@ ret_t blend_image_bgr565_bgr565(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rec
     return RET_OK;
   }
 }
+
+ret_t blend_image_bgr565_bgr565_smooth(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r,
+                                       rect_t* clip_r, uint8_t a) {
+  return_value_if_fail(dst != NULL && src != NULL && src_r != NULL && dst_r != NULL &&
+                           clip_r != NULL,
+                       RET_BAD_PARAMS);
+  return_value_if_fail(dst->format == BITMAP_FMT_BGR565 && src->format == BITMAP_FMT_BGR565,
+                       RET_BAD_PARAMS);
+
+  if (a > 0xf8) {
+    return blend_image_smooth(dst, src, dst_r, src_r, clip_r, 0xff);
+  } else if (a > 8) {
+    return blend_image_smooth(dst, src, dst_r, src_r, clip_r, a);
+  } else {
+    return RET_OK;
+  }
+}
+
+ret_t blend_image_bgr565_bgr565_transform(bitmap_t* dst, bitmap_t* src, rect_t* dst_r,
+                                          rect_t* src_r, const matrix_t* m, uint8_t a) {
+  return_value_if_fail(dst != NULL && src != NULL && src_r != NULL && dst_r != NULL && m != NULL,
+                       RET_BAD_PARAMS);
+  return_value_if_fail(dst->format == BITMAP_FMT_BGR565 && src->format == BITMAP_FMT_BGR565,
+                       RET_BAD_PARAMS);
+
+  if (a > 0xf8) {
+    return blend_image_transform(dst, src, dst_r, src_r, m, 0xff);
+  } else if (a > 8) {
+    return blend_image_transform(dst, src, dst_r, src_r, m, a);
+  } else {
+    return RET_OK;
+  }
+}
+
+ret_t blend_image_bgr565_bgr565_transform_smooth(bitmap_t* dst, bitmap_t* src, rect_t* dst_r,
+                                                 rect_t* src_r, const matrix_t* m, uint8_t a) {
+  return_value_if_fail(dst != NULL && src != NULL && src_r != NULL && dst_r != NULL && m != NULL,
+                       RET_BAD_PARAMS);
+  return_value_if_fail(dst->format == BITMAP_FMT_BGR565 && src->format == BITMAP_FMT_BGR565,
+                       RET_BAD_PARAMS);
+
+  if (a > 0xf8) {
+    return blend_image_transform_smooth(dst, src, dst_r, src_r, m, 0xff);
+  } else if (a > 8) {
+    return blend_image_transform_smooth(dst, src, dst_r, src_r, m, a);
+  } else {
+    return RET_OK;
+  }
+}
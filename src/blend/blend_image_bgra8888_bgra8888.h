@@ -21,9 +21,19 @@
 #ifndef TK_BLEND_IMAGE_BGRA8888_BGRA8888_H
 #define TK_BLEND_IMAGE_BGRA8888_BGRA8888_H
 
+#include "tkc/matrix.h"
 #include "base/bitmap.h"
 
 ret_t blend_image_bgra8888_bgra8888(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r,
                                     uint8_t a);
 
+ret_t blend_image_bgra8888_bgra8888_smooth(bitmap_t* dst, bitmap_t* src, rect_t* dst_r,
+                                           rect_t* src_r, rect_t* clip_r, uint8_t a);
+
+ret_t blend_image_bgra8888_bgra8888_transform(bitmap_t* dst, bitmap_t* src, rect_t* dst_r,
+                                              rect_t* src_r, const matrix_t* m, uint8_t a);
+
+ret_t blend_image_bgra8888_bgra8888_transform_smooth(bitmap_t* dst, bitmap_t* src, rect_t* dst_r,
+                                                     rect_t* src_r, const matrix_t* m, uint8_t a);
+
 #endif /*TK_BLEND_IMAGE_BGRA8888_BGRA8888_H*/
@@ -78,3 +78,41 @@ ret_t image_blend(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r,
 
   return soft_blend_image(dst, src, dst_r, src_r, global_alpha);
 }
+
+ret_t image_blend_ex(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r,
+                     uint8_t global_alpha, image_quality_t quality) {
+  return_value_if_fail(dst != NULL && src != NULL && dst_r != NULL && src_r != NULL,
+                       RET_BAD_PARAMS);
+
+  if (quality == IMAGE_QUALITY_NEAREST || (dst_r->w == src_r->w && dst_r->h == src_r->h)) {
+    return image_blend(dst, src, dst_r, src_r, global_alpha);
+  }
+
+  return soft_blend_image_ex(dst, src, dst_r, src_r, global_alpha, quality);
+}
+
+ret_t image_blend_smooth(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r, rect_t* clip,
+                         uint8_t global_alpha) {
+  return_value_if_fail(dst != NULL && src != NULL && dst_r != NULL && src_r != NULL && clip != NULL,
+                       RET_BAD_PARAMS);
+
+  if (dst_r->w == src_r->w && dst_r->h == src_r->h) {
+    /*没有缩放，裁剪后直接混合。*/
+    rect_t d = rect_intersect(dst_r, clip);
+    rect_t s = rect_init(src_r->x + d.x - dst_r->x, src_r->y + d.y - dst_r->y, d.w, d.h);
+
+    return (d.w > 0 && d.h > 0) ? image_blend(dst, src, &d, &s, global_alpha) : RET_OK;
+  }
+
+  return soft_blend_image_smooth(dst, src, dst_r, src_r, clip, global_alpha);
+}
+
+ret_t image_blend_transform(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r,
+                            rect_t* clip, matrix_t* matrix, uint8_t global_alpha,
+                            image_quality_t quality) {
+  return_value_if_fail(dst != NULL && src != NULL && dst_r != NULL && src_r != NULL &&
+                           clip != NULL && matrix != NULL,
+                       RET_BAD_PARAMS);
+
+  return soft_blend_image_transform(dst, src, dst_r, src_r, clip, matrix, global_alpha, quality);
+}
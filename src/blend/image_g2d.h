@@ -23,6 +23,7 @@
 #define TK_IMAGE_G2D_H
 
 #include "tkc/rect.h"
+#include "tkc/matrix.h"
 #include "base/bitmap.h"
 
 BEGIN_C_DECLS
@@ -32,6 +33,13 @@ ret_t image_clear(bitmap_t* dst, rect_t* dst_r, color_t c);
 ret_t image_copy(bitmap_t* dst, bitmap_t* src, rect_t* src_r, xy_t dx, xy_t dy);
 ret_t image_rotate(bitmap_t* dst, bitmap_t* src, rect_t* src_r, lcd_orientation_t o);
 ret_t image_blend(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r, uint8_t global_alpha);
+ret_t image_blend_ex(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r,
+                     uint8_t global_alpha, image_quality_t quality);
+ret_t image_blend_smooth(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r, rect_t* clip,
+                         uint8_t global_alpha);
+ret_t image_blend_transform(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r,
+                            rect_t* clip, matrix_t* matrix, uint8_t global_alpha,
+                            image_quality_t quality);
 
 END_C_DECLS
 
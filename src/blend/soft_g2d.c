@@ -183,25 +183,216 @@ ret_t soft_rotate_image(bitmap_t* dst, bitmap_t* src, rect_t* src_r, lcd_orienta
   return RET_NOT_IMPL;
 }
 
-ret_t soft_blend_image(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r, uint8_t alpha) {
-  return_value_if_fail(dst != NULL && src != NULL && src_r != NULL && dst_r != NULL,
-                       RET_BAD_PARAMS);
+#define BLEND_IMAGE(name)                                        \
+  (smooth ? name##_smooth(dst, src, dst_r, src_r, clip_r, alpha) \
+          : name(dst, src, dst_r, src_r, alpha))
 
+/*平滑缩放时dst_r/src_r是完整的映射关系，只输出clip_r内的部分。*/
+static ret_t soft_blend_image_impl(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r,
+                                   rect_t* clip_r, uint8_t alpha, bool_t smooth) {
   switch (dst->format) {
     case BITMAP_FMT_BGR565: {
       switch (src->format) {
         case BITMAP_FMT_BGR565: {
-          if (dst_r->w == src_r->w && dst_r->h == src_r->h && alpha > 0xf8) {
+          if (!smooth && dst_r->w == src_r->w && dst_r->h == src_r->h && alpha > 0xf8) {
             return soft_copy_image(dst, src, src_r, dst_r->x, dst_r->y);
           } else {
-            return blend_image_bgr565_bgr565(dst, src, dst_r, src_r, alpha);
+            return BLEND_IMAGE(blend_image_bgr565_bgr565);
           }
         }
         case BITMAP_FMT_RGBA8888: {
-          return blend_image_bgr565_rgba8888(dst, src, dst_r, src_r, alpha);
+          return BLEND_IMAGE(blend_image_bgr565_rgba8888);
+        }
+        case BITMAP_FMT_BGRA8888: {
+          return BLEND_IMAGE(blend_image_bgr565_bgra8888);
+        }
+        default:
+          break;
+      }
+      break;
+    }
+    case BITMAP_FMT_RGB565: {
+      switch (src->format) {
+        case BITMAP_FMT_BGR565: {
+          return BLEND_IMAGE(blend_image_rgb565_bgr565);
+        }
+        case BITMAP_FMT_RGBA8888: {
+          return BLEND_IMAGE(blend_image_rgb565_rgba8888);
+        }
+        case BITMAP_FMT_BGRA8888: {
+          return BLEND_IMAGE(blend_image_rgb565_bgra8888);
+        }
+        default:
+          break;
+      }
+      break;
+    }
+    case BITMAP_FMT_BGR888: {
+      switch (src->format) {
+        case BITMAP_FMT_BGR565: {
+          return BLEND_IMAGE(blend_image_bgr888_bgr565);
+        }
+        case BITMAP_FMT_RGBA8888: {
+          return BLEND_IMAGE(blend_image_bgr888_rgba8888);
+        }
+        case BITMAP_FMT_BGRA8888: {
+          return BLEND_IMAGE(blend_image_bgr888_bgra8888);
+        }
+        default:
+          break;
+      }
+      break;
+    }
+    case BITMAP_FMT_BGRA8888: {
+      switch (src->format) {
+        case BITMAP_FMT_BGR565: {
+          return BLEND_IMAGE(blend_image_bgra8888_bgr565);
+        }
+        case BITMAP_FMT_RGBA8888: {
+          return BLEND_IMAGE(blend_image_bgra8888_rgba8888);
+        }
+        case BITMAP_FMT_BGRA8888: {
+          return BLEND_IMAGE(blend_image_bgra8888_bgra8888);
+        }
+        default:
+          break;
+      }
+      break;
+    }
+    case BITMAP_FMT_RGBA8888: {
+      switch (src->format) {
+        case BITMAP_FMT_BGR565: {
+          return BLEND_IMAGE(blend_image_rgba8888_bgr565);
+        }
+        case BITMAP_FMT_RGBA8888: {
+          return BLEND_IMAGE(blend_image_rgba8888_rgba8888);
+        }
+        case BITMAP_FMT_BGRA8888: {
+          return BLEND_IMAGE(blend_image_rgba8888_bgra8888);
+        }
+        default:
+          break;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  return RET_NOT_IMPL;
+}
+
+ret_t soft_blend_image_ex(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r,
+                          uint8_t alpha, image_quality_t quality) {
+  bool_t smooth = FALSE;
+  return_value_if_fail(dst != NULL && src != NULL && src_r != NULL && dst_r != NULL,
+                       RET_BAD_PARAMS);
+
+  /*只有缩放时才需要平滑处理。*/
+  smooth = quality == IMAGE_QUALITY_SMOOTH && (dst_r->w != src_r->w || dst_r->h != src_r->h);
+
+  return soft_blend_image_impl(dst, src, dst_r, src_r, dst_r, alpha, smooth);
+}
+
+ret_t soft_blend_image_smooth(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r,
+                              rect_t* clip, uint8_t alpha) {
+  return_value_if_fail(dst != NULL && src != NULL && src_r != NULL && dst_r != NULL && clip != NULL,
+                       RET_BAD_PARAMS);
+
+  return soft_blend_image_impl(dst, src, dst_r, src_r, clip, alpha, TRUE);
+}
+
+ret_t soft_blend_image(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r, uint8_t alpha) {
+  return soft_blend_image_ex(dst, src, dst_r, src_r, alpha, IMAGE_QUALITY_NEAREST);
+}
+
+/*把源图片的四个角变换到目标图片上，求出需要处理的区域。*/
+static rect_t soft_transform_bounds(matrix_t* m, rect_t* src_r) {
+  uint32_t i = 0;
+  float_t x0 = 0;
+  float_t y0 = 0;
+  float_t x1 = 0;
+  float_t y1 = 0;
+  float_t xs[4] = {src_r->x, src_r->x + src_r->w, src_r->x, src_r->x + src_r->w};
+  float_t ys[4] = {src_r->y, src_r->y, src_r->y + src_r->h, src_r->y + src_r->h};
+
+  for (i = 0; i < 4; i++) {
+    float_t x = m->a0 * xs[i] + m->a2 * ys[i] + m->a4;
+    float_t y = m->a1 * xs[i] + m->a3 * ys[i] + m->a5;
+
+    if (i == 0) {
+      x0 = x1 = x;
+      y0 = y1 = y;
+    } else {
+      x0 = tk_min(x0, x);
+      y0 = tk_min(y0, y);
+      x1 = tk_max(x1, x);
+      y1 = tk_max(y1, y);
+    }
+  }
+
+  x0 = tk_max(x0, -0x7fff);
+  y0 = tk_max(y0, -0x7fff);
+  x1 = tk_min(x1, 0x7fff);
+  y1 = tk_min(y1, 0x7fff);
+
+  return rect_init((xy_t)floorf(x0), (xy_t)floorf(y0), (wh_t)(ceilf(x1) - floorf(x0)),
+                   (wh_t)(ceilf(y1) - floorf(y0)));
+}
+
+/*只有缩放和旋转90度的整数倍时，最近邻取样才不会在边缘产生锯齿。*/
+static bool_t soft_matrix_is_axis_aligned(const matrix_t* m) {
+  return (tk_abs(m->a1) < 1e-6f && tk_abs(m->a2) < 1e-6f) ||
+         (tk_abs(m->a0) < 1e-6f && tk_abs(m->a3) < 1e-6f);
+}
+
+#define BLEND_IMAGE_TRANSFORM(name)                                 \
+  (smooth ? name##_transform_smooth(dst, src, &r, src_r, &m, alpha) \
+          : name##_transform(dst, src, &r, src_r, &m, alpha))
+
+ret_t soft_blend_image_transform(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r,
+                                 rect_t* clip, matrix_t* matrix, uint8_t alpha,
+                                 image_quality_t quality) {
+  rect_t r;
+  matrix_t m;
+  rect_t dst_all;
+  bool_t smooth = FALSE;
+  return_value_if_fail(dst != NULL && src != NULL && src_r != NULL && dst_r != NULL &&
+                           clip != NULL && matrix != NULL,
+                       RET_BAD_PARAMS);
+
+  if (src_r->w <= 0 || src_r->h <= 0 || dst_r->w <= 0 || dst_r->h <= 0) {
+    return RET_OK;
+  }
+
+  /*先把src_r映射到dst_r，再用matrix变换。*/
+  m = *matrix;
+  matrix_translate(&m, dst_r->x, dst_r->y);
+  matrix_scale(&m, (float_t)(dst_r->w) / src_r->w, (float_t)(dst_r->h) / src_r->h);
+  matrix_translate(&m, -src_r->x, -src_r->y);
+
+  dst_all = rect_init(0, 0, dst->w, dst->h);
+  r = soft_transform_bounds(&m, src_r);
+  r = rect_intersect(&r, clip);
+  r = rect_intersect(&r, &dst_all);
+  if (r.w <= 0 || r.h <= 0 || matrix_invert(&m) == NULL) {
+    return RET_OK;
+  }
+
+  /*任意角度的旋转和斜切总是使用双线性取样，边缘反走样。*/
+  smooth = quality == IMAGE_QUALITY_SMOOTH || !soft_matrix_is_axis_aligned(&m);
+
+  switch (dst->format) {
+    case BITMAP_FMT_BGR565: {
+      switch (src->format) {
+        case BITMAP_FMT_BGR565: {
+          return BLEND_IMAGE_TRANSFORM(blend_image_bgr565_bgr565);
+        }
+        case BITMAP_FMT_RGBA8888: {
+          return BLEND_IMAGE_TRANSFORM(blend_image_bgr565_rgba8888);
         }
         case BITMAP_FMT_BGRA8888: {
-          return blend_image_bgr565_bgra8888(dst, src, dst_r, src_r, alpha);
+          return BLEND_IMAGE_TRANSFORM(blend_image_bgr565_bgra8888);
         }
         default:
           break;
@@ -211,13 +402,13 @@ ret_t soft_blend_image(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_
     case BITMAP_FMT_RGB565: {
       switch (src->format) {
         case BITMAP_FMT_BGR565: {
-          return blend_image_rgb565_bgr565(dst, src, dst_r, src_r, alpha);
+          return BLEND_IMAGE_TRANSFORM(blend_image_rgb565_bgr565);
         }
         case BITMAP_FMT_RGBA8888: {
-          return blend_image_rgb565_rgba8888(dst, src, dst_r, src_r, alpha);
+          return BLEND_IMAGE_TRANSFORM(blend_image_rgb565_rgba8888);
         }
         case BITMAP_FMT_BGRA8888: {
-          return blend_image_rgb565_bgra8888(dst, src, dst_r, src_r, alpha);
+          return BLEND_IMAGE_TRANSFORM(blend_image_rgb565_bgra8888);
         }
         default:
           break;
@@ -227,13 +418,13 @@ ret_t soft_blend_image(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_
     case BITMAP_FMT_BGR888: {
       switch (src->format) {
         case BITMAP_FMT_BGR565: {
-          return blend_image_bgr888_bgr565(dst, src, dst_r, src_r, alpha);
+          return BLEND_IMAGE_TRANSFORM(blend_image_bgr888_bgr565);
         }
         case BITMAP_FMT_RGBA8888: {
-          return blend_image_bgr888_rgba8888(dst, src, dst_r, src_r, alpha);
+          return BLEND_IMAGE_TRANSFORM(blend_image_bgr888_rgba8888);
         }
         case BITMAP_FMT_BGRA8888: {
-          return blend_image_bgr888_bgra8888(dst, src, dst_r, src_r, alpha);
+          return BLEND_IMAGE_TRANSFORM(blend_image_bgr888_bgra8888);
         }
         default:
           break;
@@ -243,13 +434,13 @@ ret_t soft_blend_image(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_
     case BITMAP_FMT_BGRA8888: {
       switch (src->format) {
         case BITMAP_FMT_BGR565: {
-          return blend_image_bgra8888_bgr565(dst, src, dst_r, src_r, alpha);
+          return BLEND_IMAGE_TRANSFORM(blend_image_bgra8888_bgr565);
         }
         case BITMAP_FMT_RGBA8888: {
-          return blend_image_bgra8888_rgba8888(dst, src, dst_r, src_r, alpha);
+          return BLEND_IMAGE_TRANSFORM(blend_image_bgra8888_rgba8888);
         }
         case BITMAP_FMT_BGRA8888: {
-          return blend_image_bgra8888_bgra8888(dst, src, dst_r, src_r, alpha);
+          return BLEND_IMAGE_TRANSFORM(blend_image_bgra8888_bgra8888);
         }
         default:
           break;
@@ -259,13 +450,13 @@ ret_t soft_blend_image(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_
     case BITMAP_FMT_RGBA8888: {
       switch (src->format) {
         case BITMAP_FMT_BGR565: {
-          return blend_image_rgba8888_bgr565(dst, src, dst_r, src_r, alpha);
+          return BLEND_IMAGE_TRANSFORM(blend_image_rgba8888_bgr565);
         }
         case BITMAP_FMT_RGBA8888: {
-          return blend_image_rgba8888_rgba8888(dst, src, dst_r, src_r, alpha);
+          return BLEND_IMAGE_TRANSFORM(blend_image_rgba8888_rgba8888);
         }
         case BITMAP_FMT_BGRA8888: {
-          return blend_image_rgba8888_bgra8888(dst, src, dst_r, src_r, alpha);
+          return BLEND_IMAGE_TRANSFORM(blend_image_rgba8888_bgra8888);
         }
         default:
           break;
@@ -23,6 +23,7 @@
 #define TK_SOFT_G2D_H
 
 #include "tkc/rect.h"
+#include "tkc/matrix.h"
 #include "base/bitmap.h"
 
 BEGIN_C_DECLS
@@ -33,6 +34,13 @@ ret_t soft_copy_image(bitmap_t* dst, bitmap_t* src, rect_t* src_r, xy_t dx, xy_t
 ret_t soft_rotate_image(bitmap_t* dst, bitmap_t* src, rect_t* src_r, lcd_orientation_t o);
 ret_t soft_blend_image(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r,
                        uint8_t global_alpha);
+ret_t soft_blend_image_ex(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r,
+                          uint8_t global_alpha, image_quality_t quality);
+ret_t soft_blend_image_smooth(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r,
+                              rect_t* clip, uint8_t global_alpha);
+ret_t soft_blend_image_transform(bitmap_t* dst, bitmap_t* src, rect_t* dst_r, rect_t* src_r,
+                                 rect_t* clip, matrix_t* matrix, uint8_t global_alpha,
+                                 image_quality_t quality);
 
 END_C_DECLS
 
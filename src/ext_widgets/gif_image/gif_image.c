@@ -68,13 +68,11 @@ static ret_t gif_image_on_paint_self(widget_t* widget, canvas_t* c) {
   rect_t src;
   rect_t dst;
   bitmap_t bitmap;
-  vgcanvas_t* vg = NULL;
   gif_image_t* image = GIF_IMAGE(widget);
   image_base_t* image_base = IMAGE_BASE(widget);
   return_value_if_fail(image_base != NULL && image != NULL && widget != NULL && c != NULL,
                        RET_BAD_PARAMS);
 
-  vg = lcd_get_vgcanvas(c->lcd);
   if (image_base->image == NULL) {
     return RET_OK;
   }
@@ -97,18 +95,11 @@ static ret_t gif_image_on_paint_self(widget_t* widget, canvas_t* c) {
   h = bitmap.gif_frame_h;
   y = bitmap.gif_frame_h * image->index;
 
-  if (vg != NULL) {
-    if (image_need_transform(widget)) {
-      vgcanvas_save(vg);
-      image_transform(widget, c);
-      vgcanvas_draw_icon(vg, &bitmap, 0, y, bitmap.w, h, 0, 0, widget->w, widget->h);
-      vgcanvas_restore(vg);
-
-      return RET_OK;
-    }
+  src = rect_init(0, y, bitmap.w, h);
+  if (image_need_transform(widget) && image_transform_draw(widget, c, &bitmap, &src) == RET_OK) {
+    return RET_OK;
   }
 
-  src = rect_init(0, y, bitmap.w, h);
   dst = rect_init(0, 0, widget->w, widget->h);
   canvas_draw_image_scale_down(c, &bitmap, &src, &dst);
 
@@ -153,7 +144,9 @@ TK_DECL_VTABLE(gif_image) = {.size = sizeof(gif_image_t),
                              .on_paint_self = gif_image_on_paint_self,
                              .on_paint_background = widget_on_paint_null,
                              .set_prop = image_base_set_prop,
-                             .get_prop = image_base_get_prop};
+                             .get_prop = image_base_get_prop,
+                             .set_prop_atom = image_base_set_prop_atom,
+                             .get_prop_atom = image_base_get_prop_atom};
 
 widget_t* gif_image_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
   widget_t* widget = widget_create(parent, TK_REF_VTABLE(gif_image), x, y, w, h);
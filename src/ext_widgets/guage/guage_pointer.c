@@ -23,6 +23,7 @@
 #include "tkc/utils.h"
 #include "tkc/matrix.h"
 #include "svg/bsvg_draw.h"
+#include "base/widget_atoms.h"
 #include "base/widget_vtable.h"
 #include "guage/guage_pointer.h"
 #include "base/image_manager.h"
@@ -179,6 +180,36 @@ static ret_t guage_pointer_set_prop(widget_t* widget, const char* name, const va
   return RET_NOT_FOUND;
 }
 
+static ret_t guage_pointer_get_prop_atom(widget_t* widget, atom_t atom, value_t* v) {
+  guage_pointer_t* guage_pointer = GUAGE_POINTER(widget);
+  return_value_if_fail(guage_pointer != NULL && v != NULL, RET_BAD_PARAMS);
+
+  switch (atom) {
+    case WIDGET_ATOM_VALUE: {
+      value_set_int(v, guage_pointer->angle);
+      return RET_OK;
+    }
+    default:
+      break;
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static ret_t guage_pointer_set_prop_atom(widget_t* widget, atom_t atom, const value_t* v) {
+  return_value_if_fail(widget != NULL && v != NULL, RET_BAD_PARAMS);
+
+  switch (atom) {
+    case WIDGET_ATOM_VALUE: {
+      return guage_pointer_set_angle(widget, value_int(v));
+    }
+    default:
+      break;
+  }
+
+  return RET_NOT_FOUND;
+}
+
 static ret_t guage_pointer_on_destroy(widget_t* widget) {
   guage_pointer_t* guage_pointer = GUAGE_POINTER(widget);
   return_value_if_fail(widget != NULL && guage_pointer != NULL, RET_BAD_PARAMS);
@@ -230,6 +261,21 @@ static ret_t guage_pointer_on_paint_self(widget_t* widget, canvas_t* c) {
 
   rotation = TK_D2R(guage_pointer->angle);
 
+  /*图片指针直接由LCD做仿射变换(如lcd_mem)，不需要经过vgcanvas。*/
+  if (guage_pointer->bsvg_asset == NULL && guage_pointer->image != NULL &&
+      widget_load_image(widget, guage_pointer->image, &bitmap) == RET_OK) {
+    matrix_t m;
+    matrix_t t;
+
+    matrix_init(&m);
+    matrix_multiply(&m, matrix_set(&t, 1, 0, 0, 1, c->ox + anchor_x, c->oy + anchor_y));
+    matrix_rotate(&m, rotation);
+    matrix_multiply(&m, matrix_set(&t, 1, 0, 0, 1, -anchor_x, -anchor_y));
+    if (canvas_draw_image_matrix(c, &bitmap, &m) != RET_NOT_IMPL) {
+      return RET_OK;
+    }
+  }
+
   vgcanvas_save(vg);
   vgcanvas_translate(vg, c->ox, c->oy);
   vgcanvas_translate(vg, anchor_x, anchor_y);
@@ -274,6 +320,8 @@ TK_DECL_VTABLE(guage_pointer) = {.size = sizeof(guage_pointer_t),
                                  .on_paint_background = widget_on_paint_null,
                                  .set_prop = guage_pointer_set_prop,
                                  .get_prop = guage_pointer_get_prop,
+                                 .set_prop_atom = guage_pointer_set_prop_atom,
+                                 .get_prop_atom = guage_pointer_get_prop_atom,
                                  .on_destroy = guage_pointer_on_destroy};
 
 widget_t* guage_pointer_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
@@ -83,7 +83,7 @@ static uint32_t candidates_calc_child_width(canvas_t* c, widget_t* widget) {
   return canvas_measure_text(c, str->str, str->size) + 8;
 }
 
-static ret_t candidates_relayout_children(widget_t* widget) {
+static ret_t candidates_relayout_children(widget_t* widget, bool_t append) {
   uint32_t i = 0;
   xy_t margin = 2;
   wh_t child_w = 0;
@@ -113,40 +113,71 @@ static ret_t candidates_relayout_children(widget_t* widget) {
     child_x += child_w + margin;
   }
 
-  hscrollable_set_xoffset(candidates->hscrollable, 0);
+  if (!append) {
+    hscrollable_set_xoffset(candidates->hscrollable, 0);
+  }
   hscrollable_set_virtual_w(candidates->hscrollable, child_x + 30);
 
   return RET_OK;
 }
 
-static ret_t candidates_update_candidates(widget_t* widget, const char* strs, uint32_t nr) {
+static ret_t candidates_update_candidates(widget_t* widget, const char* strs, uint32_t nr,
+                                          bool_t append) {
   uint32_t i = 0;
+  uint32_t start = 0;
   widget_t* iter = NULL;
   const char* text = strs;
   widget_t** children = NULL;
   candidates_t* candidates = CANDIDATES(widget);
   return_value_if_fail(candidates != NULL && strs != NULL, RET_BAD_PARAMS);
-  return_value_if_fail(candidates_ensure_children(widget, nr + 1) == RET_OK, RET_OOM);
+
+  start = append ? candidates->candidates_nr : 0;
+  return_value_if_fail(candidates_ensure_children(widget, start + nr + 1) == RET_OK, RET_OOM);
 
   children = (widget_t**)(widget->children->elms);
 
-  for (i = 0; i < nr; i++) {
+  for (i = start; i < start + nr; i++) {
     iter = children[i];
     widget_set_text_utf8(iter, text);
     text += strlen(text) + 1;
   }
+  candidates->candidates_nr = start + nr;
 
   for (; i < widget->children->size; i++) {
     iter = children[i];
     widget_set_text_utf8(iter, "");
   }
 
-  candidates_relayout_children(widget);
+  candidates_relayout_children(widget, append);
   widget_invalidate_force(widget, NULL);
 
   return RET_OK;
 }
 
+/*只显示填满控件(和预取的半屏)所需的候选字，滚动到接近末尾时再从输入法引擎获取下一页。*/
+static ret_t candidates_load_more(widget_t* widget) {
+  int32_t xoffset = 0;
+  candidates_t* candidates = CANDIDATES(widget);
+  hscrollable_t* hscrollable = candidates->hscrollable;
+
+  if (candidates->canvas == NULL) {
+    return RET_OK;
+  }
+
+  xoffset = hscrollable->xoffset;
+  if (hscrollable->wa != NULL) {
+    xoffset = tk_max(xoffset, hscrollable->xoffset_end);
+  }
+
+  while (candidates->has_more && hscrollable->virtual_w < xoffset + widget->w * 3 / 2) {
+    if (input_method_next_candidates_page(input_method()) != RET_OK) {
+      candidates->has_more = FALSE;
+    }
+  }
+
+  return RET_OK;
+}
+
 static ret_t candidates_on_destroy_default(widget_t* widget) {
   candidates_t* candidates = CANDIDATES(widget);
   return_value_if_fail(widget != NULL && candidates != NULL, RET_BAD_PARAMS);
@@ -166,10 +197,16 @@ static ret_t candidates_on_paint_self(widget_t* widget, canvas_t* c) {
 }
 
 static ret_t candidates_on_event(widget_t* widget, event_t* e) {
+  ret_t ret = RET_OK;
   candidates_t* candidates = CANDIDATES(widget);
   return_value_if_fail(candidates != NULL, RET_BAD_PARAMS);
 
-  return hscrollable_on_event(candidates->hscrollable, e);
+  ret = hscrollable_on_event(candidates->hscrollable, e);
+  if (e->type == EVT_POINTER_MOVE || e->type == EVT_POINTER_UP) {
+    candidates_load_more(widget);
+  }
+
+  return ret;
 }
 
 static ret_t candidates_invalidate(widget_t* widget, rect_t* r) {
@@ -215,9 +252,16 @@ TK_DECL_VTABLE(candidates) = {.size = sizeof(candidates_t),
 
 static ret_t candidates_on_im_candidates_event(void* ctx, event_t* e) {
   widget_t* widget = WIDGET(ctx);
+  candidates_t* candidates = CANDIDATES(widget);
   im_candidates_event_t* evt = (im_candidates_event_t*)e;
 
-  return candidates_update_candidates(widget, evt->candidates, evt->candidates_nr);
+  candidates_update_candidates(widget, evt->candidates, evt->candidates_nr, evt->append);
+  if (!evt->append) {
+    candidates->has_more = evt->candidates_nr > 0;
+    candidates_load_more(widget);
+  }
+
+  return RET_OK;
 }
 
 widget_t* candidates_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
@@ -39,8 +39,10 @@ typedef struct _candidates_t {
 
   /*private*/
   bool_t expanded;
+  bool_t has_more;
   wh_t normal_h;
   uint32_t event_id;
+  uint32_t candidates_nr;
   canvas_t* canvas;
   hscrollable_t* hscrollable;
 } candidates_t;
@@ -154,6 +154,7 @@ static ret_t mledit_set_prop(widget_t* widget, const char* name, const value_t*
     return RET_OK;
   } else if (tk_str_eq(name, WIDGET_PROP_VALUE)) {
     wstr_from_value(&(widget->text), v);
+    text_edit_layout(mledit->model);
     return RET_OK;
   }
 
@@ -164,6 +165,11 @@ static ret_t mledit_on_destroy(widget_t* widget) {
   mledit_t* mledit = MLEDIT(widget);
   return_value_if_fail(widget != NULL && mledit != NULL, RET_BAD_PARAMS);
 
+  if (mledit->timer_id != TK_INVALID_ID) {
+    timer_remove(mledit->timer_id);
+    mledit->timer_id = TK_INVALID_ID;
+  }
+
   text_edit_destroy(mledit->model);
 
   return RET_OK;
@@ -64,13 +64,8 @@ static ret_t mutable_image_on_paint_self(widget_t* widget, canvas_t* canvas) {
     image_copy(mutable_image->fb, bitmap, &r, canvas->ox, canvas->oy);
   } else {
     if (image_need_transform(widget)) {
-      vgcanvas_t* vg = canvas_get_vgcanvas(canvas);
-      if (vg != NULL) {
-        vgcanvas_save(vg);
-        image_transform(widget, canvas);
-        vgcanvas_draw_icon(vg, bitmap, 0, 0, bitmap->w, bitmap->h, 0, 0, widget->w, widget->h);
-        vgcanvas_restore(vg);
-
+      rect_t src = rect_init(0, 0, bitmap->w, bitmap->h);
+      if (image_transform_draw(widget, canvas, bitmap, &src) == RET_OK) {
         return RET_OK;
       }
     }
@@ -112,7 +107,9 @@ TK_DECL_VTABLE(mutable_image) = {.size = sizeof(mutable_image_t),
                                  .on_paint_self = mutable_image_on_paint_self,
                                  .on_paint_background = widget_on_paint_null,
                                  .set_prop = image_base_set_prop,
-                                 .get_prop = image_base_get_prop};
+                                 .get_prop = image_base_get_prop,
+                                 .set_prop_atom = image_base_set_prop_atom,
+                                 .get_prop_atom = image_base_get_prop_atom};
 
 static ret_t mutable_image_invalidate(const timer_info_t* info) {
   widget_invalidate_force(WIDGET(info->ctx), NULL);
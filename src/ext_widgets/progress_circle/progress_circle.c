@@ -21,10 +21,40 @@
 
 #include "tkc/mem.h"
 #include "tkc/utils.h"
+#include "base/widget_atoms.h"
 #include "base/widget_vtable.h"
 #include "base/image_manager.h"
 #include "progress_circle/progress_circle.h"
 
+/*圆弧的参数，用于判断缓存的路径是否可以重用*/
+typedef struct _progress_circle_arc_t {
+  float_t cx;
+  float_t cy;
+  float_t r;
+  float_t start_angle;
+  float_t end_angle;
+  float_t ccw;
+} progress_circle_arc_t;
+
+static ret_t progress_circle_arc(progress_circle_t* progress_circle, vgcanvas_t* vg,
+                                 const progress_circle_arc_t* arc) {
+  if (progress_circle->path == NULL) {
+    progress_circle->path = vgcanvas_path_create();
+  }
+
+  if (progress_circle->path != NULL &&
+      vgcanvas_reuse_path(vg, progress_circle->path, arc, sizeof(*arc)) == RET_OK) {
+    return RET_OK;
+  }
+
+  vgcanvas_arc(vg, arc->cx, arc->cy, arc->r, arc->start_angle, arc->end_angle, arc->ccw != 0);
+  if (progress_circle->path != NULL) {
+    vgcanvas_retain_path(vg, progress_circle->path, arc, sizeof(*arc));
+  }
+
+  return RET_OK;
+}
+
 static ret_t progress_circle_on_paint_self(widget_t* widget, canvas_t* c) {
   bitmap_t img;
   style_t* style = widget->astyle;
@@ -61,7 +91,9 @@ static ret_t progress_circle_on_paint_self(widget_t* widget, canvas_t* c) {
     vgcanvas_set_line_cap(vg, "round");
     vgcanvas_begin_path(vg);
     if (end_angle > start_angle) {
-      vgcanvas_arc(vg, cx, cy, r, start_angle, end_angle, ccw);
+      progress_circle_arc_t arc = {cx, cy, r, start_angle, end_angle, ccw ? 1.0f : 0.0f};
+
+      progress_circle_arc(progress_circle, vg, &arc);
       if (has_image) {
         vgcanvas_paint(vg, TRUE, &img);
       } else {
@@ -160,6 +192,10 @@ static ret_t progress_circle_on_destroy(widget_t* widget) {
   return_value_if_fail(widget != NULL && progress_circle != NULL, RET_BAD_PARAMS);
 
   TKMEM_FREE(progress_circle->unit);
+  if (progress_circle->path != NULL) {
+    vgcanvas_path_destroy(progress_circle->path);
+    progress_circle->path = NULL;
+  }
 
   return RET_OK;
 }
@@ -216,6 +252,36 @@ static ret_t progress_circle_set_prop(widget_t* widget, const char* name, const
   return RET_NOT_FOUND;
 }
 
+static ret_t progress_circle_get_prop_atom(widget_t* widget, atom_t atom, value_t* v) {
+  progress_circle_t* progress_circle = PROGRESS_CIRCLE(widget);
+  return_value_if_fail(progress_circle != NULL && v != NULL, RET_BAD_PARAMS);
+
+  switch (atom) {
+    case WIDGET_ATOM_VALUE: {
+      value_set_float(v, progress_circle->value);
+      return RET_OK;
+    }
+    default:
+      break;
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static ret_t progress_circle_set_prop_atom(widget_t* widget, atom_t atom, const value_t* v) {
+  return_value_if_fail(widget != NULL && v != NULL, RET_BAD_PARAMS);
+
+  switch (atom) {
+    case WIDGET_ATOM_VALUE: {
+      return progress_circle_set_value(widget, value_float(v));
+    }
+    default:
+      break;
+  }
+
+  return RET_NOT_FOUND;
+}
+
 static const char* s_progress_circle_clone_properties[] = {WIDGET_PROP_VALUE,
                                                            WIDGET_PROP_MAX,
                                                            PROGRESS_CIRCLE_PROP_COUNTER_CLOCK_WISE,
@@ -232,7 +298,9 @@ TK_DECL_VTABLE(progress_circle) = {.size = sizeof(progress_circle_t),
                                    .on_paint_self = progress_circle_on_paint_self,
                                    .on_destroy = progress_circle_on_destroy,
                                    .get_prop = progress_circle_get_prop,
-                                   .set_prop = progress_circle_set_prop};
+                                   .set_prop = progress_circle_set_prop,
+                                   .get_prop_atom = progress_circle_get_prop_atom,
+                                   .set_prop_atom = progress_circle_set_prop_atom};
 
 widget_t* progress_circle_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
   widget_t* widget = widget_create(parent, TK_REF_VTABLE(progress_circle), x, y, w, h);
@@ -119,6 +119,9 @@ typedef struct _progress_circle_t {
    * 是否显示文本(缺省为TRUE)。
    */
   bool_t show_text;
+
+  /*private*/
+  vgcanvas_path_t* path;
 } progress_circle_t;
 
 /**
@@ -26,35 +26,69 @@
 #include "rich_text/rich_text.h"
 #include "rich_text/rich_text_parser.h"
 
+static ret_t rich_text_destroy_layouts(rich_text_t* rich_text, uint32_t start) {
+  uint32_t i = 0;
+
+  for (i = start; i < TK_RICH_TEXT_LAYOUT_CACHE_SIZE; i++) {
+    rich_text_layout_t* iter = rich_text->layouts + i;
+
+    if (iter->render_node != NULL) {
+      rich_text_render_node_destroy(iter->render_node);
+      iter->render_node = NULL;
+    }
+    iter->w = 0;
+  }
+
+  return RET_OK;
+}
+
+static ret_t rich_text_reset_layouts(rich_text_t* rich_text) {
+  rich_text_destroy_layouts(rich_text, 0);
+
+  if (rich_text->layout_node != NULL && rich_text->layout_node != rich_text->node) {
+    rich_text_node_destroy(rich_text->layout_node);
+  }
+  rich_text->layout_node = NULL;
+
+  return RET_OK;
+}
+
 static ret_t rich_text_reset(widget_t* widget) {
   rich_text_t* rich_text = RICH_TEXT(widget);
   return_value_if_fail(rich_text != NULL, RET_BAD_PARAMS);
 
+  rich_text_reset_layouts(rich_text);
   if (rich_text->node != NULL) {
     rich_text_node_destroy(rich_text->node);
     rich_text->node = NULL;
   }
 
-  if (rich_text->render_node != NULL) {
-    rich_text_render_node_destroy(rich_text->render_node);
-    rich_text->render_node = NULL;
-  }
-
   return RET_OK;
 }
 
 static ret_t rich_text_on_paint_text(widget_t* widget, canvas_t* c) {
+  rect_t clip;
+  int32_t top = 0;
+  int32_t bottom = 0;
   rich_text_render_node_t* iter = NULL;
   rich_text_t* rich_text = RICH_TEXT(widget);
   return_value_if_fail(widget != NULL && rich_text != NULL && c != NULL, RET_BAD_PARAMS);
 
-  iter = rich_text->render_node;
-  while (iter != NULL) {
+  canvas_get_clip_rect(c, &clip);
+  top = clip.y - c->oy;
+  bottom = tk_min(clip.y + clip.h - c->oy, widget->h);
+
+  /*节点按y坐标排列，只绘制和裁剪区相交的节点。*/
+  for (iter = rich_text->layouts[0].render_node; iter != NULL; iter = iter->next) {
     rect_t* r = &(iter->rect);
-    if (r->y > widget->h) {
+    if (r->y >= bottom) {
       break;
     }
 
+    if ((r->y + r->h) <= top) {
+      continue;
+    }
+
     switch (iter->node->type) {
       case RICH_TEXT_TEXT: {
         rect_t cr;
@@ -70,6 +104,8 @@ static ret_t rich_text_on_paint_text(widget_t* widget, canvas_t* c) {
 
         for (i = 0; i < iter->size; i++) {
           float_t cw = canvas_measure_text(c, text + i, 1);
+
+          cw += canvas_get_kerning(c, text[i], text[i + 1]);
           cr.x = x;
           cr.y = r->y;
           cr.h = r->h;
@@ -99,36 +135,248 @@ static ret_t rich_text_on_paint_text(widget_t* widget, canvas_t* c) {
       default:
         break;
     }
-
-    iter = iter->next;
   }
 
   return RET_OK;
 }
 
-static ret_t rich_text_ensure_render_node(widget_t* widget, canvas_t* c) {
+static bool_t rich_text_name_equal(const char* a, const char* b) {
+  return a == b || tk_str_eq(a, b);
+}
+
+static bool_t rich_text_node_equal(widget_t* widget, rich_text_node_t* a, rich_text_node_t* b) {
+  if (a->type != b->type) {
+    return FALSE;
+  }
+
+  if (a->type == RICH_TEXT_TEXT) {
+    rich_text_font_t* fa = &(a->u.text.font);
+    rich_text_font_t* fb = &(b->u.text.font);
+
+    return wcscmp(a->u.text.text, b->u.text.text) == 0 && rich_text_name_equal(fa->name, fb->name) &&
+           fa->color.color == fb->color.color && fa->align_v == fb->align_v &&
+           fa->size == fb->size && fa->bold == fb->bold && fa->italic == fb->italic &&
+           fa->underline == fb->underline;
+  } else {
+    bitmap_t bitmap;
+    rich_text_image_t* ia = &(a->u.image);
+    rich_text_image_t* ib = &(b->u.image);
+
+    /*排版时用图片的大小代替0，比较之前也同样处理。*/
+    if ((ib->w == 0 || ib->h == 0) && widget_load_image(widget, ib->name, &bitmap) == RET_OK) {
+      if (ib->w == 0) {
+        ib->w = bitmap.w;
+      }
+      if (ib->h == 0) {
+        ib->h = bitmap.h;
+      }
+    }
+
+    return rich_text_name_equal(ia->name, ib->name) && ia->w == ib->w && ia->h == ib->h &&
+           ia->draw_type == ib->draw_type;
+  }
+}
+
+/*
+ * 文本修改后，重用第一个修改的节点之前的段落(把它们的渲染节点指向新的节点)，从后面的段落开始重新排版。
+ */
+static ret_t rich_text_reflow_text(widget_t* widget, canvas_t* c, int32_t w, int32_t h,
+                                   int32_t margin, int32_t line_gap) {
+  rich_text_para_t para;
+  uint32_t k = 0;
+  uint32_t index = 0;
   rich_text_t* rich_text = RICH_TEXT(widget);
-  return_value_if_fail(widget != NULL && rich_text != NULL, RET_BAD_PARAMS);
+  rich_text_node_t* old_node = rich_text->layout_node;
+  rich_text_node_t* old_iter = old_node;
+  rich_text_node_t* new_iter = rich_text->node;
+  rich_text_render_node_t* iter = NULL;
+  rich_text_render_node_t* prev = NULL;
+  rich_text_render_node_t* resume = NULL;
+  rich_text_render_node_t* resume_prev = NULL;
+  rich_text_render_node_t* render_node = rich_text->layouts[0].render_node;
+
+  if (old_node == NULL || render_node == NULL || rich_text->layouts[0].w != w) {
+    rich_text_reset_layouts(rich_text);
+    rich_text->layout_node = rich_text->node;
 
-  if (rich_text->render_node != NULL) {
     return RET_OK;
   }
 
-  if (rich_text->node == NULL) {
-    return RET_FAIL;
+  /*其它宽度的排版结果不再重用。*/
+  rich_text->layouts[0].render_node = NULL;
+  rich_text_destroy_layouts(rich_text, 1);
+
+  /*k为第一个修改的节点的序号。*/
+  while (old_iter != NULL && new_iter != NULL && rich_text_node_equal(widget, old_iter, new_iter)) {
+    k++;
+    old_iter = old_iter->next;
+    new_iter = new_iter->next;
+  }
+
+  /*下一个段落从第k个节点之前(或者第k个节点的开头)开始，当前段落就不受影响。*/
+  resume = render_node;
+  old_iter = old_node;
+  for (iter = render_node; iter != NULL; prev = iter, iter = iter->next) {
+    while (old_iter != iter->node) {
+      old_iter = old_iter->next;
+      index++;
+    }
+
+    if (iter->para_start && iter != render_node) {
+      rich_text_render_node_get_para(iter, &para);
+      if (index < k || (index == k && para.offset == 0)) {
+        resume = iter;
+        resume_prev = prev;
+      } else {
+        break;
+      }
+    }
+  }
+
+  if (resume == render_node) {
+    rich_text_render_node_destroy(render_node);
+    rich_text_node_destroy(old_node);
+    rich_text->layout_node = rich_text->node;
+
+    return RET_OK;
+  }
+
+  /*把前面的渲染节点指向新的节点，它们的内容是相同的。*/
+  rich_text_render_node_get_para(resume, &para);
+  old_iter = old_node;
+  new_iter = rich_text->node;
+  for (iter = render_node; iter != NULL; iter = iter->next) {
+    while (old_iter != iter->node) {
+      old_iter = old_iter->next;
+      new_iter = new_iter != NULL ? new_iter->next : NULL;
+    }
+
+    if (iter == resume) {
+      para.node = new_iter;
+      break;
+    }
+
+    if (iter->text != NULL) {
+      iter->text = new_iter->u.text.text + (iter->text - old_iter->u.text.text);
+    }
+    iter->node = new_iter;
+  }
+
+  resume_prev->next = NULL;
+  rich_text_render_node_destroy(resume);
+  rich_text_node_destroy(old_node);
+  rich_text->layout_node = rich_text->node;
+
+  if (para.node != NULL) {
+    render_node =
+        rich_text_render_node_layout_from(widget, render_node, &para, c, w, h, margin, line_gap);
+  }
+  rich_text->layouts[0].render_node = render_node;
+
+  return RET_OK;
+}
+
+/*
+ * 宽度改变后，复制不受影响的段落，从第一个受影响的段落开始重新排版。
+ */
+static rich_text_render_node_t* rich_text_reflow_width(widget_t* widget, canvas_t* c, int32_t w,
+                                                       int32_t h, int32_t margin,
+                                                       int32_t line_gap) {
+  rich_text_para_t para;
+  rich_text_t* rich_text = RICH_TEXT(widget);
+  rich_text_render_node_t* prefix = NULL;
+  rich_text_render_node_t* resume = NULL;
+  rich_text_render_node_t* render_node = rich_text->layouts[0].render_node;
+
+  if (render_node == NULL || w - 2 * margin <= 0) {
+    return rich_text_render_node_layout(widget, rich_text->node, c, w, h, margin, line_gap);
+  }
+
+  resume = rich_text_render_node_find_reflow_para(render_node, w, margin);
+  if (resume != render_node) {
+    prefix = rich_text_render_node_clone_range(render_node, resume);
+    if (prefix == NULL) {
+      return rich_text_render_node_layout(widget, rich_text->node, c, w, h, margin, line_gap);
+    }
+  }
+
+  if (resume == NULL) {
+    return prefix;
+  }
+
+  rich_text_render_node_get_para(resume, &para);
+
+  return rich_text_render_node_layout_from(widget, prefix, &para, c, w, h, margin, line_gap);
+}
+
+static bool_t rich_text_use_layout(rich_text_t* rich_text, int32_t w) {
+  uint32_t i = 0;
+  rich_text_layout_t* layouts = rich_text->layouts;
+
+  for (i = 0; i < TK_RICH_TEXT_LAYOUT_CACHE_SIZE; i++) {
+    if (layouts[i].render_node != NULL && layouts[i].w == w) {
+      rich_text_layout_t layout = layouts[i];
+
+      memmove(layouts + 1, layouts, i * sizeof(rich_text_layout_t));
+      layouts[0] = layout;
+
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+static ret_t rich_text_add_layout(rich_text_t* rich_text, int32_t w,
+                                  rich_text_render_node_t* render_node) {
+  rich_text_layout_t* layouts = rich_text->layouts;
+  rich_text_layout_t* last = layouts + TK_RICH_TEXT_LAYOUT_CACHE_SIZE - 1;
+
+  if (last->render_node != NULL) {
+    rich_text_render_node_destroy(last->render_node);
   }
 
-  if (rich_text->render_node == NULL) {
+  memmove(layouts + 1, layouts, (TK_RICH_TEXT_LAYOUT_CACHE_SIZE - 1) * sizeof(rich_text_layout_t));
+  layouts[0].w = w;
+  layouts[0].render_node = render_node;
+
+  return RET_OK;
+}
+
+static ret_t rich_text_ensure_render_node(widget_t* widget, canvas_t* c) {
+  rich_text_t* rich_text = RICH_TEXT(widget);
+  return_value_if_fail(widget != NULL && rich_text != NULL, RET_BAD_PARAMS);
+
+  if (rich_text->node == NULL) {
+    rich_text_reset_layouts(rich_text);
+    return RET_FAIL;
+  } else {
     int32_t w = widget->w;
     int32_t h = widget->h;
     int32_t line_gap = rich_text->line_gap;
     style_t* style = widget->astyle;
     int32_t margin = style_get_int(style, STYLE_ID_MARGIN, 2);
+    rich_text_render_node_t* render_node = NULL;
 
-    rich_text->render_node =
-        rich_text_render_node_layout(widget, rich_text->node, c, w, h, margin, line_gap);
+    if (margin != rich_text->layout_margin || line_gap != rich_text->layout_line_gap) {
+      rich_text_reset_layouts(rich_text);
+      rich_text->layout_margin = margin;
+      rich_text->layout_line_gap = line_gap;
+    }
+
+    if (rich_text->layout_node != rich_text->node) {
+      rich_text_reflow_text(widget, c, w, h, margin, line_gap);
+    }
+
+    if (rich_text_use_layout(rich_text, w)) {
+      return RET_OK;
+    }
+
+    render_node = rich_text_reflow_width(widget, c, w, h, margin, line_gap);
+    return_value_if_fail(render_node != NULL, RET_OOM);
+
+    rich_text_add_layout(rich_text, w, render_node);
   }
-  return_value_if_fail(rich_text->render_node != NULL, RET_OOM);
 
   return RET_OK;
 }
@@ -199,11 +447,16 @@ widget_t* rich_text_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
 }
 
 ret_t rich_text_set_text(widget_t* widget, const char* text) {
+  rich_text_node_t* node = NULL;
   rich_text_t* rich_text = RICH_TEXT(widget);
   return_value_if_fail(rich_text != NULL, RET_BAD_PARAMS);
 
-  rich_text_reset(widget);
-  rich_text->node = rich_text_parse(text, strlen(text));
+  node = rich_text_parse(text, strlen(text));
+  /*排版时和旧的节点比较，重用没有修改的段落。*/
+  if (rich_text->node != NULL && rich_text->node != rich_text->layout_node) {
+    rich_text_node_destroy(rich_text->node);
+  }
+  rich_text->node = node;
 
   return RET_OK;
 }
@@ -27,6 +27,18 @@
 
 BEGIN_C_DECLS
 
+#ifndef TK_RICH_TEXT_LAYOUT_CACHE_SIZE
+#define TK_RICH_TEXT_LAYOUT_CACHE_SIZE 2
+#endif /*TK_RICH_TEXT_LAYOUT_CACHE_SIZE*/
+
+/*
+ * 指定宽度下的排版结果。
+ */
+typedef struct _rich_text_layout_t {
+  int32_t w;
+  rich_text_render_node_t* render_node;
+} rich_text_layout_t;
+
 /**
  * @class rich_text_t
  * @parent widget_t
@@ -93,7 +105,12 @@ typedef struct _rich_text_t {
 
   /*private*/
   rich_text_node_t* node;
-  rich_text_render_node_t* render_node;
+  /*排版结果引用的节点。设置新的文本后，在重新排版之前保留旧的节点，以便重用没有修改的段落。*/
+  rich_text_node_t* layout_node;
+  int32_t layout_margin;
+  int32_t layout_line_gap;
+  /*最近使用过的几个宽度的排版结果，第一个是当前的排版结果。*/
+  rich_text_layout_t layouts[TK_RICH_TEXT_LAYOUT_CACHE_SIZE];
 } rich_text_t;
 
 /**
@@ -25,6 +25,8 @@
 #include "rich_text/rich_text_render_node.h"
 
 #define ICON_SIZE 128
+/*排版时每次计算换行类型的字符数。*/
+#define RICH_TEXT_BREAK_CHUNK 64
 
 rich_text_render_node_t* rich_text_render_node_create(rich_text_node_t* node) {
   rich_text_render_node_t* render_node = NULL;
@@ -120,21 +122,63 @@ break_type_t rich_text_line_break_check(wchar_t c1, wchar_t c2) {
   return break_type;
 }
 
-rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_text_node_t* node,
-                                                      canvas_t* c, int32_t w, int32_t h,
-                                                      int32_t margin, int32_t line_gap) {
-  int32_t row_h = 0;
+static rich_text_render_node_t* rich_text_render_node_add(rich_text_render_node_t** tail,
+                                                         rich_text_node_t* node,
+                                                         rich_text_para_t* para) {
+  rich_text_render_node_t* new_node = rich_text_render_node_create(node);
+  return_value_if_fail(new_node != NULL, NULL);
+
+  /*para->node不为NULL表示刚开始一个新的段落，记录段落开始时的状态。*/
+  if (para->node != NULL) {
+    new_node->para_start = TRUE;
+    new_node->para_y = para->y;
+    new_node->para_row_h = para->row_h;
+    para->node = NULL;
+  }
+
+  if (*tail != NULL) {
+    (*tail)->next = new_node;
+  }
+  *tail = new_node;
+
+  return new_node;
+}
+
+#define BEGIN_PARA() \
+  para.node = iter;  \
+  para.y = y;        \
+  para.row_h = row_h;
+
+rich_text_render_node_t* rich_text_render_node_layout_from(widget_t* widget,
+                                                           rich_text_render_node_t* render_node,
+                                                           const rich_text_para_t* para_start,
+                                                           canvas_t* c, int32_t w, int32_t h,
+                                                           int32_t margin, int32_t line_gap) {
+  rich_text_para_t para;
   int32_t x = margin;
-  int32_t y = margin;
+  int32_t y = 0;
+  int32_t row_h = 0;
+  uint32_t offset = 0;
   int32_t right = w - margin;
   int32_t client_w = w - 2 * margin;
   int32_t client_h = h - 2 * margin;
 
-  rich_text_node_t* iter = node;
+  rich_text_node_t* iter = NULL;
+  rich_text_render_node_t* tail = render_node;
   rich_text_render_node_t* new_node = NULL;
-  rich_text_render_node_t* render_node = NULL;
   rich_text_render_node_t* row_first_node = NULL;
-  return_value_if_fail(node != NULL && c != NULL && client_w > 0 && client_h > 0, NULL);
+  return_value_if_fail(para_start != NULL && c != NULL, render_node);
+  return_value_if_fail(client_w > 0 && client_h > 0, render_node);
+
+  para = *para_start;
+  iter = para.node;
+  y = para.y;
+  row_h = para.row_h;
+  offset = para.offset;
+
+  while (tail != NULL && tail->next != NULL) {
+    tail = tail->next;
+  }
 
   while (iter != NULL) {
     switch (iter->type) {
@@ -143,8 +187,6 @@ rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_tex
         int32_t flexible_w = 0;
         rich_text_image_t* image = &(iter->u.image);
         const char* name = image->name;
-        new_node = rich_text_render_node_create(iter);
-        return_value_if_fail(new_node != NULL, render_node);
 
         if (widget_load_image(widget, name, &bitmap) == RET_OK) {
           if (image->w == 0) {
@@ -159,6 +201,12 @@ rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_tex
           MOVE_TO_NEXT_ROW();
         }
 
+        new_node = rich_text_render_node_add(&tail, iter, &para);
+        return_value_if_fail(new_node != NULL, render_node);
+        if (render_node == NULL) {
+          render_node = new_node;
+        }
+
         new_node->rect.x = x;
         new_node->rect.y = y;
         new_node->rect.w = image->w;
@@ -172,11 +220,11 @@ rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_tex
           row_h = image->h;
         }
 
-        render_node = rich_text_render_node_append(render_node, new_node);
         if (image->w > ICON_SIZE) {
           x = margin;
           y += row_h + line_gap;
           row_h = 0;
+          BEGIN_PARA();
         } else {
           if (row_first_node == NULL) {
             row_first_node = new_node;
@@ -187,14 +235,18 @@ rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_tex
         break;
       }
       case RICH_TEXT_TEXT: {
-        int32_t i = 0;
         float_t tw = 0;
         float_t cw = 0;
-        int32_t start = 0;
+        float_t breakable_tw = 0;
+        int32_t i = offset;
+        int32_t start = offset;
         int32_t flexible_w = 0;
-        int32_t last_breakable = 0;
+        int32_t brks_start = 0;
+        int32_t brks_end = 0;
+        int32_t last_breakable = offset;
         wchar_t* str = iter->u.text.text;
-        break_type_t break_type = LINE_BREAK_ALLOW;
+        break_type_t line_brks[RICH_TEXT_BREAK_CHUNK + 1];
+        break_type_t word_brks[RICH_TEXT_BREAK_CHUNK + 1];
         int32_t font_size = iter->u.text.font.size;
 
         if (row_h < font_size) {
@@ -202,75 +254,118 @@ rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_tex
         }
         canvas_set_font(c, iter->u.text.font.name, font_size);
 
-        for (i = 0; str[i]; i++) {
-          cw = canvas_measure_text(c, str + i, 1);
-          if (i > 0) {
-            break_type = rich_text_line_break_check(str[i - 1], str[i]);
+        while (str[i]) {
+          break_type_t break_type = LINE_BREAK_ALLOW;
+
+          cw = canvas_measure_text(c, str + i, 1) + canvas_get_kerning(c, str[i], str[i + 1]);
+          cw = tk_max(cw, 0);
+          if (i > start) {
+            int32_t k = i - 1;
+
+            if (k < brks_start || k >= brks_end) {
+              /*多算一个字符，保证每块最后一个字符与后面字符之间的结果正确。*/
+              int32_t size = 0;
+              while (size <= RICH_TEXT_BREAK_CHUNK && str[k + size]) {
+                size++;
+              }
+
+              line_break_check_str(str + k, size, line_brks, word_brks);
+              brks_start = k;
+              brks_end = k + tk_min(size, RICH_TEXT_BREAK_CHUNK);
+            }
+
+            break_type = line_brks[k - brks_start];
+            if (break_type == LINE_BREAK_NO) {
+              break_type = word_brks[k - brks_start];
+            }
           }
 
-          if ((x + tw + cw) > right || break_type == LINE_BREAK_MUST) {
+          /*行首的字符即使放不下也不换行，否则会一直换行。*/
+          if (break_type == LINE_BREAK_MUST || ((x + tw + cw) > right && (tw > 0 || x > margin))) {
+            int32_t end = i;
+
             if (break_type != LINE_BREAK_MUST) {
-              if ((i - last_breakable) < 10) {
-                i = last_breakable;
+              if ((i - last_breakable) < 10 && last_breakable > start) {
+                end = last_breakable;
+                tw = breakable_tw;
               }
             }
 
-            new_node = rich_text_render_node_create(iter);
-            return_value_if_fail(new_node != NULL, render_node);
+            if (end > start) {
+              new_node = rich_text_render_node_add(&tail, iter, &para);
+              return_value_if_fail(new_node != NULL, render_node);
+              if (render_node == NULL) {
+                render_node = new_node;
+              }
 
-            new_node->text = str + start;
-            new_node->size = i - start;
-            new_node->rect = rect_init(x, y, tw, font_size);
+              new_node->text = str + start;
+              new_node->size = end - start;
+              new_node->rect = rect_init(x, y, tw, font_size);
 
-            render_node = rich_text_render_node_append(render_node, new_node);
-            if (row_first_node == NULL) {
-              row_first_node = new_node;
+              if (row_first_node == NULL) {
+                row_first_node = new_node;
+              }
             }
 
+            i = end;
             if (break_type == LINE_BREAK_MUST) {
               while (str[i] == '\r' || str[i] == '\n') {
                 i++;
               }
               y += font_size;
-              start = i;
               flexible_w = 0;
             } else {
               if (str[i] == ' ' || str[i] == '\t') {
                 i++;
               }
-              start = i;
-              flexible_w = right - x - canvas_measure_text(c, new_node->text, new_node->size);
+              flexible_w = right - x - tw;
             }
 
-            x += tw + 1;
-            tw = 0;
             MOVE_TO_NEXT_ROW();
             row_h = font_size;
-          } else {
-            if (i > 0) {
-              if (rich_text_line_break_check(str[i - 1], str[i]) == LINE_BREAK_ALLOW) {
-                last_breakable = i;
-              }
+            if (break_type == LINE_BREAK_MUST) {
+              BEGIN_PARA();
             }
 
-            tw += cw;
+            tw = 0;
+            start = i;
+            last_breakable = i;
+            continue;
+          }
+
+          if (break_type == LINE_BREAK_ALLOW && i > start) {
+            last_breakable = i;
+            breakable_tw = tw;
           }
+
+          tw += cw;
+          i++;
         }
 
         if (i > start) {
-          new_node = rich_text_render_node_create(iter);
+          new_node = rich_text_render_node_add(&tail, iter, &para);
           return_value_if_fail(new_node != NULL, render_node);
+          if (render_node == NULL) {
+            render_node = new_node;
+          }
 
           new_node->text = str + start;
           new_node->size = i - start;
           new_node->rect = rect_init(x, y, tw, font_size);
           x += tw + 1;
-          tw = 0;
 
-          render_node = rich_text_render_node_append(render_node, new_node);
           if (row_first_node == NULL) {
             row_first_node = new_node;
           }
+
+          /*文本以换行符结束时，后面的节点从新的段落开始。*/
+          if (str[i - 1] == '\r' || str[i - 1] == '\n') {
+            y += font_size;
+            flexible_w = 0;
+            MOVE_TO_NEXT_ROW();
+            row_h = font_size;
+            BEGIN_PARA();
+          }
         }
 
         break;
@@ -279,6 +374,7 @@ rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_tex
         break;
     }
 
+    offset = 0;
     iter = iter->next;
   }
 
@@ -289,6 +385,94 @@ rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_tex
   return render_node;
 }
 
+rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_text_node_t* node,
+                                                      canvas_t* c, int32_t w, int32_t h,
+                                                      int32_t margin, int32_t line_gap) {
+  rich_text_para_t para;
+  return_value_if_fail(node != NULL, NULL);
+
+  para.node = node;
+  para.offset = 0;
+  para.y = margin;
+  para.row_h = 0;
+
+  return rich_text_render_node_layout_from(widget, NULL, &para, c, w, h, margin, line_gap);
+}
+
+ret_t rich_text_render_node_get_para(rich_text_render_node_t* render_node, rich_text_para_t* para) {
+  rich_text_node_t* node = NULL;
+  return_value_if_fail(render_node != NULL && render_node->para_start && para != NULL,
+                       RET_BAD_PARAMS);
+
+  node = render_node->node;
+  para->node = node;
+  para->offset = 0;
+  para->y = render_node->para_y;
+  para->row_h = render_node->para_row_h;
+  if (node->type == RICH_TEXT_TEXT) {
+    para->offset = render_node->text - node->u.text.text;
+  }
+
+  return RET_OK;
+}
+
+rich_text_render_node_t* rich_text_render_node_find_reflow_para(rich_text_render_node_t* render_node,
+                                                                int32_t w, int32_t margin) {
+  int32_t right = w - margin;
+  bool_t affected = FALSE;
+  rich_text_render_node_t* iter = render_node;
+  rich_text_render_node_t* para = render_node;
+
+  /*只有一行并且在新的宽度下也放得下的段落，重新排版的结果不变。*/
+  while (iter != NULL) {
+    if (iter->para_start) {
+      if (affected) {
+        return para;
+      }
+      para = iter;
+    }
+
+    if (iter->rect.y != para->para_y || iter->spacing != 0 || (iter->rect.x + iter->rect.w) > right) {
+      affected = TRUE;
+    } else if (iter->node->type == RICH_TEXT_IMAGE && iter->node->u.image.w > ICON_SIZE) {
+      affected = TRUE;
+    }
+
+    iter = iter->next;
+  }
+
+  return affected ? para : NULL;
+}
+
+rich_text_render_node_t* rich_text_render_node_clone_range(rich_text_render_node_t* first,
+                                                           rich_text_render_node_t* end) {
+  rich_text_render_node_t* iter = first;
+  rich_text_render_node_t* tail = NULL;
+  rich_text_render_node_t* render_node = NULL;
+
+  while (iter != NULL && iter != end) {
+    rich_text_render_node_t* new_node = TKMEM_ZALLOC(rich_text_render_node_t);
+    if (new_node == NULL) {
+      if (render_node != NULL) {
+        rich_text_render_node_destroy(render_node);
+      }
+      return NULL;
+    }
+
+    memcpy(new_node, iter, sizeof(rich_text_render_node_t));
+    new_node->next = NULL;
+    if (tail != NULL) {
+      tail->next = new_node;
+    } else {
+      render_node = new_node;
+    }
+    tail = new_node;
+    iter = iter->next;
+  }
+
+  return render_node;
+}
+
 rich_text_render_node_t* rich_text_render_node_append(rich_text_render_node_t* node,
                                                       rich_text_render_node_t* next) {
   rich_text_render_node_t* iter = node;
@@ -52,14 +52,49 @@ typedef struct _rich_text_render_node_t {
   /*每个弹性宽度字符应该承担的多余空间*/
   uint8_t flexible_w_char_delta_w;
 
+  /*该节点是否是段落(强制换行之后的内容)的第一个节点*/
+  bool_t para_start;
+  /*段落开始时的y坐标和行高，从这里可以独立地重新排版后面的内容*/
+  int32_t para_y;
+  int32_t para_row_h;
+
   struct _rich_text_render_node_t* next;
 } rich_text_render_node_t;
 
+/*
+ * 表示排版的起点。段落之间互不影响，修改文本或者改变宽度时，可以从受影响的段落开始重新排版。
+ */
+typedef struct _rich_text_para_t {
+  rich_text_node_t* node;
+  /*文本节点中的偏移*/
+  uint32_t offset;
+  int32_t y;
+  int32_t row_h;
+} rich_text_para_t;
+
 bool_t rich_text_is_flexable_w_char(wchar_t c);
 
 rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_text_node_t* node,
                                                       canvas_t* c, int32_t w, int32_t h,
                                                       int32_t margin, int32_t line_gap);
+
+/*从para开始排版，新的节点追加到render_node(para之前已经排好的节点)后面。*/
+rich_text_render_node_t* rich_text_render_node_layout_from(widget_t* widget,
+                                                           rich_text_render_node_t* render_node,
+                                                           const rich_text_para_t* para,
+                                                           canvas_t* c, int32_t w, int32_t h,
+                                                           int32_t margin, int32_t line_gap);
+
+/*获取段落的第一个节点对应的排版起点。*/
+ret_t rich_text_render_node_get_para(rich_text_render_node_t* render_node, rich_text_para_t* para);
+
+/*查找宽度变为w后第一个需要重新排版的段落，返回NULL表示全部段落都不受影响。*/
+rich_text_render_node_t* rich_text_render_node_find_reflow_para(rich_text_render_node_t* render_node,
+                                                                int32_t w, int32_t margin);
+
+/*复制从first开始到end(不含)之间的节点。*/
+rich_text_render_node_t* rich_text_render_node_clone_range(rich_text_render_node_t* first,
+                                                           rich_text_render_node_t* end);
 rich_text_render_node_t* rich_text_render_node_append(rich_text_render_node_t* node,
                                                       rich_text_render_node_t* next);
 
@@ -266,7 +266,8 @@ static ret_t children_layouter_list_view_layout(children_layouter_t* layouter, w
       }
 
       widget_move_resize(iter, x, y, w, h);
-      widget_layout(iter);
+      widget_layout_self(iter);
+      widget_layout_children_if_needed(iter);
 
       y = iter->y + iter->h + spacing;
     }
@@ -113,7 +113,8 @@ static ret_t list_view_h_on_scroll_view_layout_children(widget_t* widget) {
       widget_t* iter = children[i];
 
       widget_move_resize(iter, x, y, w, h);
-      widget_layout(iter);
+      widget_layout_self(iter);
+      widget_layout_children_if_needed(iter);
 
       x = iter->x + iter->w + spacing;
     }
@@ -25,6 +25,7 @@
 #include "base/velocity.h"
 #include "tkc/time_now.h"
 #include "scroll_view/scroll_view.h"
+#include "base/widget_atoms.h"
 #include "base/widget_vtable.h"
 #include "base/image_manager.h"
 #include "widget_animators/widget_animator_scroll.h"
@@ -481,6 +482,49 @@ static ret_t scroll_view_set_prop(widget_t* widget, const char* name, const valu
   return RET_NOT_FOUND;
 }
 
+static ret_t scroll_view_get_prop_atom(widget_t* widget, atom_t atom, value_t* v) {
+  scroll_view_t* scroll_view = SCROLL_VIEW(widget);
+  return_value_if_fail(scroll_view != NULL && v != NULL, RET_BAD_PARAMS);
+
+  switch (atom) {
+    case WIDGET_ATOM_XOFFSET: {
+      value_set_int(v, scroll_view->xoffset);
+      return RET_OK;
+    }
+    case WIDGET_ATOM_YOFFSET: {
+      value_set_int(v, scroll_view->yoffset);
+      return RET_OK;
+    }
+    default:
+      break;
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static ret_t scroll_view_set_prop_atom(widget_t* widget, atom_t atom, const value_t* v) {
+  scroll_view_t* scroll_view = SCROLL_VIEW(widget);
+  return_value_if_fail(scroll_view != NULL && v != NULL, RET_BAD_PARAMS);
+
+  switch (atom) {
+    case WIDGET_ATOM_XOFFSET: {
+      scroll_view->xoffset = value_int(v);
+      break;
+    }
+    case WIDGET_ATOM_YOFFSET: {
+      scroll_view->yoffset = value_int(v);
+      break;
+    }
+    default:
+      return RET_NOT_FOUND;
+  }
+
+  scroll_view_notify_scrolled(scroll_view);
+  scroll_view_invalidate_self(widget);
+
+  return RET_OK;
+}
+
 static const char* s_scroll_view_clone_properties[] = {WIDGET_PROP_VIRTUAL_W,
                                                        WIDGET_PROP_VIRTUAL_H,
                                                        WIDGET_PROP_XSLIDABLE,
@@ -501,7 +545,9 @@ TK_DECL_VTABLE(scroll_view) = {.size = sizeof(scroll_view_t),
                                .on_add_child = scroll_view_on_add_child,
                                .find_target = scroll_view_find_target,
                                .get_prop = scroll_view_get_prop,
-                               .set_prop = scroll_view_set_prop};
+                               .set_prop = scroll_view_set_prop,
+                               .get_prop_atom = scroll_view_get_prop_atom,
+                               .set_prop_atom = scroll_view_set_prop_atom};
 
 widget_t* scroll_view_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
   widget_t* widget = widget_create(parent, TK_REF_VTABLE(scroll_view), x, y, w, h);
@@ -39,6 +39,10 @@ static ret_t svg_image_load_bsvg(widget_t* widget) {
     widget_unload_asset(widget, svg_image->bsvg_asset);
   }
 
+  if (svg_image->paths != NULL) {
+    darray_clear(svg_image->paths);
+  }
+
   svg_image->bsvg_asset = widget_load_asset(widget, ASSET_TYPE_IMAGE, image_base->image);
   return_value_if_fail(svg_image->bsvg_asset != NULL, RET_NOT_FOUND);
 
@@ -80,7 +84,11 @@ static ret_t svg_image_on_paint_self(widget_t* widget, canvas_t* c) {
     vgcanvas_set_fill_color(vg, bg);
     vgcanvas_set_stroke_color(vg, fg);
 
-    bsvg_draw(&bsvg, vg);
+    if (svg_image->paths == NULL) {
+      svg_image->paths = darray_create(8, (tk_destroy_t)vgcanvas_path_destroy, NULL);
+    }
+
+    bsvg_draw_ex(&bsvg, vg, svg_image->paths);
 
     vgcanvas_restore(vg);
   }
@@ -99,6 +107,11 @@ static ret_t svg_image_on_destroy(widget_t* widget) {
     svg_image->bsvg_asset = NULL;
   }
 
+  if (svg_image->paths != NULL) {
+    darray_destroy(svg_image->paths);
+    svg_image->paths = NULL;
+  }
+
   return image_base_on_destroy(widget);
 }
 
@@ -117,7 +130,9 @@ TK_DECL_VTABLE(svg_image) = {.size = sizeof(svg_image_t),
                              .on_paint_self = svg_image_on_paint_self,
                              .on_paint_background = widget_on_paint_null,
                              .set_prop = image_base_set_prop,
-                             .get_prop = image_base_get_prop};
+                             .get_prop = image_base_get_prop,
+                             .set_prop_atom = image_base_set_prop_atom,
+                             .get_prop_atom = image_base_get_prop_atom};
 
 widget_t* svg_image_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
   widget_t* widget = widget_create(parent, TK_REF_VTABLE(svg_image), x, y, w, h);
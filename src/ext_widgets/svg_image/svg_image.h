@@ -22,6 +22,7 @@
 #ifndef TK_SVG_IMAGE_H
 #define TK_SVG_IMAGE_H
 
+#include "tkc/darray.h"
 #include "base/widget.h"
 #include "base/image_base.h"
 
@@ -73,6 +74,7 @@ typedef struct _svg_image_t {
 
   /*private*/
   const asset_info_t* bsvg_asset;
+  darray_t* paths;
 } svg_image_t;
 
 /**
@@ -20,6 +20,7 @@
  */
 
 #include "tkc/mem.h"
+#include "tkc/buffer.h"
 #include "font_loader/font_loader_bitmap.h"
 
 typedef struct _font_bitmap_t {
@@ -51,6 +52,8 @@ static font_bitmap_index_t* find_glyph(font_bitmap_index_t* elms, uint32_t nr, w
 }
 
 static ret_t font_bitmap_get_glyph(font_t* f, wchar_t c, font_size_t font_size, glyph_t* g) {
+  uint8_t v = 0;
+  uint16_t advance = 0;
   const uint8_t* p = NULL;
   font_bitmap_t* font = (font_bitmap_t*)f;
   font_bitmap_header_t* header = (font_bitmap_header_t*)(font->buff);
@@ -59,8 +62,17 @@ static ret_t font_bitmap_get_glyph(font_t* f, wchar_t c, font_size_t font_size,
   return_value_if_fail(header->font_size == font_size, RET_NOT_FOUND);
 
   p = (font->buff + index->offset);
-  memcpy(g, p, sizeof(glyph_t));
-  g->data = font->buff + index->offset + sizeof(glyph_t) - sizeof(g->data);
+  load_uint8(p, v);
+  g->x = (int8_t)v;
+  load_uint8(p, v);
+  g->y = (int8_t)v;
+  load_uint8(p, g->w);
+  load_uint8(p, g->h);
+  load_uint16(p, advance);
+  g->advance = advance;
+  p++;
+  load_uint8(p, g->format);
+  g->data = p;
 
   return RET_OK;
 }
@@ -31,6 +31,13 @@ typedef struct _font_bitmap_index_t {
   uint16_t offset;
 } font_bitmap_index_t;
 
+/*
+ * 每个字模的数据由8字节的头和字模数据组成：
+ * x(int8) y(int8) w(uint8) h(uint8) advance(uint16) reserved(uint8) format(uint8)
+ * format为glyph_format_t，旧版本工具生成的字体此处为0(即GLYPH_FMT_ALPHA)。
+ */
+#define FONT_BITMAP_GLYPH_HEADER_SIZE 8
+
 typedef struct _font_bitmap_header_t {
   uint16_t char_nr;
   uint8_t font_size;
@@ -111,6 +111,24 @@ static int32_t font_ft_get_baseline(font_t* f, font_size_t font_size) {
   return ascender >> 6;
 }
 
+static int32_t font_ft_get_kerning(font_t* f, font_size_t font_size, wchar_t c1, wchar_t c2) {
+  FT_Vector delta;
+  font_ft_t* font = (font_ft_t*)f;
+  ft_fontinfo* sf = &(font->ft_font);
+
+  if (!FT_HAS_KERNING(sf->face)) {
+    return 0;
+  }
+
+  FT_Set_Char_Size(sf->face, 0, font_size * 64, 0, 50);
+  if (FT_Get_Kerning(sf->face, FT_Get_Char_Index(sf->face, c1), FT_Get_Char_Index(sf->face, c2),
+                     FT_KERNING_DEFAULT, &delta) != 0) {
+    return 0;
+  }
+
+  return delta.x >> 6;
+}
+
 static ret_t font_ft_destroy(font_t* f) {
   font_ft_t* font = (font_ft_t*)f;
   glyph_cache_deinit(&(font->cache));
@@ -152,6 +170,7 @@ font_t* font_ft_create(const char* name, const uint8_t* buff, uint32_t size) {
   f->base.match = font_ft_match;
   f->base.get_glyph = font_ft_get_glyph;
   f->base.get_baseline = font_ft_get_baseline;
+  f->base.get_kerning = font_ft_get_kerning;
   f->base.destroy = font_ft_destroy;
 
   glyph_cache_init(&(f->cache), 256, destroy_glyph);
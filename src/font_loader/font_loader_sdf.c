@@ -0,0 +1,142 @@
+/**
+ * File:   font_loader_sdf.c
+ * Author: AWTK Develop Team
+ * Brief:  signed distance field font loader
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "tkc/buffer.h"
+#include "font_loader/font_loader_sdf.h"
+
+typedef struct _font_sdf_t {
+  font_t base;
+  const uint8_t* buff;
+  uint32_t buff_size;
+} font_sdf_t;
+
+static font_sdf_index_t* font_sdf_find(font_sdf_index_t* elms, uint32_t nr, wchar_t c) {
+  int low = 0;
+  int mid = 0;
+  int high = (int)nr - 1;
+
+  while (low <= high) {
+    mid = low + ((high - low) >> 1);
+
+    if (elms[mid].c == (uint32_t)c) {
+      return elms + mid;
+    } else if (elms[mid].c < (uint32_t)c) {
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+
+  return NULL;
+}
+
+static int32_t font_sdf_scale(int32_t v, font_size_t font_size, uint32_t base) {
+  float_t r = (float_t)v * font_size / base;
+
+  return tk_roundi(r);
+}
+
+static ret_t font_sdf_get_glyph(font_t* f, wchar_t c, font_size_t font_size, glyph_t* g) {
+  uint8_t v = 0;
+  uint16_t advance = 0;
+  const uint8_t* p = NULL;
+  font_sdf_t* font = (font_sdf_t*)f;
+  font_sdf_header_t* header = (font_sdf_header_t*)(font->buff);
+  font_sdf_index_t* index = font_sdf_find(header->index, header->char_nr, c);
+  return_value_if_fail(index != NULL && index->offset > 0, RET_NOT_FOUND);
+  return_value_if_fail(index->offset + FONT_SDF_GLYPH_HEADER_SIZE < font->buff_size,
+                       RET_NOT_FOUND);
+
+  p = font->buff + index->offset;
+  load_uint8(p, v);
+  g->x = font_sdf_scale((int8_t)v, font_size, header->font_size);
+  load_uint8(p, v);
+  g->y = font_sdf_scale((int8_t)v, font_size, header->font_size);
+  load_uint16(p, advance);
+  g->advance = font_sdf_scale(advance, font_size, header->font_size);
+
+  g->data = p;
+  g->format = GLYPH_FMT_SDF;
+  g->w = tk_min(tk_max(font_sdf_scale(p[0], font_size, header->font_size), 1), 0xff);
+  g->h = tk_min(tk_max(font_sdf_scale(p[1], font_size, header->font_size), 1), 0xff);
+  if (p[0] == 0 || p[1] == 0) {
+    g->w = 0;
+    g->h = 0;
+  }
+
+  return RET_OK;
+}
+
+static bool_t font_sdf_match(font_t* f, const char* name, font_size_t font_size) {
+  (void)font_size;
+
+  return name == NULL || tk_str_eq(name, f->name);
+}
+
+static int32_t font_sdf_get_baseline(font_t* f, font_size_t font_size) {
+  font_sdf_t* font = (font_sdf_t*)f;
+  font_sdf_header_t* header = (font_sdf_header_t*)(font->buff);
+
+  return font_sdf_scale(header->baseline, font_size, header->font_size);
+}
+
+static ret_t font_sdf_destroy(font_t* f) {
+  TKMEM_FREE(f);
+
+  return RET_OK;
+}
+
+font_t* font_sdf_create(const char* name, const uint8_t* buff, uint32_t buff_size) {
+  font_sdf_t* font = NULL;
+  font_sdf_header_t* header = (font_sdf_header_t*)buff;
+  return_value_if_fail(buff != NULL && name != NULL, NULL);
+  return_value_if_fail(buff_size >= sizeof(font_sdf_header_t) && header->font_size > 0, NULL);
+
+  font = TKMEM_ZALLOC(font_sdf_t);
+  return_value_if_fail(font != NULL, NULL);
+
+  font->buff = buff;
+  font->buff_size = buff_size;
+  font->base.name = name;
+  font->base.match = font_sdf_match;
+  font->base.get_baseline = font_sdf_get_baseline;
+  font->base.get_glyph = font_sdf_get_glyph;
+  font->base.destroy = font_sdf_destroy;
+
+  return &(font->base);
+}
+
+static font_t* font_sdf_load(font_loader_t* loader, const char* name, const uint8_t* buff,
+                             uint32_t buff_size) {
+  (void)loader;
+
+  return font_sdf_create(name, buff, buff_size);
+}
+
+font_loader_t* font_loader_sdf(void) {
+  static font_loader_t loader;
+  loader.type = ASSET_TYPE_FONT_SDF;
+  loader.load = font_sdf_load;
+
+  return &loader;
+}
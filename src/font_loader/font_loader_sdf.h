@@ -0,0 +1,91 @@
+/**
+ * File:   font_loader_sdf.h
+ * Author: AWTK Develop Team
+ * Brief:  signed distance field font loader
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_FONT_LOADER_SDF_H
+#define TK_FONT_LOADER_SDF_H
+
+#include "base/font_loader.h"
+
+BEGIN_C_DECLS
+
+typedef struct _font_sdf_index_t {
+  uint32_t c;
+  uint32_t offset;
+} font_sdf_index_t;
+
+/*
+ * 每个字模的数据：x(int8) y(int8) advance(uint16)，后面是GLYPH_FMT_SDF格式的数据：
+ * w(uint8) h(uint8) spread(uint8) reserved(uint8) w*h个字节的距离。
+ * x/y/advance/w/h都是font_size大小时的值，x/y/w/h包含了spread的边距。
+ * offset为0表示字体中没有该字符。
+ */
+#define FONT_SDF_GLYPH_HEADER_SIZE 4
+
+typedef struct _font_sdf_header_t {
+  uint32_t char_nr;
+  uint8_t font_size;
+  uint8_t baseline;
+  uint8_t spread;
+  uint8_t reserved;
+  font_sdf_index_t index[1];
+} font_sdf_header_t;
+
+/**
+ * @method font_sdf_create
+ * @annotation ["constructor"]
+ * 创建距离场字体对象。
+ *
+ * @param {const char*} name 字体名称。
+ * @param {const uint8_t*} buff 字体数据(由fontgen生成，字体对象不拷贝数据)。
+ * @param {uint32_t} buff_size 字体数据的长度。
+ *
+ * @return {font_t*} 返回字体对象。
+ */
+font_t* font_sdf_create(const char* name, const uint8_t* buff, uint32_t buff_size);
+
+/**
+ * @class font_loader_sdf_t
+ * @parent font_loader_t
+ * 有向距离场(SDF)字体加载器。
+ *
+ * 距离场字体保存每个字符在一个字体大小下的有向距离场，绘制时按需要的大小采样，
+ * 一份数据可以绘制任意大小的文字，边缘清晰，不需要为每个大小生成点阵字体，也不占用glyph cache。
+ * 适合需要多种字体大小或者字体大小有动画的场景。
+ *
+ * tools/font_gen用于把矢量字体(如truetype)转换成距离场字体(格式参数为sdf)。
+ *
+ * @annotation["fake"]
+ *
+ */
+
+/**
+ * @method font_loader_sdf
+ * @annotation ["constructor"]
+ *
+ * 获取距离场字体加载器对象。
+ *
+ * @return {font_loader_t*} 返回字体加载器对象。
+ */
+font_loader_t* font_loader_sdf(void);
+
+END_C_DECLS
+
+#endif /*TK_FONT_LOADER_SDF_H*/
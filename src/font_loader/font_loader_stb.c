@@ -95,6 +95,33 @@ static ret_t font_stb_get_glyph(font_t* f, wchar_t c, font_size_t font_size, gly
   return g->data != NULL ? RET_OK : RET_NOT_FOUND;
 }
 
+static int32_t font_stb_get_kerning(font_t* f, font_size_t font_size, wchar_t c1, wchar_t c2) {
+  int g1 = 0;
+  int g2 = 0;
+  int kerning = 0;
+  font_stb_t* font = (font_stb_t*)f;
+  stbtt_fontinfo* sf = &(font->stb_font);
+
+  if (!sf->kern && !sf->gpos) {
+    return 0;
+  }
+
+  /*stb_truetype会把kern表和GPOS表的值相加，两者都有时只用kern表。*/
+  g1 = stbtt_FindGlyphIndex(sf, c1);
+  g2 = stbtt_FindGlyphIndex(sf, c2);
+  if (sf->kern) {
+    kerning = stbtt__GetGlyphKernInfoAdvance(sf, g1, g2);
+  } else {
+    kerning = stbtt__GetGlyphGPOSInfoAdvance(sf, g1, g2);
+  }
+
+  if (kerning == 0) {
+    return 0;
+  }
+
+  return tk_roundi(kerning * stbtt_ScaleForPixelHeight(sf, font_size));
+}
+
 static ret_t font_stb_destroy(font_t* f) {
   font_stb_t* font = (font_stb_t*)f;
   glyph_cache_deinit(&(font->cache));
@@ -125,6 +152,7 @@ font_t* font_stb_create(const char* name, const uint8_t* buff, uint32_t buff_siz
   f->base.match = font_stb_match;
   f->base.get_glyph = font_stb_get_glyph;
   f->base.get_baseline = font_stb_get_baseline;
+  f->base.get_kerning = font_stb_get_kerning;
   f->base.destroy = font_stb_destroy;
 
   glyph_cache_init(&(f->cache), 256, destroy_glyph);
@@ -29,8 +29,21 @@
 #define MAX_WORD_LEN 32
 
 using namespace ime_pinyin;
+
+typedef struct _input_engine_pinyin_t {
+  input_engine_t input_engine;
+
+  /*当前按键组合对应的候选字总数*/
+  uint32_t candidates_total;
+  /*下一页第一个候选字的序号*/
+  uint32_t candidates_next;
+} input_engine_pinyin_t;
+
 static ret_t input_engine_pinyin_reset_input(input_engine_t* engine) {
-  (void)engine;
+  input_engine_pinyin_t* pinyin = (input_engine_pinyin_t*)engine;
+
+  pinyin->candidates_total = 0;
+  pinyin->candidates_next = 0;
   im_reset_search();
 
   return RET_OK;
@@ -60,35 +73,61 @@ static ret_t input_engine_pinyin_add_candidate(input_engine_t* engine, wbuffer_t
   return wbuffer_write_string(wb, str);
 }
 
+/*只转换一页候选字，后面的候选字在滚动到时才转换。*/
+static ret_t input_engine_pinyin_add_page(input_engine_t* engine, wbuffer_t* wb) {
+  uint32_t nr = 0;
+  input_engine_pinyin_t* pinyin = (input_engine_pinyin_t*)engine;
+
+  while (pinyin->candidates_next < pinyin->candidates_total && nr < TK_IM_CANDIDATES_PAGE_SIZE) {
+    if (input_engine_pinyin_add_candidate(engine, wb, pinyin->candidates_next) != RET_OK) {
+      break;
+    }
+
+    nr++;
+    pinyin->candidates_next++;
+  }
+
+  engine->candidates_nr += nr;
+
+  return nr > 0 ? RET_OK : RET_DONE;
+}
+
 static ret_t input_engine_pinyin_input(input_engine_t* engine, int c) {
-  uint32_t i = 0;
   wbuffer_t wb;
-  uint32_t nr = im_search(engine->keys.str, engine->keys.size);
-  wbuffer_init(&wb, (uint8_t*)(engine->candidates), sizeof(engine->candidates));
+  input_engine_pinyin_t* pinyin = (input_engine_pinyin_t*)engine;
+
+  /*im_search从与上次搜索的公共前缀之后继续解码，追加或删除按键时不会从头搜索。*/
+  pinyin->candidates_total = im_search(engine->keys.str, engine->keys.size);
+  pinyin->candidates_next = 0;
 
+  wbuffer_init(&wb, (uint8_t*)(engine->candidates), sizeof(engine->candidates));
   wbuffer_write_string(&wb, engine->keys.str);
   engine->candidates_nr = 1;
-
-  for (i = 0; i < nr; i++) {
-    if (input_engine_pinyin_add_candidate(engine, &wb, i) == RET_OK) {
-      engine->candidates_nr++;
-    } else {
-      break;
-    }
-  }
+  input_engine_pinyin_add_page(engine, &wb);
 
   (void)c;
 
   return RET_OK;
 }
 
+static ret_t input_engine_pinyin_next_page(input_engine_t* engine) {
+  wbuffer_t wb;
+
+  wbuffer_init(&wb, (uint8_t*)(engine->candidates), sizeof(engine->candidates));
+  engine->candidates_nr = 0;
+
+  return input_engine_pinyin_add_page(engine, &wb);
+}
+
 input_engine_t* input_engine_create(void) {
-  input_engine_t* engine = TKMEM_ZALLOC(input_engine_t);
-  return_value_if_fail(engine != NULL, NULL);
+  input_engine_pinyin_t* pinyin = TKMEM_ZALLOC(input_engine_pinyin_t);
+  input_engine_t* engine = (input_engine_t*)pinyin;
+  return_value_if_fail(pinyin != NULL, NULL);
 
   str_init(&(engine->keys), TK_IM_MAX_INPUT_CHARS + 1);
   engine->reset_input = input_engine_pinyin_reset_input;
   engine->input = input_engine_pinyin_input;
+  engine->next_page = input_engine_pinyin_next_page;
 
   im_open_decoder_rom();
   im_set_max_lens(32, 16);
@@ -333,7 +333,7 @@ static ret_t children_layouter_default_layout(children_layouter_t* layouter, wid
     }
 
     for (i = 0; i < n; i++) {
-      widget_layout_children(children[i]);
+      widget_layout_children_if_needed(children[i]);
     }
   } else if (cols == 1 && rows == 0) { /*vbox*/
     w = layout_w - 2 * x_margin;
@@ -356,7 +356,7 @@ static ret_t children_layouter_default_layout(children_layouter_t* layouter, wid
     }
 
     for (i = 0; i < n; i++) {
-      widget_layout_children(children[i]);
+      widget_layout_children_if_needed(children[i]);
     }
   } else if (cols > 0 && rows > 0) { /*grid|vlist|hlist*/
     uint8_t r = 0;
@@ -399,7 +399,7 @@ static ret_t children_layouter_default_layout(children_layouter_t* layouter, wid
         x += item_w + spacing;
       }
 
-      widget_layout_children(children[i]);
+      widget_layout_children_if_needed(children[i]);
     }
   } else { /*not support*/
     log_debug("not supported(rows=%d, cols=%d)\n", rows, cols);
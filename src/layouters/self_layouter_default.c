@@ -387,6 +387,7 @@ static ret_t self_layouter_default_destroy(self_layouter_t* layouter) {
 
 static const self_layouter_vtable_t s_self_layouter_default_vtable = {
     .type = "default",
+    .cacheable = TRUE,
     .to_string = self_layouter_default_to_string,
     .get_param = self_layouter_default_get_param,
     .set_param = self_layouter_default_set_param,
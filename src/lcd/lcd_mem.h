@@ -31,6 +31,8 @@ typedef struct _lcd_mem_t {
   uint8_t* offline_fb;
   uint8_t* online_fb;
   uint8_t* next_fb;
+  /*绑定的快照(lcd_bind_snapshot)，不为空时直接绘制到快照中*/
+  uint8_t* snapshot_fb;
   vgcanvas_t* vgcanvas;
 
   uint32_t line_length;
@@ -85,6 +85,13 @@ static ret_t lcd_mem_special_draw_image_matrix(lcd_t* lcd, draw_image_info_t* in
   return lcd_draw_image_matrix(mem, info);
 }
 
+static ret_t lcd_mem_special_draw_image_smooth(lcd_t* lcd, draw_image_info_t* info) {
+  lcd_mem_special_t* special = (lcd_mem_special_t*)lcd;
+  lcd_t* mem = (lcd_t*)(special->lcd_mem);
+
+  return lcd_draw_image_smooth(mem, info);
+}
+
 static ret_t lcd_mem_special_draw_image(lcd_t* lcd, bitmap_t* img, rect_t* src, rect_t* dst) {
   lcd_mem_special_t* special = (lcd_mem_special_t*)lcd;
   lcd_t* mem = (lcd_t*)(special->lcd_mem);
@@ -130,6 +137,12 @@ static ret_t lcd_mem_special_take_snapshot(lcd_t* lcd, bitmap_t* img, bool_t aut
   return lcd_take_snapshot((lcd_t*)(special->lcd_mem), img, auto_rotate);
 }
 
+static ret_t lcd_mem_special_bind_snapshot(lcd_t* lcd, bitmap_t* img) {
+  lcd_mem_special_t* special = (lcd_mem_special_t*)lcd;
+
+  return lcd_bind_snapshot((lcd_t*)(special->lcd_mem), img);
+}
+
 static bitmap_format_t lcd_mem_special_get_desired_bitmap_format(lcd_t* lcd) {
   lcd_mem_special_t* special = (lcd_mem_special_t*)lcd;
 
@@ -215,12 +228,14 @@ lcd_t* lcd_mem_special_create(wh_t w, wh_t h, bitmap_format_t fmt, lcd_flush_t o
   lcd->fill_rect = lcd_mem_special_fill_rect;
   lcd->draw_image = lcd_mem_special_draw_image;
   lcd->draw_image_matrix = lcd_mem_special_draw_image_matrix;
+  lcd->draw_image_smooth = lcd_mem_special_draw_image_smooth;
   lcd->draw_glyph = lcd_mem_special_draw_glyph;
   lcd->draw_points = lcd_mem_special_draw_points;
   lcd->get_point_color = lcd_mem_special_get_point_color;
   lcd->end_frame = lcd_mem_special_end_frame;
   lcd->get_vgcanvas = lcd_mem_special_get_vgcanvas;
   lcd->take_snapshot = lcd_mem_special_take_snapshot;
+  lcd->bind_snapshot = lcd_mem_special_bind_snapshot;
   lcd->set_global_alpha = lcd_mem_special_set_global_alpha;
   lcd->get_desired_bitmap_format = lcd_mem_special_get_desired_bitmap_format;
   lcd->resize = lcd_mem_special_resize;
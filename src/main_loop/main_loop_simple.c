@@ -20,6 +20,8 @@
  */
 
 #include "tkc/time_now.h"
+#include "tkc/perf_trace.h"
+#include "base/widget_animator_manager.h"
 #include "main_loop/main_loop_simple.h"
 
 static ret_t main_loop_simple_queue_event(main_loop_t* l, const event_queue_req_t* r) {
@@ -156,12 +158,29 @@ static ret_t main_loop_dispatch_input(main_loop_simple_t* loop) {
 static ret_t main_loop_simple_step(main_loop_t* l) {
   main_loop_simple_t* loop = (main_loop_simple_t*)l;
 
+  PERF_TRACE_BEGIN("main_loop", "timer", NULL);
   timer_dispatch();
+  PERF_TRACE_END("main_loop", "timer");
+
+  PERF_TRACE_BEGIN("main_loop", "input", NULL);
   main_loop_dispatch_input(loop);
   main_loop_dispatch_events(loop);
+  PERF_TRACE_END("main_loop", "input");
+
+  PERF_TRACE_BEGIN("main_loop", "idle", NULL);
   idle_dispatch();
+  PERF_TRACE_END("main_loop", "idle");
+
+  /*在绘制之前更新动画，每帧只更新一次*/
+  PERF_TRACE_BEGIN("main_loop", "animate", NULL);
+  if (widget_animator_manager() != NULL) {
+    widget_animator_manager_tick(widget_animator_manager(), time_now_ms());
+  }
+  PERF_TRACE_END("main_loop", "animate");
 
+  PERF_TRACE_BEGIN("main_loop", "paint", NULL);
   window_manager_paint(loop->base.wm, &(loop->base.canvas));
+  PERF_TRACE_END("main_loop", "paint");
 
   return RET_OK;
 }
@@ -27,7 +27,7 @@ bsvg_builder_t* bsvg_builder_init(bsvg_builder_t* svg, uint32_t* buff, uint32_t
   svg->header = (bsvg_header_t*)buff;
   memset(svg->header, 0x00, sizeof(bsvg_header_t));
 
-  svg->header->version = 1;
+  svg->header->version = BSVG_VERSION;
   svg->header->stroke_width = 1;
   svg->header->magic = BSVG_MAGIC;
 
@@ -38,6 +38,32 @@ bsvg_builder_t* bsvg_builder_init(bsvg_builder_t* svg, uint32_t* buff, uint32_t
   return svg;
 }
 
+bsvg_builder_t* bsvg_builder_init_extendable(bsvg_builder_t* svg) {
+  bsvg_header_t header;
+  return_value_if_fail(svg != NULL, NULL);
+
+  memset(&header, 0x00, sizeof(header));
+  header.version = BSVG_VERSION;
+  header.stroke_width = 1;
+  header.magic = BSVG_MAGIC;
+
+  svg->current_shape_type = SVG_SHAPE_NULL;
+  wbuffer_init_extendable(&(svg->buff));
+  return_value_if_fail(wbuffer_write_binary(&(svg->buff), &header, sizeof(header)) == RET_OK, NULL);
+  svg->header = (bsvg_header_t*)(svg->buff.data);
+
+  return svg;
+}
+
+static ret_t bsvg_builder_write(bsvg_builder_t* svg, const void* data, uint32_t size) {
+  ret_t ret = wbuffer_write_binary(&(svg->buff), data, size);
+
+  /*可扩展的缓冲区写入时可能重新分配了内存*/
+  svg->header = (bsvg_header_t*)(svg->buff.data);
+
+  return ret;
+}
+
 ret_t bsvg_builder_add_shape(bsvg_builder_t* svg, const svg_shape_t* shape) {
   return_value_if_fail(svg != NULL && shape != NULL, RET_BAD_PARAMS);
 
@@ -47,14 +73,14 @@ ret_t bsvg_builder_add_shape(bsvg_builder_t* svg, const svg_shape_t* shape) {
   }
   svg->current_shape_type = (svg_shape_type_t)(shape->type);
 
-  return wbuffer_write_binary(&(svg->buff), shape, svg_shape_size(shape));
+  return bsvg_builder_write(svg, shape, svg_shape_size(shape));
 }
 
 ret_t bsvg_builder_add_sub_path(bsvg_builder_t* svg, const svg_path_t* path) {
   return_value_if_fail(svg != NULL && path != NULL, RET_BAD_PARAMS);
   return_value_if_fail(svg->current_shape_type == SVG_SHAPE_PATH, RET_BAD_PARAMS);
 
-  return wbuffer_write_binary(&(svg->buff), path, svg_path_size(path));
+  return bsvg_builder_write(svg, path, svg_path_size(path));
 }
 
 ret_t bsvg_builder_done(bsvg_builder_t* svg) {
@@ -34,6 +34,8 @@ typedef struct _bsvg_builder_t {
 } bsvg_builder_t;
 
 bsvg_builder_t* bsvg_builder_init(bsvg_builder_t* svg, uint32_t* buff, uint32_t size);
+/*使用可扩展的缓冲区，结果在buff.data中(大小为buff.cursor)，由调用者用TKMEM_FREE释放*/
+bsvg_builder_t* bsvg_builder_init_extendable(bsvg_builder_t* svg);
 
 ret_t bsvg_builder_add_shape(bsvg_builder_t* svg, const svg_shape_t* shape);
 ret_t bsvg_builder_add_sub_path(bsvg_builder_t* svg, const svg_path_t* path);
@@ -43,6 +43,10 @@ typedef struct _bsvg_header_t {
 #pragma pack(pop)
 
 #define BSVG_MAGIC 0x20181115
+
+/*v1保存SVG的shape和path，v2(svg_to_bsvg_ex)只包含预先细分的SVG_SHAPE_FLAT*/
+#define BSVG_VERSION 1
+#define BSVG_VERSION_FLAT 2
 #define BSVG_MIN_SIZE (sizeof(bsvg_header_t) + sizeof(svg_shape_t))
 
 END_C_DECLS
@@ -19,10 +19,18 @@
  *
  */
 
+#include "svg/svg_arc.h"
 #include "svg/bsvg_draw.h"
 
 /*https://www.w3.org/TR/SVG11/implnote.html#ArcImplementationNotes*/
 
+/*shape的路径和开始时的当前点(相对路径)有关*/
+typedef struct _draw_path_key_t {
+  const svg_shape_t* shape;
+  float_t x;
+  float_t y;
+} draw_path_key_t;
+
 typedef struct _draw_ctx_t {
   float_t x;
   float_t y;
@@ -37,20 +45,75 @@ typedef struct _draw_ctx_t {
   /*for T/T_REL*/
   float_t last_x1;
   float_t last_y1;
+
+  /*缓存的路径*/
+  darray_t* paths;
+  uint32_t index;
+  draw_path_key_t key;
+  /*重用了缓存的路径时，只更新当前点，不生成路径*/
+  bool_t reused;
 } draw_ctx_t;
 
 static ret_t bsvg_draw_arc_path(draw_ctx_t* ctx, const svg_path_arc_t* arc);
 
-ret_t bsvg_draw_path(draw_ctx_t* ctx, const svg_path_t* path) {
-  vgcanvas_t* canvas = ctx->canvas;
+static ret_t bsvg_draw_move_to(draw_ctx_t* ctx, float_t x, float_t y) {
+  return ctx->reused ? RET_OK : vgcanvas_move_to(ctx->canvas, x, y);
+}
+
+static ret_t bsvg_draw_line_to(draw_ctx_t* ctx, float_t x, float_t y) {
+  return ctx->reused ? RET_OK : vgcanvas_line_to(ctx->canvas, x, y);
+}
+
+static ret_t bsvg_draw_bezier_to(draw_ctx_t* ctx, float_t x1, float_t y1, float_t x2, float_t y2,
+                                 float_t x, float_t y) {
+  return ctx->reused ? RET_OK : vgcanvas_bezier_to(ctx->canvas, x1, y1, x2, y2, x, y);
+}
+
+static ret_t bsvg_draw_quad_to(draw_ctx_t* ctx, float_t x1, float_t y1, float_t x, float_t y) {
+  return ctx->reused ? RET_OK : vgcanvas_quad_to(ctx->canvas, x1, y1, x, y);
+}
+
+static ret_t bsvg_draw_close_path(draw_ctx_t* ctx) {
+  return ctx->reused ? RET_OK : vgcanvas_close_path(ctx->canvas);
+}
+
+static vgcanvas_path_t* bsvg_draw_get_path(draw_ctx_t* ctx) {
+  darray_t* paths = ctx->paths;
+
+  if (paths == NULL) {
+    return NULL;
+  }
 
+  if (ctx->index >= paths->size) {
+    vgcanvas_path_t* path = vgcanvas_path_create();
+    return_value_if_fail(path != NULL, NULL);
+
+    if (darray_push(paths, path) != RET_OK) {
+      vgcanvas_path_destroy(path);
+      return NULL;
+    }
+  }
+
+  return (vgcanvas_path_t*)(paths->elms[ctx->index]);
+}
+
+static ret_t bsvg_draw_init_key(draw_ctx_t* ctx, draw_path_key_t* key) {
+  memset(key, 0x00, sizeof(*key));
+  key->shape = ctx->shape;
+  key->x = ctx->x;
+  key->y = ctx->y;
+
+  return RET_OK;
+}
+
+ret_t bsvg_draw_path(draw_ctx_t* ctx, const svg_path_t* path) {
   switch (path->type) {
     case SVG_PATH_M: {
       const svg_path_move_t* p = (const svg_path_move_t*)path;
 
       ctx->x = p->x;
       ctx->y = p->y;
-      vgcanvas_move_to(canvas, ctx->x, ctx->y);
+      bsvg_draw_move_to(ctx, ctx->x, ctx->y);
 
       break;
     }
@@ -59,7 +122,7 @@ ret_t bsvg_draw_path(draw_ctx_t* ctx, const svg_path_t* path) {
 
       ctx->x += p->x;
       ctx->y += p->y;
-      vgcanvas_move_to(canvas, ctx->x, ctx->y);
+      bsvg_draw_move_to(ctx, ctx->x, ctx->y);
       break;
     }
     case SVG_PATH_L: {
@@ -67,7 +130,7 @@ ret_t bsvg_draw_path(draw_ctx_t* ctx, const svg_path_t* path) {
 
       ctx->x = p->x;
       ctx->y = p->y;
-      vgcanvas_line_to(canvas, ctx->x, ctx->y);
+      bsvg_draw_line_to(ctx, ctx->x, ctx->y);
       break;
     }
     case SVG_PATH_L_REL: {
@@ -75,41 +138,41 @@ ret_t bsvg_draw_path(draw_ctx_t* ctx, const svg_path_t* path) {
 
       ctx->x += p->x;
       ctx->y += p->y;
-      vgcanvas_line_to(canvas, ctx->x, ctx->y);
+      bsvg_draw_line_to(ctx, ctx->x, ctx->y);
       break;
     }
     case SVG_PATH_H: {
       const svg_path_hline_t* p = (const svg_path_hline_t*)path;
 
       ctx->x = p->x;
-      vgcanvas_line_to(canvas, ctx->x, ctx->y);
+      bsvg_draw_line_to(ctx, ctx->x, ctx->y);
       break;
     }
     case SVG_PATH_H_REL: {
       const svg_path_hline_t* p = (const svg_path_hline_t*)path;
 
       ctx->x += p->x;
-      vgcanvas_line_to(canvas, ctx->x, ctx->y);
+      bsvg_draw_line_to(ctx, ctx->x, ctx->y);
       break;
     }
     case SVG_PATH_V: {
       const svg_path_vline_t* p = (const svg_path_vline_t*)path;
 
       ctx->y = p->y;
-      vgcanvas_line_to(canvas, ctx->x, ctx->y);
+      bsvg_draw_line_to(ctx, ctx->x, ctx->y);
       break;
     }
     case SVG_PATH_V_REL: {
       const svg_path_vline_t* p = (const svg_path_vline_t*)path;
 
       ctx->y += p->y;
-      vgcanvas_line_to(canvas, ctx->x, ctx->y);
+      bsvg_draw_line_to(ctx, ctx->x, ctx->y);
       break;
     }
     case SVG_PATH_C: {
       const svg_path_curve_to_t* p = (const svg_path_curve_to_t*)path;
 
-      vgcanvas_bezier_to(canvas, p->x1, p->y1, p->x2, p->y2, p->x, p->y);
+      bsvg_draw_bezier_to(ctx, p->x1, p->y1, p->x2, p->y2, p->x, p->y);
       ctx->x = p->x;
       ctx->y = p->y;
       ctx->last_x2 = p->x2;
@@ -126,7 +189,7 @@ ret_t bsvg_draw_path(draw_ctx_t* ctx, const svg_path_t* path) {
       float_t x = ctx->x + p->x;
       float_t y = ctx->y + p->y;
 
-      vgcanvas_bezier_to(canvas, x1, y1, x2, y2, x, y);
+      bsvg_draw_bezier_to(ctx, x1, y1, x2, y2, x, y);
       ctx->x = x;
       ctx->y = y;
       ctx->last_x2 = x2;
@@ -138,7 +201,7 @@ ret_t bsvg_draw_path(draw_ctx_t* ctx, const svg_path_t* path) {
       float_t x1 = 2 * ctx->x - ctx->last_x2;
       float_t y1 = 2 * ctx->y - ctx->last_y2;
 
-      vgcanvas_bezier_to(canvas, x1, y1, p->x2, p->y2, p->x, p->y);
+      bsvg_draw_bezier_to(ctx, x1, y1, p->x2, p->y2, p->x, p->y);
 
       ctx->x = p->x;
       ctx->y = p->y;
@@ -155,7 +218,7 @@ ret_t bsvg_draw_path(draw_ctx_t* ctx, const svg_path_t* path) {
       float_t x = ctx->x + p->x;
       float_t y = ctx->y + p->y;
 
-      vgcanvas_bezier_to(canvas, x1, y1, x2, y2, x, y);
+      bsvg_draw_bezier_to(ctx, x1, y1, x2, y2, x, y);
 
       ctx->x = x;
       ctx->y = y;
@@ -165,7 +228,7 @@ ret_t bsvg_draw_path(draw_ctx_t* ctx, const svg_path_t* path) {
     }
     case SVG_PATH_Q: {
       const svg_path_qcurve_to_t* p = (const svg_path_qcurve_to_t*)path;
-      vgcanvas_quad_to(canvas, p->x1, p->y1, p->x, p->y);
+      bsvg_draw_quad_to(ctx, p->x1, p->y1, p->x, p->y);
       ctx->x = p->x;
       ctx->y = p->y;
       ctx->last_x1 = p->x1;
@@ -179,7 +242,7 @@ ret_t bsvg_draw_path(draw_ctx_t* ctx, const svg_path_t* path) {
       float_t x = ctx->x + p->x;
       float_t y = ctx->y + p->y;
 
-      vgcanvas_quad_to(canvas, x1, y1, x, y);
+      bsvg_draw_quad_to(ctx, x1, y1, x, y);
       ctx->x = x;
       ctx->y = y;
       ctx->last_x1 = x1;
@@ -191,7 +254,7 @@ ret_t bsvg_draw_path(draw_ctx_t* ctx, const svg_path_t* path) {
       float_t x1 = 2 * ctx->x - ctx->last_x1;
       float_t y1 = 2 * ctx->y - ctx->last_y1;
 
-      vgcanvas_quad_to(canvas, x1, y1, p->x, p->y);
+      bsvg_draw_quad_to(ctx, x1, y1, p->x, p->y);
 
       ctx->x = p->x;
       ctx->y = p->y;
@@ -206,7 +269,7 @@ ret_t bsvg_draw_path(draw_ctx_t* ctx, const svg_path_t* path) {
       float_t x = ctx->x + p->x;
       float_t y = ctx->y + p->y;
 
-      vgcanvas_quad_to(canvas, x1, y1, x, y);
+      bsvg_draw_quad_to(ctx, x1, y1, x, y);
 
       ctx->x = x;
       ctx->y = y;
@@ -225,7 +288,7 @@ ret_t bsvg_draw_path(draw_ctx_t* ctx, const svg_path_t* path) {
       break;
     }
     case SVG_PATH_Z: {
-      vgcanvas_close_path(canvas);
+      bsvg_draw_close_path(ctx);
       break;
     }
     case SVG_PATH_NULL:
@@ -262,6 +325,13 @@ static ret_t bsvg_draw_set_line_join(vgcanvas_t* canvas, char line_join) {
 ret_t bsvg_draw_shape_end(draw_ctx_t* ctx, const svg_shape_t* shape) {
   vgcanvas_t* canvas = ctx->canvas;
   bsvg_header_t* header = ctx->bsvg->header;
+  vgcanvas_path_t* path = ctx->reused ? NULL : bsvg_draw_get_path(ctx);
+
+  if (path != NULL) {
+    vgcanvas_retain_path(canvas, path, &(ctx->key), sizeof(ctx->key));
+  }
+  ctx->reused = FALSE;
+  ctx->index++;
 
   if (shape->line_cap) {
     bsvg_draw_set_line_cap(canvas, shape->line_cap);
@@ -308,8 +378,18 @@ ret_t bsvg_draw_shape_end(draw_ctx_t* ctx, const svg_shape_t* shape) {
 
 ret_t bsvg_draw_shape(draw_ctx_t* ctx, const svg_shape_t* shape) {
   vgcanvas_t* canvas = ctx->canvas;
+  vgcanvas_path_t* path = shape->type != SVG_SHAPE_NULL ? bsvg_draw_get_path(ctx) : NULL;
 
   vgcanvas_begin_path(canvas);
+  if (path != NULL) {
+    bsvg_draw_init_key(ctx, &(ctx->key));
+    if (vgcanvas_reuse_path(canvas, path, &(ctx->key), sizeof(ctx->key)) == RET_OK) {
+      /*SVG_SHAPE_PATH的子路径仍然需要遍历，以更新当前点*/
+      ctx->reused = TRUE;
+      return shape->type == SVG_SHAPE_PATH ? RET_OK : bsvg_draw_shape_end(ctx, shape);
+    }
+  }
+
   switch (shape->type) {
     case SVG_SHAPE_RECT: {
       svg_shape_rect_t* s = (svg_shape_rect_t*)shape;
@@ -368,6 +448,27 @@ ret_t bsvg_draw_shape(draw_ctx_t* ctx, const svg_shape_t* shape) {
 
       break;
     }
+    case SVG_SHAPE_FLAT: {
+      uint32_t i = 0;
+      uint32_t j = 0;
+      svg_shape_flat_t* s = (svg_shape_flat_t*)shape;
+      const float_t* p = svg_shape_flat_get_points(s);
+
+      for (i = 0; i < s->subpaths_nr; i++) {
+        uint32_t nr = s->data[i] & ~SVG_SHAPE_FLAT_CLOSED;
+
+        vgcanvas_move_to(canvas, p[0], p[1]);
+        for (j = 1; j < nr; j++) {
+          vgcanvas_line_to(canvas, p[2 * j], p[2 * j + 1]);
+        }
+        if (s->data[i] & SVG_SHAPE_FLAT_CLOSED) {
+          vgcanvas_close_path(canvas);
+        }
+        p += 2 * nr;
+      }
+
+      break;
+    }
     case SVG_SHAPE_PATH: {
       return RET_OK;
     }
@@ -401,12 +502,26 @@ static ret_t bsvg_draw_on_shape(void* ctx, const void* data) {
   const svg_shape_t* shape = (const svg_shape_t*)data;
 
   info->shape = shape;
+  if (shape->type == SVG_SHAPE_FLAT) {
+    const svg_shape_flat_t* s = (const svg_shape_flat_t*)shape;
+
+    /*完全在裁剪区之外，不需要生成路径(仍然占用一个缓存的路径，保持后面shape的路径对应关系)*/
+    if (!vgcanvas_is_rect_visible(info->canvas, s->x, s->y, s->w, s->h)) {
+      bsvg_draw_get_path(info);
+      info->index++;
+      return RET_OK;
+    }
+  }
   bsvg_draw_shape(info, shape);
 
   return RET_OK;
 }
 
 ret_t bsvg_draw(bsvg_t* svg, vgcanvas_t* canvas) {
+  return bsvg_draw_ex(svg, canvas, NULL);
+}
+
+ret_t bsvg_draw_ex(bsvg_t* svg, vgcanvas_t* canvas, darray_t* paths) {
   float_t sx = 1;
   float_t sy = 1;
   draw_ctx_t ctx;
@@ -418,6 +533,9 @@ ret_t bsvg_draw(bsvg_t* svg, vgcanvas_t* canvas) {
   ctx.bsvg = svg;
   ctx.shape = NULL;
   ctx.canvas = canvas;
+  ctx.paths = paths;
+  ctx.index = 0;
+  ctx.reused = FALSE;
 
   vgcanvas_save(canvas);
   if (header->w && header->h && header->viewport.w && header->viewport.h) {
@@ -432,138 +550,6 @@ ret_t bsvg_draw(bsvg_t* svg, vgcanvas_t* canvas) {
   return RET_OK;
 }
 
-/*Adapt from https://github.com/mozilla/newtab-dev/blob/master/dom/svg/nsSVGPathDataParser.cpp
- * begin:*/
-typedef struct _arc_info_t {
-  uint32_t seg_index;
-  uint32_t num_segs;
-  float_t rx;
-  float_t ry;
-  float_t sin_phi;
-  float_t cos_phi;
-  pointf_t c;
-  float_t delta;
-  pointf_t from;
-  float_t t;
-  float_t theta;
-} arc_info_t;
-
-static float_t calc_vector_angle(float_t ux, float_t uy, float_t vx, float_t vy) {
-  float_t ta = atan2(uy, ux);
-  float_t tb = atan2(vy, vx);
-  if (tb >= ta) return tb - ta;
-
-  return 2 * M_PI - (ta - tb);
-}
-
-static ret_t arc_info_init(arc_info_t* info, pointf_t from, pointf_t to, pointf_t radii,
-                           float_t angle, bool_t largeArcFlag, bool_t sweepFlag) {
-  const float_t radPerDeg = M_PI / 180.0f;
-  info->seg_index = 0;
-
-  if (from.x == to.x && from.y == to.y) {
-    info->num_segs = 0;
-    return RET_OK;
-  }
-  /*
-  // Convert to center parameterization as shown in
-  // http://www.w3.org/TR/SVG/implnote.html
-  */
-  info->rx = fabs(radii.x);
-  info->ry = fabs(radii.y);
-
-  info->sin_phi = sin(angle * radPerDeg);
-  info->cos_phi = cos(angle * radPerDeg);
-
-  float_t x1dash = info->cos_phi * (from.x - to.x) / 2.0f + info->sin_phi * (from.y - to.y) / 2.0f;
-  float_t y1dash = -info->sin_phi * (from.x - to.x) / 2.0f + info->cos_phi * (from.y - to.y) / 2.0f;
-
-  float_t root;
-  float_t numerator = info->rx * info->rx * info->ry * info->ry -
-                      info->rx * info->rx * y1dash * y1dash - info->ry * info->ry * x1dash * x1dash;
-
-  if (numerator < 0.0f) {
-    /*
-    //  If info->rx , info->ry and are such that there is no solution (basically,
-    //  the ellipse is not big enough to reach from 'from' to 'to'
-    //  then the ellipse is scaled up uniformly until there is
-    //  exactly one solution (until the ellipse is just big enough).
-
-    // -> find factor s, such that numerator' with info->rx'=s*info->rx and
-    //    info->ry'=s*info->ry becomes 0 :
-    */
-    float_t s = sqrt(1.0f - numerator / (info->rx * info->rx * info->ry * info->ry));
-
-    info->rx *= s;
-    info->ry *= s;
-    root = 0.0f;
-
-  } else {
-    root = (largeArcFlag == sweepFlag ? -1.0f : 1.0f) *
-           sqrt(numerator /
-                (info->rx * info->rx * y1dash * y1dash + info->ry * info->ry * x1dash * x1dash));
-  }
-
-  float_t cxdash = root * info->rx * y1dash / info->ry;
-  float_t cydash = -root * info->ry * x1dash / info->rx;
-
-  info->c.x = info->cos_phi * cxdash - info->sin_phi * cydash + (from.x + to.x) / 2.0f;
-  info->c.y = info->sin_phi * cxdash + info->cos_phi * cydash + (from.y + to.y) / 2.0f;
-  info->theta =
-      calc_vector_angle(1.0f, 0.0f, (x1dash - cxdash) / info->rx, (y1dash - cydash) / info->ry);
-  float_t dtheta = calc_vector_angle((x1dash - cxdash) / info->rx, (y1dash - cydash) / info->ry,
-                                     (-x1dash - cxdash) / info->rx, (-y1dash - cydash) / info->ry);
-  if (!sweepFlag && dtheta > 0)
-    dtheta -= 2.0f * M_PI;
-  else if (sweepFlag && dtheta < 0)
-    dtheta += 2.0f * M_PI;
-
-  /* Convert into cubic bezier segments <= 90deg */
-  info->num_segs = (int32_t)(ceil(fabs(dtheta / (M_PI / 2.0f))));
-  info->delta = dtheta / info->num_segs;
-  info->t =
-      8.0f / 3.0f * sin(info->delta / 4.0f) * sin(info->delta / 4.0f) / sin(info->delta / 2.0f);
-
-  info->from = from;
-
-  return RET_OK;
-}
-
-bool_t arc_info_next(arc_info_t* info, pointf_t* cp1, pointf_t* cp2, pointf_t* to) {
-  if (info->seg_index == info->num_segs) {
-    return FALSE;
-  }
-
-  float_t cosTheta1 = cos(info->theta);
-  float_t sinTheta1 = sin(info->theta);
-  float_t theta2 = info->theta + info->delta;
-  float_t cosTheta2 = cos(theta2);
-  float_t sinTheta2 = sin(theta2);
-
-  /* a) calculate endpoint of the segment:*/
-  to->x = info->cos_phi * info->rx * cosTheta2 - info->sin_phi * info->ry * sinTheta2 + info->c.x;
-  to->y = info->sin_phi * info->rx * cosTheta2 + info->cos_phi * info->ry * sinTheta2 + info->c.y;
-
-  /* b) calculate gradients at start/end points of segment:*/
-  cp1->x = info->from.x +
-           info->t * (-info->cos_phi * info->rx * sinTheta1 - info->sin_phi * info->ry * cosTheta1);
-  cp1->y = info->from.y +
-           info->t * (-info->sin_phi * info->rx * sinTheta1 + info->cos_phi * info->ry * cosTheta1);
-
-  cp2->x = to->x +
-           info->t * (info->cos_phi * info->rx * sinTheta2 + info->sin_phi * info->ry * cosTheta2);
-  cp2->y = to->y +
-           info->t * (info->sin_phi * info->rx * sinTheta2 - info->cos_phi * info->ry * cosTheta2);
-
-  /* do next segment*/
-  info->theta = theta2;
-  info->from = *to;
-  ++info->seg_index;
-
-  return TRUE;
-}
-/*Adapt from https://github.com/mozilla/newtab-dev/blob/master/dom/svg/nsSVGPathDataParser.cpp end*/
-
 static ret_t bsvg_draw_arc_path(draw_ctx_t* ctx, const svg_path_arc_t* arc) {
   arc_info_t info;
   pointf_t cp1 = {0, 0};
@@ -572,16 +558,21 @@ static ret_t bsvg_draw_arc_path(draw_ctx_t* ctx, const svg_path_arc_t* arc) {
   pointf_t r = {arc->rx, arc->ry};
   pointf_t from = {ctx->x, ctx->y};
   pointf_t to = {arc->x, arc->y};
-  vgcanvas_t* canvas = ctx->canvas;
 
   if (arc->path.type == SVG_PATH_A_REL) {
     to.x += ctx->x;
     to.y += ctx->y;
   }
 
+  if (ctx->reused) {
+    ctx->x = to.x;
+    ctx->y = to.y;
+    return RET_OK;
+  }
+
   arc_info_init(&info, from, to, r, arc->rotation, arc->large_arc, arc->sweep);
   while (arc_info_next(&info, &cp1, &cp2, &end)) {
-    vgcanvas_bezier_to(canvas, cp1.x, cp1.y, cp2.x, cp2.y, end.x, end.y);
+    bsvg_draw_bezier_to(ctx, cp1.x, cp1.y, cp2.x, cp2.y, end.x, end.y);
   }
 
   ctx->x = to.x;
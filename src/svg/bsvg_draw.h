@@ -23,12 +23,20 @@
 #define TK_BSVG_DRAW_H
 
 #include "svg/bsvg.h"
+#include "tkc/darray.h"
 #include "base/vgcanvas.h"
 
 BEGIN_C_DECLS
 
 ret_t bsvg_draw(bsvg_t* svg, vgcanvas_t* canvas);
 
+/*
+ * 绘制bsvg，并把每个shape的路径缓存到paths(元素为vgcanvas_path_t*)中。
+ * 下次绘制时，如果只有平移发生了变化，直接使用缓存的路径。
+ * paths的destroy函数应为vgcanvas_path_destroy。
+ */
+ret_t bsvg_draw_ex(bsvg_t* svg, vgcanvas_t* canvas, darray_t* paths);
+
 END_C_DECLS
 
 #endif /*TK_BSVG_DRAW_H*/
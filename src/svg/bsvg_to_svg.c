@@ -254,6 +254,27 @@ ret_t bsvg_to_svg_shape(str_t* str, const svg_shape_t* shape) {
       str_append(str, "<path d=\"");
       return RET_OK;
     }
+    case SVG_SHAPE_FLAT: {
+      uint32_t i = 0;
+      uint32_t j = 0;
+      svg_shape_flat_t* s = (svg_shape_flat_t*)shape;
+      const float_t* p = svg_shape_flat_get_points(s);
+
+      str_append(str, "<path d=\"");
+      for (i = 0; i < s->subpaths_nr; i++) {
+        uint32_t nr = s->data[i] & ~SVG_SHAPE_FLAT_CLOSED;
+
+        for (j = 0; j < nr; j++, p += 2) {
+          tk_snprintf(buff, sizeof(buff) - 1, " %c%.1f %.1f", j == 0 ? 'M' : 'L', p[0], p[1]);
+          str_append(str, buff);
+        }
+        if (s->data[i] & SVG_SHAPE_FLAT_CLOSED) {
+          str_append(str, " Z");
+        }
+      }
+      str_append_char(str, '\"');
+      break;
+    }
     case SVG_SHAPE_NULL: {
       return RET_OK;
     }
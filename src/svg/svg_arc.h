@@ -0,0 +1,50 @@
+/**
+ * File:   svg_arc.h
+ * Author: AWTK Develop Team
+ * Brief:  convert svg arc to bezier curves
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_SVG_ARC_H
+#define TK_SVG_ARC_H
+
+#include "tkc/rect.h"
+
+BEGIN_C_DECLS
+
+/*把SVG的圆弧(A/a)转换成不超过90度的三次贝塞尔曲线，供bsvg_draw和svg_flatten使用*/
+typedef struct _arc_info_t {
+  uint32_t seg_index;
+  uint32_t num_segs;
+  float_t rx;
+  float_t ry;
+  float_t sin_phi;
+  float_t cos_phi;
+  pointf_t c;
+  float_t delta;
+  pointf_t from;
+  float_t t;
+  float_t theta;
+} arc_info_t;
+
+ret_t arc_info_init(arc_info_t* info, pointf_t from, pointf_t to, pointf_t radii, float_t angle,
+                    bool_t largeArcFlag, bool_t sweepFlag);
+bool_t arc_info_next(arc_info_t* info, pointf_t* cp1, pointf_t* cp2, pointf_t* to);
+
+END_C_DECLS
+
+#endif /*TK_SVG_ARC_H*/
@@ -0,0 +1,546 @@
+/**
+ * File:   svg_flatten.c
+ * Author: AWTK Develop Team
+ * Brief:  flatten svg shapes to polylines
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "svg/svg_arc.h"
+#include "svg/svg_flatten.h"
+
+/*用4段三次贝塞尔曲线近似椭圆时控制点的比例(与nanovg相同)*/
+#define SVG_FLATTEN_KAPPA 0.5522847493f
+#define SVG_FLATTEN_MAX_LEVEL 10
+#define SVG_FLATTEN_DIST_TOL 0.001f
+
+svg_flatten_t* svg_flatten_init(svg_flatten_t* flatten, float_t tolerance) {
+  return_value_if_fail(flatten != NULL && tolerance > 0, NULL);
+
+  memset(flatten, 0x00, sizeof(*flatten));
+  flatten->tolerance = tolerance;
+  wbuffer_init_extendable(&(flatten->subpaths));
+  wbuffer_init_extendable(&(flatten->points));
+  svg_flatten_set_transform(flatten, NULL);
+
+  return flatten;
+}
+
+ret_t svg_flatten_set_transform(svg_flatten_t* flatten, const float_t* matrix) {
+  return_value_if_fail(flatten != NULL, RET_BAD_PARAMS);
+
+  if (matrix != NULL) {
+    memcpy(flatten->m, matrix, sizeof(flatten->m));
+  } else {
+    memset(flatten->m, 0x00, sizeof(flatten->m));
+    flatten->m[0] = 1;
+    flatten->m[3] = 1;
+  }
+
+  return RET_OK;
+}
+
+static ret_t svg_flatten_add_point(svg_flatten_t* flatten, float_t x, float_t y) {
+  if (flatten->nr > 0 && tk_abs(flatten->px - x) < SVG_FLATTEN_DIST_TOL &&
+      tk_abs(flatten->py - y) < SVG_FLATTEN_DIST_TOL) {
+    return RET_OK;
+  }
+
+  wbuffer_write_float(&(flatten->points), x);
+  wbuffer_write_float(&(flatten->points), y);
+  flatten->px = x;
+  flatten->py = y;
+  flatten->nr++;
+
+  return RET_OK;
+}
+
+static ret_t svg_flatten_end_sub_path(svg_flatten_t* flatten, bool_t closed) {
+  if (flatten->nr == 1) {
+    /*只有一个点的子路径不会绘制任何东西*/
+    wbuffer_skip(&(flatten->points), -(int32_t)(2 * sizeof(float_t)));
+  } else if (flatten->nr > 1) {
+    uint32_t nr = flatten->nr | (closed ? SVG_SHAPE_FLAT_CLOSED : 0);
+    wbuffer_write_uint32(&(flatten->subpaths), nr);
+  }
+  flatten->nr = 0;
+
+  return RET_OK;
+}
+
+static void svg_flatten_transform(svg_flatten_t* flatten, float_t x, float_t y, float_t* ox,
+                                  float_t* oy) {
+  const float_t* m = flatten->m;
+
+  *ox = m[0] * x + m[2] * y + m[4];
+  *oy = m[1] * x + m[3] * y + m[5];
+}
+
+/*与nanovg的nvg__tesselateBezier相同，tolerance是控制点到弦的距离*/
+static void svg_flatten_bezier(svg_flatten_t* flatten, float_t x1, float_t y1, float_t x2,
+                               float_t y2, float_t x3, float_t y3, float_t x4, float_t y4,
+                               uint32_t level) {
+  float_t x12, y12, x23, y23, x34, y34, x123, y123, x234, y234, x1234, y1234;
+  float_t dx = x4 - x1;
+  float_t dy = y4 - y1;
+  float_t d2 = tk_abs((x2 - x4) * dy - (y2 - y4) * dx);
+  float_t d3 = tk_abs((x3 - x4) * dy - (y3 - y4) * dx);
+  float_t tol = flatten->tolerance;
+
+  if (level >= SVG_FLATTEN_MAX_LEVEL || (d2 + d3) * (d2 + d3) <= tol * tol * (dx * dx + dy * dy)) {
+    svg_flatten_add_point(flatten, x4, y4);
+    return;
+  }
+
+  x12 = (x1 + x2) * 0.5f;
+  y12 = (y1 + y2) * 0.5f;
+  x23 = (x2 + x3) * 0.5f;
+  y23 = (y2 + y3) * 0.5f;
+  x34 = (x3 + x4) * 0.5f;
+  y34 = (y3 + y4) * 0.5f;
+  x123 = (x12 + x23) * 0.5f;
+  y123 = (y12 + y23) * 0.5f;
+  x234 = (x23 + x34) * 0.5f;
+  y234 = (y23 + y34) * 0.5f;
+  x1234 = (x123 + x234) * 0.5f;
+  y1234 = (y123 + y234) * 0.5f;
+
+  svg_flatten_bezier(flatten, x1, y1, x12, y12, x123, y123, x1234, y1234, level + 1);
+  svg_flatten_bezier(flatten, x1234, y1234, x234, y234, x34, y34, x4, y4, level + 1);
+}
+
+static ret_t svg_flatten_move_to(svg_flatten_t* flatten, float_t x, float_t y) {
+  float_t px = 0;
+  float_t py = 0;
+
+  svg_flatten_end_sub_path(flatten, FALSE);
+  svg_flatten_transform(flatten, x, y, &px, &py);
+
+  return svg_flatten_add_point(flatten, px, py);
+}
+
+static ret_t svg_flatten_begin_sub_path(svg_flatten_t* flatten) {
+  /*没有move_to(如close_path之后)时从最后一个点开始*/
+  if (flatten->nr == 0) {
+    float_t px = flatten->px;
+    float_t py = flatten->py;
+
+    return svg_flatten_add_point(flatten, px, py);
+  }
+
+  return RET_OK;
+}
+
+static ret_t svg_flatten_line_to(svg_flatten_t* flatten, float_t x, float_t y) {
+  float_t px = 0;
+  float_t py = 0;
+
+  svg_flatten_begin_sub_path(flatten);
+  svg_flatten_transform(flatten, x, y, &px, &py);
+
+  return svg_flatten_add_point(flatten, px, py);
+}
+
+static ret_t svg_flatten_bezier_to(svg_flatten_t* flatten, float_t x1, float_t y1, float_t x2,
+                                   float_t y2, float_t x, float_t y) {
+  float_t p[6];
+
+  svg_flatten_begin_sub_path(flatten);
+  svg_flatten_transform(flatten, x1, y1, p, p + 1);
+  svg_flatten_transform(flatten, x2, y2, p + 2, p + 3);
+  svg_flatten_transform(flatten, x, y, p + 4, p + 5);
+  svg_flatten_bezier(flatten, flatten->px, flatten->py, p[0], p[1], p[2], p[3], p[4], p[5], 0);
+
+  return RET_OK;
+}
+
+static ret_t svg_flatten_quad_to(svg_flatten_t* flatten, float_t x0, float_t y0, float_t x1,
+                                 float_t y1, float_t x, float_t y) {
+  /*二次曲线升阶为三次曲线，(x0, y0)为起点*/
+  return svg_flatten_bezier_to(flatten, x0 + 2.0f / 3.0f * (x1 - x0), y0 + 2.0f / 3.0f * (y1 - y0),
+                               x + 2.0f / 3.0f * (x1 - x), y + 2.0f / 3.0f * (y1 - y), x, y);
+}
+
+static ret_t svg_flatten_close_path(svg_flatten_t* flatten) {
+  return svg_flatten_end_sub_path(flatten, TRUE);
+}
+
+static ret_t svg_flatten_ellipse(svg_flatten_t* flatten, float_t cx, float_t cy, float_t rx,
+                                 float_t ry) {
+  float_t kx = rx * SVG_FLATTEN_KAPPA;
+  float_t ky = ry * SVG_FLATTEN_KAPPA;
+
+  svg_flatten_move_to(flatten, cx - rx, cy);
+  svg_flatten_bezier_to(flatten, cx - rx, cy + ky, cx - kx, cy + ry, cx, cy + ry);
+  svg_flatten_bezier_to(flatten, cx + kx, cy + ry, cx + rx, cy + ky, cx + rx, cy);
+  svg_flatten_bezier_to(flatten, cx + rx, cy - ky, cx + kx, cy - ry, cx, cy - ry);
+  svg_flatten_bezier_to(flatten, cx - kx, cy - ry, cx - rx, cy - ky, cx - rx, cy);
+
+  return svg_flatten_close_path(flatten);
+}
+
+/*与vgcanvas_arc(0到2*M_PI)相同：从0度开始顺时针，路径不封闭*/
+static ret_t svg_flatten_circle(svg_flatten_t* flatten, float_t cx, float_t cy, float_t r) {
+  float_t k = r * SVG_FLATTEN_KAPPA;
+
+  svg_flatten_move_to(flatten, cx + r, cy);
+  svg_flatten_bezier_to(flatten, cx + r, cy + k, cx + k, cy + r, cx, cy + r);
+  svg_flatten_bezier_to(flatten, cx - k, cy + r, cx - r, cy + k, cx - r, cy);
+  svg_flatten_bezier_to(flatten, cx - r, cy - k, cx - k, cy - r, cx, cy - r);
+
+  return svg_flatten_bezier_to(flatten, cx + k, cy - r, cx + r, cy - k, cx + r, cy);
+}
+
+/*与nanovg的nvgRoundedRect相同*/
+static ret_t svg_flatten_rect(svg_flatten_t* flatten, float_t x, float_t y, float_t w, float_t h,
+                              float_t r) {
+  float_t k = 1 - SVG_FLATTEN_KAPPA;
+  float_t rx = tk_min(r, tk_abs(w) * 0.5f) * (w < 0 ? -1 : 1);
+  float_t ry = tk_min(r, tk_abs(h) * 0.5f) * (h < 0 ? -1 : 1);
+
+  if (r < 0.1f) {
+    svg_flatten_move_to(flatten, x, y);
+    svg_flatten_line_to(flatten, x, y + h);
+    svg_flatten_line_to(flatten, x + w, y + h);
+    svg_flatten_line_to(flatten, x + w, y);
+
+    return svg_flatten_close_path(flatten);
+  }
+
+  svg_flatten_move_to(flatten, x, y + ry);
+  svg_flatten_line_to(flatten, x, y + h - ry);
+  svg_flatten_bezier_to(flatten, x, y + h - ry * k, x + rx * k, y + h, x + rx, y + h);
+  svg_flatten_line_to(flatten, x + w - rx, y + h);
+  svg_flatten_bezier_to(flatten, x + w - rx * k, y + h, x + w, y + h - ry * k, x + w, y + h - ry);
+  svg_flatten_line_to(flatten, x + w, y + ry);
+  svg_flatten_bezier_to(flatten, x + w, y + ry * k, x + w - rx * k, y, x + w - rx, y);
+  svg_flatten_line_to(flatten, x + rx, y);
+  svg_flatten_bezier_to(flatten, x + rx * k, y, x, y + ry * k, x, y + ry);
+
+  return svg_flatten_close_path(flatten);
+}
+
+static ret_t svg_flatten_points(svg_flatten_t* flatten, const float_t* data, uint32_t nr) {
+  uint32_t i = 0;
+
+  for (i = 0; i + 1 < nr; i += 2) {
+    if (i == 0) {
+      svg_flatten_move_to(flatten, data[i], data[i + 1]);
+    } else {
+      svg_flatten_line_to(flatten, data[i], data[i + 1]);
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t svg_flatten_add_shape(svg_flatten_t* flatten, const svg_shape_t* shape) {
+  return_value_if_fail(flatten != NULL && shape != NULL, RET_BAD_PARAMS);
+
+  /*和bsvg_draw_shape生成的路径一致*/
+  switch (shape->type) {
+    case SVG_SHAPE_RECT: {
+      const svg_shape_rect_t* s = (const svg_shape_rect_t*)shape;
+      return svg_flatten_rect(flatten, s->x, s->y, s->w, s->h, s->r);
+    }
+    case SVG_SHAPE_CIRCLE: {
+      const svg_shape_circle_t* s = (const svg_shape_circle_t*)shape;
+      return svg_flatten_circle(flatten, s->cx, s->cy, s->r);
+    }
+    case SVG_SHAPE_ELLIPSE: {
+      const svg_shape_ellipse_t* s = (const svg_shape_ellipse_t*)shape;
+      return svg_flatten_ellipse(flatten, s->cx, s->cy, s->rx, s->ry);
+    }
+    case SVG_SHAPE_LINE: {
+      const svg_shape_line_t* s = (const svg_shape_line_t*)shape;
+
+      svg_flatten_move_to(flatten, s->x1, s->y1);
+      return svg_flatten_line_to(flatten, s->x2, s->y2);
+    }
+    case SVG_SHAPE_POLYGON: {
+      const svg_shape_polygon_t* s = (const svg_shape_polygon_t*)shape;
+      return svg_flatten_points(flatten, s->data, s->nr);
+    }
+    case SVG_SHAPE_POLYLINE: {
+      const svg_shape_polyline_t* s = (const svg_shape_polyline_t*)shape;
+
+      svg_flatten_points(flatten, s->data, s->nr);
+      return svg_flatten_close_path(flatten);
+    }
+    default: {
+      /*SVG_SHAPE_PATH的子路径由svg_flatten_add_path添加*/
+      return RET_OK;
+    }
+  }
+}
+
+static ret_t svg_flatten_arc(svg_flatten_t* flatten, const svg_path_arc_t* arc) {
+  arc_info_t info;
+  pointf_t cp1 = {0, 0};
+  pointf_t cp2 = {0, 0};
+  pointf_t end = {0, 0};
+  pointf_t r = {arc->rx, arc->ry};
+  pointf_t from = {flatten->x, flatten->y};
+  pointf_t to = {arc->x, arc->y};
+
+  if (arc->path.type == SVG_PATH_A_REL) {
+    to.x += flatten->x;
+    to.y += flatten->y;
+  }
+
+  arc_info_init(&info, from, to, r, arc->rotation, arc->large_arc, arc->sweep);
+  while (arc_info_next(&info, &cp1, &cp2, &end)) {
+    svg_flatten_bezier_to(flatten, cp1.x, cp1.y, cp2.x, cp2.y, end.x, end.y);
+  }
+
+  flatten->x = to.x;
+  flatten->y = to.y;
+
+  return RET_OK;
+}
+
+ret_t svg_flatten_add_path(svg_flatten_t* flatten, const svg_path_t* path) {
+  float_t x0 = 0;
+  float_t y0 = 0;
+  return_value_if_fail(flatten != NULL && path != NULL, RET_BAD_PARAMS);
+
+  /*当前点的处理和bsvg_draw_path一致*/
+  x0 = flatten->x;
+  y0 = flatten->y;
+  switch (path->type) {
+    case SVG_PATH_M:
+    case SVG_PATH_M_REL: {
+      const svg_path_move_t* p = (const svg_path_move_t*)path;
+      bool_t rel = path->type == SVG_PATH_M_REL;
+
+      flatten->x = rel ? x0 + p->x : p->x;
+      flatten->y = rel ? y0 + p->y : p->y;
+      svg_flatten_move_to(flatten, flatten->x, flatten->y);
+      break;
+    }
+    case SVG_PATH_L:
+    case SVG_PATH_L_REL: {
+      const svg_path_line_t* p = (const svg_path_line_t*)path;
+      bool_t rel = path->type == SVG_PATH_L_REL;
+
+      flatten->x = rel ? x0 + p->x : p->x;
+      flatten->y = rel ? y0 + p->y : p->y;
+      svg_flatten_line_to(flatten, flatten->x, flatten->y);
+      break;
+    }
+    case SVG_PATH_H:
+    case SVG_PATH_H_REL: {
+      const svg_path_hline_t* p = (const svg_path_hline_t*)path;
+
+      flatten->x = path->type == SVG_PATH_H_REL ? x0 + p->x : p->x;
+      svg_flatten_line_to(flatten, flatten->x, flatten->y);
+      break;
+    }
+    case SVG_PATH_V:
+    case SVG_PATH_V_REL: {
+      const svg_path_vline_t* p = (const svg_path_vline_t*)path;
+
+      flatten->y = path->type == SVG_PATH_V_REL ? y0 + p->y : p->y;
+      svg_flatten_line_to(flatten, flatten->x, flatten->y);
+      break;
+    }
+    case SVG_PATH_C:
+    case SVG_PATH_C_REL: {
+      const svg_path_curve_to_t* p = (const svg_path_curve_to_t*)path;
+      float_t dx = path->type == SVG_PATH_C_REL ? x0 : 0;
+      float_t dy = path->type == SVG_PATH_C_REL ? y0 : 0;
+
+      flatten->last_x2 = dx + p->x2;
+      flatten->last_y2 = dy + p->y2;
+      flatten->x = dx + p->x;
+      flatten->y = dy + p->y;
+      svg_flatten_bezier_to(flatten, dx + p->x1, dy + p->y1, flatten->last_x2, flatten->last_y2,
+                            flatten->x, flatten->y);
+      break;
+    }
+    case SVG_PATH_S:
+    case SVG_PATH_S_REL: {
+      const svg_path_scurve_to_t* p = (const svg_path_scurve_to_t*)path;
+      float_t dx = path->type == SVG_PATH_S_REL ? x0 : 0;
+      float_t dy = path->type == SVG_PATH_S_REL ? y0 : 0;
+      float_t x1 = 2 * x0 - flatten->last_x2;
+      float_t y1 = 2 * y0 - flatten->last_y2;
+
+      flatten->last_x2 = dx + p->x2;
+      flatten->last_y2 = dy + p->y2;
+      flatten->x = dx + p->x;
+      flatten->y = dy + p->y;
+      svg_flatten_bezier_to(flatten, x1, y1, flatten->last_x2, flatten->last_y2, flatten->x,
+                            flatten->y);
+      break;
+    }
+    case SVG_PATH_Q:
+    case SVG_PATH_Q_REL: {
+      const svg_path_qcurve_to_t* p = (const svg_path_qcurve_to_t*)path;
+      float_t dx = path->type == SVG_PATH_Q_REL ? x0 : 0;
+      float_t dy = path->type == SVG_PATH_Q_REL ? y0 : 0;
+
+      flatten->last_x1 = dx + p->x1;
+      flatten->last_y1 = dy + p->y1;
+      flatten->x = dx + p->x;
+      flatten->y = dy + p->y;
+      svg_flatten_quad_to(flatten, x0, y0, flatten->last_x1, flatten->last_y1, flatten->x,
+                          flatten->y);
+      break;
+    }
+    case SVG_PATH_T:
+    case SVG_PATH_T_REL: {
+      const svg_path_tcurve_to_t* p = (const svg_path_tcurve_to_t*)path;
+      float_t dx = path->type == SVG_PATH_T_REL ? x0 : 0;
+      float_t dy = path->type == SVG_PATH_T_REL ? y0 : 0;
+
+      flatten->last_x1 = 2 * x0 - flatten->last_x1;
+      flatten->last_y1 = 2 * y0 - flatten->last_y1;
+      flatten->x = dx + p->x;
+      flatten->y = dy + p->y;
+      svg_flatten_quad_to(flatten, x0, y0, flatten->last_x1, flatten->last_y1, flatten->x,
+                          flatten->y);
+      break;
+    }
+    case SVG_PATH_A:
+    case SVG_PATH_A_REL: {
+      svg_flatten_arc(flatten, (const svg_path_arc_t*)path);
+      break;
+    }
+    case SVG_PATH_Z: {
+      svg_flatten_close_path(flatten);
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t svg_flatten_reset(svg_flatten_t* flatten) {
+  flatten->nr = 0;
+  flatten->subpaths.cursor = 0;
+  flatten->points.cursor = 0;
+
+  return RET_OK;
+}
+
+static uint8_t svg_flatten_stroke_width(const svg_shape_t* shape, const bsvg_header_t* header) {
+  if (shape->stroke_width) {
+    return shape->stroke_width;
+  } else if (header->stroke_width) {
+    return header->stroke_width;
+  } else {
+    return 1;
+  }
+}
+
+static ret_t svg_flatten_init_bounds(svg_shape_flat_t* s, const bsvg_header_t* header) {
+  uint32_t i = 0;
+  const float_t* p = svg_shape_flat_get_points(s);
+  float_t x1 = p[0];
+  float_t y1 = p[1];
+  float_t x2 = p[0];
+  float_t y2 = p[1];
+
+  for (i = 1; i < s->points_nr; i++) {
+    float_t x = p[2 * i];
+    float_t y = p[2 * i + 1];
+
+    x1 = tk_min(x1, x);
+    y1 = tk_min(y1, y);
+    x2 = tk_max(x2, x);
+    y2 = tk_max(y2, y);
+  }
+
+  if (!s->shape.no_stroke) {
+    /*miter的尖角最长为miter_limit(缺省为10)倍的半线宽，round/bevel和线帽不超过1.5倍*/
+    uint8_t line_join = s->shape.line_join ? s->shape.line_join : header->line_join;
+    float_t ext = svg_flatten_stroke_width(&(s->shape), header) * 0.5f;
+
+    ext *= (line_join == 'r' || line_join == 'b') ? 1.5f : 10.0f;
+    x1 -= ext;
+    y1 -= ext;
+    x2 += ext;
+    y2 += ext;
+  }
+
+  s->x = x1;
+  s->y = y1;
+  s->w = x2 - x1;
+  s->h = y2 - y1;
+
+  return RET_OK;
+}
+
+ret_t svg_flatten_end(svg_flatten_t* flatten, const svg_shape_t* shape, bsvg_builder_t* builder) {
+  ret_t ret = RET_OK;
+  uint32_t size = 0;
+  svg_shape_flat_t* s = NULL;
+  const float_t* m = NULL;
+  float_t scale = 1;
+  return_value_if_fail(flatten != NULL && shape != NULL && builder != NULL, RET_BAD_PARAMS);
+
+  svg_flatten_end_sub_path(flatten, FALSE);
+  if (flatten->subpaths.cursor == 0) {
+    /*没有可以绘制的内容*/
+    return svg_flatten_reset(flatten);
+  }
+
+  size = sizeof(svg_shape_flat_t) - sizeof(s->data) + flatten->subpaths.cursor +
+         flatten->points.cursor;
+  s = (svg_shape_flat_t*)TKMEM_ALLOC(size);
+  goto_error_if_fail(s != NULL);
+
+  svg_shape_flat_init(s);
+  s->shape = *shape;
+  s->shape.type = SVG_SHAPE_FLAT;
+  s->subpaths_nr = flatten->subpaths.cursor / sizeof(uint32_t);
+  s->points_nr = flatten->points.cursor / (2 * sizeof(float_t));
+  memcpy(s->data, flatten->subpaths.data, flatten->subpaths.cursor);
+  memcpy(s->data + s->subpaths_nr, flatten->points.data, flatten->points.cursor);
+
+  /*transform已经应用到坐标上，线宽也要按变换的缩放比例调整*/
+  m = flatten->m;
+  scale = sqrt(tk_abs(m[0] * m[3] - m[1] * m[2]));
+  if (tk_abs(scale - 1) > 0.001f) {
+    float_t w = svg_flatten_stroke_width(shape, builder->header) * scale + 0.5f;
+
+    s->shape.stroke_width = (uint8_t)tk_clampi((int32_t)w, 1, 255);
+  }
+
+  svg_flatten_init_bounds(s, builder->header);
+  ret = bsvg_builder_add_shape(builder, (svg_shape_t*)s);
+  TKMEM_FREE(s);
+  svg_flatten_reset(flatten);
+
+  return ret;
+error:
+  svg_flatten_reset(flatten);
+  return RET_OOM;
+}
+
+ret_t svg_flatten_deinit(svg_flatten_t* flatten) {
+  return_value_if_fail(flatten != NULL, RET_BAD_PARAMS);
+
+  wbuffer_deinit(&(flatten->subpaths));
+  wbuffer_deinit(&(flatten->points));
+
+  return RET_OK;
+}
@@ -0,0 +1,71 @@
+/**
+ * File:   svg_flatten.h
+ * Author: AWTK Develop Team
+ * Brief:  flatten svg shapes to polylines
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_SVG_FLATTEN_H
+#define TK_SVG_FLATTEN_H
+
+#include "svg/bsvg_builder.h"
+
+BEGIN_C_DECLS
+
+/*
+ * 把shape和path转换成SVG_SHAPE_FLAT(BSVG v2)：先对坐标应用transform，再把曲线和圆弧细分成折线，
+ * 这样绘制时不需要再解析路径和细分曲线。
+ */
+typedef struct _svg_flatten_t {
+  /*细分的误差(变换后的坐标)*/
+  float_t tolerance;
+  /*x' = m[0] * x + m[2] * y + m[4], y' = m[1] * x + m[3] * y + m[5]*/
+  float_t m[6];
+
+  /*当前点和上一个控制点(变换前的坐标)，与bsvg_draw一样在shape之间保持*/
+  float_t x;
+  float_t y;
+  float_t last_x1;
+  float_t last_y1;
+  float_t last_x2;
+  float_t last_y2;
+
+  /*当前子路径的点数和最后一个点(变换后的坐标)*/
+  uint32_t nr;
+  float_t px;
+  float_t py;
+
+  wbuffer_t subpaths;
+  wbuffer_t points;
+} svg_flatten_t;
+
+svg_flatten_t* svg_flatten_init(svg_flatten_t* flatten, float_t tolerance);
+/*matrix为NULL时使用单位矩阵*/
+ret_t svg_flatten_set_transform(svg_flatten_t* flatten, const float_t* matrix);
+
+/*把shape(SVG_SHAPE_PATH的子路径用svg_flatten_add_path添加)细分后加入当前shape*/
+ret_t svg_flatten_add_shape(svg_flatten_t* flatten, const svg_shape_t* shape);
+ret_t svg_flatten_add_path(svg_flatten_t* flatten, const svg_path_t* path);
+
+/*用shape的样式生成SVG_SHAPE_FLAT并加入builder，然后开始下一个shape*/
+ret_t svg_flatten_end(svg_flatten_t* flatten, const svg_shape_t* shape, bsvg_builder_t* builder);
+
+ret_t svg_flatten_deinit(svg_flatten_t* flatten);
+
+END_C_DECLS
+
+#endif /*TK_SVG_FLATTEN_H*/
@@ -54,6 +54,12 @@ uint32_t svg_shape_size(const svg_shape_t* shape) {
       size = sizeof(svg_shape_path_t);
       break;
     }
+    case SVG_SHAPE_FLAT: {
+      svg_shape_flat_t* s = (svg_shape_flat_t*)shape;
+      size = sizeof(svg_shape_flat_t) - sizeof(s->data) + s->subpaths_nr * sizeof(uint32_t) +
+             s->points_nr * 2 * sizeof(float_t);
+      break;
+    }
     case SVG_SHAPE_NULL: {
       size = sizeof(svg_shape_t);
       break;
@@ -157,3 +163,13 @@ svg_shape_t* svg_shape_path_init(svg_shape_path_t* s) {
 
   return (svg_shape_t*)s;
 }
+
+svg_shape_t* svg_shape_flat_init(svg_shape_flat_t* s) {
+  return_value_if_fail(s != NULL, NULL);
+
+  memset(s, 0x00, sizeof(*s));
+
+  s->shape.type = SVG_SHAPE_FLAT;
+
+  return (svg_shape_t*)s;
+}
@@ -34,7 +34,8 @@ typedef enum _svg_shape_type_t {
   SVG_SHAPE_LINE,
   SVG_SHAPE_POLYGON,
   SVG_SHAPE_POLYLINE,
-  SVG_SHAPE_PATH
+  SVG_SHAPE_PATH,
+  SVG_SHAPE_FLAT
 } svg_shape_type_t;
 
 #pragma pack(push, 1)
@@ -99,8 +100,28 @@ typedef struct _svg_shape_path_t {
 
   svg_path_t path[1];
 } svg_shape_path_t;
+
+/*
+ * 预先细分的shape(BSVG v2)：圆弧和曲线已经细分成折线，transform已经应用到坐标上。
+ * data中先是subpaths_nr个子路径的点数(SVG_SHAPE_FLAT_CLOSED表示子路径是封闭的)，
+ * 后面是points_nr个点(x, y)。
+ */
+typedef struct _svg_shape_flat_t {
+  svg_shape_t shape;
+  /*包围盒(包括描边的宽度)，绘制时用来剔除裁剪区之外的shape*/
+  float_t x;
+  float_t y;
+  float_t w;
+  float_t h;
+  uint32_t subpaths_nr;
+  uint32_t points_nr;
+  uint32_t data[1];
+} svg_shape_flat_t;
 #pragma pack(pop)
 
+#define SVG_SHAPE_FLAT_CLOSED 0x80000000u
+#define svg_shape_flat_get_points(s) ((const float_t*)((s)->data + (s)->subpaths_nr))
+
 uint32_t svg_shape_size(const svg_shape_t* shape);
 
 svg_shape_t* svg_shape_rect_init(svg_shape_rect_t* s, float_t x, float_t y, float_t w, float_t h,
@@ -113,6 +134,7 @@ svg_shape_t* svg_shape_line_init(svg_shape_line_t* s, float_t x1, float_t y1, fl
 svg_shape_t* svg_shape_polygon_init(svg_shape_polygon_t* s);
 svg_shape_t* svg_shape_polyline_init(svg_shape_polyline_t* s);
 svg_shape_t* svg_shape_path_init(svg_shape_path_t* s);
+svg_shape_t* svg_shape_flat_init(svg_shape_flat_t* s);
 
 END_C_DECLS
 
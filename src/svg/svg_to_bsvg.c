@@ -26,15 +26,29 @@
 #include "svg/svg_to_bsvg.h"
 #include "svg/svg_path_parser.h"
 #include "svg/bsvg_builder.h"
+#include "svg/svg_flatten.h"
+
+#define SVG_GROUP_MAX_DEPTH 16
 
 typedef struct _xml_builder_t {
   XmlBuilder builder;
 
   bsvg_builder_t bsvg;
+
+  /*v2：shape细分后保存为SVG_SHAPE_FLAT，v1时为NULL*/
+  svg_flatten_t* flatten;
+  /*细分的误差(输出的像素)*/
+  float_t tolerance;
+
+  /*g的transform的累积，v1不使用*/
+  float_t matrix[6];
+  uint32_t depth;
+  float_t stack[SVG_GROUP_MAX_DEPTH][6];
 } xml_builder_t;
 
-static void svg_on_svg_tag(bsvg_builder_t* svg, const char** attrs) {
+static void svg_on_svg_tag(xml_builder_t* b, const char** attrs) {
   uint32_t i = 0;
+  bsvg_builder_t* svg = &(b->bsvg);
   int32_t x = 0;
   int32_t y = 0;
   int32_t w = 0;
@@ -58,18 +72,174 @@ static void svg_on_svg_tag(bsvg_builder_t* svg, const char** attrs) {
     i += 2;
   }
 
+  if (b->flatten != NULL) {
+    /*细分在viewBox的坐标中进行，把误差从像素换算到viewBox的坐标*/
+    float_t tolerance = b->tolerance;
+    bsvg_header_t* header = svg->header;
+
+    if (header->w && header->h && header->viewport.w && header->viewport.h) {
+      float_t sx = (float_t)(header->w) / (float_t)(header->viewport.w);
+      float_t sy = (float_t)(header->h) / (float_t)(header->viewport.h);
+
+      tolerance /= tk_max(sx, sy);
+    }
+    b->flatten->tolerance = tolerance;
+  }
+
+  return;
+}
+
+static void svg_matrix_identity(float_t* m) {
+  memset(m, 0x00, sizeof(float_t) * 6);
+  m[0] = 1;
+  m[3] = 1;
+}
+
+/*m = m * t：坐标先经过t变换，再经过m变换*/
+static void svg_matrix_multiply(float_t* m, const float_t* t) {
+  float_t r[6];
+
+  r[0] = m[0] * t[0] + m[2] * t[1];
+  r[1] = m[1] * t[0] + m[3] * t[1];
+  r[2] = m[0] * t[2] + m[2] * t[3];
+  r[3] = m[1] * t[2] + m[3] * t[3];
+  r[4] = m[0] * t[4] + m[2] * t[5] + m[4];
+  r[5] = m[1] * t[4] + m[3] * t[5] + m[5];
+
+  memcpy(m, r, sizeof(r));
+}
+
+/*transform="translate(10 20) rotate(45, 5 5)"：把变换列表依次乘到m上*/
+static ret_t svg_parse_transform(const char* str, float_t* m) {
+  const char* p = str;
+
+  while (*p) {
+    uint32_t i = 0;
+    uint32_t nr = 0;
+    float_t a[6];
+    float_t t[6];
+    char name[16];
+    char args[128];
+    const char* end = NULL;
+
+    while (*p == ' ' || *p == ',' || *p == '\t' || *p == '\r' || *p == '\n') {
+      p++;
+    }
+    for (i = 0; *p && *p != '(' && *p != ' ' && i < sizeof(name) - 1; i++) {
+      name[i] = *p++;
+    }
+    name[i] = '\0';
+
+    p = strchr(p, '(');
+    end = p != NULL ? strchr(p, ')') : NULL;
+    if (end == NULL) {
+      break;
+    }
+
+    /*参数之间可以用空格或者逗号分隔*/
+    p++;
+    for (i = 0; p < end && i < sizeof(args) - 1; i++, p++) {
+      args[i] = (*p == ',' || *p == '\t' || *p == '\r' || *p == '\n') ? ' ' : *p;
+    }
+    args[i] = '\0';
+    nr = svg_parse_numbers(args, a, ARRAY_SIZE(a));
+    p = end + 1;
+
+    svg_matrix_identity(t);
+    if (tk_str_eq(name, "matrix") && nr == 6) {
+      memcpy(t, a, sizeof(t));
+    } else if (tk_str_eq(name, "translate") && nr >= 1) {
+      t[4] = a[0];
+      t[5] = nr > 1 ? a[1] : 0;
+    } else if (tk_str_eq(name, "scale") && nr >= 1) {
+      t[0] = a[0];
+      t[3] = nr > 1 ? a[1] : a[0];
+    } else if (tk_str_eq(name, "rotate") && nr >= 1) {
+      float_t cx = nr >= 3 ? a[1] : 0;
+      float_t cy = nr >= 3 ? a[2] : 0;
+      float_t cs = cos(TK_D2R(a[0]));
+      float_t sn = sin(TK_D2R(a[0]));
+
+      t[0] = cs;
+      t[1] = sn;
+      t[2] = -sn;
+      t[3] = cs;
+      t[4] = cx - cs * cx + sn * cy;
+      t[5] = cy - sn * cx - cs * cy;
+    } else if (tk_str_eq(name, "skewX") && nr >= 1) {
+      t[2] = tan(TK_D2R(a[0]));
+    } else if (tk_str_eq(name, "skewY") && nr >= 1) {
+      t[1] = tan(TK_D2R(a[0]));
+    } else {
+      log_debug("not supported transform: %s\n", name);
+      continue;
+    }
+
+    svg_matrix_multiply(m, t);
+  }
+
+  return RET_OK;
+}
+
+static void svg_on_group_start(xml_builder_t* b, const char** attrs) {
+  const char* transform = xml_builder_get_attr(attrs, "transform");
+
+  if (b->depth < SVG_GROUP_MAX_DEPTH) {
+    memcpy(b->stack[b->depth], b->matrix, sizeof(b->matrix));
+  }
+  b->depth++;
+
+  if (transform != NULL) {
+    svg_parse_transform(transform, b->matrix);
+  }
+
+  return;
+}
+
+static void svg_on_group_end(xml_builder_t* b) {
+  return_if_fail(b->depth > 0);
+
+  b->depth--;
+  if (b->depth < SVG_GROUP_MAX_DEPTH) {
+    memcpy(b->matrix, b->stack[b->depth], sizeof(b->matrix));
+  }
+
   return;
 }
 
 static ret_t svg_on_sub_path(void* ctx, const void* data) {
-  bsvg_builder_t* svg = (bsvg_builder_t*)ctx;
+  xml_builder_t* b = (xml_builder_t*)ctx;
   const svg_path_t* path = (const svg_path_t*)data;
 
-  bsvg_builder_add_sub_path(svg, path);
+  if (b->flatten != NULL) {
+    svg_flatten_add_path(b->flatten, path);
+  } else {
+    bsvg_builder_add_sub_path(&(b->bsvg), path);
+  }
 
   return RET_OK;
 }
 
+static ret_t svg_add_shape(xml_builder_t* b, const svg_shape_t* shape, const char** attrs) {
+  float_t m[6];
+  const char* transform = NULL;
+
+  if (b->flatten == NULL) {
+    return bsvg_builder_add_shape(&(b->bsvg), shape);
+  }
+
+  memcpy(m, b->matrix, sizeof(m));
+  transform = xml_builder_get_attr(attrs, "transform");
+  if (transform != NULL) {
+    svg_parse_transform(transform, m);
+  }
+  svg_flatten_set_transform(b->flatten, m);
+  svg_flatten_add_shape(b->flatten, shape);
+
+  /*SVG_SHAPE_PATH在子路径都添加之后才结束*/
+  return shape->type == SVG_SHAPE_PATH ? RET_OK : svg_flatten_end(b->flatten, shape, &(b->bsvg));
+}
+
 static void svg_init_shape(bsvg_builder_t* svg, svg_shape_t* shape, const char** attrs) {
   uint32_t i = 0;
   bsvg_header_t* header = svg->header;
@@ -106,26 +276,30 @@ static void svg_init_shape(bsvg_builder_t* svg, svg_shape_t* shape, const char**
   return;
 }
 
-static void svg_on_shape_path(bsvg_builder_t* svg, const char** attrs) {
+static void svg_on_shape_path(xml_builder_t* b, const char** attrs) {
   uint32_t i = 0;
   svg_shape_path_t s;
   svg_shape_path_init(&s);
-  svg_init_shape(svg, (svg_shape_t*)&s, attrs);
-  bsvg_builder_add_shape(svg, (svg_shape_t*)&s);
+  svg_init_shape(&(b->bsvg), (svg_shape_t*)&s, attrs);
+  svg_add_shape(b, (svg_shape_t*)&s, attrs);
 
   while (attrs[i] != NULL) {
     const char* k = attrs[i];
     const char* v = attrs[i + 1];
     if (tk_str_eq(k, "d")) {
-      svg_path_parse(v, svg, svg_on_sub_path);
+      svg_path_parse(v, b, svg_on_sub_path);
     }
     i += 2;
   }
 
+  if (b->flatten != NULL) {
+    svg_flatten_end(b->flatten, (svg_shape_t*)&s, &(b->bsvg));
+  }
+
   return;
 }
 
-static void svg_on_shape_line(bsvg_builder_t* svg, const char** attrs) {
+static void svg_on_shape_line(xml_builder_t* b, const char** attrs) {
   float_t x1 = 0;
   float_t y1 = 0;
   float_t x2 = 0;
@@ -149,13 +323,13 @@ static void svg_on_shape_line(bsvg_builder_t* svg, const char** attrs) {
   }
 
   svg_shape_line_init(&s, x1, y1, x2, y2);
-  svg_init_shape(svg, (svg_shape_t*)&s, attrs);
-  bsvg_builder_add_shape(svg, (svg_shape_t*)&s);
+  svg_init_shape(&(b->bsvg), (svg_shape_t*)&s, attrs);
+  svg_add_shape(b, (svg_shape_t*)&s, attrs);
 
   return;
 }
 
-static void svg_on_shape_rect(bsvg_builder_t* svg, const char** attrs) {
+static void svg_on_shape_rect(xml_builder_t* b, const char** attrs) {
   float_t x = 0;
   float_t y = 0;
   float_t w = 0;
@@ -182,13 +356,13 @@ static void svg_on_shape_rect(bsvg_builder_t* svg, const char** attrs) {
   }
 
   svg_shape_rect_init(&s, x, y, w, h, r);
-  svg_init_shape(svg, (svg_shape_t*)&s, attrs);
-  bsvg_builder_add_shape(svg, (svg_shape_t*)&s);
+  svg_init_shape(&(b->bsvg), (svg_shape_t*)&s, attrs);
+  svg_add_shape(b, (svg_shape_t*)&s, attrs);
 
   return;
 }
 
-static void svg_on_shape_circle(bsvg_builder_t* svg, const char** attrs) {
+static void svg_on_shape_circle(xml_builder_t* b, const char** attrs) {
   float_t x = 0;
   float_t y = 0;
   float_t r = 0;
@@ -209,13 +383,13 @@ static void svg_on_shape_circle(bsvg_builder_t* svg, const char** attrs) {
   }
 
   svg_shape_circle_init(&s, x, y, r);
-  svg_init_shape(svg, (svg_shape_t*)&s, attrs);
-  bsvg_builder_add_shape(svg, (svg_shape_t*)&s);
+  svg_init_shape(&(b->bsvg), (svg_shape_t*)&s, attrs);
+  svg_add_shape(b, (svg_shape_t*)&s, attrs);
 
   return;
 }
 
-static void svg_on_shape_ellipse(bsvg_builder_t* svg, const char** attrs) {
+static void svg_on_shape_ellipse(xml_builder_t* b, const char** attrs) {
   float_t x = 0;
   float_t y = 0;
   float_t rx = 0;
@@ -239,8 +413,8 @@ static void svg_on_shape_ellipse(bsvg_builder_t* svg, const char** attrs) {
   }
 
   svg_shape_ellipse_init(&s, x, y, rx, ry);
-  svg_init_shape(svg, (svg_shape_t*)&s, attrs);
-  bsvg_builder_add_shape(svg, (svg_shape_t*)&s);
+  svg_init_shape(&(b->bsvg), (svg_shape_t*)&s, attrs);
+  svg_add_shape(b, (svg_shape_t*)&s, attrs);
 
   return;
 }
@@ -317,7 +491,7 @@ uint32_t svg_parse_numbers(const char* str, float_t* out, uint32_t max_nr) {
   return parser.nr;
 }
 
-static void svg_on_shape_polygon(bsvg_builder_t* svg, const char** attrs) {
+static void svg_on_shape_polygon(xml_builder_t* b, const char** attrs) {
   uint32_t i = 0;
   svg_shape_polygon_t* s = NULL;
 
@@ -338,15 +512,15 @@ static void svg_on_shape_polygon(bsvg_builder_t* svg, const char** attrs) {
   }
 
   if (s != NULL) {
-    svg_init_shape(svg, (svg_shape_t*)s, attrs);
-    bsvg_builder_add_shape(svg, (svg_shape_t*)s);
+    svg_init_shape(&(b->bsvg), (svg_shape_t*)s, attrs);
+    svg_add_shape(b, (svg_shape_t*)s, attrs);
     TKMEM_FREE(s);
   }
 
   return;
 }
 
-static void svg_on_shape_polyline(bsvg_builder_t* svg, const char** attrs) {
+static void svg_on_shape_polyline(xml_builder_t* b, const char** attrs) {
   uint32_t i = 0;
   svg_shape_polyline_t* s = NULL;
 
@@ -367,8 +541,8 @@ static void svg_on_shape_polyline(bsvg_builder_t* svg, const char** attrs) {
   }
 
   if (s != NULL) {
-    svg_init_shape(svg, (svg_shape_t*)s, attrs);
-    bsvg_builder_add_shape(svg, (svg_shape_t*)s);
+    svg_init_shape(&(b->bsvg), (svg_shape_t*)s, attrs);
+    svg_add_shape(b, (svg_shape_t*)s, attrs);
     TKMEM_FREE(s);
   }
 
@@ -377,24 +551,35 @@ static void svg_on_shape_polyline(bsvg_builder_t* svg, const char** attrs) {
 
 static void svg_on_start(XmlBuilder* thiz, const char* tag, const char** attrs) {
   xml_builder_t* b = (xml_builder_t*)thiz;
-  bsvg_builder_t* svg = &(b->bsvg);
 
   if (tk_str_eq(tag, "svg")) {
-    svg_on_svg_tag(svg, attrs);
+    svg_on_svg_tag(b, attrs);
+  } else if (tk_str_eq(tag, "g")) {
+    svg_on_group_start(b, attrs);
   } else if (tk_str_eq(tag, "path")) {
-    svg_on_shape_path(svg, attrs);
+    svg_on_shape_path(b, attrs);
   } else if (tk_str_eq(tag, "rect")) {
-    svg_on_shape_rect(svg, attrs);
+    svg_on_shape_rect(b, attrs);
   } else if (tk_str_eq(tag, "circle")) {
-    svg_on_shape_circle(svg, attrs);
+    svg_on_shape_circle(b, attrs);
   } else if (tk_str_eq(tag, "ellipse")) {
-    svg_on_shape_ellipse(svg, attrs);
+    svg_on_shape_ellipse(b, attrs);
   } else if (tk_str_eq(tag, "line")) {
-    svg_on_shape_line(svg, attrs);
+    svg_on_shape_line(b, attrs);
   } else if (tk_str_eq(tag, "polygon")) {
-    svg_on_shape_polygon(svg, attrs);
+    svg_on_shape_polygon(b, attrs);
   } else if (tk_str_eq(tag, "polyline")) {
-    svg_on_shape_polyline(svg, attrs);
+    svg_on_shape_polyline(b, attrs);
+  }
+
+  return;
+}
+
+static void svg_on_end(XmlBuilder* thiz, const char* tag) {
+  xml_builder_t* b = (xml_builder_t*)thiz;
+
+  if (tk_str_eq(tag, "g")) {
+    svg_on_group_end(b);
   }
 
   return;
@@ -410,8 +595,14 @@ static XmlBuilder* builder_init(xml_builder_t* b, uint32_t* buff, uint32_t buff_
   memset(b, 0x00, sizeof(*b));
 
   b->builder.on_start = svg_on_start;
+  b->builder.on_end = svg_on_end;
   b->builder.on_error = svg_on_error;
-  bsvg_builder_init(&(b->bsvg), buff, buff_size);
+  svg_matrix_identity(b->matrix);
+  if (buff != NULL) {
+    bsvg_builder_init(&(b->bsvg), buff, buff_size);
+  } else {
+    bsvg_builder_init_extendable(&(b->bsvg));
+  }
 
   return &(b->builder);
 }
@@ -436,3 +627,39 @@ ret_t svg_to_bsvg(const char* xml, uint32_t size, uint32_t** out, uint32_t* out_
 
   return RET_OK;
 }
+
+ret_t svg_to_bsvg_ex(const char* xml, uint32_t size, float_t tolerance, uint32_t** out,
+                     uint32_t* out_size) {
+  xml_builder_t b;
+  svg_flatten_t flatten;
+  XmlParser* parser = NULL;
+  return_value_if_fail(xml != NULL && out != NULL && out_size != NULL, RET_BAD_PARAMS);
+
+  if (tolerance <= 0) {
+    return svg_to_bsvg(xml, size, out, out_size);
+  }
+
+  /*细分后的大小和原文件没有固定的比例，使用可扩展的缓冲区*/
+  parser = xml_parser_create();
+  return_value_if_fail(parser != NULL, RET_OOM);
+
+  xml_parser_set_builder(parser, builder_init(&b, NULL, 0));
+  if (b.bsvg.header == NULL) {
+    xml_parser_destroy(parser);
+    return RET_OOM;
+  }
+
+  b.tolerance = tolerance;
+  b.flatten = svg_flatten_init(&flatten, tolerance);
+  b.bsvg.header->version = BSVG_VERSION_FLAT;
+
+  xml_parser_parse(parser, xml, size);
+  bsvg_builder_done(&(b.bsvg));
+  svg_flatten_deinit(&flatten);
+  xml_parser_destroy(parser);
+
+  *out = (uint32_t*)(b.bsvg.buff.data);
+  *out_size = b.bsvg.buff.cursor;
+
+  return RET_OK;
+}
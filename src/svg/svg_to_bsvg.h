@@ -28,6 +28,13 @@ BEGIN_C_DECLS
 
 ret_t svg_to_bsvg(const char* xml, uint32_t size, uint32_t** out, uint32_t* out_size);
 
+/*
+ * 生成BSVG v2：应用transform，把曲线和圆弧按tolerance(输出的像素)细分成折线，
+ * 并计算每个shape的包围盒。tolerance<=0时与svg_to_bsvg相同。结果由调用者用TKMEM_FREE释放。
+ */
+ret_t svg_to_bsvg_ex(const char* xml, uint32_t size, float_t tolerance, uint32_t** out,
+                     uint32_t* out_size);
+
 /*public for test*/
 uint32_t svg_parse_numbers(const char* str, float_t* out, uint32_t max_nr);
 
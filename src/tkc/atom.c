@@ -0,0 +1,205 @@
+/**
+ * File:   atom.c
+ * Author: AWTK Develop Team
+ * Brief:  interned string atoms
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/atom.h"
+#include "tkc/utils.h"
+
+#define ATOM_MIN_BUCKETS 128
+
+typedef struct _atom_table_t {
+  /*以原子为下标的字符串数组，ID小于ATOM_STATIC_MAX的是静态原子(不拷贝)。*/
+  const char** strs;
+  uint32_t capacity;
+  uint32_t next;
+
+  /*开放地址的哈希表，存放原子ID，0表示空位。*/
+  atom_t* buckets;
+  uint32_t buckets_nr;
+  uint32_t size;
+} atom_table_t;
+
+static atom_table_t s_atom_table;
+
+static uint32_t atom_hash(const char* str) {
+  uint32_t hash = 5381;
+
+  while (*str) {
+    hash = ((hash << 5) + hash) + (uint8_t)(*str++);
+  }
+
+  return hash;
+}
+
+static atom_t* atom_table_find_slot(atom_table_t* t, const char* str) {
+  uint32_t mask = t->buckets_nr - 1;
+  uint32_t i = atom_hash(str) & mask;
+
+  while (t->buckets[i] != ATOM_NONE) {
+    if (tk_str_eq(t->strs[t->buckets[i]], str)) {
+      break;
+    }
+    i = (i + 1) & mask;
+  }
+
+  return t->buckets + i;
+}
+
+static ret_t atom_table_rehash(atom_table_t* t, uint32_t buckets_nr) {
+  uint32_t i = 0;
+  atom_t* old = t->buckets;
+  uint32_t old_nr = t->buckets_nr;
+  atom_t* buckets = TKMEM_ZALLOCN(atom_t, buckets_nr);
+  return_value_if_fail(buckets != NULL, RET_OOM);
+
+  t->buckets = buckets;
+  t->buckets_nr = buckets_nr;
+  for (i = 0; i < old_nr; i++) {
+    atom_t atom = old[i];
+    if (atom != ATOM_NONE) {
+      *atom_table_find_slot(t, t->strs[atom]) = atom;
+    }
+  }
+  TKMEM_FREE(old);
+
+  return RET_OK;
+}
+
+static ret_t atom_table_extend(atom_table_t* t, atom_t atom) {
+  if (t->strs == NULL) {
+    t->strs = TKMEM_ZALLOCN(const char*, ATOM_STATIC_MAX * 2);
+    return_value_if_fail(t->strs != NULL, RET_OOM);
+
+    t->capacity = ATOM_STATIC_MAX * 2;
+    t->next = ATOM_STATIC_MAX;
+  }
+
+  if (atom == ATOM_NONE) {
+    atom = t->next;
+  }
+
+  if (atom >= t->capacity) {
+    uint32_t capacity = t->capacity + t->capacity / 2;
+    const char** strs = TKMEM_REALLOCT(const char*, t->strs, capacity);
+    return_value_if_fail(strs != NULL, RET_OOM);
+
+    memset(strs + t->capacity, 0x00, (capacity - t->capacity) * sizeof(const char*));
+    t->strs = strs;
+    t->capacity = capacity;
+  }
+
+  if ((t->size + 1) * 2 > t->buckets_nr) {
+    uint32_t buckets_nr = t->buckets_nr ? t->buckets_nr * 2 : ATOM_MIN_BUCKETS;
+    return atom_table_rehash(t, buckets_nr);
+  }
+
+  return RET_OK;
+}
+
+static atom_t atom_table_add(atom_table_t* t, const char* str, atom_t atom) {
+  atom_t* slot = NULL;
+  return_value_if_fail(atom_table_extend(t, atom) == RET_OK, ATOM_NONE);
+
+  slot = atom_table_find_slot(t, str);
+  if (*slot != ATOM_NONE) {
+    if (atom != ATOM_NONE && *slot >= ATOM_STATIC_MAX) {
+      /*已经作为动态原子存在，改为对应静态原子，原来的动态原子仍然有效(字符串相同)*/
+      t->strs[atom] = t->strs[*slot];
+      *slot = atom;
+    }
+
+    return *slot;
+  }
+
+  if (atom == ATOM_NONE) {
+    atom = t->next;
+    str = tk_strdup(str);
+    return_value_if_fail(str != NULL, ATOM_NONE);
+    t->next++;
+  }
+
+  *slot = atom;
+  t->strs[atom] = str;
+  t->size++;
+
+  return atom;
+}
+
+ret_t atom_add_static(const char* str, atom_t atom) {
+  atom_t ret = ATOM_NONE;
+  atom_table_t* t = &s_atom_table;
+  return_value_if_fail(str != NULL && atom > ATOM_NONE && atom < ATOM_STATIC_MAX, RET_BAD_PARAMS);
+
+  if (t->strs != NULL && t->strs[atom] != NULL) {
+    return tk_str_eq(t->strs[atom], str) ? RET_OK : RET_FOUND;
+  }
+
+  ret = atom_table_add(t, str, atom);
+
+  return ret == atom ? RET_OK : RET_FOUND;
+}
+
+atom_t atom_from_str(const char* str) {
+  return_value_if_fail(str != NULL, ATOM_NONE);
+
+  return atom_table_add(&s_atom_table, str, ATOM_NONE);
+}
+
+atom_t atom_find(const char* str) {
+  atom_table_t* t = &s_atom_table;
+  return_value_if_fail(str != NULL, ATOM_NONE);
+
+  if (t->buckets == NULL) {
+    return ATOM_NONE;
+  }
+
+  return *atom_table_find_slot(t, str);
+}
+
+const char* atom_to_str(atom_t atom) {
+  atom_table_t* t = &s_atom_table;
+
+  if (atom == ATOM_NONE || atom >= t->capacity) {
+    return NULL;
+  }
+
+  return t->strs[atom];
+}
+
+const char* atom_intern(const char* str) {
+  return atom_to_str(atom_from_str(str));
+}
+
+ret_t atom_deinit(void) {
+  uint32_t i = 0;
+  atom_table_t* t = &s_atom_table;
+
+  for (i = ATOM_STATIC_MAX; i < t->next; i++) {
+    char* str = (char*)(t->strs[i]);
+    TKMEM_FREE(str);
+  }
+
+  TKMEM_FREE(t->strs);
+  TKMEM_FREE(t->buckets);
+  memset(t, 0x00, sizeof(atom_table_t));
+
+  return RET_OK;
+}
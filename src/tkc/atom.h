@@ -0,0 +1,131 @@
+/**
+ * File:   atom.h
+ * Author: AWTK Develop Team
+ * Brief:  interned string atoms
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_ATOM_H
+#define TK_ATOM_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+typedef uint32_t atom_t;
+
+/**
+ * @enum atom_id_t
+ * 原子ID的范围。
+ */
+typedef enum _atom_id_t {
+  /**
+   * @const ATOM_NONE
+   * 无效的原子。
+   */
+  ATOM_NONE = 0,
+  /**
+   * @const ATOM_STATIC_MAX
+   * 静态原子的最大ID(不含)。1到ATOM\_STATIC\_MAX-1保留给静态原子，可以在switch语句中使用。
+   */
+  ATOM_STATIC_MAX = 256
+} atom_id_t;
+
+/**
+ * @class atom_t
+ * @annotation ["fake"]
+ * 全局的原子表。
+ *
+ * 把字符串映射为一个小整数，相同的字符串对应相同的原子，可以直接比较整数或者switch。
+ * 每个原子对应唯一的字符串指针(原子化的字符串)，比较原子化的字符串只需比较指针。
+ *
+ * 静态原子的ID是固定的(由模块预先定义)，动态原子的ID在运行时分配。
+ *
+ * 示例：
+ *
+ * ```c
+ * atom_t a = atom_from_str("value");
+ * assert(atom_from_str("value") == a);
+ * assert(atom_to_str(a) == atom_intern("value"));
+ * ```
+ */
+
+/**
+ * @method atom_add_static
+ * 注册静态原子。
+ * 如果字符串已经作为动态原子存在(先调用了atom\_from\_str)，之后查找该字符串返回静态原子，
+ * 原来的动态原子仍然有效。
+ * @annotation ["static"]
+ * @param {const char*} str 字符串(必须是常量字符串，不会拷贝)。
+ * @param {atom_t} atom 原子ID(必须小于ATOM\_STATIC\_MAX)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t atom_add_static(const char* str, atom_t atom);
+
+/**
+ * @method atom_from_str
+ * 获取字符串对应的原子，如果不存在则创建一个新的原子。
+ * @annotation ["static"]
+ * @param {const char*} str 字符串。
+ *
+ * @return {atom_t} 返回原子，失败返回ATOM_NONE。
+ */
+atom_t atom_from_str(const char* str);
+
+/**
+ * @method atom_find
+ * 查找字符串对应的原子(不存在时不会创建)。
+ * @annotation ["static"]
+ * @param {const char*} str 字符串。
+ *
+ * @return {atom_t} 返回原子，不存在返回ATOM_NONE。
+ */
+atom_t atom_find(const char* str);
+
+/**
+ * @method atom_to_str
+ * 获取原子对应的字符串。
+ * @annotation ["static"]
+ * @param {atom_t} atom 原子。
+ *
+ * @return {const char*} 返回原子化的字符串，无效的原子返回NULL。
+ */
+const char* atom_to_str(atom_t atom);
+
+/**
+ * @method atom_intern
+ * 获取原子化的字符串。相同的字符串返回相同的指针。
+ * @annotation ["static"]
+ * @param {const char*} str 字符串。
+ *
+ * @return {const char*} 返回原子化的字符串。
+ */
+const char* atom_intern(const char* str);
+
+/**
+ * @method atom_deinit
+ * 释放原子表(之后所有的原子都将失效)。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t atom_deinit(void);
+
+END_C_DECLS
+
+#endif /*TK_ATOM_H*/
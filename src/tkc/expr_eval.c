@@ -24,7 +24,9 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include "tkc/mem.h"
 #include "tkc/utils.h"
+#include "tkc/mutex.h"
 #include "tkc/expr_eval.h"
 
 #ifdef WIN32
@@ -91,9 +93,12 @@ typedef struct {
   size_t stack_level;
   EvalToken token;
   ExprStr str;
+
+  ExprCode* code;
+  uint32_t depth;
 } EvalContext;
 
-static EvalResult parse_expr(EvalContext* ctx, ExprValue* output);
+static EvalResult parse_expr(EvalContext* ctx);
 
 static int is_digit(char c) {
   return (c >= '0') && (c <= '9');
@@ -730,13 +735,182 @@ static EvalResult get_token(EvalContext* ctx) {
   }
 }
 
-static EvalResult parse_func(EvalContext* ctx, ExprValue* output) {
+#define EXPR_UNARY_NEG 1
+#define EXPR_UNARY_NOT 2
+#define EXPR_UNARY_BITS_NOT 4
+
+#define EXPR_MAX_INDEX 0xffff
+#define EXPR_STACK_SIZE 16
+
+typedef enum {
+  EXPR_OP_NUMBER,
+  EXPR_OP_STRING,
+  EXPR_OP_VARIABLE,
+  EXPR_OP_FUNC,
+  EXPR_OP_UNARY,
+  EXPR_OP_BINARY
+} ExprOp;
+
+typedef struct {
+  uint8_t op;
+  /* FUNC: number of args, UNARY: EXPR_UNARY_* flags, BINARY: EvalTokenType */
+  uint8_t arg;
+  /* NUMBER: numbers[], STRING: strs[], VARIABLE: vars[] (slot), FUNC: funcs[] */
+  uint16_t index;
+} ExprInstr;
+
+typedef struct {
+  uint32_t offset;
+  uint32_t size;
+} ExprStrRef;
+
+struct _ExprCode {
+  uint32_t ref_count;
+  uint32_t max_depth;
+
+  ExprInstr* instrs;
+  uint32_t instrs_nr;
+  double* numbers;
+  uint32_t numbers_nr;
+  ExprStrRef* strs;
+  uint32_t strs_nr;
+  /* offsets of the variable names in pool, one slot per distinct name */
+  uint32_t* vars;
+  uint32_t vars_nr;
+  EvalFunc* funcs;
+  uint32_t funcs_nr;
+
+  /* string literals and variable names, each followed by '\0' */
+  ExprStr pool;
+};
+
+/* grows when nr is 0 or a power of 2, so no capacity needs to be kept */
+static void* code_array_reserve(void* items, uint32_t nr, uint32_t item_size) {
+  if (nr >= EXPR_MAX_INDEX) {
+    return NULL;
+  }
+
+  if ((nr & (nr - 1)) == 0) {
+    uint32_t capacity = nr ? nr * 2 : 4;
+    return TKMEM_REALLOC(items, capacity * item_size);
+  }
+
+  return items;
+}
+
+#define CODE_ARRAY_ADD(code, name, type)                                                    \
+  do {                                                                                      \
+    type* items = (type*)code_array_reserve((code)->name, (code)->name##_nr, sizeof(type)); \
+    if (items == NULL) return EVAL_RESULT_OOM;                                              \
+    (code)->name = items;                                                                   \
+  } while (0)
+
+static EvalResult code_add_str(ExprCode* code, const char* str, size_t len, uint32_t* offset) {
+  *offset = code->pool.size;
+  if (expr_str_append_str(&(code->pool), str, len) != EVAL_RESULT_OK) {
+    return EVAL_RESULT_OOM;
+  }
+
+  return expr_str_append_char(&(code->pool), '\0');
+}
+
+static EvalResult emit(EvalContext* ctx, ExprOp op, uint32_t arg, uint32_t index) {
+  ExprCode* code = ctx->code;
+  ExprInstr* instr = NULL;
+
+  CODE_ARRAY_ADD(code, instrs, ExprInstr);
+  instr = code->instrs + code->instrs_nr++;
+  instr->op = op;
+  instr->arg = arg;
+  instr->index = index;
+
+  switch (op) {
+    case EXPR_OP_NUMBER:
+    case EXPR_OP_STRING:
+    case EXPR_OP_VARIABLE: {
+      ctx->depth++;
+      break;
+    }
+    case EXPR_OP_FUNC: {
+      ctx->depth = ctx->depth - arg + 1;
+      break;
+    }
+    case EXPR_OP_BINARY: {
+      ctx->depth--;
+      break;
+    }
+    default:
+      break;
+  }
+
+  if (ctx->depth > code->max_depth) {
+    code->max_depth = ctx->depth;
+  }
+
+  return EVAL_RESULT_OK;
+}
+
+static EvalResult emit_number(EvalContext* ctx, double number) {
+  ExprCode* code = ctx->code;
+
+  CODE_ARRAY_ADD(code, numbers, double);
+  code->numbers[code->numbers_nr] = number;
+
+  return emit(ctx, EXPR_OP_NUMBER, 0, code->numbers_nr++);
+}
+
+static EvalResult emit_string(EvalContext* ctx, const char* str, size_t len) {
+  ExprCode* code = ctx->code;
+  ExprStrRef* ref = NULL;
+
+  CODE_ARRAY_ADD(code, strs, ExprStrRef);
+  ref = code->strs + code->strs_nr;
+  ref->size = len;
+  if (code_add_str(code, str, len, &(ref->offset)) != EVAL_RESULT_OK) {
+    return EVAL_RESULT_OOM;
+  }
+
+  return emit(ctx, EXPR_OP_STRING, 0, code->strs_nr++);
+}
+
+static EvalResult emit_variable(EvalContext* ctx, const char* name) {
+  uint32_t i = 0;
+  ExprCode* code = ctx->code;
+
+  for (i = 0; i < code->vars_nr; i++) {
+    if (strcmp(code->pool.str + code->vars[i], name) == 0) {
+      return emit(ctx, EXPR_OP_VARIABLE, 0, i);
+    }
+  }
+
+  CODE_ARRAY_ADD(code, vars, uint32_t);
+  if (code_add_str(code, name, strlen(name), code->vars + code->vars_nr) != EVAL_RESULT_OK) {
+    return EVAL_RESULT_OOM;
+  }
+
+  return emit(ctx, EXPR_OP_VARIABLE, 0, code->vars_nr++);
+}
+
+static EvalResult emit_func(EvalContext* ctx, EvalFunc func, uint32_t args_nr) {
+  uint32_t i = 0;
+  ExprCode* code = ctx->code;
+
+  for (i = 0; i < code->funcs_nr; i++) {
+    if (code->funcs[i] == func) {
+      return emit(ctx, EXPR_OP_FUNC, args_nr, i);
+    }
+  }
+
+  CODE_ARRAY_ADD(code, funcs, EvalFunc);
+  code->funcs[code->funcs_nr] = func;
+
+  return emit(ctx, EXPR_OP_FUNC, args_nr, code->funcs_nr++);
+}
+
+static EvalResult parse_func(EvalContext* ctx) {
   EvalFunc func;
   EvalResult result;
   uint32_t args_nr = 0;
-  ExprValue args[MAX_ARGS_NR + 1];
-
-  args_init(args, MAX_ARGS_NR + 1);
 
   if (!ctx->hooks || !ctx->hooks->get_func) {
     return EVAL_RESULT_UNDEFINED_FUNCTION;
@@ -756,7 +930,7 @@ static EvalResult parse_func(EvalContext* ctx, ExprValue* output) {
   if (result != EVAL_RESULT_OK) return result;
 
   while (args_nr < MAX_ARGS_NR) {
-    result = parse_expr(ctx, args + args_nr);
+    result = parse_expr(ctx);
     if (result != EVAL_RESULT_OK) return result;
 
     args_nr++;
@@ -767,279 +941,531 @@ static EvalResult parse_func(EvalContext* ctx, ExprValue* output) {
   }
 
   if (ctx->token.type != EVAL_TOKEN_TYPE_CLOSE_BRACKET) {
-    args_clear(args, MAX_ARGS_NR);
     return EVAL_RESULT_EXPECTED_CLOSE_BRACKET;
   }
 
-  result = func(args, ctx->user_data, output);
-  args_clear(args, MAX_ARGS_NR);
-
-  if (result != EVAL_RESULT_OK) {
-    return result;
-  }
+  result = emit_func(ctx, func, args_nr);
+  if (result != EVAL_RESULT_OK) return result;
 
   return get_token(ctx);
 }
 
-static EvalResult parse_term(EvalContext* ctx, ExprValue* output) {
+static EvalResult parse_term(EvalContext* ctx) {
   EvalResult result;
 
   if (ctx->token.type == EVAL_TOKEN_TYPE_NUMBER) {
-    expr_value_set_number(output, ctx->token.value.number);
+    result = emit_number(ctx, ctx->token.value.number);
   } else if (ctx->token.type == EVAL_TOKEN_TYPE_STRING) {
-    expr_value_set_string(output, ctx->str.str, ctx->str.size);
+    result = emit_string(ctx, ctx->str.str, ctx->str.size);
   } else if (ctx->token.type == EVAL_TOKEN_TYPE_OPEN_BRACKET) {
     result = get_token(ctx);
     if (result != EVAL_RESULT_OK) return result;
 
-    result = parse_expr(ctx, output);
+    result = parse_expr(ctx);
     if (result != EVAL_RESULT_OK) return result;
 
     if (ctx->token.type != EVAL_TOKEN_TYPE_CLOSE_BRACKET) {
       return EVAL_RESULT_EXPECTED_CLOSE_BRACKET;
     }
   } else if (ctx->token.type == EVAL_TOKEN_TYPE_FUNC) {
-    return parse_func(ctx, output);
+    return parse_func(ctx);
   } else if (ctx->token.type == EVAL_TOKEN_TYPE_VARIABLE) {
-    if (!ctx->hooks || !ctx->hooks->get_variable) {
-      return EVAL_RESULT_UNDEFINED_VARIABLE;
-    }
-
-    result = ctx->hooks->get_variable(ctx->token.value.name, ctx->user_data, output);
-    if (result != EVAL_RESULT_OK) return result;
+    result = emit_variable(ctx, ctx->token.value.name);
   } else {
     return EVAL_RESULT_EXPECTED_TERM;
   }
 
+  if (result != EVAL_RESULT_OK) return result;
+
   return get_token(ctx);
 }
 
-static EvalResult parse_unary(EvalContext* ctx, ExprValue* output) {
+static EvalResult parse_unary(EvalContext* ctx) {
   EvalResult result;
-  int neg = 0;
-  int not = 0;
-  int bit_not = 0;
-  ExprValue value;
-
-  expr_value_init(&value);
+  uint32_t flags = 0;
 
   for (;;) {
     if (ctx->token.type == EVAL_TOKEN_TYPE_NOT) {
-      not = !not;
-
-      result = get_token(ctx);
-      if (result != EVAL_RESULT_OK) return result;
+      flags ^= EXPR_UNARY_NOT;
     } else if (ctx->token.type == EVAL_TOKEN_TYPE_BITS_NOT) {
-      bit_not = !bit_not;
-
-      result = get_token(ctx);
-      if (result != EVAL_RESULT_OK) return result;
+      flags ^= EXPR_UNARY_BITS_NOT;
     } else if (ctx->token.type == EVAL_TOKEN_TYPE_SUBTRACT) {
-      neg = !neg;
-
-      result = get_token(ctx);
-      if (result != EVAL_RESULT_OK) return result;
+      flags ^= EXPR_UNARY_NEG;
     } else {
       break;
     }
-  }
 
-  result = parse_term(ctx, &value);
-  if (result != EVAL_RESULT_OK) return result;
-
-  if (value.type == EXPR_VALUE_TYPE_NUMBER) {
-    if (neg) {
-      value.v.val = -value.v.val;
-    }
-    if (not) {
-      value.v.val = !value.v.val;
-    }
-    if (bit_not) {
-      value.v.val = ~(unsigned int)value.v.val;
-    }
-  }
-  if (value.type == EXPR_VALUE_TYPE_STRING) {
-    if (not) {
-      expr_value_set_number(&value, !value.v.str.size);
-    }
+    result = get_token(ctx);
+    if (result != EVAL_RESULT_OK) return result;
   }
 
-  *output = value;
+  result = parse_term(ctx);
+  if (result != EVAL_RESULT_OK) return result;
 
-  return EVAL_RESULT_OK;
+  return flags ? emit(ctx, EXPR_OP_UNARY, flags, 0) : EVAL_RESULT_OK;
 }
 
-static EvalResult parse_product(EvalContext* ctx, ExprValue* output) {
-  EvalResult result;
-  ExprValue lhs;
-  ExprValue rhs;
+typedef EvalResult (*ParseFunc)(EvalContext* ctx);
 
-  expr_value_init(&lhs);
-  expr_value_init(&rhs);
+static EvalResult parse_binary(EvalContext* ctx, ParseFunc parse_operand, const int* ops) {
+  EvalResult result;
 
-  result = parse_unary(ctx, &lhs);
+  result = parse_operand(ctx);
   if (result != EVAL_RESULT_OK) return result;
 
   for (;;) {
+    int i = 0;
     int type = ctx->token.type;
-    if (type == EVAL_TOKEN_TYPE_MULTIPLY || type == EVAL_TOKEN_TYPE_DIVIDE ||
-        type == EVAL_TOKEN_TYPE_MODEL) {
-      result = get_token(ctx);
-      if (result != EVAL_RESULT_OK) return result;
 
-      result = parse_unary(ctx, &rhs);
-      if (result != EVAL_RESULT_OK) return result;
+    while (ops[i] != EVAL_TOKEN_TYPE_END && ops[i] != type) {
+      i++;
+    }
 
-      expr_value_op(&lhs, &rhs, (EvalTokenType)type);
-    } else {
+    if (ops[i] == EVAL_TOKEN_TYPE_END) {
       break;
     }
-  }
 
-  *output = lhs;
-  expr_value_clear(&rhs);
+    result = get_token(ctx);
+    if (result != EVAL_RESULT_OK) return result;
+
+    result = parse_operand(ctx);
+    if (result != EVAL_RESULT_OK) return result;
+
+    result = emit(ctx, EXPR_OP_BINARY, type, 0);
+    if (result != EVAL_RESULT_OK) return result;
+  }
 
   return EVAL_RESULT_OK;
 }
 
-static EvalResult parse_sum(EvalContext* ctx, ExprValue* output) {
-  ExprValue lhs;
-  ExprValue rhs;
+static EvalResult parse_product(EvalContext* ctx) {
+  static const int ops[] = {EVAL_TOKEN_TYPE_MULTIPLY, EVAL_TOKEN_TYPE_DIVIDE,
+                            EVAL_TOKEN_TYPE_MODEL, EVAL_TOKEN_TYPE_END};
+
+  return parse_binary(ctx, parse_unary, ops);
+}
+
+static EvalResult parse_sum(EvalContext* ctx) {
+  static const int ops[] = {EVAL_TOKEN_TYPE_ADD, EVAL_TOKEN_TYPE_SUBTRACT, EVAL_TOKEN_TYPE_END};
+
+  return parse_binary(ctx, parse_product, ops);
+}
+
+static EvalResult parse_compare(EvalContext* ctx) {
+  static const int ops[] = {EVAL_TOKEN_TYPE_E,  EVAL_TOKEN_TYPE_L,  EVAL_TOKEN_TYPE_G,
+                            EVAL_TOKEN_TYPE_NE, EVAL_TOKEN_TYPE_LE, EVAL_TOKEN_TYPE_GE,
+                            EVAL_TOKEN_TYPE_END};
+
+  return parse_binary(ctx, parse_sum, ops);
+}
+
+static EvalResult parse_logic(EvalContext* ctx) {
+  static const int ops[] = {EVAL_TOKEN_TYPE_OR, EVAL_TOKEN_TYPE_AND, EVAL_TOKEN_TYPE_BITS_OR,
+                            EVAL_TOKEN_TYPE_BITS_AND, EVAL_TOKEN_TYPE_END};
+
+  return parse_binary(ctx, parse_compare, ops);
+}
+
+static EvalResult parse_expr(EvalContext* ctx) {
   EvalResult result;
 
-  expr_value_init(&lhs);
-  expr_value_init(&rhs);
+  if (ctx->stack_level >= EVAL_MAX_STACK_DEPTH) {
+    return EVAL_RESULT_STACK_OVERFLOW;
+  }
+
+  ctx->stack_level++;
+  result = parse_logic(ctx);
+  ctx->stack_level--;
 
-  result = parse_product(ctx, &lhs);
-  if (result != EVAL_RESULT_OK) return result;
+  return result;
+}
 
-  for (;;) {
-    int type = ctx->token.type;
-    if (type == EVAL_TOKEN_TYPE_ADD || type == EVAL_TOKEN_TYPE_SUBTRACT) {
-      result = get_token(ctx);
-      if (result != EVAL_RESULT_OK) return result;
+ExprCode* eval_compile(const char* expression, const EvalHooks* hooks, void* user_data,
+                       EvalResult* result) {
+  EvalContext ctx;
+  EvalResult ret;
+  ExprCode* code = NULL;
 
-      result = parse_product(ctx, &rhs);
-      if (result != EVAL_RESULT_OK) return result;
+  if (expression == NULL) {
+    ret = EVAL_RESULT_BAD_PARAMS;
+    goto error;
+  }
 
-      expr_value_op(&lhs, &rhs, (EvalTokenType)type);
-    } else {
-      break;
+  code = TKMEM_ZALLOC(ExprCode);
+  if (code == NULL) {
+    ret = EVAL_RESULT_OOM;
+    goto error;
+  }
+
+  code->ref_count = 1;
+  if (expr_str_init(&(code->pool), 31) != EVAL_RESULT_OK) {
+    ret = EVAL_RESULT_OOM;
+    goto error;
+  }
+
+  memset(&ctx, 0x00, sizeof(ctx));
+  if (expr_str_init(&ctx.str, 100) != EVAL_RESULT_OK) {
+    ret = EVAL_RESULT_OOM;
+    goto error;
+  }
+
+  ctx.hooks = hooks;
+  ctx.user_data = user_data;
+  ctx.input = expression;
+  ctx.code = code;
+
+  ret = get_token(&ctx);
+  if (ret == EVAL_RESULT_OK) {
+    ret = parse_expr(&ctx);
+  }
+
+  if (ret == EVAL_RESULT_OK && ctx.token.type != EVAL_TOKEN_TYPE_END) {
+    ret = EVAL_RESULT_UNEXPECTED_CHAR;
+  }
+  expr_str_clear(&ctx.str);
+
+  if (ret == EVAL_RESULT_OK) {
+    if (result != NULL) {
+      *result = ret;
     }
+
+    return code;
   }
 
-  *output = lhs;
-  expr_value_clear(&rhs);
+error:
+  eval_code_destroy(code);
+  if (result != NULL) {
+    *result = ret;
+  }
 
-  return EVAL_RESULT_OK;
+  return NULL;
 }
 
-static EvalResult parse_compare(EvalContext* ctx, ExprValue* output) {
-  ExprValue lhs;
-  ExprValue rhs;
-  EvalResult result;
+static void expr_value_dup(ExprValue* v, const ExprValue* from) {
+  expr_value_init(v);
 
-  expr_value_init(&lhs);
-  expr_value_init(&rhs);
+  if (from->type == EXPR_VALUE_TYPE_STRING) {
+    expr_value_set_string(v, from->v.str.str, from->v.str.size);
+  } else {
+    v->v.val = from->v.val;
+  }
+}
 
-  result = parse_sum(ctx, &lhs);
-  if (result != EVAL_RESULT_OK) return result;
+static EvalResult exec_variable(const ExprCode* code, uint32_t slot, const EvalHooks* hooks,
+                                void* user_data, ExprValue* vars, ExprValue* output) {
+  ExprValue* var = vars + slot;
 
-  for (;;) {
-    int type = ctx->token.type;
-    if (type == EVAL_TOKEN_TYPE_E || type == EVAL_TOKEN_TYPE_L || type == EVAL_TOKEN_TYPE_G ||
-        type == EVAL_TOKEN_TYPE_NE || type == EVAL_TOKEN_TYPE_LE || type == EVAL_TOKEN_TYPE_GE) {
-      result = get_token(ctx);
-      if (result != EVAL_RESULT_OK) return result;
+  if (var->type == EXPR_VALUE_TYPE_NONE) {
+    EvalResult result;
 
-      result = parse_sum(ctx, &rhs);
-      if (result != EVAL_RESULT_OK) return result;
+    if (!hooks || !hooks->get_variable) {
+      return EVAL_RESULT_UNDEFINED_VARIABLE;
+    }
 
-      expr_value_op(&lhs, &rhs, (EvalTokenType)type);
-    } else {
-      break;
+    expr_value_init(var);
+    result = hooks->get_variable(code->pool.str + code->vars[slot], user_data, var);
+    if (result != EVAL_RESULT_OK) {
+      expr_value_clear(var);
+      var->type = EXPR_VALUE_TYPE_NONE;
+      return result;
     }
   }
 
-  *output = lhs;
-  expr_value_clear(&rhs);
+  expr_value_dup(output, var);
 
   return EVAL_RESULT_OK;
 }
 
-static EvalResult parse_logic(EvalContext* ctx, ExprValue* output) {
-  ExprValue lhs;
-  ExprValue rhs;
+static EvalResult exec_func(EvalFunc func, uint32_t args_nr, void* user_data, ExprValue* top) {
   EvalResult result;
+  ExprValue args[MAX_ARGS_NR + 1];
 
-  expr_value_init(&lhs);
-  expr_value_init(&rhs);
+  args_init(args, MAX_ARGS_NR + 1);
+  memcpy(args, top - args_nr, args_nr * sizeof(ExprValue));
 
-  result = parse_compare(ctx, &lhs);
-  if (result != EVAL_RESULT_OK) return result;
+  top -= args_nr;
+  expr_value_init(top);
+  result = func(args, user_data, top);
+  args_clear(args, MAX_ARGS_NR);
 
-  for (;;) {
-    int type = ctx->token.type;
-    if (type == EVAL_TOKEN_TYPE_OR || type == EVAL_TOKEN_TYPE_AND ||
-        type == EVAL_TOKEN_TYPE_BITS_OR || type == EVAL_TOKEN_TYPE_BITS_AND) {
-      result = get_token(ctx);
-      if (result != EVAL_RESULT_OK) return result;
+  return result;
+}
+
+static void exec_unary(ExprValue* v, uint32_t flags) {
+  if (v->type == EXPR_VALUE_TYPE_NUMBER) {
+    if (flags & EXPR_UNARY_NEG) {
+      v->v.val = -v->v.val;
+    }
+    if (flags & EXPR_UNARY_NOT) {
+      v->v.val = !v->v.val;
+    }
+    if (flags & EXPR_UNARY_BITS_NOT) {
+      v->v.val = ~(unsigned int)v->v.val;
+    }
+  } else if (v->type == EXPR_VALUE_TYPE_STRING) {
+    if (flags & EXPR_UNARY_NOT) {
+      expr_value_set_number(v, !v->v.str.size);
+    }
+  }
+}
 
-      result = parse_compare(ctx, &rhs);
-      if (result != EVAL_RESULT_OK) return result;
+EvalResult eval_code_execute(const ExprCode* code, const EvalHooks* hooks, void* user_data,
+                             ExprValue* output) {
+  uint32_t i = 0;
+  uint32_t sp = 0;
+  ExprValue* vars = NULL;
+  ExprValue* stack = NULL;
+  EvalResult result = EVAL_RESULT_OK;
+  ExprValue local_stack[EXPR_STACK_SIZE];
+  ExprValue local_vars[EXPR_STACK_SIZE];
+
+  if (code == NULL || output == NULL) {
+    return EVAL_RESULT_BAD_PARAMS;
+  }
 
-      expr_value_op(&lhs, &rhs, (EvalTokenType)type);
-    } else {
-      break;
+  stack = code->max_depth <= EXPR_STACK_SIZE ? local_stack
+                                              : TKMEM_ZALLOCN(ExprValue, code->max_depth);
+  vars = code->vars_nr <= EXPR_STACK_SIZE ? local_vars : TKMEM_ZALLOCN(ExprValue, code->vars_nr);
+  if (stack == NULL || vars == NULL) {
+    result = EVAL_RESULT_OOM;
+    goto done;
+  }
+  args_init(vars, code->vars_nr);
+
+  for (i = 0; i < code->instrs_nr && result == EVAL_RESULT_OK; i++) {
+    const ExprInstr* instr = code->instrs + i;
+
+    switch (instr->op) {
+      case EXPR_OP_NUMBER: {
+        expr_value_init(stack + sp);
+        stack[sp++].v.val = code->numbers[instr->index];
+        break;
+      }
+      case EXPR_OP_STRING: {
+        const ExprStrRef* ref = code->strs + instr->index;
+        expr_value_init(stack + sp);
+        result = expr_value_set_string(stack + sp, code->pool.str + ref->offset, ref->size);
+        sp++;
+        break;
+      }
+      case EXPR_OP_VARIABLE: {
+        result = exec_variable(code, instr->index, hooks, user_data, vars, stack + sp);
+        if (result == EVAL_RESULT_OK) {
+          sp++;
+        }
+        break;
+      }
+      case EXPR_OP_FUNC: {
+        result = exec_func(code->funcs[instr->index], instr->arg, user_data, stack + sp);
+        sp = sp - instr->arg + 1;
+        break;
+      }
+      case EXPR_OP_UNARY: {
+        exec_unary(stack + sp - 1, instr->arg);
+        break;
+      }
+      case EXPR_OP_BINARY: {
+        result = expr_value_op(stack + sp - 2, stack + sp - 1, (EvalTokenType)(instr->arg));
+        expr_value_clear(stack + --sp);
+        break;
+      }
+      default:
+        break;
     }
   }
 
-  *output = lhs;
-  expr_value_clear(&rhs);
+  if (result == EVAL_RESULT_OK) {
+    *output = stack[0];
+  } else {
+    args_clear(stack, sp);
+  }
 
-  return EVAL_RESULT_OK;
+done:
+  if (vars != NULL) {
+    args_clear(vars, code->vars_nr);
+    if (vars != local_vars) {
+      TKMEM_FREE(vars);
+    }
+  }
+
+  if (stack != NULL && stack != local_stack) {
+    TKMEM_FREE(stack);
+  }
+
+  return result;
 }
 
-static EvalResult parse_expr(EvalContext* ctx, ExprValue* output) {
-  EvalResult result;
+static ExprCode* eval_code_ref(ExprCode* code) {
+  code->ref_count++;
 
-  if (ctx->stack_level >= EVAL_MAX_STACK_DEPTH) {
-    return EVAL_RESULT_STACK_OVERFLOW;
+  return code;
+}
+
+void eval_code_destroy(ExprCode* code) {
+  if (code != NULL && --code->ref_count == 0) {
+    TKMEM_FREE(code->instrs);
+    TKMEM_FREE(code->numbers);
+    TKMEM_FREE(code->strs);
+    TKMEM_FREE(code->vars);
+    TKMEM_FREE(code->funcs);
+    expr_str_clear(&(code->pool));
+    TKMEM_FREE(code);
   }
+}
 
-  ctx->stack_level++;
-  result = parse_logic(ctx, output);
-  ctx->stack_level--;
+/* compiled expressions are cached by source string, most recently used first */
+typedef struct {
+  char* expr;
+  EvalFunc (*get_func)(const char* name, void* user_data);
+  ExprCode* code;
+} EvalCacheEntry;
+
+/*
+ * the cache is shared by all threads: the entries and the reference counts of the cached code are
+ * only touched with s_eval_cache_mutex held, compiling and executing run without the lock.
+ */
+static EvalCacheEntry s_eval_cache[EVAL_CACHE_SIZE];
+static uint32_t s_eval_cache_nr;
+static tk_mutex_t* s_eval_cache_mutex;
+static bool_t s_eval_cache_atexit;
 
-  return result;
+static void eval_cache_atexit(void) {
+  eval_cache_deinit();
+
+  if (s_eval_cache_mutex != NULL) {
+    tk_mutex_destroy(s_eval_cache_mutex);
+    s_eval_cache_mutex = NULL;
+  }
 }
 
-EvalResult eval_execute(const char* expression, const EvalHooks* hooks, void* user_data,
-                        ExprValue* output) {
-  EvalContext ctx;
-  EvalResult result;
+void eval_cache_init(void) {
+  if (s_eval_cache_mutex == NULL) {
+    s_eval_cache_mutex = tk_mutex_create();
+  }
 
-  expr_str_init(&ctx.str, 100);
+  /* tkc has no global teardown, so release the cached code when the process exits */
+  if (!s_eval_cache_atexit) {
+    s_eval_cache_atexit = TRUE;
+    atexit(eval_cache_atexit);
+  }
+}
 
-  ctx.hooks = hooks;
-  ctx.user_data = user_data;
-  ctx.input = expression;
-  ctx.stack_level = 0;
+static void eval_cache_lock(void) {
+  if (s_eval_cache_mutex != NULL) {
+    tk_mutex_lock(s_eval_cache_mutex);
+  }
+}
+
+static void eval_cache_unlock(void) {
+  if (s_eval_cache_mutex != NULL) {
+    tk_mutex_unlock(s_eval_cache_mutex);
+  }
+}
+
+static ExprCode* eval_cache_find(const char* expression,
+                                 EvalFunc (*get_func)(const char* name, void* user_data)) {
+  uint32_t i = 0;
+  EvalCacheEntry entry;
 
-  result = get_token(&ctx);
-  if (result != EVAL_RESULT_OK) {
-    expr_str_clear(&ctx.str);
+  for (i = 0; i < s_eval_cache_nr; i++) {
+    EvalCacheEntry* iter = s_eval_cache + i;
+    if (iter->get_func == get_func && strcmp(iter->expr, expression) == 0) {
+      entry = *iter;
+      memmove(s_eval_cache + 1, s_eval_cache, i * sizeof(EvalCacheEntry));
+      s_eval_cache[0] = entry;
+
+      return eval_code_ref(entry.code);
+    }
+  }
+
+  return NULL;
+}
+
+static ExprCode* eval_cache_get(const char* expression, const EvalHooks* hooks, void* user_data,
+                                EvalResult* result) {
+  EvalCacheEntry entry;
+  ExprCode* code = NULL;
+  EvalFunc (*get_func)(const char* name, void* user_data) = hooks ? hooks->get_func : NULL;
+
+  if (s_eval_cache_mutex == NULL) {
+    eval_cache_init();
+  }
+
+  eval_cache_lock();
+  code = eval_cache_find(expression, get_func);
+  eval_cache_unlock();
+
+  if (code != NULL) {
+    return code;
+  }
+
+  /* compile without the lock, hooks->get_func may evaluate other expressions */
+  code = eval_compile(expression, hooks, user_data, result);
+  if (code == NULL) {
+    return NULL;
+  }
+
+  entry.expr = tk_strdup(expression);
+  entry.get_func = get_func;
+  entry.code = code;
+  if (entry.expr == NULL) {
+    return code;
+  }
+
+  /* one reference for the cache, one for the caller; no other thread can see the code yet */
+  eval_code_ref(code);
+
+  eval_cache_lock();
+  if (s_eval_cache_nr == EVAL_CACHE_SIZE) {
+    EvalCacheEntry* last = s_eval_cache + EVAL_CACHE_SIZE - 1;
+    TKMEM_FREE(last->expr);
+    eval_code_destroy(last->code);
+    s_eval_cache_nr--;
+  }
+
+  memmove(s_eval_cache + 1, s_eval_cache, s_eval_cache_nr * sizeof(EvalCacheEntry));
+  s_eval_cache[0] = entry;
+  s_eval_cache_nr++;
+  eval_cache_unlock();
+
+  return code;
+}
+
+static void eval_cache_release(ExprCode* code) {
+  eval_cache_lock();
+  eval_code_destroy(code);
+  eval_cache_unlock();
+}
+
+void eval_cache_deinit(void) {
+  uint32_t i = 0;
+
+  eval_cache_lock();
+  for (i = 0; i < s_eval_cache_nr; i++) {
+    TKMEM_FREE(s_eval_cache[i].expr);
+    eval_code_destroy(s_eval_cache[i].code);
+  }
+  s_eval_cache_nr = 0;
+  eval_cache_unlock();
+}
+
+EvalResult eval_execute(const char* expression, const EvalHooks* hooks, void* user_data,
+                        ExprValue* output) {
+  ExprCode* code = NULL;
+  EvalResult result = EVAL_RESULT_BAD_PARAMS;
+
+  if (expression == NULL) {
     return result;
   }
 
-  result = parse_expr(&ctx, output);
-  if (result != EVAL_RESULT_OK) {
-    expr_str_clear(&ctx.str);
+  /* the cache may evict the code while a hook evaluates another expression, so hold a reference */
+  code = eval_cache_get(expression, hooks, user_data, &result);
+  if (code == NULL) {
     return result;
   }
 
-  result = (ctx.token.type == EVAL_TOKEN_TYPE_END) ? EVAL_RESULT_OK : EVAL_RESULT_UNEXPECTED_CHAR;
-  expr_str_clear(&ctx.str);
+  result = eval_code_execute(code, hooks, user_data, output);
+  eval_cache_release(code);
 
   return result;
 }
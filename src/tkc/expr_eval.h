@@ -34,6 +34,10 @@ BEGIN_C_DECLS
 #define EVAL_MAX_STACK_DEPTH 8
 #define EVAL_MAX_NAME_LENGTH 32
 
+#ifndef EVAL_CACHE_SIZE
+#define EVAL_CACHE_SIZE 16
+#endif /*EVAL_CACHE_SIZE*/
+
 typedef enum _ExprValueType {
   EXPR_VALUE_TYPE_NUMBER = 0,
   EXPR_VALUE_TYPE_STRING,
@@ -79,7 +83,24 @@ typedef struct {
   EvalResult (*get_variable)(const char* name, void* user_data, ExprValue* output);
 } EvalHooks;
 
+/* compiled expression: functions are resolved at compile time, variables when executed */
+typedef struct _ExprCode ExprCode;
+
+ExprCode* eval_compile(const char* expr, const EvalHooks* hooks, void* ctx, EvalResult* result);
+EvalResult eval_code_execute(const ExprCode* code, const EvalHooks* hooks, void* ctx,
+                             ExprValue* output);
+void eval_code_destroy(ExprCode* code);
+
+/*
+ * eval_execute compiles expr on first use and keeps the last EVAL_CACHE_SIZE compiled
+ * expressions (keyed by expr and hooks->get_func). hooks->get_func must depend on name only.
+ * The cache is guarded by a mutex. eval_cache_init creates it and is called on first use;
+ * call it before other threads start evaluating. The cache is released at exit, or earlier
+ * by eval_cache_deinit.
+ */
 EvalResult eval_execute(const char* expr, const EvalHooks* hooks, void* ctx, ExprValue* output);
+void eval_cache_init(void);
+void eval_cache_deinit(void);
 
 double tk_expr_eval(const char* expr);
 
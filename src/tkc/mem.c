@@ -27,12 +27,16 @@ static void* tk_alloc_impl(uint32_t size);
 static void* tk_realloc_impl(void* ptr, uint32_t size);
 static void* tk_calloc_impl(uint32_t nmemb, uint32_t size);
 
+static uint32_t s_alloc_times;
+
 #ifdef HAS_STD_MALLOC
 
 #define MAX_BLOCK_SIZE 0xffff0000
 
 static mem_stat_t s_mem_stat;
 mem_stat_t tk_mem_stat(void) {
+  s_mem_stat.alloc_times = s_alloc_times;
+
   return s_mem_stat;
 }
 
@@ -263,6 +267,7 @@ mem_stat_t tk_mem_stat() {
 
   st.used_bytes = s_mem_info.size;
   st.used_block_nr = s_mem_info.used_block_nr;
+  st.alloc_times = s_alloc_times;
 
   return st;
 }
@@ -325,6 +330,7 @@ void* tk_calloc(uint32_t nmemb, uint32_t size, const char* func, uint32_t line)
   do {
     addr = tk_calloc_impl(nmemb, size);
     if (addr != NULL) {
+      s_alloc_times++;
       break;
     }
 
@@ -344,6 +350,7 @@ void* tk_realloc(void* ptr, uint32_t size, const char* func, uint32_t line) {
   do {
     addr = tk_realloc_impl(ptr, size);
     if (addr != NULL) {
+      s_alloc_times++;
       break;
     }
 
@@ -363,6 +370,7 @@ void* tk_alloc(uint32_t size, const char* func, uint32_t line) {
   do {
     addr = tk_alloc_impl(size);
     if (addr != NULL) {
+      s_alloc_times++;
       break;
     }
 
@@ -130,6 +130,8 @@ void tk_free(void* ptr);
 typedef struct _mem_stat_t {
   uint32_t used_bytes;
   uint32_t used_block_nr;
+  /*number of successful tk_alloc/tk_calloc/tk_realloc calls since startup*/
+  uint32_t alloc_times;
 } mem_stat_t;
 
 void tk_mem_dump(void);
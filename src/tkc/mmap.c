@@ -0,0 +1,111 @@
+/**
+ * File:   mmap.c
+ * Author: AWTK Develop Team
+ * Brief:  map file into memory
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/fs.h"
+#include "tkc/mem.h"
+#include "tkc/mmap.h"
+
+#if defined(__APPLE__) || defined(LINUX)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static ret_t mmap_map_file(mmap_t* map, const char* filename) {
+  void* data = NULL;
+  struct stat st;
+  int fd = open(filename, O_RDONLY);
+  return_value_if_fail(fd >= 0, RET_FAIL);
+
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return RET_FAIL;
+  }
+
+  data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  /*the mapping keeps a reference to the file, fd is not needed any more.*/
+  close(fd);
+  return_value_if_fail(data != MAP_FAILED, RET_FAIL);
+
+  map->data = data;
+  map->size = st.st_size;
+  map->is_mapped = TRUE;
+
+  return RET_OK;
+}
+
+static ret_t mmap_unmap_file(mmap_t* map) {
+  munmap(map->data, map->size);
+
+  return RET_OK;
+}
+#else
+static ret_t mmap_map_file(mmap_t* map, const char* filename) {
+  (void)map;
+  (void)filename;
+
+  return RET_NOT_IMPL;
+}
+
+static ret_t mmap_unmap_file(mmap_t* map) {
+  (void)map;
+
+  return RET_NOT_IMPL;
+}
+#endif /*__APPLE__ || LINUX*/
+
+mmap_t* mmap_create(const char* filename) {
+  mmap_t* map = NULL;
+  return_value_if_fail(filename != NULL, NULL);
+
+  map = TKMEM_ZALLOC(mmap_t);
+  return_value_if_fail(map != NULL, NULL);
+
+  if (mmap_map_file(map, filename) != RET_OK) {
+    uint32_t size = 0;
+
+    map->data = file_read(filename, &size);
+    map->size = size;
+    map->is_mapped = FALSE;
+  }
+
+  if (map->data == NULL) {
+    TKMEM_FREE(map);
+    map = NULL;
+  }
+
+  return map;
+}
+
+ret_t mmap_destroy(mmap_t* map) {
+  return_value_if_fail(map != NULL, RET_BAD_PARAMS);
+
+  if (map->is_mapped) {
+    mmap_unmap_file(map);
+  } else {
+    TKMEM_FREE(map->data);
+  }
+
+  memset(map, 0x00, sizeof(mmap_t));
+  TKMEM_FREE(map);
+
+  return RET_OK;
+}
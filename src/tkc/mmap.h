@@ -0,0 +1,75 @@
+/**
+ * File:   mmap.h
+ * Author: AWTK Develop Team
+ * Brief:  map file into memory
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_MMAP_H
+#define TK_MMAP_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class mmap_t
+ * 把文件以只读方式映射到内存。
+ *
+ * 在支持mmap的平台上，文件内容由操作系统按需加载到页缓存中，多个进程映射同一个文件时共享物理内存。
+ * 在不支持mmap的平台上，退化为把整个文件读入内存。
+ */
+typedef struct _mmap_t {
+  /**
+   * @property {void*} data
+   * @annotation ["readable"]
+   * 映射后的内存地址。
+   */
+  void* data;
+  /**
+   * @property {uint32_t} size
+   * @annotation ["readable"]
+   * 映射的大小(即文件的大小)。
+   */
+  uint32_t size;
+
+  /*private*/
+  bool_t is_mapped;
+} mmap_t;
+
+/**
+ * @method mmap_create
+ * 以只读方式把指定的文件映射到内存。
+ * @annotation ["constructor"]
+ * @param {const char*} filename 文件名。
+ *
+ * @return {mmap_t*} 返回mmap对象，失败返回NULL。
+ */
+mmap_t* mmap_create(const char* filename);
+
+/**
+ * @method mmap_destroy
+ * 取消映射并销毁mmap对象。
+ * @param {mmap_t*} map mmap对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t mmap_destroy(mmap_t* map);
+
+END_C_DECLS
+
+#endif /*TK_MMAP_H*/
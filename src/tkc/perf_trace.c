@@ -0,0 +1,211 @@
+/**
+ * File:   perf_trace.c
+ * Author: AWTK Develop Team
+ * Brief:  frame level performance trace
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/fs.h"
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "tkc/time_now.h"
+#include "tkc/perf_trace.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PERF_TRACE_FETCH_ADD(p, v) __atomic_fetch_add(p, v, __ATOMIC_RELAXED)
+#define PERF_TRACE_LOAD(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#else
+#define PERF_TRACE_FETCH_ADD(p, v) ((*(p) += (v)) - (v))
+#define PERF_TRACE_LOAD(p) (*(p))
+#endif /*__GNUC__*/
+
+typedef struct _perf_trace_t {
+  perf_trace_event_t* events;
+  uint32_t mask;
+  uint32_t capacity;
+  volatile uint32_t windex;
+  uint64_t (*get_time_us)(void);
+} perf_trace_t;
+
+static perf_trace_t s_perf_trace;
+
+ret_t perf_trace_init(uint32_t capacity) {
+  uint32_t size = 16;
+  perf_trace_t* trace = &s_perf_trace;
+  return_value_if_fail(capacity > 0 && capacity <= 0x1000000, RET_BAD_PARAMS);
+
+  perf_trace_deinit();
+  while (size < capacity) {
+    size <<= 1;
+  }
+
+  trace->events = TKMEM_ZALLOCN(perf_trace_event_t, size);
+  return_value_if_fail(trace->events != NULL, RET_OOM);
+
+  trace->windex = 0;
+  trace->mask = size - 1;
+  trace->capacity = size;
+  if (trace->get_time_us == NULL) {
+    trace->get_time_us = time_now_us;
+  }
+
+  return RET_OK;
+}
+
+ret_t perf_trace_set_clock(uint64_t (*get_time_us)(void)) {
+  s_perf_trace.get_time_us = get_time_us != NULL ? get_time_us : time_now_us;
+
+  return RET_OK;
+}
+
+static ret_t perf_trace_record(const char* cat, const char* name, const char* detail, char ph) {
+  uint32_t index = 0;
+  perf_trace_event_t* e = NULL;
+  perf_trace_t* trace = &s_perf_trace;
+
+  if (trace->events == NULL) {
+    return RET_NOT_FOUND;
+  }
+
+  index = PERF_TRACE_FETCH_ADD(&(trace->windex), 1);
+  e = trace->events + (index & trace->mask);
+
+  e->ph = ph;
+  e->cat = cat;
+  e->name = name;
+  e->ts = trace->get_time_us();
+  if (detail != NULL) {
+    tk_strncpy(e->detail, detail, TK_PERF_TRACE_DETAIL_LEN);
+  } else {
+    e->detail[0] = '\0';
+  }
+
+  return RET_OK;
+}
+
+ret_t perf_trace_begin(const char* cat, const char* name, const char* detail) {
+  return_value_if_fail(cat != NULL && name != NULL, RET_BAD_PARAMS);
+
+  return perf_trace_record(cat, name, detail, 'B');
+}
+
+ret_t perf_trace_end(const char* cat, const char* name) {
+  return_value_if_fail(cat != NULL && name != NULL, RET_BAD_PARAMS);
+
+  return perf_trace_record(cat, name, NULL, 'E');
+}
+
+uint32_t perf_trace_count(void) {
+  uint32_t windex = PERF_TRACE_LOAD(&(s_perf_trace.windex));
+
+  return tk_min(windex, s_perf_trace.capacity);
+}
+
+const perf_trace_event_t* perf_trace_get(uint32_t index) {
+  uint32_t nr = perf_trace_count();
+  uint32_t windex = PERF_TRACE_LOAD(&(s_perf_trace.windex));
+  return_value_if_fail(index < nr, NULL);
+
+  return s_perf_trace.events + ((windex - nr + index) & s_perf_trace.mask);
+}
+
+ret_t perf_trace_reset(void) {
+  s_perf_trace.windex = 0;
+
+  return RET_OK;
+}
+
+static ret_t perf_trace_append_json_str(str_t* str, const char* s) {
+  char buff[8];
+
+  str_append_char(str, '\"');
+  while (*s) {
+    char c = *s++;
+
+    if (c == '\"' || c == '\\') {
+      str_append_char(str, '\\');
+      str_append_char(str, c);
+    } else if ((unsigned char)c < 0x20) {
+      tk_snprintf(buff, sizeof(buff), "\\u%04x", (int)c);
+      str_append(str, buff);
+    } else {
+      str_append_char(str, c);
+    }
+  }
+
+  return str_append_char(str, '\"');
+}
+
+ret_t perf_trace_to_json(str_t* str) {
+  uint32_t i = 0;
+  char buff[64];
+  uint32_t nr = perf_trace_count();
+  return_value_if_fail(str != NULL, RET_BAD_PARAMS);
+
+  str_set(str, "{\"traceEvents\":[");
+  for (i = 0; i < nr; i++) {
+    const perf_trace_event_t* e = perf_trace_get(i);
+
+    if (i > 0) {
+      str_append_char(str, ',');
+    }
+
+    str_append(str, "\n{\"name\":");
+    perf_trace_append_json_str(str, e->name);
+    str_append(str, ",\"cat\":");
+    perf_trace_append_json_str(str, e->cat);
+    tk_snprintf(buff, sizeof(buff), ",\"ph\":\"%c\",\"ts\":%llu,\"pid\":1,\"tid\":1", e->ph,
+                (unsigned long long)(e->ts));
+    str_append(str, buff);
+
+    if (e->detail[0]) {
+      str_append(str, ",\"args\":{\"name\":");
+      perf_trace_append_json_str(str, e->detail);
+      str_append_char(str, '}');
+    }
+    str_append_char(str, '}');
+  }
+
+  return str_append(str, "\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+ret_t perf_trace_save(const char* filename) {
+  str_t str;
+  ret_t ret = RET_OK;
+  return_value_if_fail(filename != NULL, RET_BAD_PARAMS);
+
+  str_init(&str, 1024);
+  ret = perf_trace_to_json(&str);
+  if (ret == RET_OK) {
+    ret = file_write(filename, str.str, str.size);
+  }
+  str_reset(&str);
+
+  return ret;
+}
+
+ret_t perf_trace_deinit(void) {
+  perf_trace_t* trace = &s_perf_trace;
+
+  TKMEM_FREE(trace->events);
+  trace->events = NULL;
+  trace->windex = 0;
+  trace->mask = 0;
+  trace->capacity = 0;
+
+  return RET_OK;
+}
@@ -0,0 +1,204 @@
+/**
+ * File:   perf_trace.h
+ * Author: AWTK Develop Team
+ * Brief:  frame level performance trace
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_PERF_TRACE_H
+#define TK_PERF_TRACE_H
+
+#include "tkc/str.h"
+
+BEGIN_C_DECLS
+
+#ifndef TK_PERF_TRACE_CAPACITY
+#define TK_PERF_TRACE_CAPACITY 4096
+#endif /*TK_PERF_TRACE_CAPACITY*/
+
+#define TK_PERF_TRACE_DETAIL_LEN 15
+
+/**
+ * @class perf_trace_event_t
+ * 性能跟踪事件。
+ */
+typedef struct _perf_trace_event_t {
+  /**
+   * @property {uint64_t} ts
+   * @annotation ["readable"]
+   * 时间戳(微秒)。
+   */
+  uint64_t ts;
+  /**
+   * @property {const char*} cat
+   * @annotation ["readable"]
+   * 分类(必须是常量字符串)。
+   */
+  const char* cat;
+  /**
+   * @property {const char*} name
+   * @annotation ["readable"]
+   * 名称(必须是常量字符串)。
+   */
+  const char* name;
+  /**
+   * @property {char*} detail
+   * @annotation ["readable"]
+   * 附加信息(如控件的名称)，记录时会拷贝一份。
+   */
+  char detail[TK_PERF_TRACE_DETAIL_LEN + 1];
+  /**
+   * @property {char} ph
+   * @annotation ["readable"]
+   * 事件类型：'B'表示开始，'E'表示结束。
+   */
+  char ph;
+} perf_trace_event_t;
+
+/**
+ * @class perf_trace_t
+ * @annotation ["fake"]
+ * 帧级性能跟踪。
+ *
+ * 在主循环的各个阶段(定时器、输入、idle、布局、绘制和LCD刷新)记录开始/结束事件，
+ * 事件保存在固定大小的环形缓冲区中(写满后覆盖最旧的事件)，记录时不需要加锁。
+ * 可以导出为Chrome trace event格式的JSON，用chrome://tracing或Perfetto查看，
+ * 以便找出是哪个控件超出了帧时间预算。
+ *
+ * 只有定义了ENABLE\_PERFORMANCE\_PROFILE时，PERF\_TRACE\_BEGIN/PERF\_TRACE\_END才会生效。
+ *
+ * 示例：
+ *
+ * ```c
+ * perf_trace_init(4096);
+ * ...
+ * perf_trace_save("trace.json");
+ * perf_trace_deinit();
+ * ```
+ */
+
+/**
+ * @method perf_trace_init
+ * 初始化性能跟踪。
+ * @annotation ["static"]
+ * @param {uint32_t} capacity 环形缓冲区可以容纳的事件数(会向上取整到2的幂)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t perf_trace_init(uint32_t capacity);
+
+/**
+ * @method perf_trace_set_clock
+ * 设置获取当前时间(微秒)的函数。缺省使用time\_now\_us(Linux和MacOS上为单调时钟)。
+ * @annotation ["static"]
+ * @param {uint64_t (*)(void)} get_time_us 获取当前时间的函数，为NULL时恢复缺省的时钟。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t perf_trace_set_clock(uint64_t (*get_time_us)(void));
+
+/**
+ * @method perf_trace_begin
+ * 记录开始事件。
+ * @annotation ["static"]
+ * @param {const char*} cat 分类(必须是常量字符串)。
+ * @param {const char*} name 名称(必须是常量字符串)。
+ * @param {const char*} detail 附加信息(可以为NULL)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t perf_trace_begin(const char* cat, const char* name, const char* detail);
+
+/**
+ * @method perf_trace_end
+ * 记录结束事件。
+ * @annotation ["static"]
+ * @param {const char*} cat 分类(必须是常量字符串)。
+ * @param {const char*} name 名称(必须是常量字符串)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t perf_trace_end(const char* cat, const char* name);
+
+/**
+ * @method perf_trace_count
+ * 获取缓冲区中有效事件的个数。
+ * @annotation ["static"]
+ *
+ * @return {uint32_t} 返回事件的个数。
+ */
+uint32_t perf_trace_count(void);
+
+/**
+ * @method perf_trace_get
+ * 获取缓冲区中第index个事件(0表示最旧的事件)。
+ * @annotation ["static"]
+ * @param {uint32_t} index 序数。
+ *
+ * @return {const perf_trace_event_t*} 返回事件，失败返回NULL。
+ */
+const perf_trace_event_t* perf_trace_get(uint32_t index);
+
+/**
+ * @method perf_trace_reset
+ * 清除已经记录的事件。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t perf_trace_reset(void);
+
+/**
+ * @method perf_trace_to_json
+ * 把已经记录的事件导出为Chrome trace event格式的JSON。
+ * @annotation ["static"]
+ * @param {str_t*} str 用于返回JSON的字符串对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t perf_trace_to_json(str_t* str);
+
+/**
+ * @method perf_trace_save
+ * 把已经记录的事件导出为Chrome trace event格式的JSON文件。
+ * @annotation ["static"]
+ * @param {const char*} filename 文件名。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t perf_trace_save(const char* filename);
+
+/**
+ * @method perf_trace_deinit
+ * 释放性能跟踪的资源。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t perf_trace_deinit(void);
+
+#ifdef ENABLE_PERFORMANCE_PROFILE
+#define PERF_TRACE_BEGIN(cat, name, detail) perf_trace_begin(cat, name, detail)
+#define PERF_TRACE_END(cat, name) perf_trace_end(cat, name)
+#else
+#define PERF_TRACE_BEGIN(cat, name, detail)
+#define PERF_TRACE_END(cat, name)
+#endif /*ENABLE_PERFORMANCE_PROFILE*/
+
+END_C_DECLS
+
+#endif /*TK_PERF_TRACE_H*/
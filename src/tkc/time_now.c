@@ -22,6 +22,10 @@
 #include "tkc/time_now.h"
 #include "tkc/platform.h"
 
+#if defined(LINUX) || defined(__APPLE__)
+#include <time.h>
+#endif /*LINUX || __APPLE__*/
+
 uint32_t time_now_ms(void) {
   return get_time_ms();
 }
@@ -29,3 +33,14 @@ uint32_t time_now_ms(void) {
 uint32_t time_now_s(void) {
   return get_time_ms() / 1000;
 }
+
+uint64_t time_now_us(void) {
+#if defined(LINUX) || defined(__APPLE__)
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+  return (uint64_t)get_time_ms() * 1000;
+#endif /*LINUX || __APPLE__*/
+}
@@ -52,6 +52,17 @@ uint32_t time_now_s(void);
  */
 uint32_t time_now_ms(void);
 
+/**
+ * @method time_now_us
+ * 获取当前时间(微秒)，只用于计算时间间隔。
+ * Linux和MacOS上使用单调时钟，不受系统时间调整的影响。
+ * 平台不支持高精度时钟时，精度和time\_now\_ms相同。
+ * @annotation ["static"]
+ *
+ * @return {uint64_t} 返回当前时间(微秒)。
+ */
+uint64_t time_now_us(void);
+
 END_C_DECLS
 
 #endif /*TK_TIME_NOW_H*/
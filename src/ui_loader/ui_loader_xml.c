@@ -78,6 +78,18 @@ static bool_t is_valid_self_layout(const char* x, const char* y, const char* w,
          is_valid_layout_param(h);
 }
 
+/*只有包含实体或者转义字符的值才需要解码，其它的值直接使用(不用复制)。*/
+static const char* xml_loader_decode_value(xml_builder_t* b, const char* value) {
+  if (strpbrk(value, "&\\") == NULL) {
+    return value;
+  }
+
+  ENSURE(str_decode_xml_entity(&(b->str), value) == RET_OK);
+  str_unescape(&(b->str));
+
+  return b->str.str;
+}
+
 static void xml_loader_on_start_widget(XmlBuilder* thiz, const char* tag, const char** attrs) {
   char c = '\0';
   uint32_t i = 0;
@@ -170,9 +182,7 @@ static void xml_loader_on_start_widget(XmlBuilder* thiz, const char* tag, const
     }
 
     if (is_precedence_prop(tag, key)) {
-      ENSURE(str_decode_xml_entity(&(b->str), value) == RET_OK);
-      str_unescape(&(b->str));
-      ui_builder_on_widget_prop(b->ui_builder, key, b->str.str);
+      ui_builder_on_widget_prop(b->ui_builder, key, xml_loader_decode_value(b, value));
     }
 
     i += 2;
@@ -193,9 +203,7 @@ static void xml_loader_on_start_widget(XmlBuilder* thiz, const char* tag, const
     }
 
     if (!is_precedence_prop(tag, key)) {
-      ENSURE(str_decode_xml_entity(&(b->str), value) == RET_OK);
-      str_unescape(&(b->str));
-      ui_builder_on_widget_prop(b->ui_builder, key, b->str.str);
+      ui_builder_on_widget_prop(b->ui_builder, key, xml_loader_decode_value(b, value));
     }
 
     i += 2;
@@ -217,6 +225,8 @@ static void xml_loader_on_start_property(XmlBuilder* thiz, const char* tag, cons
       tk_strncpy(b->property_name, value, TK_NAME_LEN);
       break;
     }
+
+    i += 2;
   }
 }
 
@@ -315,16 +325,24 @@ static XmlBuilder* builder_init(xml_builder_t* b, ui_builder_t* ui_builder) {
 ret_t ui_loader_load_xml(ui_loader_t* loader, const uint8_t* data, uint32_t size,
                          ui_builder_t* ui_builder) {
   xml_builder_t b;
+  char* xml = NULL;
   XmlParser* parser = NULL;
   return_value_if_fail(loader != NULL && data != NULL && ui_builder != NULL, RET_BAD_PARAMS);
 
+  /*资源数据是只读的，复制一份后原地解析，避免为每个标签和属性复制字符串。*/
+  xml = TKMEM_ALLOC(size + 1);
+  return_value_if_fail(xml != NULL, RET_OOM);
+  memcpy(xml, data, size);
+  xml[size] = '\0';
+
   parser = xml_parser_create();
   xml_parser_set_builder(parser, builder_init(&b, ui_builder));
   ui_builder_on_start(ui_builder);
-  xml_parser_parse(parser, (const char*)data, size);
+  xml_parser_parse_insitu(parser, xml, size);
   ui_builder_on_end(ui_builder);
   xml_parser_destroy(parser);
   str_reset(&(b.str));
+  TKMEM_FREE(xml);
 
   return RET_OK;
 }
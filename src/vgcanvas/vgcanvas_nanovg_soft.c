@@ -32,6 +32,33 @@
 #include "agg/nanovg_agg.h"
 #endif /*WITH_NANOVG_AGGE|WITH_NANOVG_AGG*/
 
+/*
+ * vgcanvas中图片纹理引用的像素数据(由image_manager解码和缓存)的预算，单位为字节，0表示不限制。
+ * 超出预算时，在一帧结束时卸载最近最少绘制的图片(当前帧绘制的图片除外)。
+ */
+#ifndef TK_VGCANVAS_TEXTURE_BUDGET
+#define TK_VGCANVAS_TEXTURE_BUDGET 0
+#endif /*TK_VGCANVAS_TEXTURE_BUDGET*/
+
+/*
+ * 光栅化使用的线程数(包括调用者所在的线程)，0或1表示单线程渲染。
+ * 只有覆盖的行数不少于TK_VGCANVAS_RENDER_MIN_ROWS的填充和描边才使用多个线程。
+ */
+#ifndef TK_VGCANVAS_RENDER_THREADS
+#define TK_VGCANVAS_RENDER_THREADS 0
+#endif /*TK_VGCANVAS_RENDER_THREADS*/
+
+#ifndef TK_VGCANVAS_RENDER_MIN_ROWS
+#define TK_VGCANVAS_RENDER_MIN_ROWS 64
+#endif /*TK_VGCANVAS_RENDER_MIN_ROWS*/
+
+#if defined(WITH_NANOVG_AGGE) && (defined(HAS_PTHREAD) || defined(WIN32))
+#define WITH_VGCANVAS_RENDER_THREADS 1
+#endif /*WITH_NANOVG_AGGE && (HAS_PTHREAD || WIN32)*/
+
+struct _render_workers_t;
+typedef struct _render_workers_t render_workers_t;
+
 typedef struct _vgcanvas_nanovg_t {
   vgcanvas_t base;
 
@@ -39,11 +66,28 @@ typedef struct _vgcanvas_nanovg_t {
   NVGcontext* vg;
   uint32_t text_align_v;
   uint32_t text_align_h;
+  render_workers_t* workers;
 } vgcanvas_nanovg_t;
 
 #include "vgcanvas_nanovg_soft.inc"
 #include "vgcanvas_nanovg.inc"
 
+#ifdef WITH_NANOVG_AGGE
+/*
+ * 纹理随图片一起释放(见nanovg_on_bitmap_destroy)，所以被回收纹理的data一定属于仍然有效的图片。
+ * 卸载图片时先删除了该纹理，之后nanovg再删除时纹理的id已经失效，不会产生影响。
+ */
+static void vgcanvas_nanovg_on_evict_texture(void* ctx, int image, const uint8_t* data) {
+  bitmap_t img;
+  (void)ctx;
+  (void)image;
+
+  memset(&img, 0x00, sizeof(img));
+  img.data = data;
+  image_manager_unload_bitmap(image_manager(), &img);
+}
+#endif /*WITH_NANOVG_AGGE*/
+
 vgcanvas_t* vgcanvas_create(uint32_t w, uint32_t h, uint32_t stride, bitmap_format_t format,
                             void* data) {
   enum NVGtexture f = bitmap_format_to_nanovg(format);
@@ -61,6 +105,13 @@ vgcanvas_t* vgcanvas_create(uint32_t w, uint32_t h, uint32_t stride, bitmap_form
   nanovg->vg = nvgCreateAGG(w, h, stride, f, (uint8_t*)data);
 #elif defined(WITH_NANOVG_AGGE)
   nanovg->vg = nvgCreateAGGE(w, h, stride, f, (uint8_t*)data);
+  if (nanovg->vg != NULL) {
+    nvgAggeSetTextureBudget(nanovg->vg, TK_VGCANVAS_TEXTURE_BUDGET,
+                            vgcanvas_nanovg_on_evict_texture, nanovg);
+    if (TK_VGCANVAS_RENDER_THREADS > 1) {
+      vgcanvas_nanovg_set_render_threads(&(nanovg->base), TK_VGCANVAS_RENDER_THREADS);
+    }
+  }
 #else
   assert(!"not support backend");
 #endif
@@ -21,6 +21,7 @@
 
 #include "tkc/mem.h"
 #include "tkc/utils.h"
+#include "base/widget_atoms.h"
 #include "widget_animators/widget_animator_prop.h"
 
 static ret_t widget_animator_prop_update(widget_animator_t* animator, float_t percent) {
@@ -30,7 +31,7 @@ static ret_t widget_animator_prop_update(widget_animator_t* animator, float_t pe
   return_value_if_fail(prop != NULL, RET_BAD_PARAMS);
 
   new_prop = prop->from + (prop->to - prop->from) * percent;
-  widget_set_prop(animator->widget, prop->prop_name, value_set_float(&v, new_prop));
+  widget_set_prop_atom(animator->widget, prop->prop_atom, value_set_float(&v, new_prop));
 
   return RET_OK;
 }
@@ -50,6 +51,7 @@ widget_animator_t* widget_animator_prop_create(widget_t* widget, uint32_t durati
   prop = (widget_animator_prop_t*)animator;
   animator->update = widget_animator_prop_update;
   tk_strncpy(prop->prop_name, prop_name, TK_NAME_LEN);
+  prop->prop_atom = widget_atom_from_str(prop->prop_name);
 
   return animator;
 }
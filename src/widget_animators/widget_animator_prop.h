@@ -36,6 +36,7 @@ typedef struct _widget_animator_prop_t {
   float_t to;
   float_t from;
   char prop_name[TK_NAME_LEN + 1];
+  atom_t prop_atom;
 } widget_animator_prop_t;
 
 /**
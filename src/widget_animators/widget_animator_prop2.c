@@ -21,6 +21,7 @@
 
 #include "tkc/mem.h"
 #include "tkc/utils.h"
+#include "base/widget_atoms.h"
 #include "widget_animators/widget_animator_prop2.h"
 
 static ret_t widget_animator_prop2_update(widget_animator_t* animator, float_t percent) {
@@ -30,12 +31,12 @@ static ret_t widget_animator_prop2_update(widget_animator_t* animator, float_t p
 
   if (prop2->to1 != prop2->from1) {
     value_set_float(&v, prop2->from1 + (prop2->to1 - prop2->from1) * percent);
-    widget_set_prop(animator->widget, prop2->prop1_name, &v);
+    widget_set_prop_atom(animator->widget, prop2->prop1_atom, &v);
   }
 
   if (prop2->to2 != prop2->from2) {
     value_set_float(&v, prop2->from2 + (prop2->to2 - prop2->from2) * percent);
-    widget_set_prop(animator->widget, prop2->prop2_name, &v);
+    widget_set_prop_atom(animator->widget, prop2->prop2_atom, &v);
   }
 
   return RET_OK;
@@ -59,6 +60,8 @@ widget_animator_t* widget_animator_prop2_create(widget_t* widget, uint32_t durat
   animator->update = widget_animator_prop2_update;
   tk_strncpy(prop2->prop1_name, prop1_name, TK_NAME_LEN);
   tk_strncpy(prop2->prop2_name, prop2_name, TK_NAME_LEN);
+  prop2->prop1_atom = widget_atom_from_str(prop2->prop1_name);
+  prop2->prop2_atom = widget_atom_from_str(prop2->prop2_name);
 
   return animator;
 }
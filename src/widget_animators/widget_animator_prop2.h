@@ -39,6 +39,8 @@ typedef struct _widget_animator_prop2_t {
   float_t from2;
   char prop1_name[TK_NAME_LEN + 1];
   char prop2_name[TK_NAME_LEN + 1];
+  atom_t prop1_atom;
+  atom_t prop2_atom;
 } widget_animator_prop2_t;
 
 /**
@@ -20,6 +20,7 @@
  */
 
 #include "tkc/mem.h"
+#include "base/widget_atoms.h"
 #include "widget_animators/widget_animator_scroll.h"
 
 static ret_t widget_animator_scroll_update(widget_animator_t* animator, float_t percent) {
@@ -32,13 +33,13 @@ static ret_t widget_animator_scroll_update(widget_animator_t* animator, float_t
   if (scroll->x_to != scroll->x_from) {
     xoffset = scroll->x_from + (scroll->x_to - scroll->x_from) * percent;
     value_set_int(&v, xoffset);
-    widget_set_prop(animator->widget, WIDGET_PROP_XOFFSET, &v);
+    widget_set_prop_atom(animator->widget, WIDGET_ATOM_XOFFSET, &v);
   }
 
   if (scroll->y_to != scroll->y_from) {
     yoffset = scroll->y_from + (scroll->y_to - scroll->y_from) * percent;
     value_set_int(&v, yoffset);
-    widget_set_prop(animator->widget, WIDGET_PROP_YOFFSET, &v);
+    widget_set_prop_atom(animator->widget, WIDGET_ATOM_YOFFSET, &v);
   }
 
   return RET_OK;
@@ -53,6 +54,7 @@ widget_animator_t* widget_animator_scroll_create(widget_t* widget, uint32_t dura
   return_value_if_fail(
       widget_animator_init(animator, widget, duration, delay, easing_get(easing)) == RET_OK, NULL);
   animator->update = widget_animator_scroll_update;
+  widget_atoms_init();
 
   return animator;
 }
@@ -29,7 +29,6 @@ static ret_t image_on_paint_self(widget_t* widget, canvas_t* c) {
   rect_t dst;
   bitmap_t bitmap;
   image_t* image = IMAGE(widget);
-  vgcanvas_t* vg = lcd_get_vgcanvas(c->lcd);
   image_base_t* image_base = IMAGE_BASE(widget);
   return_value_if_fail(image != NULL, RET_BAD_PARAMS);
 
@@ -40,13 +39,9 @@ static ret_t image_on_paint_self(widget_t* widget, canvas_t* c) {
   return_value_if_fail(widget_load_image(widget, image_base->image, &bitmap) == RET_OK,
                        RET_BAD_PARAMS);
 
-  if (vg != NULL) {
-    if (image_need_transform(widget)) {
-      vgcanvas_save(vg);
-      image_transform(widget, c);
-      vgcanvas_draw_icon(vg, &bitmap, 0, 0, bitmap.w, bitmap.h, 0, 0, widget->w, widget->h);
-      vgcanvas_restore(vg);
-
+  if (image_need_transform(widget)) {
+    rect_t src = rect_init(0, 0, bitmap.w, bitmap.h);
+    if (image_transform_draw(widget, c, &bitmap, &src) == RET_OK) {
       return RET_OK;
     }
   }
@@ -106,7 +101,9 @@ TK_DECL_VTABLE(image) = {.size = sizeof(image_t),
                          .on_event = image_base_on_event,
                          .on_paint_self = image_on_paint_self,
                          .set_prop = image_set_prop,
-                         .get_prop = image_get_prop};
+                         .get_prop = image_get_prop,
+                         .set_prop_atom = image_base_set_prop_atom,
+                         .get_prop_atom = image_base_get_prop_atom};
 
 widget_t* image_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
   widget_t* widget = widget_create(parent, TK_REF_VTABLE(image), x, y, w, h);
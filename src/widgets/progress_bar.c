@@ -22,6 +22,7 @@
 #include "tkc/mem.h"
 #include "tkc/utils.h"
 #include "widgets/progress_bar.h"
+#include "base/widget_atoms.h"
 #include "base/widget_vtable.h"
 #include "base/image_manager.h"
 
@@ -145,6 +146,36 @@ static ret_t progress_bar_set_prop(widget_t* widget, const char* name, const val
   return RET_NOT_FOUND;
 }
 
+static ret_t progress_bar_get_prop_atom(widget_t* widget, atom_t atom, value_t* v) {
+  progress_bar_t* progress_bar = PROGRESS_BAR(widget);
+  return_value_if_fail(progress_bar != NULL && v != NULL, RET_BAD_PARAMS);
+
+  switch (atom) {
+    case WIDGET_ATOM_VALUE: {
+      value_set_uint8(v, progress_bar->value);
+      return RET_OK;
+    }
+    default:
+      break;
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static ret_t progress_bar_set_prop_atom(widget_t* widget, atom_t atom, const value_t* v) {
+  return_value_if_fail(widget != NULL && v != NULL, RET_BAD_PARAMS);
+
+  switch (atom) {
+    case WIDGET_ATOM_VALUE: {
+      return progress_bar_set_value(widget, value_int(v));
+    }
+    default:
+      break;
+  }
+
+  return RET_NOT_FOUND;
+}
+
 static const char* s_progress_bar_clone_properties[] = {WIDGET_PROP_VALUE, WIDGET_PROP_VERTICAL,
                                                         WIDGET_PROP_SHOW_TEXT, NULL};
 TK_DECL_VTABLE(progress_bar) = {.size = sizeof(progress_bar_t),
@@ -155,7 +186,9 @@ TK_DECL_VTABLE(progress_bar) = {.size = sizeof(progress_bar_t),
                                 .on_paint_self = progress_bar_on_paint_self,
                                 .on_paint_background = widget_on_paint_null,
                                 .get_prop = progress_bar_get_prop,
-                                .set_prop = progress_bar_set_prop};
+                                .set_prop = progress_bar_set_prop,
+                                .get_prop_atom = progress_bar_get_prop_atom,
+                                .set_prop_atom = progress_bar_set_prop_atom};
 
 widget_t* progress_bar_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
   widget_t* widget = widget_create(parent, TK_REF_VTABLE(progress_bar), x, y, w, h);
@@ -24,6 +24,7 @@
 #include "tkc/utils.h"
 #include "base/keys.h"
 #include "widgets/slider.h"
+#include "base/widget_atoms.h"
 #include "base/widget_vtable.h"
 #include "base/image_manager.h"
 
@@ -446,6 +447,36 @@ static ret_t slider_set_prop(widget_t* widget, const char* name, const value_t*
   return RET_NOT_FOUND;
 }
 
+static ret_t slider_get_prop_atom(widget_t* widget, atom_t atom, value_t* v) {
+  slider_t* slider = SLIDER(widget);
+  return_value_if_fail(slider != NULL && v != NULL, RET_BAD_PARAMS);
+
+  switch (atom) {
+    case WIDGET_ATOM_VALUE: {
+      value_set_int(v, slider->value);
+      return RET_OK;
+    }
+    default:
+      break;
+  }
+
+  return RET_NOT_FOUND;
+}
+
+static ret_t slider_set_prop_atom(widget_t* widget, atom_t atom, const value_t* v) {
+  return_value_if_fail(widget != NULL && v != NULL, RET_BAD_PARAMS);
+
+  switch (atom) {
+    case WIDGET_ATOM_VALUE: {
+      return slider_set_value(widget, value_int(v));
+    }
+    default:
+      break;
+  }
+
+  return RET_NOT_FOUND;
+}
+
 static const char* s_slider_properties[] = {WIDGET_PROP_VALUE, WIDGET_PROP_VERTICAL,
                                             WIDGET_PROP_MIN,   WIDGET_PROP_MAX,
                                             WIDGET_PROP_STEP,  NULL};
@@ -461,7 +492,9 @@ TK_DECL_VTABLE(slider) = {.size = sizeof(slider_t),
                           .on_paint_border = widget_on_paint_null,
                           .on_paint_background = widget_on_paint_null,
                           .get_prop = slider_get_prop,
-                          .set_prop = slider_set_prop};
+                          .set_prop = slider_set_prop,
+                          .get_prop_atom = slider_get_prop_atom,
+                          .set_prop_atom = slider_set_prop_atom};
 
 widget_t* slider_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
   widget_t* widget = widget_create(parent, TK_REF_VTABLE(slider), x, y, w, h);
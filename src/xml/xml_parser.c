@@ -42,6 +42,12 @@ struct _XmlParser {
 
   XmlBuilder* builder;
   str_t text;
+
+  /*原地解析时的文档。名称和属性直接引用文档中的字符串，回调前在结束位置写入'\0'，回调后恢复。*/
+  char* insitu;
+  int terms_nr;
+  char* terms[MAX_ATTR_NR + 2];
+  char terms_saved[MAX_ATTR_NR + 2];
 };
 
 static const char* strtrim(char* str);
@@ -176,17 +182,75 @@ void xml_parser_parse(XmlParser* thiz, const char* xml, int length) {
   return;
 }
 
+void xml_parser_parse_insitu(XmlParser* thiz, char* xml, int length) {
+  thiz->insitu = xml;
+  xml_parser_parse(thiz, xml, length);
+  thiz->insitu = NULL;
+  thiz->terms_nr = 0;
+
+  return;
+}
+
 static void xml_parser_reset_buffer(XmlParser* thiz) {
   thiz->buffer_used = 0;
   thiz->attrs_nr = 0;
   thiz->attrs[0] = NULL;
+  thiz->terms_nr = 0;
+
+  return;
+}
+
+static char* xml_parser_get_str(XmlParser* thiz, int offset) {
+  return (thiz->insitu != NULL ? thiz->insitu : thiz->buffer) + offset;
+}
+
+static void xml_parser_terminate_strs(XmlParser* thiz) {
+  int i = 0;
+
+  for (i = 0; i < thiz->terms_nr; i++) {
+    thiz->terms_saved[i] = *(thiz->terms[i]);
+    *(thiz->terms[i]) = '\0';
+  }
+
+  return;
+}
+
+static void xml_parser_restore_strs(XmlParser* thiz) {
+  int i = 0;
+
+  for (i = thiz->terms_nr - 1; i >= 0; i--) {
+    *(thiz->terms[i]) = thiz->terms_saved[i];
+  }
+  thiz->terms_nr = 0;
 
   return;
 }
 
+static int xml_parser_strref(XmlParser* thiz, const char* start, int length) {
+  const char* end = start + length;
+
+  while (start < end && isspace(*start)) {
+    start++;
+  }
+
+  while (end > start && isspace(end[-1])) {
+    end--;
+  }
+
+  if (thiz->terms_nr < (int)ARRAY_SIZE(thiz->terms)) {
+    thiz->terms[thiz->terms_nr++] = (char*)end;
+  }
+
+  return start - thiz->insitu;
+}
+
 static int xml_parser_strdup(XmlParser* thiz, const char* start, int length) {
   int offset = -1;
 
+  if (thiz->insitu != NULL) {
+    return xml_parser_strref(thiz, start, length);
+  }
+
   if ((thiz->buffer_used + length) >= thiz->capacity) {
     int new_capacity = thiz->capacity + (thiz->capacity >> 1) + length + 32;
     char* buffer = (char*)TKMEM_REALLOCT(char, thiz->buffer, new_capacity);
@@ -269,7 +333,7 @@ static void xml_parser_parse_attrs(XmlParser* thiz, char end_char) {
   }
 
   for (i = 0; i < thiz->attrs_nr; i++) {
-    thiz->attrs[i] = thiz->buffer + tk_pointer_to_int(thiz->attrs[i]);
+    thiz->attrs[i] = xml_parser_get_str(thiz, tk_pointer_to_int(thiz->attrs[i]));
   }
   thiz->attrs[thiz->attrs_nr] = NULL;
 
@@ -284,6 +348,7 @@ static void xml_parser_parse_start_tag(XmlParser* thiz) {
   } state = STAT_NAME;
 
   char* tag_name = NULL;
+  bool_t empty_tag = FALSE;
   const char* start = thiz->read_ptr - 1;
 
   for (; *thiz->read_ptr != '\0'; thiz->read_ptr++) {
@@ -312,12 +377,15 @@ static void xml_parser_parse_start_tag(XmlParser* thiz) {
     }
   }
 
-  tag_name = thiz->buffer + tk_pointer_to_int(tag_name);
-  xml_builder_on_start(thiz->builder, tag_name, (const char**)thiz->attrs);
+  empty_tag = thiz->read_ptr[0] == '/';
+  tag_name = xml_parser_get_str(thiz, tk_pointer_to_int(tag_name));
 
-  if (thiz->read_ptr[0] == '/') {
+  xml_parser_terminate_strs(thiz);
+  xml_builder_on_start(thiz->builder, tag_name, (const char**)thiz->attrs);
+  if (empty_tag) {
     xml_builder_on_end(thiz->builder, tag_name);
   }
+  xml_parser_restore_strs(thiz);
 
   for (; *thiz->read_ptr != '>' && *thiz->read_ptr != '\0'; thiz->read_ptr++)
     ;
@@ -330,8 +398,10 @@ static void xml_parser_parse_end_tag(XmlParser* thiz) {
   const char* start = thiz->read_ptr;
   for (; *thiz->read_ptr != '\0'; thiz->read_ptr++) {
     if (*thiz->read_ptr == '>') {
-      tag_name = thiz->buffer + xml_parser_strdup(thiz, start, thiz->read_ptr - start);
+      tag_name = xml_parser_get_str(thiz, xml_parser_strdup(thiz, start, thiz->read_ptr - start));
+      xml_parser_terminate_strs(thiz);
       xml_builder_on_end(thiz->builder, tag_name);
+      xml_parser_restore_strs(thiz);
 
       break;
     }
@@ -423,8 +493,10 @@ static void xml_parser_parse_pi(XmlParser* thiz) {
     }
   }
 
-  tag_name = thiz->buffer + tk_pointer_to_int(tag_name);
+  tag_name = xml_parser_get_str(thiz, tk_pointer_to_int(tag_name));
+  xml_parser_terminate_strs(thiz);
   xml_builder_on_pi(thiz->builder, tag_name, (const char**)thiz->attrs);
+  xml_parser_restore_strs(thiz);
 
   for (; *thiz->read_ptr != '>' && *thiz->read_ptr != '\0'; thiz->read_ptr++)
     ;
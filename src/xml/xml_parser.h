@@ -34,6 +34,12 @@ typedef struct _XmlParser XmlParser;
 XmlParser* xml_parser_create(void);
 void xml_parser_set_builder(XmlParser* thiz, XmlBuilder* builder);
 void xml_parser_parse(XmlParser* thiz, const char* xml, int length);
+
+/*
+ * 原地解析：标签名和属性不再复制，直接引用xml中的字符串(回调期间在其结束位置写入'\0'，
+ * 回调返回后恢复)，所以xml必须是可写的，回调中也不能保存这些指针。
+ */
+void xml_parser_parse_insitu(XmlParser* thiz, char* xml, int length);
 void xml_parser_parse_file(XmlParser* thiz, const char* filename);
 void xml_parser_destroy(XmlParser* thiz);
 
@@ -0,0 +1,96 @@
+#include "tkc/fs.h"
+#include "tkc/mem.h"
+#include "base/asset_bundle.h"
+#include "base/assets_manager.h"
+#include "res_gen/asset_bundle_gen.h"
+#include "gtest/gtest.h"
+
+#define TEST_RAW_DIR "./demos/assets/raw"
+#define TEST_BUNDLE "./tests/testdata/test.bundle"
+
+static void assert_same_as_file(const asset_info_t* info, const char* filename) {
+  uint32_t size = 0;
+  void* data = file_read(filename, &size);
+
+  ASSERT_EQ(data != NULL, true);
+  ASSERT_EQ(info->size, size);
+  ASSERT_EQ(memcmp(info->data, data, size), 0);
+  TKMEM_FREE(data);
+}
+
+TEST(AssetBundle, basic) {
+  const asset_info_t* info = NULL;
+  asset_bundle_t* bundle = NULL;
+
+  ASSERT_EQ(asset_bundle_gen(TEST_RAW_DIR, TEST_BUNDLE), RET_OK);
+  bundle = asset_bundle_open(TEST_BUNDLE);
+  ASSERT_EQ(bundle != NULL, true);
+
+  info = asset_bundle_find(bundle, ASSET_TYPE_IMAGE, "x1/earth");
+  ASSERT_EQ(info != NULL, true);
+  ASSERT_EQ(info->is_in_rom, TRUE);
+  ASSERT_EQ(info->subtype, ASSET_TYPE_IMAGE_PNG);
+  ASSERT_STREQ(info->name, "earth");
+  ASSERT_EQ(asset_bundle_has(bundle, info), true);
+  assert_same_as_file(info, TEST_RAW_DIR "/images/x1/earth.png");
+
+  info = asset_bundle_find(bundle, ASSET_TYPE_IMAGE, "svg/china");
+  ASSERT_EQ(info != NULL, true);
+  ASSERT_EQ(info->subtype, ASSET_TYPE_IMAGE_BSVG);
+
+  info = asset_bundle_find(bundle, ASSET_TYPE_UI, "main");
+  ASSERT_EQ(info != NULL, true);
+  assert_same_as_file(info, TEST_RAW_DIR "/ui/main.bin");
+
+  info = asset_bundle_find(bundle, ASSET_TYPE_DATA, "a-b-c.any");
+  ASSERT_EQ(info != NULL, true);
+  ASSERT_EQ(strncmp((const char*)(info->data), "abc\n", 4), 0);
+
+  ASSERT_EQ(asset_bundle_find(bundle, ASSET_TYPE_UI, "earth") == NULL, true);
+  ASSERT_EQ(asset_bundle_find(bundle, ASSET_TYPE_IMAGE, "earth") == NULL, true);
+  ASSERT_EQ(asset_bundle_find(bundle, ASSET_TYPE_IMAGE, "x1/not_exist") == NULL, true);
+
+  ASSERT_EQ(asset_bundle_close(bundle), RET_OK);
+  file_remove(TEST_BUNDLE);
+}
+
+TEST(AssetBundle, invalid) {
+  const char* str = "not a bundle";
+
+  ASSERT_EQ(file_write(TEST_BUNDLE, str, strlen(str)), RET_OK);
+  ASSERT_EQ(asset_bundle_open(TEST_BUNDLE) == NULL, true);
+  ASSERT_EQ(asset_bundle_open("./not_exist.bundle") == NULL, true);
+
+  file_remove(TEST_BUNDLE);
+}
+
+TEST(AssetBundle, assets_manager) {
+  const asset_info_t* r = NULL;
+  assets_manager_t* rm = assets_manager_create(10);
+
+  ASSERT_EQ(asset_bundle_gen(TEST_RAW_DIR, TEST_BUNDLE), RET_OK);
+  ASSERT_EQ(assets_manager_set_bundle(rm, TEST_BUNDLE), RET_OK);
+
+  r = assets_manager_ref(rm, ASSET_TYPE_IMAGE, "earth");
+  ASSERT_EQ(r != NULL, true);
+  ASSERT_EQ(r->is_in_rom, TRUE);
+  ASSERT_EQ(asset_bundle_has(rm->bundle, r), true);
+  ASSERT_EQ(assets_manager_find_in_cache(rm, ASSET_TYPE_IMAGE, "earth"), r);
+  ASSERT_EQ(assets_manager_unref(rm, r), RET_OK);
+
+  r = assets_manager_ref(rm, ASSET_TYPE_STYLE, "default");
+  ASSERT_EQ(r != NULL, true);
+  ASSERT_EQ(asset_bundle_has(rm->bundle, r), true);
+
+  ASSERT_EQ(assets_manager_set_bundle(rm, NULL), RET_OK);
+  ASSERT_EQ(assets_manager_find_in_cache(rm, ASSET_TYPE_IMAGE, "earth") == NULL, true);
+
+  /*fallback to the files*/
+  r = assets_manager_ref(rm, ASSET_TYPE_IMAGE, "earth");
+  ASSERT_EQ(r != NULL, true);
+  ASSERT_EQ(r->is_in_rom, FALSE);
+  ASSERT_EQ(assets_manager_unref(rm, r), RET_OK);
+
+  assets_manager_destroy(rm);
+  file_remove(TEST_BUNDLE);
+}
@@ -0,0 +1,111 @@
+#include "tkc/atom.h"
+#include "tkc/utils.h"
+#include "base/widget.h"
+#include "base/widget_atoms.h"
+#include "widgets/button.h"
+#include "widgets/slider.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using std::string;
+
+TEST(Atom, basic) {
+  atom_t a = atom_from_str("atom_test_value");
+
+  ASSERT_NE(a, (atom_t)ATOM_NONE);
+  ASSERT_GE(a, (atom_t)ATOM_STATIC_MAX);
+  ASSERT_EQ(atom_from_str("atom_test_value"), a);
+  ASSERT_EQ(atom_find("atom_test_value"), a);
+  ASSERT_STREQ(atom_to_str(a), "atom_test_value");
+  ASSERT_EQ(atom_intern("atom_test_value"), atom_to_str(a));
+
+  ASSERT_EQ(atom_find("atom_test_not_exist"), (atom_t)ATOM_NONE);
+  ASSERT_EQ(atom_to_str(ATOM_NONE), (const char*)NULL);
+  ASSERT_EQ(atom_from_str(NULL), (atom_t)ATOM_NONE);
+}
+
+TEST(Atom, static) {
+  static const char* name = "atom_test_static";
+
+  ASSERT_EQ(atom_add_static(name, 200), RET_OK);
+  ASSERT_EQ(atom_add_static(name, 200), RET_OK);
+  ASSERT_EQ(atom_to_str(200), name);
+  ASSERT_EQ(atom_from_str("atom_test_static"), (atom_t)200);
+
+  ASSERT_EQ(atom_add_static("atom_test_other", 200), RET_FOUND);
+  ASSERT_EQ(atom_add_static(name, 201), RET_FOUND);
+  ASSERT_EQ(atom_add_static(name, ATOM_STATIC_MAX), RET_BAD_PARAMS);
+}
+
+TEST(Atom, static_after_dynamic) {
+  atom_t a = atom_from_str("atom_test_promote");
+
+  ASSERT_GE(a, (atom_t)ATOM_STATIC_MAX);
+  ASSERT_EQ(atom_add_static("atom_test_promote", 202), RET_OK);
+  ASSERT_EQ(atom_find("atom_test_promote"), (atom_t)202);
+  ASSERT_EQ(atom_from_str("atom_test_promote"), (atom_t)202);
+  ASSERT_EQ(atom_to_str(a), atom_to_str(202));
+  ASSERT_STREQ(atom_to_str(202), "atom_test_promote");
+}
+
+TEST(Atom, many) {
+  uint32_t i = 0;
+  char name[32];
+  atom_t atoms[1000];
+
+  for (i = 0; i < ARRAY_SIZE(atoms); i++) {
+    tk_snprintf(name, sizeof(name), "atom_test_%u", i);
+    atoms[i] = atom_from_str(name);
+    ASSERT_NE(atoms[i], (atom_t)ATOM_NONE);
+  }
+
+  for (i = 0; i < ARRAY_SIZE(atoms); i++) {
+    tk_snprintf(name, sizeof(name), "atom_test_%u", i);
+    ASSERT_EQ(atom_find(name), atoms[i]);
+    ASSERT_STREQ(atom_to_str(atoms[i]), name);
+  }
+}
+
+TEST(Atom, widget) {
+  value_t v;
+  widget_t* b = button_create(NULL, 10, 20, 30, 40);
+
+  ASSERT_EQ(widget_atom_find(WIDGET_PROP_X), (atom_t)WIDGET_ATOM_X);
+  ASSERT_EQ(widget_atom_find(WIDGET_PROP_ROTATION), (atom_t)WIDGET_ATOM_ROTATION);
+
+  ASSERT_EQ(widget_set_prop_atom(b, WIDGET_ATOM_X, value_set_int(&v, 100)), RET_OK);
+  ASSERT_EQ(b->x, 100);
+  ASSERT_EQ(widget_get_prop_atom(b, WIDGET_ATOM_Y, &v), RET_OK);
+  ASSERT_EQ(value_int(&v), 20);
+
+  ASSERT_EQ(widget_set_prop_atom(b, widget_atom_from_str("atom_test_custom"),
+                                 value_set_int(&v, 123)),
+            RET_OK);
+  ASSERT_EQ(widget_get_prop_int(b, "atom_test_custom", 0), 123);
+  ASSERT_EQ(widget_get_prop_atom(b, widget_atom_from_str("atom_test_custom"), &v), RET_OK);
+  ASSERT_EQ(value_int(&v), 123);
+
+  ASSERT_NE(widget_set_prop_atom(b, ATOM_NONE, &v), RET_OK);
+
+  widget_destroy(b);
+}
+
+TEST(Atom, widget_vtable) {
+  value_t v;
+  widget_t* s = slider_create(NULL, 0, 0, 100, 20);
+
+  ASSERT_TRUE(s->vt->set_prop_atom != NULL);
+  ASSERT_EQ(widget_set_prop_atom(s, WIDGET_ATOM_VALUE, value_set_int(&v, 30)), RET_OK);
+  ASSERT_EQ(SLIDER(s)->value, 30);
+  ASSERT_EQ(widget_get_prop_atom(s, WIDGET_ATOM_VALUE, &v), RET_OK);
+  ASSERT_EQ(value_int(&v), 30);
+
+  /*按名称设置的属性也走按原子的路径，其它属性仍然按名称*/
+  ASSERT_EQ(widget_set_prop_int(s, WIDGET_PROP_VALUE, 40), RET_OK);
+  ASSERT_EQ(widget_get_prop_int(s, WIDGET_PROP_VALUE, 0), 40);
+  ASSERT_EQ(widget_set_prop_int(s, WIDGET_PROP_MAX, 50), RET_OK);
+  ASSERT_EQ(widget_get_prop_int(s, WIDGET_PROP_MAX, 0), 50);
+
+  widget_destroy(s);
+}
@@ -18,3 +18,37 @@ TEST(Bitmap, basic) {
     bitmap_destroy(b);
   }
 }
+
+TEST(Bitmap, spans) {
+  /*每一行的alpha：透明、混合、不透明、混合、不透明、不透明、透明、透明*/
+  uint8_t alphas[8] = {0, 0x80, 0xff, 0x40, 0xff, 0xff, 0x08, 0};
+  bitmap_span_t spans[3];
+  bitmap_t* b = bitmap_create_ex(8, 3, 0, BITMAP_FMT_RGBA8888);
+  uint8_t* data = (uint8_t*)(b->data);
+
+  memset(data, 0x00, bitmap_get_line_length(b) * b->h);
+  for (uint32_t x = 0; x < 8; x++) {
+    data[x * 4 + 3] = alphas[x];
+    data[b->line_length * 2 + x * 4 + 3] = 0xff;
+  }
+
+  ASSERT_EQ(bitmap_calc_spans(b, spans), RET_OK);
+  ASSERT_EQ(spans[0].start, 1);
+  ASSERT_EQ(spans[0].end, 6);
+  ASSERT_EQ(spans[0].opaque_start, 4);
+  ASSERT_EQ(spans[0].opaque_end, 6);
+
+  ASSERT_EQ(spans[1].start, spans[1].end);
+  ASSERT_EQ(spans[1].opaque_start, spans[1].opaque_end);
+
+  ASSERT_EQ(spans[2].start, 0);
+  ASSERT_EQ(spans[2].end, 8);
+  ASSERT_EQ(spans[2].opaque_start, 0);
+  ASSERT_EQ(spans[2].opaque_end, 8);
+
+  bitmap_destroy(b);
+
+  b = bitmap_create_ex(8, 3, 0, BITMAP_FMT_BGR565);
+  ASSERT_EQ(bitmap_calc_spans(b, spans), RET_NOT_IMPL);
+  bitmap_destroy(b);
+}
@@ -1,4 +1,5 @@
 ﻿#include "base/pixel.h"
+#include "tkc/mem.h"
 #include "tkc/color.h"
 #include "base/bitmap.h"
 #include "blend/image_g2d.h"
@@ -34,6 +35,65 @@ static void test_blend_image(uint32_t stride, bitmap_format_t bgfmt, bitmap_form
   bitmap_destroy(fg);
 }
 
+static void test_blend_image_spans(bitmap_format_t bgfmt, bitmap_format_t fgfmt) {
+  uint32_t w = 16;
+  uint32_t h = 12;
+  uint8_t alphas[] = {0xff, 0xff, 0x80};
+  rect_t rects[] = {rect_init(0, 0, 16, 12), rect_init(3, 2, 9, 8), rect_init(6, 0, 10, 5)};
+  bitmap_span_t* spans = (bitmap_span_t*)TKMEM_ZALLOCN(bitmap_span_t, h);
+  bitmap_t* fg = bitmap_create_ex(w, h, 0, fgfmt);
+  bitmap_t* bg1 = bitmap_create_ex(20, 20, 0, bgfmt);
+  bitmap_t* bg2 = bitmap_create_ex(20, 20, 0, bgfmt);
+  rect_t bg_r = rect_init(0, 0, 20, 20);
+
+  /*四周透明，中间不透明，边缘半透明，中间夹杂一些半透明的像素*/
+  for (uint32_t y = 0; y < h; y++) {
+    for (uint32_t x = 0; x < w; x++) {
+      uint32_t d = tk_min(tk_min(x, w - 1 - x), tk_min(y, h - 1 - y));
+      uint8_t a = d == 0 ? 0 : (d == 1 ? (x * 37 + y * 11) & 0xff : 0xff);
+      rect_t r = rect_init(x, y, 1, 1);
+
+      if ((x + y) % 7 == 0 && d > 1) {
+        a = 0xc0;
+      }
+      ASSERT_EQ(image_clear(fg, &r, color_init(x * 16, y * 20, 0x80, a)), RET_OK);
+    }
+  }
+  ASSERT_EQ(bitmap_calc_spans(fg, spans), RET_OK);
+
+  for (uint32_t i = 0; i < ARRAY_SIZE(rects); i++) {
+    for (uint32_t k = 0; k < ARRAY_SIZE(alphas); k++) {
+      rect_t dst_r = rect_init(2, 3, rects[i].w, rects[i].h);
+
+      ASSERT_EQ(image_clear(bg1, &bg_r, color_init(0x20, 0x40, 0x60, 0xff)), RET_OK);
+      ASSERT_EQ(image_clear(bg2, &bg_r, color_init(0x20, 0x40, 0x60, 0xff)), RET_OK);
+
+      fg->spans = NULL;
+      ASSERT_EQ(image_blend(bg1, fg, &dst_r, rects + i, alphas[k]), RET_OK);
+      fg->spans = spans;
+      ASSERT_EQ(image_blend(bg2, fg, &dst_r, rects + i, alphas[k]), RET_OK);
+
+      ASSERT_EQ(memcmp(bg1->data, bg2->data, bitmap_get_line_length(bg1) * bg1->h), 0);
+    }
+  }
+
+  fg->spans = NULL;
+  bitmap_destroy(fg);
+  bitmap_destroy(bg1);
+  bitmap_destroy(bg2);
+  TKMEM_FREE(spans);
+}
+
+TEST(BlendImage, spans) {
+  test_blend_image_spans(BITMAP_FMT_BGRA8888, BITMAP_FMT_BGRA8888);
+  test_blend_image_spans(BITMAP_FMT_BGRA8888, BITMAP_FMT_RGBA8888);
+  test_blend_image_spans(BITMAP_FMT_RGBA8888, BITMAP_FMT_RGBA8888);
+  test_blend_image_spans(BITMAP_FMT_BGR888, BITMAP_FMT_RGBA8888);
+  test_blend_image_spans(BITMAP_FMT_BGR565, BITMAP_FMT_BGRA8888);
+  test_blend_image_spans(BITMAP_FMT_BGR565, BITMAP_FMT_RGBA8888);
+  test_blend_image_spans(BITMAP_FMT_RGB565, BITMAP_FMT_RGBA8888);
+}
+
 TEST(BlendImage, BITMAP_FMT_BGRA8888) {
   test_blend_image(0, BITMAP_FMT_BGRA8888, BITMAP_FMT_BGRA8888);
   test_blend_image(0, BITMAP_FMT_BGRA8888, BITMAP_FMT_RGBA8888);
@@ -69,3 +129,321 @@ TEST(BlendImage, BITMAP_FMT_BGR565_stride) {
   test_blend_image(2, BITMAP_FMT_BGR565, BITMAP_FMT_RGBA8888);
   test_blend_image(3, BITMAP_FMT_BGR888, BITMAP_FMT_BGR565);
 }
+
+static void test_blend_image_smooth_solid(bitmap_format_t bgfmt, bitmap_format_t fgfmt) {
+  rect_t src_r = rect_init(0, 0, 4, 4);
+  rect_t big_r = rect_init(0, 0, 11, 7);
+  rect_t small_r = rect_init(1, 1, 3, 2);
+  bitmap_t* bg = bitmap_create_ex(16, 16, 0, bgfmt);
+  bitmap_t* fg = bitmap_create_ex(4, 4, 0, fgfmt);
+  color_t c = color_init(0x40, 0x60, 0x80, 0xff);
+
+  /*纯色图片放大和缩小后颜色不变。*/
+  ASSERT_EQ(image_clear(fg, &src_r, c), RET_OK);
+  ASSERT_EQ(image_blend_ex(bg, fg, &big_r, &src_r, 0xff, IMAGE_QUALITY_SMOOTH), RET_OK);
+  bitmap_check(bg, &big_r, c.rgba);
+
+  ASSERT_EQ(image_clear(bg, &big_r, color_init(0, 0, 0, 0)), RET_OK);
+  ASSERT_EQ(image_blend_ex(bg, fg, &small_r, &src_r, 0xff, IMAGE_QUALITY_SMOOTH), RET_OK);
+  bitmap_check(bg, &small_r, c.rgba);
+
+  bitmap_destroy(bg);
+  bitmap_destroy(fg);
+}
+
+TEST(BlendImage, smooth_solid) {
+  test_blend_image_smooth_solid(BITMAP_FMT_BGRA8888, BITMAP_FMT_BGRA8888);
+  test_blend_image_smooth_solid(BITMAP_FMT_BGRA8888, BITMAP_FMT_RGBA8888);
+  test_blend_image_smooth_solid(BITMAP_FMT_BGRA8888, BITMAP_FMT_BGR565);
+  test_blend_image_smooth_solid(BITMAP_FMT_BGR888, BITMAP_FMT_RGBA8888);
+  test_blend_image_smooth_solid(BITMAP_FMT_BGR565, BITMAP_FMT_BGRA8888);
+  test_blend_image_smooth_solid(BITMAP_FMT_BGR565, BITMAP_FMT_BGR565);
+}
+
+TEST(BlendImage, smooth_upscale) {
+  rgba_t p;
+  rect_t src_r = rect_init(0, 0, 2, 1);
+  rect_t dst_r = rect_init(0, 0, 8, 1);
+  rect_t r0 = rect_init(0, 0, 1, 1);
+  rect_t r1 = rect_init(1, 0, 1, 1);
+  bitmap_t* bg = bitmap_create_ex(8, 1, 0, BITMAP_FMT_BGRA8888);
+  bitmap_t* fg = bitmap_create_ex(2, 1, 0, BITMAP_FMT_RGBA8888);
+
+  ASSERT_EQ(image_clear(fg, &r0, color_init(0, 0, 0, 0xff)), RET_OK);
+  ASSERT_EQ(image_clear(fg, &r1, color_init(0xff, 0xff, 0xff, 0xff)), RET_OK);
+
+  /*最近邻只有两种颜色。*/
+  ASSERT_EQ(image_blend_ex(bg, fg, &dst_r, &src_r, 0xff, IMAGE_QUALITY_NEAREST), RET_OK);
+  ASSERT_EQ(bitmap_get_pixel(bg, 3, 0, &p), RET_OK);
+  ASSERT_EQ(p.r, 0);
+  ASSERT_EQ(bitmap_get_pixel(bg, 4, 0, &p), RET_OK);
+  ASSERT_EQ(p.r, 0xff);
+
+  /*双线性插值：两端保持原色，中间单调递增。*/
+  ASSERT_EQ(image_blend_ex(bg, fg, &dst_r, &src_r, 0xff, IMAGE_QUALITY_SMOOTH), RET_OK);
+  ASSERT_EQ(bitmap_get_pixel(bg, 0, 0, &p), RET_OK);
+  ASSERT_EQ(p.r, 0);
+  ASSERT_EQ(bitmap_get_pixel(bg, 7, 0, &p), RET_OK);
+  ASSERT_EQ(p.r, 0xff);
+
+  uint8_t last = 0;
+  for (uint32_t x = 1; x < 7; x++) {
+    ASSERT_EQ(bitmap_get_pixel(bg, x, 0, &p), RET_OK);
+    ASSERT_GE(p.r, last);
+    ASSERT_EQ(p.r, p.g);
+    ASSERT_EQ(p.r, p.b);
+    last = p.r;
+  }
+  ASSERT_EQ(bitmap_get_pixel(bg, 3, 0, &p), RET_OK);
+  ASSERT_GT(p.r, 0x40);
+  ASSERT_LT(p.r, 0x80);
+  ASSERT_EQ(bitmap_get_pixel(bg, 4, 0, &p), RET_OK);
+  ASSERT_GT(p.r, 0x80);
+  ASSERT_LT(p.r, 0xc0);
+
+  bitmap_destroy(bg);
+  bitmap_destroy(fg);
+}
+
+TEST(BlendImage, smooth_downscale) {
+  rgba_t p;
+  rect_t src_r = rect_init(0, 0, 4, 2);
+  rect_t dst_r = rect_init(0, 0, 1, 1);
+  rect_t left_r = rect_init(0, 0, 2, 2);
+  rect_t right_r = rect_init(2, 0, 2, 2);
+  bitmap_t* bg = bitmap_create_ex(1, 1, 0, BITMAP_FMT_BGRA8888);
+  bitmap_t* fg = bitmap_create_ex(4, 2, 0, BITMAP_FMT_BGRA8888);
+
+  /*缩小时取区域内的平均值。*/
+  ASSERT_EQ(image_clear(fg, &left_r, color_init(0, 0, 0, 0xff)), RET_OK);
+  ASSERT_EQ(image_clear(fg, &right_r, color_init(0xff, 0, 0xff, 0xff)), RET_OK);
+  ASSERT_EQ(image_blend_ex(bg, fg, &dst_r, &src_r, 0xff, IMAGE_QUALITY_SMOOTH), RET_OK);
+  ASSERT_EQ(bitmap_get_pixel(bg, 0, 0, &p), RET_OK);
+  ASSERT_NEAR(p.r, 0x80, 1);
+  ASSERT_EQ(p.g, 0);
+  ASSERT_NEAR(p.b, 0x80, 1);
+
+  bitmap_destroy(bg);
+  bitmap_destroy(fg);
+}
+
+TEST(BlendImage, smooth_alpha) {
+  rgba_t p;
+  rect_t src_r = rect_init(0, 0, 2, 1);
+  rect_t dst_r = rect_init(0, 0, 8, 1);
+  rect_t r0 = rect_init(0, 0, 1, 1);
+  rect_t r1 = rect_init(1, 0, 1, 1);
+  bitmap_t* bg = bitmap_create_ex(8, 1, 0, BITMAP_FMT_BGR888);
+  bitmap_t* fg = bitmap_create_ex(2, 1, 0, BITMAP_FMT_RGBA8888);
+
+  /*透明像素按预乘alpha插值，边缘不会混入透明像素的(黑色)RGB。*/
+  ASSERT_EQ(image_clear(bg, &dst_r, color_init(0xff, 0xff, 0xff, 0xff)), RET_OK);
+  ASSERT_EQ(image_clear(fg, &r0, color_init(0xff, 0, 0, 0xff)), RET_OK);
+  ASSERT_EQ(image_clear(fg, &r1, color_init(0, 0, 0, 0)), RET_OK);
+  ASSERT_EQ(image_blend_ex(bg, fg, &dst_r, &src_r, 0xff, IMAGE_QUALITY_SMOOTH), RET_OK);
+
+  for (uint32_t x = 0; x < 8; x++) {
+    ASSERT_EQ(bitmap_get_pixel(bg, x, 0, &p), RET_OK);
+    ASSERT_GE(p.r, 0xfe);
+  }
+  ASSERT_EQ(bitmap_get_pixel(bg, 0, 0, &p), RET_OK);
+  ASSERT_LE(p.g, 1);
+  ASSERT_EQ(bitmap_get_pixel(bg, 7, 0, &p), RET_OK);
+  ASSERT_GE(p.g, 0xfe);
+
+  bitmap_destroy(bg);
+  bitmap_destroy(fg);
+}
+
+static void test_blend_image_smooth_clip(wh_t sw, wh_t sh, rect_t* dst_r) {
+  rgba_t p1;
+  rgba_t p2;
+  rect_t r_all = rect_init(0, 0, 24, 24);
+  rect_t src_r = rect_init(0, 0, sw, sh);
+  bitmap_t* full = bitmap_create_ex(24, 24, 0, BITMAP_FMT_BGRA8888);
+  bitmap_t* part = bitmap_create_ex(24, 24, 0, BITMAP_FMT_BGRA8888);
+  bitmap_t* fg = bitmap_create_ex(sw, sh, 0, BITMAP_FMT_RGBA8888);
+
+  for (xy_t y = 0; y < sh; y++) {
+    for (xy_t x = 0; x < sw; x++) {
+      rect_t r = rect_init(x, y, 1, 1);
+      ASSERT_EQ(image_clear(fg, &r, color_init(x * 50, y * 40, (x + y) * 20, 0xff - x * 10)),
+                RET_OK);
+    }
+  }
+
+  /*分块绘制(局部刷新)的结果和一次绘制的结果完全相同。*/
+  ASSERT_EQ(image_clear(full, &r_all, color_init(0x10, 0x20, 0x30, 0xff)), RET_OK);
+  ASSERT_EQ(image_clear(part, &r_all, color_init(0x10, 0x20, 0x30, 0xff)), RET_OK);
+  ASSERT_EQ(image_blend_smooth(full, fg, dst_r, &src_r, &r_all, 0xff), RET_OK);
+  for (xy_t y = 0; y < 24; y += 5) {
+    for (xy_t x = 0; x < 24; x += 3) {
+      rect_t clip = rect_init(x, y, 3, 5);
+      ASSERT_EQ(image_blend_smooth(part, fg, dst_r, &src_r, &clip, 0xff), RET_OK);
+    }
+  }
+
+  for (xy_t y = 0; y < 24; y++) {
+    for (xy_t x = 0; x < 24; x++) {
+      ASSERT_EQ(bitmap_get_pixel(full, x, y, &p1), RET_OK);
+      ASSERT_EQ(bitmap_get_pixel(part, x, y, &p2), RET_OK);
+      ASSERT_EQ(p1.r, p2.r);
+      ASSERT_EQ(p1.g, p2.g);
+      ASSERT_EQ(p1.b, p2.b);
+      ASSERT_EQ(p1.a, p2.a);
+    }
+  }
+
+  bitmap_destroy(full);
+  bitmap_destroy(part);
+  bitmap_destroy(fg);
+}
+
+TEST(BlendImage, smooth_clip) {
+  rect_t up = rect_init(2, 1, 17, 19);
+  rect_t down = rect_init(1, 3, 7, 5);
+  rect_t outside = rect_init(-5, -3, 21, 22);
+
+  test_blend_image_smooth_clip(5, 4, &up);
+  test_blend_image_smooth_clip(5, 4, &outside);
+  test_blend_image_smooth_clip(23, 19, &down);
+}
+
+static void test_blend_image_transform(bitmap_format_t bgfmt, bitmap_format_t fgfmt) {
+  rect_t r = rect_init(2, 2, 3, 3);
+  rect_t r_all = rect_init(0, 0, 8, 8);
+  bitmap_t* bg = bitmap_create_ex(8, 8, 0, bgfmt);
+  bitmap_t* fg = bitmap_create_ex(8, 8, 0, fgfmt);
+  color_t c = color_init(0x40, 0x60, 0x80, 0xff);
+  rect_t src_r = rect_init(0, 0, 3, 3);
+  matrix_t m;
+
+  /*平移*/
+  ASSERT_EQ(image_clear(fg, &r_all, c), RET_OK);
+  matrix_init(&m);
+  matrix_translate(&m, 2, 2);
+  ASSERT_EQ(image_blend_transform(bg, fg, &src_r, &src_r, &r_all, &m, 0xff, IMAGE_QUALITY_NEAREST),
+            RET_OK);
+  bitmap_check(bg, &r, c.rgba);
+
+  /*缩放后超出部分被裁剪*/
+  ASSERT_EQ(image_clear(bg, &r_all, color_init(0, 0, 0, 0)), RET_OK);
+  matrix_init(&m);
+  matrix_scale(&m, 4, 4);
+  ASSERT_EQ(image_blend_transform(bg, fg, &src_r, &src_r, &r, &m, 0xff, IMAGE_QUALITY_NEAREST),
+            RET_OK);
+  bitmap_check(bg, &r, c.rgba);
+
+  bitmap_destroy(bg);
+  bitmap_destroy(fg);
+}
+
+TEST(BlendImage, transform) {
+  test_blend_image_transform(BITMAP_FMT_BGRA8888, BITMAP_FMT_BGRA8888);
+  test_blend_image_transform(BITMAP_FMT_BGRA8888, BITMAP_FMT_RGBA8888);
+  test_blend_image_transform(BITMAP_FMT_BGR888, BITMAP_FMT_RGBA8888);
+  test_blend_image_transform(BITMAP_FMT_BGR565, BITMAP_FMT_BGRA8888);
+  test_blend_image_transform(BITMAP_FMT_BGR565, BITMAP_FMT_BGR565);
+}
+
+TEST(BlendImage, transform_rotate) {
+  rgba_t p;
+  matrix_t m;
+  rect_t src_r = rect_init(0, 0, 4, 2);
+  rect_t dst_r = rect_init(0, 0, 8, 4);
+  rect_t left_r = rect_init(0, 0, 2, 2);
+  rect_t right_r = rect_init(2, 0, 2, 2);
+  rect_t clip = rect_init(0, 0, 8, 8);
+  bitmap_t* bg = bitmap_create_ex(8, 8, 0, BITMAP_FMT_BGRA8888);
+  bitmap_t* fg = bitmap_create_ex(4, 2, 0, BITMAP_FMT_RGBA8888);
+
+  ASSERT_EQ(image_clear(fg, &left_r, color_init(0xff, 0, 0, 0xff)), RET_OK);
+  ASSERT_EQ(image_clear(fg, &right_r, color_init(0, 0, 0xff, 0xff)), RET_OK);
+
+  /*先把4x2的图片放大到8x4，再顺时针旋转90度，得到4x8的区域，上半部分为红色，下半部分为蓝色。*/
+  matrix_init(&m);
+  matrix_translate(&m, 4, 0);
+  matrix_rotate(&m, M_PI / 2);
+  ASSERT_EQ(image_blend_transform(bg, fg, &dst_r, &src_r, &clip, &m, 0xff, IMAGE_QUALITY_NEAREST),
+            RET_OK);
+
+  for (uint32_t y = 0; y < 8; y++) {
+    for (uint32_t x = 0; x < 8; x++) {
+      ASSERT_EQ(bitmap_get_pixel(bg, x, y, &p), RET_OK);
+      if (x >= 4) {
+        ASSERT_EQ(p.a, 0);
+      } else if (y < 4) {
+        ASSERT_EQ(p.r, 0xff);
+        ASSERT_EQ(p.b, 0);
+      } else {
+        ASSERT_EQ(p.r, 0);
+        ASSERT_EQ(p.b, 0xff);
+      }
+    }
+  }
+
+  /*半透明*/
+  ASSERT_EQ(image_clear(bg, &clip, color_init(0, 0, 0, 0xff)), RET_OK);
+  ASSERT_EQ(image_blend_transform(bg, fg, &dst_r, &src_r, &clip, &m, 0x80, IMAGE_QUALITY_NEAREST),
+            RET_OK);
+  ASSERT_EQ(bitmap_get_pixel(bg, 1, 1, &p), RET_OK);
+  ASSERT_NEAR(p.r, 0x80, 2);
+
+  bitmap_destroy(bg);
+  bitmap_destroy(fg);
+}
+
+TEST(BlendImage, transform_smooth) {
+  rgba_t p;
+  matrix_t m;
+  uint32_t partial = 0;
+  rect_t src_r = rect_init(0, 0, 8, 8);
+  rect_t clip = rect_init(0, 0, 24, 24);
+  bitmap_t* bg = bitmap_create_ex(24, 24, 0, BITMAP_FMT_BGRA8888);
+  bitmap_t* fg = bitmap_create_ex(8, 8, 0, BITMAP_FMT_RGBA8888);
+
+  /*绕中心旋转45度：即使没有设置平滑，边缘也是反走样的。*/
+  ASSERT_EQ(image_clear(bg, &clip, color_init(0, 0, 0, 0xff)), RET_OK);
+  ASSERT_EQ(image_clear(fg, &src_r, color_init(0xff, 0, 0, 0xff)), RET_OK);
+  matrix_init(&m);
+  matrix_translate(&m, 12, 12);
+  matrix_rotate(&m, M_PI / 4);
+  matrix_translate(&m, -4, -4);
+  ASSERT_EQ(image_blend_transform(bg, fg, &src_r, &src_r, &clip, &m, 0xff, IMAGE_QUALITY_NEAREST),
+            RET_OK);
+
+  ASSERT_EQ(bitmap_get_pixel(bg, 12, 12, &p), RET_OK);
+  ASSERT_EQ(p.r, 0xff);
+  ASSERT_EQ(bitmap_get_pixel(bg, 2, 2, &p), RET_OK);
+  ASSERT_EQ(p.r, 0);
+  for (uint32_t y = 0; y < 24; y++) {
+    for (uint32_t x = 0; x < 24; x++) {
+      ASSERT_EQ(bitmap_get_pixel(bg, x, y, &p), RET_OK);
+      ASSERT_EQ(p.g, 0);
+      if (p.r > 0 && p.r < 0xff) {
+        partial++;
+      }
+    }
+  }
+  ASSERT_GT(partial, 16u);
+
+  /*设置平滑时，缩放也使用双线性取样。*/
+  ASSERT_EQ(image_clear(fg, &src_r, color_init(0, 0, 0, 0xff)), RET_OK);
+  src_r = rect_init(1, 0, 1, 8);
+  ASSERT_EQ(image_clear(fg, &src_r, color_init(0xff, 0xff, 0xff, 0xff)), RET_OK);
+  src_r = rect_init(0, 0, 2, 1);
+  matrix_init(&m);
+  matrix_scale(&m, 8, 1);
+  ASSERT_EQ(image_blend_transform(bg, fg, &src_r, &src_r, &clip, &m, 0xff, IMAGE_QUALITY_SMOOTH),
+            RET_OK);
+  ASSERT_EQ(bitmap_get_pixel(bg, 3, 0, &p), RET_OK);
+  ASSERT_EQ(p.r, 0);
+  ASSERT_EQ(bitmap_get_pixel(bg, 8, 0, &p), RET_OK);
+  ASSERT_GT(p.r, 0x40);
+  ASSERT_LT(p.r, 0xc0);
+  ASSERT_EQ(bitmap_get_pixel(bg, 11, 0, &p), RET_OK);
+  ASSERT_GT(p.r, 0xe0);
+
+  bitmap_destroy(bg);
+  bitmap_destroy(fg);
+}
@@ -1,4 +1,5 @@
 ﻿#include "keyboard/candidates.h"
+#include "base/input_method.h"
 #include "gtest/gtest.h"
 
 TEST(Candidates, cast) {
@@ -8,3 +9,49 @@ TEST(Candidates, cast) {
 
   widget_destroy(w);
 }
+
+static uint32_t s_pages = 0;
+static ret_t fake_engine_next_page(input_engine_t* engine) {
+  if (s_pages >= 2) {
+    return RET_DONE;
+  }
+
+  s_pages++;
+  memcpy(engine->candidates, s_pages == 1 ? "b\0c\0" : "d\0", 5);
+  engine->candidates_nr = s_pages == 1 ? 2 : 1;
+
+  return RET_OK;
+}
+
+TEST(Candidates, next_page) {
+  input_engine_t engine;
+  input_method_t* im = input_method();
+  input_engine_t* old_engine = im->engine;
+  widget_t* w = candidates_create(NULL, 0, 0, 400, 30);
+
+  memset(&engine, 0x00, sizeof(engine));
+  str_init(&(engine.keys), 10);
+  str_set(&(engine.keys), "a");
+  engine.next_page = fake_engine_next_page;
+  im->engine = &engine;
+  s_pages = 0;
+
+  input_method_dispatch_candidates(im, "a\0", 1);
+  ASSERT_EQ(CANDIDATES(w)->candidates_nr, 1u);
+
+  ASSERT_EQ(input_method_next_candidates_page(im), RET_OK);
+  ASSERT_EQ(input_method_next_candidates_page(im), RET_OK);
+  ASSERT_EQ(input_method_next_candidates_page(im), RET_DONE);
+  ASSERT_EQ(CANDIDATES(w)->candidates_nr, 4u);
+  ASSERT_EQ(wcscmp(widget_get_child(w, 1)->text.str, L"b"), 0);
+  ASSERT_EQ(wcscmp(widget_get_child(w, 3)->text.str, L"d"), 0);
+
+  input_method_dispatch_candidates(im, "x\0", 1);
+  ASSERT_EQ(CANDIDATES(w)->candidates_nr, 1u);
+  ASSERT_EQ(wcscmp(widget_get_child(w, 0)->text.str, L"x"), 0);
+  ASSERT_EQ(widget_get_child(w, 1)->text.size, 0u);
+
+  im->engine = old_engine;
+  str_reset(&(engine.keys));
+  widget_destroy(w);
+}
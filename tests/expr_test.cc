@@ -1,4 +1,5 @@
-﻿#include "tkc/expr_eval.h"
+﻿#include "tkc/thread.h"
+#include "tkc/expr_eval.h"
 #include "gtest/gtest.h"
 
 TEST(ExprEval, basic) {
@@ -34,3 +35,129 @@ TEST(ExprEval, func) {
   ASSERT_EQ(11, tk_expr_eval("if(1, \"11\", \"22\")"));
   ASSERT_EQ(22, tk_expr_eval("if(0, \"11\", \"22\")"));
 }
+
+static int s_get_variable_count = 0;
+
+static EvalResult test_get_variable(const char* name, void* user_data, ExprValue* output) {
+  s_get_variable_count++;
+  if (strcmp(name, "a") == 0) {
+    return expr_value_set_number(output, 3);
+  } else if (strcmp(name, "s") == 0) {
+    return expr_value_set_string(output, "abc", 3);
+  } else if (strcmp(name, "evict") == 0) {
+    /*在执行过程中计算其它表达式，把正在执行的表达式挤出缓存*/
+    for (int i = 0; i < EVAL_CACHE_SIZE * 2; i++) {
+      char expr[32];
+      snprintf(expr, sizeof(expr), "%d+1", i);
+      EXPECT_EQ(i + 1, tk_expr_eval(expr));
+    }
+    return expr_value_set_number(output, 1);
+  }
+
+  return eval_default_hooks()->get_variable(name, user_data, output);
+}
+
+static EvalFunc test_get_func(const char* name, void* user_data) {
+  return eval_default_hooks()->get_func(name, user_data);
+}
+
+TEST(ExprEval, compile) {
+  ExprValue v;
+  EvalResult ret;
+  EvalHooks hooks = {test_get_func, test_get_variable};
+  ExprCode* code = eval_compile("$a*$a+$a+strlen($s)", &hooks, NULL, &ret);
+
+  ASSERT_EQ(ret, EVAL_RESULT_OK);
+  ASSERT_TRUE(code != NULL);
+
+  for (int i = 0; i < 2; i++) {
+    s_get_variable_count = 0;
+    expr_value_init(&v);
+    ASSERT_EQ(eval_code_execute(code, &hooks, NULL, &v), EVAL_RESULT_OK);
+    ASSERT_EQ(expr_value_get_number(&v), 15);
+    ASSERT_EQ(s_get_variable_count, 2);
+  }
+  eval_code_destroy(code);
+
+  code = eval_compile("$s+\"d\"", &hooks, NULL, &ret);
+  expr_value_init(&v);
+  ASSERT_EQ(eval_code_execute(code, &hooks, NULL, &v), EVAL_RESULT_OK);
+  ASSERT_STREQ(expr_value_get_string(&v), "abcd");
+  expr_value_clear(&v);
+  eval_code_destroy(code);
+
+  code = eval_compile("$b+1", &hooks, NULL, &ret);
+  expr_value_init(&v);
+  ASSERT_EQ(eval_code_execute(code, &hooks, NULL, &v), EVAL_RESULT_UNDEFINED_VARIABLE);
+  eval_code_destroy(code);
+
+  ASSERT_TRUE(eval_compile("1+", &hooks, NULL, &ret) == NULL);
+  ASSERT_EQ(ret, EVAL_RESULT_EXPECTED_TERM);
+  ASSERT_TRUE(eval_compile("foo(1)", &hooks, NULL, &ret) == NULL);
+  ASSERT_EQ(ret, EVAL_RESULT_UNDEFINED_FUNCTION);
+  ASSERT_TRUE(eval_compile("((((((((1))))))))", &hooks, NULL, &ret) == NULL);
+  ASSERT_EQ(ret, EVAL_RESULT_STACK_OVERFLOW);
+}
+
+TEST(ExprEval, unary) {
+  ASSERT_EQ(6, tk_expr_eval("-2*-3"));
+  ASSERT_EQ(1, tk_expr_eval("!0"));
+  ASSERT_EQ(0, tk_expr_eval("-~1"));
+  ASSERT_EQ(1, tk_expr_eval("!\"\""));
+  ASSERT_EQ(0, tk_expr_eval("!\"a\""));
+}
+
+TEST(ExprEval, cache) {
+  ExprValue v;
+  EvalHooks hooks = {test_get_func, test_get_variable};
+
+  for (int k = 0; k < 2; k++) {
+    for (int i = 0; i < EVAL_CACHE_SIZE * 3; i++) {
+      char expr[32];
+      snprintf(expr, sizeof(expr), "%d*2+$a", i % (EVAL_CACHE_SIZE + 2));
+      expr_value_init(&v);
+      ASSERT_EQ(eval_execute(expr, &hooks, NULL, &v), EVAL_RESULT_OK);
+      ASSERT_EQ(expr_value_get_number(&v), (i % (EVAL_CACHE_SIZE + 2)) * 2 + 3);
+    }
+  }
+
+  expr_value_init(&v);
+  ASSERT_EQ(eval_execute("$evict+$a*2", &hooks, NULL, &v), EVAL_RESULT_OK);
+  ASSERT_EQ(expr_value_get_number(&v), 7);
+
+  eval_cache_deinit();
+  ASSERT_EQ(3, tk_expr_eval("1+2"));
+}
+
+static void* eval_cache_thread(void* args) {
+  int32_t* fails = (int32_t*)args;
+
+  for (int i = 0; i < EVAL_CACHE_SIZE * 50; i++) {
+    char expr[32];
+    int32_t n = i % (EVAL_CACHE_SIZE + 3);
+    snprintf(expr, sizeof(expr), "%d*2+1", n);
+    if (tk_expr_eval(expr) != n * 2 + 1) {
+      (*fails)++;
+    }
+  }
+
+  return NULL;
+}
+
+TEST(ExprEval, cache_threads) {
+  int32_t fails[4] = {0, 0, 0, 0};
+  tk_thread_t* threads[4];
+
+  for (int i = 0; i < 4; i++) {
+    threads[i] = tk_thread_create(eval_cache_thread, fails + i);
+    ASSERT_EQ(tk_thread_start(threads[i]), RET_OK);
+  }
+
+  for (int i = 0; i < 4; i++) {
+    tk_thread_join(threads[i]);
+    tk_thread_destroy(threads[i]);
+    ASSERT_EQ(fails[i], 0);
+  }
+
+  eval_cache_deinit();
+}
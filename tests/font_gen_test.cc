@@ -47,3 +47,79 @@ TEST(FontGen, basic) {
   TKMEM_FREE(bmp_buff);
   TKMEM_FREE(ttf_buff);
 }
+
+static uint8_t quantize_alpha(uint8_t a, glyph_format_t format) {
+  switch (format) {
+    case GLYPH_FMT_ALPHA1:
+      return (a >> 7) * 0xff;
+    case GLYPH_FMT_ALPHA2:
+      return (a >> 6) * 0x55;
+    case GLYPH_FMT_ALPHA4:
+    case GLYPH_FMT_RLE:
+      return (a >> 4) * 0x11;
+    default:
+      return a;
+  }
+}
+
+static void test_font_gen_format(font_t* ttf_font, glyph_format_t format, uint32_t* size) {
+  uint16_t font_size = 20;
+  uint8_t alphas[256];
+  uint8_t* bmp_buff = (uint8_t*)TKMEM_ALLOC(BUFF_SIZE);
+  const char* str = "helloworldHELLOWORLD1243541";
+
+  uint32_t ret = font_gen_buff_ex(ttf_font, font_size, format, str, bmp_buff, BUFF_SIZE);
+  font_t* bmp_font = font_bitmap_create("default", bmp_buff, ret);
+  ASSERT_EQ(ret > 0, true);
+  *size = ret;
+
+  for (uint32_t i = 0; str[i]; i++) {
+    glyph_t g1;
+    glyph_t g2;
+    char c = str[i];
+    ASSERT_EQ(font_get_glyph(ttf_font, c, font_size, &g1), RET_OK);
+    ASSERT_EQ(font_get_glyph(bmp_font, c, font_size, &g2), RET_OK);
+
+    ASSERT_EQ(g2.format, format);
+    ASSERT_EQ(g1.x, g2.x);
+    ASSERT_EQ(g1.y, g2.y);
+    ASSERT_EQ(g1.w, g2.w);
+    ASSERT_EQ(g1.h, g2.h);
+    ASSERT_EQ(g1.advance, g2.advance);
+
+    for (uint32_t y = 0; y < g2.h; y++) {
+      ASSERT_EQ(glyph_get_line(&g2, y, alphas), RET_OK);
+      for (uint32_t x = 0; x < g2.w; x++) {
+        ASSERT_EQ(alphas[x], quantize_alpha(g1.data[y * g1.w + x], format));
+      }
+    }
+  }
+
+  font_destroy(bmp_font);
+  TKMEM_FREE(bmp_buff);
+}
+
+TEST(FontGen, formats) {
+  uint32_t size = 0;
+  uint32_t a8 = 0;
+  uint32_t a4 = 0;
+  uint32_t a2 = 0;
+  uint32_t a1 = 0;
+  uint32_t rle = 0;
+  uint8_t* ttf_buff = (uint8_t*)read_file(TTF_FILE, &size);
+  font_t* ttf_font = font_truetype_create("default", ttf_buff, size);
+
+  test_font_gen_format(ttf_font, GLYPH_FMT_ALPHA, &a8);
+  test_font_gen_format(ttf_font, GLYPH_FMT_ALPHA4, &a4);
+  test_font_gen_format(ttf_font, GLYPH_FMT_ALPHA2, &a2);
+  test_font_gen_format(ttf_font, GLYPH_FMT_ALPHA1, &a1);
+  test_font_gen_format(ttf_font, GLYPH_FMT_RLE, &rle);
+
+  ASSERT_LT(a4, a8);
+  ASSERT_LT(a2, a4);
+  ASSERT_LT(a1, a2);
+  ASSERT_LT(rle, a8);
+
+  font_destroy(ttf_font);
+  TKMEM_FREE(ttf_buff);
+}
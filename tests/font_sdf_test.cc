@@ -0,0 +1,168 @@
+#include "base/font.h"
+#include "tkc/mem.h"
+#include "tools/common/utils.h"
+#include "tools/font_gen/font_gen.h"
+#include "font_loader/font_loader_sdf.h"
+#include "font_loader/font_loader_truetype.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "gtest/gtest.h"
+#include <stdlib.h>
+
+#define TTF_FILE TK_ROOT "/tests/testdata/assets/raw/fonts/starthere.ttf"
+#define BUFF_SIZE 1024 * 1024
+#define SDF_FONT_SIZE 32
+
+class FontSdf : public testing::Test {
+ protected:
+  virtual void SetUp() {
+    uint32_t size = 0;
+    const char* str = "helloworldHELLOWORLD1243541 ";
+
+    ttf_buff = (uint8_t*)read_file(TTF_FILE, &size);
+    ttf_font = font_truetype_create("default", ttf_buff, size);
+    sdf_buff = (uint8_t*)TKMEM_ALLOC(BUFF_SIZE);
+    sdf_size = font_gen_sdf_buff(ttf_font, SDF_FONT_SIZE, FONT_GEN_SDF_SPREAD, str, sdf_buff,
+                                 BUFF_SIZE);
+    sdf_font = font_sdf_create("sdf", sdf_buff, sdf_size);
+  }
+
+  virtual void TearDown() {
+    font_destroy(sdf_font);
+    font_destroy(ttf_font);
+    TKMEM_FREE(sdf_buff);
+    TKMEM_FREE(ttf_buff);
+  }
+
+  uint8_t* ttf_buff;
+  uint8_t* sdf_buff;
+  uint32_t sdf_size;
+  font_t* ttf_font;
+  font_t* sdf_font;
+};
+
+TEST_F(FontSdf, match) {
+  ASSERT_NE(sdf_font, (font_t*)NULL);
+  ASSERT_GT(sdf_size, 0u);
+
+  ASSERT_EQ(font_match(sdf_font, "sdf", 12), TRUE);
+  ASSERT_EQ(font_match(sdf_font, "sdf", 100), TRUE);
+  ASSERT_EQ(font_match(sdf_font, NULL, 20), TRUE);
+  ASSERT_EQ(font_match(sdf_font, "default", 20), FALSE);
+
+  ASSERT_EQ(font_get_baseline(sdf_font, SDF_FONT_SIZE), font_get_baseline(ttf_font, SDF_FONT_SIZE));
+}
+
+TEST_F(FontSdf, metrics) {
+  glyph_t g1;
+  glyph_t g2;
+  glyph_t g3;
+
+  ASSERT_EQ(font_get_glyph(sdf_font, 'H', SDF_FONT_SIZE, &g1), RET_OK);
+  ASSERT_EQ(g1.format, GLYPH_FMT_SDF);
+  ASSERT_EQ(g1.w, g1.data[0]);
+  ASSERT_EQ(g1.h, g1.data[1]);
+  ASSERT_EQ(g1.data[2], FONT_GEN_SDF_SPREAD);
+
+  ASSERT_EQ(font_get_glyph(sdf_font, 'H', SDF_FONT_SIZE * 2, &g2), RET_OK);
+  ASSERT_EQ(g2.w, g1.w * 2);
+  ASSERT_EQ(g2.h, g1.h * 2);
+  ASSERT_EQ(g2.advance, g1.advance * 2);
+  ASSERT_EQ(g2.data, g1.data);
+
+  ASSERT_EQ(font_get_glyph(sdf_font, 'H', SDF_FONT_SIZE / 2, &g3), RET_OK);
+  ASSERT_EQ(g3.w, tk_roundi(g1.w / 2.0f));
+  ASSERT_EQ(g3.advance, (uint32_t)tk_roundi(g1.advance / 2.0f));
+
+  ASSERT_EQ(font_get_glyph(sdf_font, ' ', SDF_FONT_SIZE, &g1), RET_NOT_FOUND);
+  ASSERT_EQ(font_get_glyph(sdf_font, 'z', SDF_FONT_SIZE, &g1), RET_NOT_FOUND);
+}
+
+static uint32_t glyph_diff_at(glyph_t* g1, glyph_t* g2, int32_t dx, int32_t dy) {
+  uint32_t x = 0;
+  uint32_t y = 0;
+  uint32_t diff = 0;
+  uint8_t alphas[256];
+
+  for (y = 0; y < g2->h; y++) {
+    glyph_get_line(g2, y, alphas);
+    for (x = 0; x < g2->w; x++) {
+      int32_t tx = (int32_t)x + g2->x - g1->x + dx;
+      int32_t ty = (int32_t)y + g2->y - g1->y + dy;
+      uint8_t a = 0;
+
+      if (tx >= 0 && ty >= 0 && tx < g1->w && ty < g1->h) {
+        a = g1->data[ty * g1->w + tx];
+      }
+      diff += abs((int32_t)a - (int32_t)alphas[x]);
+    }
+  }
+
+  return diff / (g1->w * g1->h);
+}
+
+/*缩放后的位置有舍入误差，取相邻位置中最小的平均误差。*/
+static uint32_t glyph_diff(font_t* ttf_font, font_t* sdf_font, char c, font_size_t font_size) {
+  glyph_t g1;
+  glyph_t g2;
+  int32_t dx = 0;
+  int32_t dy = 0;
+  uint32_t diff = 0xffffffff;
+
+  font_get_glyph(ttf_font, c, font_size, &g1);
+  font_get_glyph(sdf_font, c, font_size, &g2);
+
+  for (dy = -1; dy <= 1; dy++) {
+    for (dx = -1; dx <= 1; dx++) {
+      diff = tk_min(diff, glyph_diff_at(&g1, &g2, dx, dy));
+    }
+  }
+
+  return diff;
+}
+
+TEST_F(FontSdf, coverage) {
+  const char* str = "helloHELLO124";
+
+  for (uint32_t i = 0; str[i]; i++) {
+    ASSERT_LT(glyph_diff(ttf_font, sdf_font, str[i], SDF_FONT_SIZE), 4u);
+    ASSERT_LT(glyph_diff(ttf_font, sdf_font, str[i], 24), 48u);
+    ASSERT_LT(glyph_diff(ttf_font, sdf_font, str[i], 48), 48u);
+  }
+}
+
+TEST_F(FontSdf, lcd_mem) {
+  glyph_t g;
+  uint32_t x = 0;
+  uint32_t y = 0;
+  uint8_t alphas[256];
+  rect_t src;
+  lcd_t* lcd = lcd_mem_bgra8888_create(100, 100, TRUE);
+  uint8_t* fb = ((lcd_mem_t*)lcd)->offline_fb;
+
+  ASSERT_EQ(font_get_glyph(sdf_font, 'W', 40, &g), RET_OK);
+  src = rect_init(3, 2, g.w - 3, g.h - 2);
+
+  lcd_begin_frame(lcd, NULL, LCD_DRAW_NORMAL);
+  lcd_set_fill_color(lcd, color_init(0, 0, 0, 0xff));
+  lcd_fill_rect(lcd, 0, 0, 100, 100);
+  lcd_set_text_color(lcd, color_init(0xff, 0xff, 0xff, 0xff));
+  ASSERT_EQ(lcd_draw_glyph(lcd, &g, &src, 10, 20), RET_OK);
+
+  for (y = 0; y < (uint32_t)src.h; y++) {
+    glyph_get_line(&g, src.y + y, alphas);
+    for (x = 0; x < (uint32_t)src.w; x++) {
+      uint8_t* p = fb + ((20 + y) * 100 + 10 + x) * 4;
+      uint8_t a = alphas[src.x + x];
+
+      if (a >= TK_OPACITY_ALPHA) {
+        ASSERT_EQ(p[0], 0xff);
+      } else if (a < TK_TRANSPARENT_ALPHA) {
+        ASSERT_EQ(p[0], 0);
+      } else {
+        ASSERT_NEAR(p[0], a, 2);
+      }
+    }
+  }
+
+  lcd_destroy(lcd);
+}
@@ -1,5 +1,7 @@
 ﻿#include <stdlib.h>
 #include "gtest/gtest.h"
+#include "tkc/utils.h"
+#include "base/locale_info.h"
 #include "base/image_manager.h"
 #include "image_loader/image_loader_stb.h"
 #include <string>
@@ -53,6 +55,30 @@ TEST(ImageManager, add) {
   ASSERT_EQ(image_manager_unload_unused(image_manager(), 0), RET_OK);
 }
 
+TEST(ImageManager, add_spans) {
+  bitmap_t bmp;
+  bitmap_t* b = bitmap_create_ex(4, 2, 0, BITMAP_FMT_RGBA8888);
+  uint8_t* data = (uint8_t*)(b->data);
+
+  memset(data, 0x00, bitmap_get_line_length(b) * b->h);
+  data[1 * 4 + 3] = 0xff;
+  data[2 * 4 + 3] = 0x80;
+
+  memset(&bmp, 0x00, sizeof(bmp));
+  ASSERT_EQ(image_manager_add(image_manager(), "spans", b), RET_OK);
+  ASSERT_EQ(image_manager_lookup(image_manager(), "spans", &bmp), RET_OK);
+  ASSERT_TRUE(bmp.spans != NULL);
+  ASSERT_EQ(bmp.spans[0].start, 1);
+  ASSERT_EQ(bmp.spans[0].opaque_start, 1);
+  ASSERT_EQ(bmp.spans[0].opaque_end, 2);
+  ASSERT_EQ(bmp.spans[0].end, 3);
+  ASSERT_EQ(bmp.spans[1].start, bmp.spans[1].end);
+
+  b->should_free_data = FALSE;
+  ASSERT_EQ(image_manager_unload_unused(image_manager(), 0), RET_OK);
+  bitmap_destroy(b);
+}
+
 TEST(ImageManager, locale) {
   bitmap_t bmp;
   memset(&bmp, 0x00, sizeof(bmp));
@@ -90,3 +116,42 @@ TEST(ImageManager, fs) {
   ASSERT_EQ(image_manager_unload_bitmap(image_manager(), &bmp), RET_OK);
 }
 #endif /*WITH_FS_RES*/
+
+TEST(ImageManager, real_name_cache) {
+  bitmap_t bmp;
+  memset(&bmp, 0x00, sizeof(bmp));
+  image_manager_t* imm = image_manager_create();
+  assets_manager_t* am = assets_manager_create(0);
+  char language[3];
+  char country[3];
+
+  tk_strncpy(country, locale_info()->country, sizeof(country) - 1);
+  tk_strncpy(language, locale_info()->language, sizeof(language) - 1);
+  assets_manager_set_res_root(am, "tests/testdata");
+  image_manager_set_assets_manager(imm, am);
+
+  ASSERT_EQ(image_manager_get_bitmap(imm, "locale1_$locale$", &bmp), RET_OK);
+  ASSERT_EQ(string(bmp.name), string("locale1_en_US"));
+  ASSERT_EQ(image_manager_get_bitmap(imm, "locale1_$locale$", &bmp), RET_OK);
+  ASSERT_EQ(string(bmp.name), string("locale1_en_US"));
+
+  locale_info_change(locale_info(), "zh", "CN");
+  ASSERT_NE(image_manager_get_bitmap(imm, "locale1_$locale$", &bmp), RET_OK);
+
+  locale_info_change(locale_info(), language, country);
+  ASSERT_EQ(image_manager_get_bitmap(imm, "locale1_$locale$", &bmp), RET_OK);
+  ASSERT_EQ(string(bmp.name), string("locale1_en_US"));
+
+  ASSERT_EQ(image_manager_get_bitmap(imm, "not_exist,locale_en", &bmp), RET_OK);
+  ASSERT_EQ(string(bmp.name), string("locale_en"));
+  ASSERT_EQ(image_manager_get_bitmap(imm, "not_exist,locale_en", &bmp), RET_OK);
+  ASSERT_EQ(string(bmp.name), string("locale_en"));
+
+  ASSERT_EQ(image_manager_unload_unused(imm, 0), RET_OK);
+  ASSERT_EQ(image_manager_get_bitmap(imm, "not_exist,locale_en", &bmp), RET_OK);
+  ASSERT_EQ(string(bmp.name), string("locale_en"));
+  ASSERT_EQ(image_manager_unload_unused(imm, 0), RET_OK);
+
+  assets_manager_destroy(am);
+  image_manager_destroy(imm);
+}
@@ -0,0 +1,64 @@
+#include "base/keys.h"
+#include "tkc/time_now.h"
+#include "base/input_engine.h"
+#include "gtest/gtest.h"
+#include <string.h>
+
+static uint32_t count_candidates(input_engine_t* engine) {
+  uint32_t i = 0;
+  uint32_t size = 0;
+  const char* p = engine->candidates;
+
+  for (i = 0; i < engine->candidates_nr; i++) {
+    size += strlen(p + size) + 1;
+  }
+
+  return size <= sizeof(engine->candidates) ? engine->candidates_nr : 0;
+}
+
+TEST(InputEngine, keystroke_latency) {
+  uint32_t i = 0;
+  uint64_t max_us = 0;
+  uint64_t total_us = 0;
+  const char* keys = "zhongguoren";
+  uint32_t nr = strlen(keys);
+  input_engine_t* engine = input_engine_create();
+
+  for (i = 0; i < nr + 3; i++) {
+    int key = i < nr ? keys[i] : TK_KEY_BACKSPACE;
+    uint64_t start = time_now_us();
+    uint64_t cost = 0;
+
+    ASSERT_EQ(input_engine_input(engine, key), RET_OK);
+    cost = time_now_us() - start;
+    total_us += cost;
+    max_us = tk_max(max_us, cost);
+
+    ASSERT_GE(engine->candidates_nr, 1u);
+    ASSERT_LE(engine->candidates_nr, TK_IM_CANDIDATES_PAGE_SIZE + 1u);
+    ASSERT_EQ(count_candidates(engine), engine->candidates_nr);
+    ASSERT_STREQ(engine->candidates, engine->keys.str);
+  }
+
+  printf("keystroke to candidates: avg=%uus max=%uus\n", (uint32_t)(total_us / (nr + 3)),
+         (uint32_t)max_us);
+
+  for (i = 0; i < 1000; i++) {
+    ret_t ret = input_engine_next_page(engine);
+    if (ret != RET_OK) {
+      ASSERT_EQ(ret, RET_DONE);
+      break;
+    }
+
+    ASSERT_GE(engine->candidates_nr, 1u);
+    ASSERT_LE(engine->candidates_nr, TK_IM_CANDIDATES_PAGE_SIZE);
+    ASSERT_EQ(count_candidates(engine), engine->candidates_nr);
+  }
+  ASSERT_LT(i, 1000u);
+
+  ASSERT_EQ(input_engine_reset_input(engine), RET_OK);
+  ASSERT_EQ(engine->candidates_nr, 0u);
+  ASSERT_EQ(input_engine_next_page(engine), RET_DONE);
+
+  input_engine_destroy(engine);
+}
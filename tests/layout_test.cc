@@ -0,0 +1,129 @@
+﻿#include "gtest/gtest.h"
+#include "widgets/view.h"
+#include "widgets/button.h"
+#include "widgets/window.h"
+#include "base/layout.h"
+
+TEST(Layout, incremental) {
+  layout_stat_t stat;
+  widget_t* w = window_create(NULL, 0, 0, 0, 0);
+  widget_t* v = view_create(w, 0, 0, 0, 0);
+  widget_t* b = button_create(v, 0, 0, 0, 0);
+
+  widget_move_resize(w, 0, 0, 400, 300);
+  widget_set_self_layout_params(v, "0", "0", "50%", "50%");
+  widget_set_self_layout_params(b, "c", "m", "50%", "50%");
+  widget_layout(w);
+  ASSERT_EQ(v->w, 200);
+  ASSERT_EQ(v->h, 150);
+  ASSERT_EQ(b->x, 50);
+  ASSERT_EQ(b->y, 37);
+  ASSERT_EQ(b->w, 100);
+  ASSERT_EQ(b->h, 75);
+  ASSERT_EQ(v->need_relayout, FALSE);
+  ASSERT_EQ(v->need_relayout_children, FALSE);
+
+  /*绘制时的自动布局：区域和参数都没变，下层控件不需要重新布局。*/
+  widget_layout_stat_reset();
+  widget_layout_children(w);
+  stat = widget_layout_stat();
+  ASSERT_EQ(stat.self_layouts, 0u);
+  ASSERT_EQ(stat.self_skipped, 1u);
+  ASSERT_EQ(stat.children_layouts, 1u);
+  ASSERT_EQ(stat.children_skipped, 1u);
+
+  widget_resize(w, 200, 100);
+  widget_layout(w);
+  ASSERT_EQ(v->w, 100);
+  ASSERT_EQ(v->h, 50);
+  ASSERT_EQ(b->x, 25);
+  ASSERT_EQ(b->y, 12);
+  ASSERT_EQ(b->w, 50);
+  ASSERT_EQ(b->h, 25);
+
+  widget_destroy(w);
+}
+
+TEST(Layout, moved) {
+  widget_t* w = window_create(NULL, 0, 0, 0, 0);
+  widget_t* v = view_create(w, 0, 0, 0, 0);
+  widget_t* b = button_create(v, 0, 0, 0, 0);
+
+  widget_move_resize(w, 0, 0, 400, 300);
+  widget_set_self_layout_params(v, "0", "0", "100%", "100%");
+  widget_set_self_layout_params(b, "10", "20", "30", "40");
+  widget_layout(w);
+  ASSERT_EQ(b->x, 10);
+
+  /*被移动过的控件在父控件重新布局时恢复。*/
+  widget_move(b, 100, 100);
+  ASSERT_EQ(b->need_relayout, TRUE);
+  widget_layout(v);
+  ASSERT_EQ(b->x, 10);
+  ASSERT_EQ(b->y, 20);
+
+  /*显式布局窗口时，被移动过的下层控件也会恢复。*/
+  widget_move(b, 100, 100);
+  widget_layout(w);
+  ASSERT_EQ(b->x, 10);
+  ASSERT_EQ(b->y, 20);
+
+  /*修改布局参数会传播到上层控件。*/
+  widget_set_self_layout_params(b, "50", "60", "30", "40");
+  ASSERT_EQ(v->need_relayout_children, TRUE);
+  ASSERT_EQ(w->need_relayout_children, TRUE);
+  widget_layout(w);
+  ASSERT_EQ(b->x, 50);
+  ASSERT_EQ(b->y, 60);
+
+  widget_destroy(w);
+}
+
+TEST(Layout, add_remove_child) {
+  widget_t* w = window_create(NULL, 0, 0, 0, 0);
+  widget_t* v = view_create(w, 0, 0, 0, 0);
+  widget_t* b = NULL;
+
+  widget_move_resize(w, 0, 0, 400, 300);
+  widget_set_self_layout_params(v, "0", "0", "100%", "100%");
+  widget_set_children_layout(v, "default(r=1,c=2)");
+  widget_layout(w);
+  ASSERT_EQ(w->need_relayout_children, FALSE);
+
+  /*动态添加/删除下层控件会传播到窗口。*/
+  b = button_create(v, 0, 0, 0, 0);
+  ASSERT_EQ(v->need_relayout_children, TRUE);
+  ASSERT_EQ(w->need_relayout_children, TRUE);
+  widget_layout(w);
+  ASSERT_EQ(b->w, 200);
+  ASSERT_EQ(b->h, 300);
+  ASSERT_EQ(w->need_relayout_children, FALSE);
+
+  widget_remove_child(v, b);
+  ASSERT_EQ(w->need_relayout_children, TRUE);
+  widget_destroy(b);
+
+  widget_destroy(w);
+}
+
+TEST(Layout, visible) {
+  widget_t* w = window_create(NULL, 0, 0, 0, 0);
+  widget_t* v = view_create(w, 0, 0, 0, 0);
+  widget_t* b1 = button_create(v, 0, 0, 0, 0);
+  widget_t* b2 = button_create(v, 0, 0, 0, 0);
+
+  widget_move_resize(w, 0, 0, 400, 300);
+  widget_set_self_layout_params(v, "0", "0", "100%", "100%");
+  widget_set_children_layout(v, "default(r=1,c=0)");
+  widget_set_self_layout_params(b1, "0", "0", "100", "100%");
+  widget_set_self_layout_params(b2, "0", "0", "100", "100%");
+  widget_layout(w);
+  ASSERT_EQ(b2->x, 100);
+
+  widget_set_visible(b1, FALSE, FALSE);
+  ASSERT_EQ(v->need_relayout_children, TRUE);
+  widget_layout(w);
+  ASSERT_EQ(b2->x, 0);
+
+  widget_destroy(w);
+}
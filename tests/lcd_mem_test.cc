@@ -1,5 +1,6 @@
 ﻿#include "base/canvas.h"
 #include "gtest/gtest.h"
+#include "tools/font_gen/font_gen.h"
 #include "lcd/lcd_mem_bgr888.h"
 #include "lcd/lcd_mem_bgra8888.h"
 #include "lcd/lcd_mem_rgba8888.h"
@@ -104,6 +105,52 @@ TEST(LCDMem, bgr888) {
   lcd_destroy(lcd);
 }
 
+TEST(LCDMem, bind_snapshot) {
+  rgba_t p;
+  bitmap_t img;
+  bitmap_t small;
+  canvas_t canvas;
+  font_manager_t font_manager;
+  font_manager_init(&font_manager, NULL);
+  lcd_t* lcd = lcd_mem_bgra8888_create(40, 30, TRUE);
+  canvas_t* c = canvas_init(&canvas, lcd, &font_manager);
+
+  memset(&img, 0x00, sizeof(img));
+  memset(&small, 0x00, sizeof(small));
+  ASSERT_EQ(canvas_begin_frame(c, NULL, LCD_DRAW_NORMAL), RET_OK);
+  ASSERT_EQ(canvas_set_fill_color(c, color_init(0, 0, 0xff, 0xff)), RET_OK);
+  ASSERT_EQ(canvas_fill_rect(c, 0, 0, 40, 30), RET_OK);
+  ASSERT_EQ(canvas_end_frame(c), RET_OK);
+
+  /*没有数据时由LCD分配，绑定后直接绘制到快照中*/
+  ASSERT_EQ(lcd_bind_snapshot(lcd, &img), RET_OK);
+  ASSERT_EQ(img.w, 40);
+  ASSERT_EQ(img.h, 30);
+  ASSERT_TRUE(img.data != NULL);
+  ASSERT_EQ(canvas_begin_frame(c, NULL, LCD_DRAW_OFFLINE), RET_OK);
+  ASSERT_EQ(canvas_set_fill_color(c, color_init(0xff, 0, 0, 0xff)), RET_OK);
+  ASSERT_EQ(canvas_fill_rect(c, 0, 0, 40, 30), RET_OK);
+  ASSERT_EQ(canvas_end_frame(c), RET_OK);
+  ASSERT_EQ(lcd_bind_snapshot(lcd, NULL), RET_OK);
+
+  ASSERT_EQ(bitmap_get_pixel(&img, 20, 10, &p), RET_OK);
+  ASSERT_EQ(p.r, 0xff);
+  ASSERT_EQ(p.b, 0);
+  ASSERT_EQ(lcd_get_point_color(lcd, 20, 10).rgba.b, 0xff);
+
+  /*重复使用*/
+  ASSERT_EQ(lcd_bind_snapshot(lcd, &img), RET_OK);
+  ASSERT_EQ(lcd_bind_snapshot(lcd, NULL), RET_OK);
+
+  ASSERT_EQ(bitmap_init(&small, 20, 30, BITMAP_FMT_BGRA8888, NULL), RET_OK);
+  ASSERT_EQ(lcd_bind_snapshot(lcd, &small), RET_BAD_PARAMS);
+
+  bitmap_destroy(&img);
+  bitmap_destroy(&small);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
+
 TEST(LCDMem, resize) {
   lcd_t* lcd = lcd_mem_bgra8888_create(100, 200, TRUE);
   lcd_mem_t* mem = (lcd_mem_t*)lcd;
@@ -115,3 +162,66 @@ TEST(LCDMem, resize) {
 
   lcd_destroy(lcd);
 }
+
+static void test_draw_glyph_format(glyph_format_t format, uint8_t global_alpha) {
+  uint32_t y = 0;
+  uint8_t data[13 * 9];
+  uint8_t encoded[13 * 9 * 2];
+  uint8_t decoded[13 * 9];
+  glyph_t g;
+  glyph_t ref;
+  rect_t src = rect_init(2, 1, 9, 6);
+  lcd_t* lcd1 = lcd_mem_bgra8888_create(40, 40, TRUE);
+  lcd_t* lcd2 = lcd_mem_bgra8888_create(40, 40, TRUE);
+  color_t bg = color_init(0x10, 0x20, 0x30, 0xff);
+  color_t fg = color_init(0xf0, 0x80, 0x00, 0xff);
+
+  for (y = 0; y < sizeof(data); y++) {
+    data[y] = (y % 5) == 0 ? 0 : ((y % 7) == 0 ? 0xff : (y * 37) & 0xff);
+  }
+
+  memset(&g, 0x00, sizeof(g));
+  g.w = 13;
+  g.h = 9;
+  g.data = data;
+  ASSERT_NE(font_gen_encode_glyph(&g, format, encoded, sizeof(encoded)), 0u);
+  g.data = encoded;
+  g.format = format;
+
+  ref = g;
+  ref.data = decoded;
+  ref.format = GLYPH_FMT_ALPHA;
+  for (y = 0; y < g.h; y++) {
+    ASSERT_EQ(glyph_get_line(&g, y, decoded + y * g.w), RET_OK);
+  }
+
+  lcd_begin_frame(lcd1, NULL, LCD_DRAW_NORMAL);
+  lcd_set_fill_color(lcd1, bg);
+  lcd_fill_rect(lcd1, 0, 0, 40, 40);
+  lcd_set_text_color(lcd1, fg);
+  lcd_set_global_alpha(lcd1, global_alpha);
+  ASSERT_EQ(lcd_draw_glyph(lcd1, &ref, &src, 5, 7), RET_OK);
+
+  lcd_begin_frame(lcd2, NULL, LCD_DRAW_NORMAL);
+  lcd_set_fill_color(lcd2, bg);
+  lcd_fill_rect(lcd2, 0, 0, 40, 40);
+  lcd_set_text_color(lcd2, fg);
+  lcd_set_global_alpha(lcd2, global_alpha);
+  ASSERT_EQ(lcd_draw_glyph(lcd2, &g, &src, 5, 7), RET_OK);
+
+  ASSERT_EQ(memcmp(((lcd_mem_t*)lcd1)->offline_fb, ((lcd_mem_t*)lcd2)->offline_fb, 40 * 40 * 4),
+            0);
+
+  lcd_destroy(lcd1);
+  lcd_destroy(lcd2);
+}
+
+TEST(LCDMem, draw_glyph_formats) {
+  test_draw_glyph_format(GLYPH_FMT_ALPHA1, 0xff);
+  test_draw_glyph_format(GLYPH_FMT_ALPHA2, 0xff);
+  test_draw_glyph_format(GLYPH_FMT_ALPHA4, 0xff);
+  test_draw_glyph_format(GLYPH_FMT_RLE, 0xff);
+
+  test_draw_glyph_format(GLYPH_FMT_ALPHA4, 0x80);
+  test_draw_glyph_format(GLYPH_FMT_RLE, 0x80);
+}
@@ -60,3 +60,91 @@ TEST(LineBreak, chars_word) {
   ASSERT_EQ(word_break_check('k', ' '), LINE_BREAK_ALLOW);
   ASSERT_EQ(word_break_check('k', 'o'), LINE_BREAK_NO);
 }
+
+TEST(LineBreak, check_str) {
+  uint32_t i = 0;
+  break_type_t line_brks[64];
+  break_type_t word_brks[64];
+  const wchar_t* str = L"It is ok\nhello world，中文。\r\n(1,234.5%) \x1F600\x1F44D\x1F3FB a\x301";
+  uint32_t size = wcslen(str);
+
+  ASSERT_EQ(line_break_check_str(str, size, line_brks, word_brks), RET_OK);
+  for (i = 0; i < size; i++) {
+    wchar_t next = i + 1 < size ? str[i + 1] : 0;
+    ASSERT_EQ(line_brks[i], line_break_check(str[i], next));
+    ASSERT_EQ(word_brks[i], word_break_check(str[i], next));
+  }
+
+  ASSERT_EQ(line_brks[1], LINE_BREAK_NO);
+  ASSERT_EQ(line_brks[2], LINE_BREAK_ALLOW);
+  ASSERT_EQ(line_brks[7], LINE_BREAK_NO);
+  ASSERT_EQ(line_brks[8], LINE_BREAK_MUST);
+  ASSERT_EQ(word_brks[0], LINE_BREAK_NO);
+  ASSERT_EQ(word_brks[1], LINE_BREAK_ALLOW);
+
+  ASSERT_EQ(line_break_check_str(str, 1, NULL, word_brks), RET_OK);
+  ASSERT_EQ(word_brks[0], word_break_check(str[0], 0));
+  ASSERT_EQ(line_break_check_str(NULL, 0, line_brks, NULL), RET_OK);
+}
+
+#ifdef WITH_UNICODE_BREAK
+static uint32_t s_samples[] = {0x0000,  0x0009,  0x000A,  0x000B,  0x000D,  0x0020,  0x0022,
+                               0x0027,  0x0028,  0x0029,  0x002C,  0x002D,  0x002E,  0x0030,
+                               0x0041,  0x005D,  0x0085,  0x00A0,  0x00A9,  0x00AD,  0x0300,
+                               0x05D0,  0x0E01,  0x1100,  0x1160,  0x11A8,  0x200B,  0x200D,
+                               0x2014,  0x2060,  0x231A,  0x3000,  0x3001,  0x3041,  0x30A2,
+                               0x4E2D,  0xAC00,  0xAC01,  0xD800,  0xFE0F,  0xFF0C,  0xFFFC,
+                               0x1F1E6, 0x1F3FB, 0x1F466, 0x1F600, 0x20000, 0xE0001, 0x10FFFF};
+
+static break_type_t unibreak_line_break_check(uint32_t c1, uint32_t c2) {
+  if (c1 == ' ') {
+    return LINE_BREAK_ALLOW;
+  }
+
+  switch (is_line_breakable(c1, c2, "")) {
+    case LINEBREAK_MUSTBREAK:
+      return LINE_BREAK_MUST;
+    case LINEBREAK_NOBREAK:
+      return LINE_BREAK_NO;
+    default:
+      return LINE_BREAK_ALLOW;
+  }
+}
+
+static break_type_t unibreak_word_break_check(uint32_t c1, uint32_t c2) {
+  char brks[2];
+  utf32_t s[2] = {c1, c2};
+
+  set_wordbreaks_utf32(s, 2, "", brks);
+
+  return brks[0] == WORDBREAK_BREAK ? LINE_BREAK_ALLOW : LINE_BREAK_NO;
+}
+
+TEST(LineBreak, same_as_unibreak) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t seed = 1;
+  uint32_t chars[ARRAY_SIZE(s_samples) + 400];
+
+  init_linebreak();
+  init_wordbreak();
+  memcpy(chars, s_samples, sizeof(s_samples));
+  for (i = ARRAY_SIZE(s_samples); i < ARRAY_SIZE(chars); i++) {
+    seed = seed * 1103515245 + 12345;
+    chars[i] = (seed >> 8) % (i % 2 ? 0x10000 : 0x110000);
+  }
+
+  for (i = 0; i < ARRAY_SIZE(chars); i++) {
+    for (j = 0; j < ARRAY_SIZE(chars); j++) {
+      wchar_t c1 = (wchar_t)chars[i];
+      wchar_t c2 = (wchar_t)chars[j];
+      if (sizeof(wchar_t) == 2 && (chars[i] > 0xffff || chars[j] > 0xffff)) {
+        continue;
+      }
+
+      ASSERT_EQ(line_break_check(c1, c2), unibreak_line_break_check(chars[i], chars[j]));
+      ASSERT_EQ(word_break_check(c1, c2), unibreak_word_break_check(chars[i], chars[j]));
+    }
+  }
+}
+#endif /*WITH_UNICODE_BREAK*/
@@ -0,0 +1,84 @@
+#include "tkc/perf_trace.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using std::string;
+
+static uint64_t s_now = 0;
+static uint64_t fake_time_us(void) {
+  return s_now;
+}
+
+TEST(PerfTrace, basic) {
+  ASSERT_EQ(perf_trace_init(4), RET_OK);
+  ASSERT_EQ(perf_trace_set_clock(fake_time_us), RET_OK);
+
+  s_now = 100;
+  ASSERT_EQ(perf_trace_begin("paint", "button", "ok"), RET_OK);
+  s_now = 250;
+  ASSERT_EQ(perf_trace_end("paint", "button"), RET_OK);
+  ASSERT_EQ(perf_trace_count(), 2);
+
+  const perf_trace_event_t* e = perf_trace_get(0);
+  ASSERT_EQ(e->ph, 'B');
+  ASSERT_EQ(e->ts, 100);
+  ASSERT_EQ(string(e->cat), string("paint"));
+  ASSERT_EQ(string(e->name), string("button"));
+  ASSERT_EQ(string(e->detail), string("ok"));
+
+  e = perf_trace_get(1);
+  ASSERT_EQ(e->ph, 'E');
+  ASSERT_EQ(e->ts, 250);
+  ASSERT_EQ(string(e->detail), string(""));
+  ASSERT_EQ(perf_trace_get(2) == NULL, true);
+
+  ASSERT_EQ(perf_trace_reset(), RET_OK);
+  ASSERT_EQ(perf_trace_count(), 0);
+
+  perf_trace_set_clock(NULL);
+  perf_trace_deinit();
+}
+
+TEST(PerfTrace, wrap) {
+  uint32_t i = 0;
+  ASSERT_EQ(perf_trace_init(16), RET_OK);
+  ASSERT_EQ(perf_trace_set_clock(fake_time_us), RET_OK);
+
+  for (i = 0; i < 20; i++) {
+    s_now = i;
+    perf_trace_begin("main_loop", "timer", NULL);
+  }
+
+  ASSERT_EQ(perf_trace_count(), 16);
+  ASSERT_EQ(perf_trace_get(0)->ts, 4);
+  ASSERT_EQ(perf_trace_get(15)->ts, 19);
+
+  perf_trace_set_clock(NULL);
+  perf_trace_deinit();
+  ASSERT_EQ(perf_trace_begin("main_loop", "timer", NULL), RET_NOT_FOUND);
+}
+
+TEST(PerfTrace, json) {
+  str_t str;
+  ASSERT_EQ(perf_trace_init(16), RET_OK);
+  ASSERT_EQ(perf_trace_set_clock(fake_time_us), RET_OK);
+
+  s_now = 1000;
+  perf_trace_begin("layout", "view", "a\"b");
+  s_now = 1500;
+  perf_trace_end("layout", "view");
+
+  str_init(&str, 0);
+  ASSERT_EQ(perf_trace_to_json(&str), RET_OK);
+  ASSERT_EQ(string(str.str),
+            string("{\"traceEvents\":[\n"
+                   "{\"name\":\"view\",\"cat\":\"layout\",\"ph\":\"B\",\"ts\":1000,\"pid\":1,"
+                   "\"tid\":1,\"args\":{\"name\":\"a\\\"b\"}},\n"
+                   "{\"name\":\"view\",\"cat\":\"layout\",\"ph\":\"E\",\"ts\":1500,\"pid\":1,"
+                   "\"tid\":1}\n],\"displayTimeUnit\":\"ms\"}\n"));
+  str_reset(&str);
+
+  perf_trace_set_clock(NULL);
+  perf_trace_deinit();
+}
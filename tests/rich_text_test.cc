@@ -1,5 +1,7 @@
 ﻿#include "widgets/window.h"
 #include "rich_text/rich_text.h"
+#include "base/font_manager.h"
+#include "lcd/lcd_mem_bgra8888.h"
 #include "gtest/gtest.h"
 
 TEST(RichText, cast) {
@@ -10,3 +12,132 @@ TEST(RichText, cast) {
 
   widget_destroy(w);
 }
+
+static void rich_text_test_paint(widget_t* widget, canvas_t* c, wh_t w) {
+  rect_t r = rect_init(0, 0, 100, 100);
+
+  widget_resize(widget, w, widget->h);
+  canvas_begin_frame(c, &r, LCD_DRAW_NORMAL);
+  widget_paint(widget, c);
+  canvas_end_frame(c);
+}
+
+/*增量排版的结果和全部重新排版的结果相同。*/
+static void rich_text_test_check_layout(widget_t* widget, canvas_t* c) {
+  rich_text_t* rich_text = RICH_TEXT(widget);
+  rich_text_render_node_t* iter = rich_text->layouts[0].render_node;
+  rich_text_render_node_t* full =
+      rich_text_render_node_layout(widget, rich_text->node, c, widget->w, widget->h,
+                                   rich_text->layout_margin, rich_text->line_gap);
+  rich_text_render_node_t* iter_full = full;
+
+  ASSERT_EQ(rich_text->layouts[0].w, widget->w);
+  ASSERT_EQ(rich_text->layout_node, rich_text->node);
+  while (iter != NULL && iter_full != NULL) {
+    ASSERT_EQ(iter->node, iter_full->node);
+    ASSERT_EQ(iter->text, iter_full->text);
+    ASSERT_EQ(iter->size, iter_full->size);
+    ASSERT_EQ(iter->rect.x, iter_full->rect.x);
+    ASSERT_EQ(iter->rect.y, iter_full->rect.y);
+    ASSERT_EQ(iter->rect.w, iter_full->rect.w);
+    ASSERT_EQ(iter->rect.h, iter_full->rect.h);
+    ASSERT_EQ(iter->spacing, iter_full->spacing);
+    ASSERT_EQ(iter->flexible_w_chars, iter_full->flexible_w_chars);
+    ASSERT_EQ(iter->para_start, iter_full->para_start);
+    ASSERT_EQ(iter->para_y, iter_full->para_y);
+    ASSERT_EQ(iter->para_row_h, iter_full->para_row_h);
+
+    iter = iter->next;
+    iter_full = iter_full->next;
+  }
+  ASSERT_EQ(iter == NULL && iter_full == NULL, TRUE);
+
+  rich_text_render_node_destroy(full);
+}
+
+#define RICH_TEXT_TEST_PARAS                                                                   \
+  "<font size=\"20\">Title\n</font><font size=\"16\">short line\nThe quick brown fox jumps " \
+  "over the lazy dog. </font><font size=\"18\">Pack my box with five dozen liquor jugs.\n"    \
+  "tail</font>"
+
+TEST(RichText, reflow_resize) {
+  canvas_t c;
+  lcd_t* lcd = lcd_mem_bgra8888_create(100, 100, TRUE);
+  widget_t* w = window_create(NULL, 0, 0, 400, 400);
+  widget_t* rich_text = rich_text_create(w, 0, 0, 200, 400);
+  rich_text_t* rt = RICH_TEXT(rich_text);
+  rich_text_render_node_t* render_node = NULL;
+
+  canvas_init(&c, lcd, font_manager());
+  ASSERT_EQ(rich_text_set_text(rich_text, RICH_TEXT_TEST_PARAS), RET_OK);
+
+  rich_text_test_paint(rich_text, &c, 200);
+  rich_text_test_check_layout(rich_text, &c);
+  render_node = rt->layouts[0].render_node;
+  ASSERT_EQ(render_node->para_start, TRUE);
+
+  rich_text_test_paint(rich_text, &c, 150);
+  rich_text_test_check_layout(rich_text, &c);
+  ASSERT_NE(rt->layouts[0].render_node, render_node);
+
+  /*切换回原来的宽度时使用缓存的排版结果。*/
+  rich_text_test_paint(rich_text, &c, 200);
+  rich_text_test_check_layout(rich_text, &c);
+  ASSERT_EQ(rt->layouts[0].render_node, render_node);
+
+  rich_text_test_paint(rich_text, &c, 400);
+  rich_text_test_check_layout(rich_text, &c);
+  rich_text_test_paint(rich_text, &c, 390);
+  rich_text_test_check_layout(rich_text, &c);
+  rich_text_test_paint(rich_text, &c, 60);
+  rich_text_test_check_layout(rich_text, &c);
+
+  widget_destroy(w);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
+
+TEST(RichText, reflow_text) {
+  canvas_t c;
+  lcd_t* lcd = lcd_mem_bgra8888_create(100, 100, TRUE);
+  widget_t* w = window_create(NULL, 0, 0, 400, 400);
+  widget_t* rich_text = rich_text_create(w, 0, 0, 200, 400);
+  rich_text_t* rt = RICH_TEXT(rich_text);
+  rich_text_render_node_t* render_node = NULL;
+
+  canvas_init(&c, lcd, font_manager());
+  ASSERT_EQ(rich_text_set_text(rich_text, RICH_TEXT_TEST_PARAS), RET_OK);
+  rich_text_test_paint(rich_text, &c, 200);
+  render_node = rt->layouts[0].render_node;
+
+  /*在末尾追加段落，前面的段落不需要重新排版。*/
+  ASSERT_EQ(rich_text_set_text(rich_text, RICH_TEXT_TEST_PARAS "<font>\nnew para</font>"), RET_OK);
+  rich_text_test_paint(rich_text, &c, 200);
+  rich_text_test_check_layout(rich_text, &c);
+  ASSERT_EQ(rt->layouts[0].render_node, render_node);
+
+  /*连续设置两次文本。*/
+  ASSERT_EQ(rich_text_set_text(rich_text, "<font>abc</font>"), RET_OK);
+  ASSERT_EQ(rich_text_set_text(rich_text, RICH_TEXT_TEST_PARAS "<font>\nxxx</font>"), RET_OK);
+  rich_text_test_paint(rich_text, &c, 200);
+  rich_text_test_check_layout(rich_text, &c);
+
+  /*修改中间的段落和第一个段落(XML解析时会去掉文本首尾的换行符，段落只在文本节点内部)。*/
+  ASSERT_EQ(rich_text_set_text(rich_text,
+                               "<font size=\"20\">Title\n</font><font size=\"16\">short line\n"
+                               "The quick brown fox jumps over the lazy dog. </font>"
+                               "<font size=\"18\">Pack my box.\ntail</font>"),
+            RET_OK);
+  rich_text_test_paint(rich_text, &c, 200);
+  rich_text_test_check_layout(rich_text, &c);
+  ASSERT_EQ(rt->layouts[0].render_node, render_node);
+
+  ASSERT_EQ(rich_text_set_text(rich_text, "<font size=\"24\">Title\n</font><font>tail</font>"),
+            RET_OK);
+  rich_text_test_paint(rich_text, &c, 200);
+  rich_text_test_check_layout(rich_text, &c);
+
+  widget_destroy(w);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
@@ -325,3 +325,126 @@ TEST(SVGToBSVG, polygon_no_stroke3) {
 
   TKMEM_FREE(out);
 }
+
+static const svg_shape_t* next_shape(const svg_shape_t* shape) {
+  return (const svg_shape_t*)((const uint8_t*)shape + svg_shape_size(shape));
+}
+
+TEST(SVGToBSVG, flat_transform) {
+  bsvg_t svg;
+  uint32_t* out = NULL;
+  uint32_t out_length = 0;
+  const float_t* p = NULL;
+  const svg_shape_flat_t* shape = NULL;
+  const char* content =
+      "<g transform=\"translate(100,200)\"><rect x=\"10\" y=\"10\" width=\"30\" height=\"40\" "
+      "stroke=\"none\" transform=\"scale(2)\"/></g>"
+      "<line x1=\"0\" y1=\"0\" x2=\"10\" y2=\"0\" stroke-width=\"2\" "
+      "stroke-linejoin=\"round\" transform=\"rotate(90 5 5)\"/>";
+
+  tk_snprintf(s_buff, sizeof(s_buff) - 1, s_template, content);
+  ASSERT_EQ(svg_to_bsvg_ex(s_buff, strlen(s_buff), 0.25f, &out, &out_length), RET_OK);
+
+  ASSERT_TRUE(bsvg_init(&svg, out, out_length) != NULL);
+  ASSERT_EQ(svg.header->version, BSVG_VERSION_FLAT);
+  ASSERT_EQ(svg.header->w, 16u);
+
+  /*g和rect的transform都应用到了坐标上*/
+  shape = (const svg_shape_flat_t*)bsvg_get_first_shape(&svg);
+  ASSERT_EQ(shape->shape.type, SVG_SHAPE_FLAT);
+  ASSERT_EQ(shape->shape.no_stroke, TRUE);
+  ASSERT_EQ(shape->shape.stroke_width, 2);
+  ASSERT_EQ(shape->subpaths_nr, 1u);
+  ASSERT_EQ(shape->points_nr, 4u);
+  ASSERT_EQ(shape->data[0], 4u | SVG_SHAPE_FLAT_CLOSED);
+  p = svg_shape_flat_get_points(shape);
+  ASSERT_EQ(p[0], 120);
+  ASSERT_EQ(p[1], 220);
+  ASSERT_EQ(p[4], 180);
+  ASSERT_EQ(p[5], 300);
+  ASSERT_EQ(shape->x, 120);
+  ASSERT_EQ(shape->y, 220);
+  ASSERT_EQ(shape->w, 60);
+  ASSERT_EQ(shape->h, 80);
+
+  /*g之外不再使用g的transform，包围盒包括描边*/
+  shape = (const svg_shape_flat_t*)next_shape((const svg_shape_t*)shape);
+  ASSERT_EQ(shape->shape.type, SVG_SHAPE_FLAT);
+  ASSERT_EQ(shape->shape.stroke_width, 2);
+  ASSERT_EQ(shape->data[0], 2u);
+  p = svg_shape_flat_get_points(shape);
+  ASSERT_NEAR(p[0], 10, 0.001f);
+  ASSERT_NEAR(p[1], 0, 0.001f);
+  ASSERT_NEAR(p[2], 10, 0.001f);
+  ASSERT_NEAR(p[3], 10, 0.001f);
+  ASSERT_NEAR(shape->x, 8.5f, 0.001f);
+  ASSERT_NEAR(shape->w, 3, 0.001f);
+  ASSERT_NEAR(shape->h, 13, 0.001f);
+
+  shape = (const svg_shape_flat_t*)next_shape((const svg_shape_t*)shape);
+  ASSERT_EQ(shape->shape.type, SVG_SHAPE_NULL);
+  TKMEM_FREE(out);
+
+  /*v1不支持transform，结果不变*/
+  svg_to_bsvg(s_buff, strlen(s_buff), &out, &out_length);
+  bsvg_init(&svg, out, out_length);
+  ASSERT_EQ(svg.header->version, BSVG_VERSION);
+  ASSERT_EQ(bsvg_get_first_shape(&svg)->type, SVG_SHAPE_RECT);
+  ASSERT_EQ(((const svg_shape_rect_t*)bsvg_get_first_shape(&svg))->x, 10);
+  TKMEM_FREE(out);
+}
+
+TEST(SVGToBSVG, flat_curves) {
+  bsvg_t svg;
+  uint32_t i = 0;
+  uint32_t* out = NULL;
+  uint32_t out_length = 0;
+  const float_t* p = NULL;
+  const svg_shape_flat_t* shape = NULL;
+  const char* content =
+      "<path d=\"M100 100 A 50 50 0 0 1 200 100\" fill=\"none\" stroke=\"red\"/>"
+      "<circle cx=\"512\" cy=\"512\" r=\"256\" stroke=\"none\"/>";
+
+  /*viewBox是1024x1024，输出16x16，0.25像素的误差是16个单位*/
+  tk_snprintf(s_buff, sizeof(s_buff) - 1, s_template, content);
+  ASSERT_EQ(svg_to_bsvg_ex(s_buff, strlen(s_buff), 0.25f, &out, &out_length), RET_OK);
+  ASSERT_TRUE(bsvg_init(&svg, out, out_length) != NULL);
+
+  /*圆弧细分成折线，子路径不封闭*/
+  shape = (const svg_shape_flat_t*)bsvg_get_first_shape(&svg);
+  ASSERT_EQ(shape->shape.type, SVG_SHAPE_FLAT);
+  ASSERT_EQ(shape->subpaths_nr, 1u);
+  ASSERT_EQ(shape->data[0], shape->points_nr);
+  ASSERT_GT(shape->points_nr, 2u);
+  p = svg_shape_flat_get_points(shape);
+  for (i = 0; i < shape->points_nr; i++) {
+    float_t dx = p[2 * i] - 150;
+    float_t dy = p[2 * i + 1] - 100;
+    ASSERT_NEAR(sqrt(dx * dx + dy * dy), 50, 0.05f);
+    ASSERT_LE(p[2 * i + 1], 100.01f);
+  }
+  ASSERT_NEAR(p[0], 100, 0.001f);
+  ASSERT_NEAR(p[2 * shape->points_nr - 2], 200, 0.01f);
+  /*miter的描边最长为10倍的半线宽*/
+  ASSERT_NEAR(shape->x, 95, 0.01f);
+  ASSERT_NEAR(shape->w, 110, 0.01f);
+
+  /*和vgcanvas_arc一样从0度开始，误差越小，点越多*/
+  shape = (const svg_shape_flat_t*)next_shape((const svg_shape_t*)shape);
+  ASSERT_EQ(shape->shape.type, SVG_SHAPE_FLAT);
+  ASSERT_EQ(shape->data[0], shape->points_nr);
+  p = svg_shape_flat_get_points(shape);
+  for (i = 0; i < shape->points_nr; i++) {
+    float_t dx = p[2 * i] - 512;
+    float_t dy = p[2 * i + 1] - 512;
+    ASSERT_NEAR(sqrt(dx * dx + dy * dy), 256, 1);
+  }
+  i = shape->points_nr;
+  TKMEM_FREE(out);
+
+  ASSERT_EQ(svg_to_bsvg_ex(s_buff, strlen(s_buff), 0.01f, &out, &out_length), RET_OK);
+  ASSERT_TRUE(bsvg_init(&svg, out, out_length) != NULL);
+  shape = (const svg_shape_flat_t*)next_shape(bsvg_get_first_shape(&svg));
+  ASSERT_GT(shape->points_nr, i);
+  TKMEM_FREE(out);
+}
@@ -4,6 +4,8 @@
 #include "base/text_edit.h"
 #include "base/clip_board.h"
 #include "base/window_manager.h"
+#include "base/font_manager.h"
+#include "lcd/lcd_mem_bgra8888.h"
 
 TEST(TextEdit, basic) {
   str_t str;
@@ -52,3 +54,101 @@ TEST(TextEdit, basic) {
   widget_destroy(w);
   text_edit_destroy(text_edit);
 }
+
+static void text_edit_test_input(text_edit_t* text_edit, widget_t* w, int32_t key) {
+  key_event_t keye;
+
+  key_event_init(&keye, EVT_KEY_DOWN, w, key);
+  ASSERT_EQ(text_edit_key_down(text_edit, &keye), RET_OK);
+}
+
+/*增量排版的结果要和全部重新排版的结果一致。*/
+static void text_edit_test_check_layout(text_edit_t* text_edit, text_edit_t* full, widget_t* w) {
+  uint32_t i = 0;
+  text_edit_state_t state;
+  text_edit_state_t full_state;
+
+  ASSERT_EQ(text_edit_get_state(text_edit, &state), RET_OK);
+  ASSERT_EQ(text_edit_set_cursor(full, state.cursor), RET_OK);
+  ASSERT_EQ(text_edit_get_state(full, &full_state), RET_OK);
+  ASSERT_EQ(state.rows, full_state.rows);
+  ASSERT_EQ(state.caret.x, full_state.caret.x);
+  ASSERT_EQ(state.caret.y, full_state.caret.y);
+
+  for (i = 0; i <= w->text.size; i++) {
+    ASSERT_EQ(text_edit_set_select(text_edit, i, i), RET_OK);
+    ASSERT_EQ(text_edit_set_select(full, i, i), RET_OK);
+    ASSERT_EQ(text_edit_get_state(text_edit, &state), RET_OK);
+    ASSERT_EQ(text_edit_get_state(full, &full_state), RET_OK);
+    ASSERT_EQ(state.caret.x, full_state.caret.x);
+    ASSERT_EQ(state.caret.y, full_state.caret.y);
+  }
+  ASSERT_EQ(text_edit_set_select(text_edit, 0, 0), RET_OK);
+}
+
+TEST(TextEdit, incremental_layout) {
+  canvas_t c;
+  uint32_t i = 0;
+  lcd_t* lcd = lcd_mem_bgra8888_create(100, 100, TRUE);
+  widget_t* w = mledit_create(NULL, 10, 20, 100, 400);
+  text_edit_t* text_edit = text_edit_create(w, FALSE);
+  text_edit_t* full = text_edit_create(w, FALSE);
+
+  canvas_init(&c, lcd, font_manager());
+  ASSERT_EQ(text_edit_set_canvas(text_edit, &c), RET_OK);
+  ASSERT_EQ(text_edit_set_canvas(full, &c), RET_OK);
+
+  widget_set_text(w, L"hello world\nabc def ghi jkl mno pqr\n\n123 456 789\nlast line");
+  ASSERT_EQ(text_edit_layout(text_edit), RET_OK);
+  ASSERT_EQ(text_edit_set_cursor(text_edit, 20), RET_OK);
+  text_edit_test_check_layout(text_edit, full, w);
+
+  /*在段落中间输入，行末的单词会被挤到下一行。*/
+  for (i = 0; i < 8; i++) {
+    text_edit_test_input(text_edit, w, TK_KEY_x);
+  }
+  text_edit_test_check_layout(text_edit, full, w);
+
+  text_edit_test_input(text_edit, w, TK_KEY_SPACE);
+  text_edit_test_check_layout(text_edit, full, w);
+
+  /*拆分和合并段落。*/
+  text_edit_test_input(text_edit, w, TK_KEY_RETURN);
+  text_edit_test_check_layout(text_edit, full, w);
+
+  text_edit_test_input(text_edit, w, TK_KEY_BACKSPACE);
+  text_edit_test_input(text_edit, w, TK_KEY_BACKSPACE);
+  text_edit_test_check_layout(text_edit, full, w);
+
+  ASSERT_EQ(text_edit_set_cursor(text_edit, 12), RET_OK);
+  text_edit_test_input(text_edit, w, TK_KEY_BACKSPACE);
+  text_edit_test_check_layout(text_edit, full, w);
+
+  /*删除选中的多行文本，再粘贴回来。*/
+  ASSERT_EQ(text_edit_set_select(text_edit, 5, 40), RET_OK);
+  ASSERT_EQ(text_edit_paste(text_edit, L"A\nB C D E F G H I J K", 21), RET_OK);
+  text_edit_test_check_layout(text_edit, full, w);
+
+  text_edit_test_input(text_edit, w, TK_KEY_z);
+  text_edit_test_input(text_edit, w, TK_KEY_DELETE);
+  text_edit_test_check_layout(text_edit, full, w);
+
+  /*在文本末尾输入。*/
+  ASSERT_EQ(text_edit_set_cursor(text_edit, w->text.size), RET_OK);
+  text_edit_test_input(text_edit, w, TK_KEY_RETURN);
+  text_edit_test_input(text_edit, w, TK_KEY_a);
+  text_edit_test_check_layout(text_edit, full, w);
+
+  /*在文本开头输入。*/
+  ASSERT_EQ(text_edit_set_cursor(text_edit, 0), RET_OK);
+  for (i = 0; i < 20; i++) {
+    text_edit_test_input(text_edit, w, i % 5 == 4 ? TK_KEY_SPACE : TK_KEY_b);
+  }
+  text_edit_test_check_layout(text_edit, full, w);
+
+  text_edit_destroy(full);
+  text_edit_destroy(text_edit);
+  widget_destroy(w);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
@@ -0,0 +1,126 @@
+#include "tkc/mem.h"
+#include "base/text_run.h"
+#include "tools/common/utils.h"
+#include "font_loader/font_loader_truetype.h"
+#include "gtest/gtest.h"
+#include <string.h>
+
+#define TTF_FILE TK_ROOT "/demos/assets/raw/fonts/default.ttf"
+
+/*每个字符宽度为10，"AV"之间的字距调整为-2。*/
+static ret_t fake_font_get_glyph(font_t* f, wchar_t chr, font_size_t font_size, glyph_t* g) {
+  memset(g, 0x00, sizeof(glyph_t));
+  g->advance = 10;
+
+  return chr == 'X' ? RET_NOT_FOUND : RET_OK;
+}
+
+static int32_t fake_font_get_kerning(font_t* f, font_size_t font_size, wchar_t c1, wchar_t c2) {
+  return (c1 == 'A' && c2 == 'V') ? -2 : 0;
+}
+
+static void fake_font_init(font_t* f) {
+  memset(f, 0x00, sizeof(font_t));
+  f->name = "fake";
+  f->get_glyph = fake_font_get_glyph;
+  f->get_kerning = fake_font_get_kerning;
+}
+
+TEST(TextRun, basic) {
+  font_t f;
+  text_run_t run;
+  fake_font_init(&f);
+
+  ASSERT_EQ(text_run_init(&run, &f, 20, L"AVa b", 5), RET_OK);
+  ASSERT_EQ(run.size, 5u);
+  ASSERT_EQ(run.font_size, 20);
+  ASSERT_EQ(run.glyphs[0].x, 0);
+  ASSERT_EQ(run.glyphs[0].advance, 11 - 2);
+  ASSERT_EQ(run.glyphs[1].x, 9);
+  ASSERT_EQ(run.glyphs[2].x, 20);
+  ASSERT_EQ(run.glyphs[3].advance, TEXT_RUN_SPACE_W);
+  ASSERT_EQ(run.w, 9 + 11 + 11 + TEXT_RUN_SPACE_W + 11);
+
+  ASSERT_EQ(text_run_get_x(&run, 0), 0);
+  ASSERT_EQ(text_run_get_x(&run, 2), 20);
+  ASSERT_EQ(text_run_get_x(&run, 5), run.w);
+  ASSERT_EQ(text_run_get_x(&run, 100), run.w);
+  ASSERT_EQ(text_run_deinit(&run), RET_OK);
+}
+
+TEST(TextRun, missing_glyph) {
+  font_t f;
+  text_run_t run;
+  fake_font_init(&f);
+
+  ASSERT_EQ(text_run_init(&run, &f, 20, L"aXb\n", 4), RET_OK);
+  ASSERT_EQ(run.glyphs[1].advance, TEXT_RUN_SPACE_W);
+  ASSERT_EQ(run.glyphs[3].advance, 0);
+  ASSERT_EQ(run.w, 11 + TEXT_RUN_SPACE_W + 11);
+  text_run_deinit(&run);
+}
+
+TEST(TextRun, cluster) {
+  font_t f;
+  text_run_t run;
+  fake_font_init(&f);
+
+  /*e + U+0301(组合重音符)*/
+  ASSERT_EQ(text_run_init(&run, &f, 20, L"ae\x301z", 4), RET_OK);
+  ASSERT_EQ(run.glyphs[2].cluster, 1u);
+  ASSERT_EQ(run.glyphs[2].advance, 0);
+  ASSERT_EQ(run.glyphs[2].x, 11 + 10);
+  ASSERT_EQ(run.glyphs[3].cluster, 3u);
+  ASSERT_EQ(run.glyphs[3].x, 22);
+  ASSERT_EQ(run.w, 33);
+
+  ASSERT_EQ(text_run_get_x(&run, 2), text_run_get_x(&run, 1));
+  ASSERT_EQ(text_run_hit_test(&run, -5), 0u);
+  ASSERT_EQ(text_run_hit_test(&run, 12), 1u);
+  ASSERT_EQ(text_run_hit_test(&run, 21), 3u);
+  ASSERT_EQ(text_run_hit_test(&run, 100), 4u);
+  text_run_deinit(&run);
+}
+
+TEST(TextRun, cache) {
+  font_t f;
+  const text_run_t* run = NULL;
+  fake_font_init(&f);
+
+  run = font_get_text_run(&f, 20, L"hello", 5);
+  ASSERT_EQ(run->w, 55);
+  ASSERT_EQ(font_get_text_run(&f, 20, L"hello", 5), run);
+  ASSERT_NE(font_get_text_run(&f, 30, L"hello", 5), run);
+  ASSERT_EQ(font_get_text_run(&f, 20, L"hello", 5), run);
+  ASSERT_EQ(font_get_text_run(&f, 20, L"h", 1)->w, 11);
+
+  for (int i = 0; i < 100; i++) {
+    wchar_t str[8];
+    str[0] = 'a' + i % 26;
+    str[1] = 'a' + i / 26;
+    ASSERT_EQ(font_get_text_run(&f, 20, str, 2)->w, 22);
+  }
+  ASSERT_EQ(font_get_text_run(&f, 20, L"hello", 5)->w, 55);
+
+  text_run_cache_destroy(f.text_runs);
+}
+
+TEST(TextRun, truetype_kerning) {
+  uint32_t size = 0;
+  uint8_t* buff = (uint8_t*)read_file(TTF_FILE, &size);
+  font_t* font = font_truetype_create("default", buff, size);
+  const text_run_t* run = NULL;
+  glyph_t g;
+
+  ASSERT_LT(font_get_kerning(font, 32, 'T', 'o'), 0);
+  ASSERT_EQ(font_get_kerning(font, 32, 'T', ' '), 0);
+  ASSERT_EQ(font_get_kerning(font, 32, 0, 'o'), 0);
+
+  ASSERT_EQ(font_get_glyph(font, 'T', 32, &g), RET_OK);
+  run = font_get_text_run(font, 32, L"To", 2);
+  ASSERT_EQ(run->glyphs[1].x,
+            g.advance + TEXT_RUN_LETTER_SPACING + font_get_kerning(font, 32, 'T', 'o'));
+
+  font_destroy(font);
+  TKMEM_FREE(buff);
+}
@@ -145,3 +145,24 @@ TEST(UILoaderXML, prop2) {
 
   widget_destroy(root);
 }
+
+TEST(UILoaderXML, prop3) {
+  widget_t* root = NULL;
+  ui_loader_t* loader = xml_ui_loader();
+  ui_builder_t* builder = ui_builder_default("");
+  const char* str =
+      "<button text=\"a\\tb\" name=\"plain\">\
+      <property comment=\"name is not the first attr\" name=\"x\">5</property>\
+      </button>";
+
+  /*资源数据没有以'\0'结束*/
+  ASSERT_EQ(ui_loader_load(loader, (const uint8_t*)str, strlen(str) - 1, builder), RET_OK);
+
+  root = builder->root;
+  ASSERT_EQ(builder->root != NULL, true);
+  ASSERT_EQ(root->x, 5);
+  ASSERT_STREQ(root->name, "plain");
+  ASSERT_EQ(wcscmp(root->text.str, L"a\tb"), 0);
+
+  widget_destroy(root);
+}
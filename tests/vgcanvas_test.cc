@@ -0,0 +1,499 @@
+﻿#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "base/vgcanvas.h"
+#include "svg/bsvg_draw.h"
+#include "svg/svg_to_bsvg.h"
+#include "gtest/gtest.h"
+
+#define VG_W 64
+#define VG_H 64
+
+typedef struct _arc_key_t {
+  float_t r;
+  float_t angle;
+} arc_key_t;
+
+static void draw_arc(vgcanvas_t* vg, vgcanvas_path_t* path, const arc_key_t* key, float_t dx,
+                     float_t dy, ret_t* reused) {
+  vgcanvas_save(vg);
+  vgcanvas_translate(vg, dx, dy);
+  vgcanvas_begin_path(vg);
+  if (path == NULL || vgcanvas_reuse_path(vg, path, key, sizeof(*key)) != RET_OK) {
+    vgcanvas_arc(vg, 20, 20, key->r, 0, key->angle, FALSE);
+    if (path != NULL) {
+      ASSERT_EQ(vgcanvas_retain_path(vg, path, key, sizeof(*key)), RET_OK);
+    }
+    *reused = RET_FAIL;
+  } else {
+    *reused = RET_OK;
+  }
+  vgcanvas_stroke(vg);
+  vgcanvas_restore(vg);
+}
+
+static void clear(vgcanvas_t* vg, uint32_t* buff) {
+  memset(buff, 0xff, VG_W * VG_H * 4);
+  vgcanvas_set_line_width(vg, 4);
+  vgcanvas_set_stroke_color(vg, color_init(0xff, 0, 0, 0xff));
+}
+
+TEST(VGCanvas, reuse_path) {
+  ret_t reused = RET_OK;
+  arc_key_t key = {15, 3};
+  uint32_t* expected = TKMEM_ZALLOCN(uint32_t, VG_W * VG_H);
+  uint32_t* buff = TKMEM_ZALLOCN(uint32_t, VG_W * VG_H);
+  vgcanvas_t* vg = vgcanvas_create(VG_W, VG_H, VG_W * 4, BITMAP_FMT_BGRA8888, buff);
+  vgcanvas_path_t* path = vgcanvas_path_create();
+  rect_t r = rect_init(0, 0, VG_W, VG_H);
+
+  vgcanvas_begin_frame(vg, &r);
+  clear(vg, buff);
+  draw_arc(vg, NULL, &key, 10, 8, &reused);
+  memcpy(expected, buff, VG_W * VG_H * 4);
+
+  /*第一次生成路径*/
+  clear(vg, buff);
+  draw_arc(vg, path, &key, 0, 0, &reused);
+  ASSERT_EQ(reused, RET_FAIL);
+
+  /*只有平移变化时直接使用缓存的路径，结果和重新生成的一样*/
+  clear(vg, buff);
+  draw_arc(vg, path, &key, 10, 8, &reused);
+  ASSERT_EQ(reused, RET_OK);
+  ASSERT_EQ(memcmp(buff, expected, VG_W * VG_H * 4), 0);
+
+  /*参数变化时重新生成*/
+  key.angle = 2;
+  draw_arc(vg, path, &key, 10, 8, &reused);
+  ASSERT_EQ(reused, RET_FAIL);
+  draw_arc(vg, path, &key, 0, 0, &reused);
+  ASSERT_EQ(reused, RET_OK);
+
+  /*缩放之后不能重用*/
+  vgcanvas_save(vg);
+  vgcanvas_scale(vg, 2, 2);
+  draw_arc(vg, path, &key, 0, 0, &reused);
+  ASSERT_EQ(reused, RET_FAIL);
+  vgcanvas_restore(vg);
+
+  ASSERT_EQ(vgcanvas_path_reset(path), RET_OK);
+  draw_arc(vg, path, &key, 0, 0, &reused);
+  ASSERT_EQ(reused, RET_FAIL);
+
+  vgcanvas_end_frame(vg);
+  vgcanvas_path_destroy(path);
+  vgcanvas_destroy(vg);
+  TKMEM_FREE(buff);
+  TKMEM_FREE(expected);
+}
+
+static const char* s_svg =
+    "<svg viewBox=\"0 0 64 64\" width=\"64\" height=\"64\">"
+    "<circle cx=\"20\" cy=\"20\" r=\"10\" fill=\"#00ff00\"/>"
+    "<path d=\"m30 30 l20 0 a10 10 0 0 1 -10 10 z\" fill=\"#0000ff\"/>"
+    "<path d=\"m4 4 q10 0 10 10\" stroke=\"#ff0000\" fill=\"none\"/></svg>";
+
+static void draw_svg(vgcanvas_t* vg, bsvg_t* svg, darray_t* paths, float_t dx, float_t dy) {
+  vgcanvas_save(vg);
+  vgcanvas_translate(vg, dx, dy);
+  bsvg_draw_ex(svg, vg, paths);
+  vgcanvas_restore(vg);
+}
+
+TEST(VGCanvas, bsvg_reuse_path) {
+  bsvg_t svg;
+  uint32_t* out = NULL;
+  uint32_t out_length = 0;
+  uint32_t* expected = TKMEM_ZALLOCN(uint32_t, VG_W * VG_H);
+  uint32_t* buff = TKMEM_ZALLOCN(uint32_t, VG_W * VG_H);
+  vgcanvas_t* vg = vgcanvas_create(VG_W, VG_H, VG_W * 4, BITMAP_FMT_BGRA8888, buff);
+  darray_t* paths = darray_create(4, (tk_destroy_t)vgcanvas_path_destroy, NULL);
+  rect_t r = rect_init(0, 0, VG_W, VG_H);
+
+  svg_to_bsvg(s_svg, strlen(s_svg), &out, &out_length);
+  ASSERT_TRUE(bsvg_init(&svg, out, out_length) != NULL);
+
+  vgcanvas_begin_frame(vg, &r);
+  clear(vg, buff);
+  draw_svg(vg, &svg, NULL, 3, 5);
+  memcpy(expected, buff, VG_W * VG_H * 4);
+
+  clear(vg, buff);
+  draw_svg(vg, &svg, paths, 0, 0);
+  ASSERT_EQ(paths->size, 3u);
+
+  /*重用缓存的路径，相对路径的当前点也要正确*/
+  clear(vg, buff);
+  draw_svg(vg, &svg, paths, 3, 5);
+  ASSERT_EQ(paths->size, 3u);
+  ASSERT_EQ(memcmp(buff, expected, VG_W * VG_H * 4), 0);
+
+  vgcanvas_end_frame(vg);
+  darray_destroy(paths);
+  vgcanvas_destroy(vg);
+  TKMEM_FREE(out);
+  TKMEM_FREE(buff);
+  TKMEM_FREE(expected);
+}
+
+static uint32_t count_diff_channels(const uint32_t* a, const uint32_t* b, uint32_t max_diff) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+  const uint8_t* pa = (const uint8_t*)a;
+  const uint8_t* pb = (const uint8_t*)b;
+
+  for (i = 0; i < VG_W * VG_H * 4; i++) {
+    if (tk_abs((int32_t)(pa[i]) - (int32_t)(pb[i])) > (int32_t)max_diff) {
+      n++;
+    }
+  }
+
+  return n;
+}
+
+TEST(VGCanvas, bsvg_flat) {
+  bsvg_t svg;
+  bsvg_t flat;
+  uint32_t* out = NULL;
+  uint32_t* out_flat = NULL;
+  uint32_t out_length = 0;
+  uint32_t out_flat_length = 0;
+  uint32_t* expected = TKMEM_ZALLOCN(uint32_t, VG_W * VG_H);
+  uint32_t* buff = TKMEM_ZALLOCN(uint32_t, VG_W * VG_H);
+  vgcanvas_t* vg = vgcanvas_create(VG_W, VG_H, VG_W * 4, BITMAP_FMT_BGRA8888, buff);
+  darray_t* paths = darray_create(4, (tk_destroy_t)vgcanvas_path_destroy, NULL);
+  rect_t r = rect_init(0, 0, VG_W, VG_H);
+
+  svg_to_bsvg(s_svg, strlen(s_svg), &out, &out_length);
+  ASSERT_TRUE(bsvg_init(&svg, out, out_length) != NULL);
+  ASSERT_EQ(svg_to_bsvg_ex(s_svg, strlen(s_svg), 0.1f, &out_flat, &out_flat_length), RET_OK);
+  ASSERT_TRUE(bsvg_init(&flat, out_flat, out_flat_length) != NULL);
+
+  /*预先细分的误差(0.1像素)比nanovg(0.5像素)小，只有曲线边缘的抗锯齿有差别*/
+  vgcanvas_begin_frame(vg, &r);
+  clear(vg, buff);
+  draw_svg(vg, &svg, NULL, 3, 5);
+  memcpy(expected, buff, VG_W * VG_H * 4);
+
+  clear(vg, buff);
+  draw_svg(vg, &flat, NULL, 3, 5);
+  ASSERT_EQ(count_diff_channels(buff, expected, 64), 0u);
+  ASSERT_LT(count_diff_channels(buff, expected, 8), (uint32_t)(VG_W * VG_H / 16));
+
+  /*裁剪区之外的shape被跳过，但是缓存的路径仍然和shape一一对应*/
+  vgcanvas_save(vg);
+  vgcanvas_clip_rect(vg, 0, 0, 16, 16);
+  ASSERT_TRUE(vgcanvas_is_rect_visible(vg, 4, 4, 4, 4));
+  ASSERT_FALSE(vgcanvas_is_rect_visible(vg, 30, 30, 20, 10));
+  clear(vg, buff);
+  draw_svg(vg, &flat, NULL, 0, 0);
+  memcpy(expected, buff, VG_W * VG_H * 4);
+
+  clear(vg, buff);
+  draw_svg(vg, &flat, paths, 0, 0);
+  ASSERT_EQ(paths->size, 3u);
+  ASSERT_EQ(memcmp(buff, expected, VG_W * VG_H * 4), 0);
+
+  vgcanvas_translate(vg, -25, -25);
+  ASSERT_TRUE(vgcanvas_is_rect_visible(vg, 30, 30, 20, 10));
+  vgcanvas_restore(vg);
+
+  /*没有裁剪区时shape都在路径缓存中*/
+  clear(vg, buff);
+  draw_svg(vg, &flat, NULL, 0, 0);
+  memcpy(expected, buff, VG_W * VG_H * 4);
+  clear(vg, buff);
+  draw_svg(vg, &flat, paths, 0, 0);
+  ASSERT_EQ(memcmp(buff, expected, VG_W * VG_H * 4), 0);
+
+  vgcanvas_end_frame(vg);
+  darray_destroy(paths);
+  vgcanvas_destroy(vg);
+  TKMEM_FREE(out);
+  TKMEM_FREE(out_flat);
+  TKMEM_FREE(buff);
+  TKMEM_FREE(expected);
+}
+
+#ifdef WITH_NANOVG_AGGE
+#include "agge/nanovg_agge.h"
+#include "agge/blender_linear_gradient.h"
+#include "agge/blender_radial_gradient.h"
+
+typedef struct _evict_info_t {
+  uint32_t count;
+  const uint8_t* data;
+} evict_info_t;
+
+static void on_evict(void* ctx, int image, const uint8_t* data) {
+  evict_info_t* info = (evict_info_t*)ctx;
+
+  info->count++;
+  info->data = data;
+}
+
+static void fill_image(NVGcontext* ctx, int image) {
+  nvgBeginPath(ctx);
+  nvgRect(ctx, 0, 0, 8, 8);
+  nvgFillPaint(ctx, nvgImagePattern(ctx, 0, 0, 8, 8, 0, image, 1));
+  nvgFill(ctx);
+}
+
+TEST(VGCanvas, agge_textures) {
+  evict_info_t info = {0, NULL};
+  uint8_t pixels[3][8 * 8 * 4];
+  uint32_t* buff = TKMEM_ZALLOCN(uint32_t, VG_W * VG_H);
+  NVGcontext* ctx = nvgCreateAGGE(VG_W, VG_H, VG_W * 4, NVG_TEXTURE_BGRA, (uint8_t*)buff);
+  int a = nvgCreateImageRaw(ctx, 8, 8, NVG_TEXTURE_RGBA, NVG_IMAGE_NEAREST, pixels[0]);
+  int b = nvgCreateImageRaw(ctx, 8, 8, NVG_TEXTURE_RGBA, NVG_IMAGE_NEAREST, pixels[1]);
+  int c = 0;
+
+  ASSERT_TRUE(a > 0 && b > 0 && a != b);
+  ASSERT_EQ(nvgAggeGetTextureData(ctx, a), pixels[0]);
+  ASSERT_EQ(nvgAggeGetTextureData(ctx, b), pixels[1]);
+  ASSERT_EQ(nvgAggeGetTextureBytes(ctx), 2u * 8 * 8 * 4);
+
+  /*删除后槽位被重用，但是旧的id不再有效*/
+  nvgDeleteImage(ctx, b);
+  ASSERT_TRUE(nvgAggeGetTextureData(ctx, b) == NULL);
+  ASSERT_EQ(nvgAggeGetTextureBytes(ctx), 8u * 8 * 4);
+  c = nvgCreateImageRaw(ctx, 8, 8, NVG_TEXTURE_RGBA, NVG_IMAGE_NEAREST, pixels[2]);
+  ASSERT_TRUE(c > 0 && c != b);
+  ASSERT_TRUE(nvgAggeGetTextureData(ctx, b) == NULL);
+  ASSERT_EQ(nvgAggeGetTextureData(ctx, c), pixels[2]);
+  b = nvgCreateImageRaw(ctx, 8, 8, NVG_TEXTURE_RGBA, NVG_IMAGE_NEAREST, pixels[1]);
+  ASSERT_EQ(nvgAggeGetTextureBytes(ctx), 3u * 8 * 8 * 4);
+  nvgEndFrame(ctx);
+
+  /*超出预算时回收之前的帧中绘制的纹理，当前帧绘制的纹理保留*/
+  nvgAggeSetTextureBudget(ctx, 2 * 8 * 8 * 4, on_evict, &info);
+  nvgBeginFrame(ctx, VG_W, VG_H, 1);
+  fill_image(ctx, a);
+  fill_image(ctx, c);
+  nvgEndFrame(ctx);
+  ASSERT_EQ(info.count, 1u);
+  ASSERT_EQ(info.data, pixels[1]);
+  ASSERT_TRUE(nvgAggeGetTextureData(ctx, b) == NULL);
+  ASSERT_EQ(nvgAggeGetTextureData(ctx, a), pixels[0]);
+  ASSERT_EQ(nvgAggeGetTextureData(ctx, c), pixels[2]);
+  ASSERT_EQ(nvgAggeGetTextureBytes(ctx), 2u * 8 * 8 * 4);
+
+  /*在预算之内不回收*/
+  nvgBeginFrame(ctx, VG_W, VG_H, 1);
+  nvgEndFrame(ctx);
+  ASSERT_EQ(info.count, 1u);
+
+  nvgDeleteAGGE(ctx);
+  TKMEM_FREE(buff);
+}
+
+static NVGcontext* draw_bitmap(vgcanvas_t* vg, bitmap_t* img) {
+  rect_t r = rect_init(0, 0, VG_W, VG_H);
+
+  vgcanvas_begin_frame(vg, &r);
+  vgcanvas_draw_image(vg, img, 0, 0, img->w, img->h, 0, 0, img->w, img->h);
+  vgcanvas_end_frame(vg);
+
+  return (NVGcontext*)(img->specific_ctx);
+}
+
+TEST(VGCanvas, agge_texture_owner) {
+  uint32_t* buff1 = TKMEM_ZALLOCN(uint32_t, VG_W * VG_H);
+  uint32_t* buff2 = TKMEM_ZALLOCN(uint32_t, VG_W * VG_H);
+  vgcanvas_t* vg1 = vgcanvas_create(VG_W, VG_H, VG_W * 4, BITMAP_FMT_BGRA8888, buff1);
+  vgcanvas_t* vg2 = vgcanvas_create(VG_W, VG_H, VG_W * 4, BITMAP_FMT_BGRA8888, buff2);
+  bitmap_t* img = bitmap_create_ex(8, 8, 0, BITMAP_FMT_RGBA8888);
+  NVGcontext* ctx1 = draw_bitmap(vg1, img);
+  NVGcontext* ctx2 = NULL;
+
+  ASSERT_TRUE(ctx1 != NULL);
+  ASSERT_EQ(nvgAggeGetTextureBytes(ctx1), 8u * 8 * 4);
+
+  /*换到另外一个canvas绘制时，释放之前的canvas中的纹理*/
+  ctx2 = draw_bitmap(vg2, img);
+  ASSERT_TRUE(ctx2 != NULL && ctx2 != ctx1);
+  ASSERT_EQ(nvgAggeGetTextureBytes(ctx1), 0u);
+  ASSERT_EQ(nvgAggeGetTextureBytes(ctx2), 8u * 8 * 4);
+
+  /*纹理随图片一起释放*/
+  bitmap_destroy(img);
+  ASSERT_EQ(nvgAggeGetTextureBytes(ctx2), 0u);
+
+  vgcanvas_destroy(vg1);
+  vgcanvas_destroy(vg2);
+  TKMEM_FREE(buff1);
+  TKMEM_FREE(buff2);
+}
+
+/*改用查找表之前逐个像素计算的渐变颜色*/
+static agge::pixel32_rgba gradient_color(agge::pixel32_rgba sc, agge::pixel32_rgba ec,
+                                         float factor) {
+  agge::pixel32_rgba c = sc;
+
+  if (factor >= 1.0f) {
+    c = ec;
+  } else if (factor > 0) {
+    c.r = sc.r + (ec.r - sc.r) * factor;
+    c.g = sc.g + (ec.g - sc.g) * factor;
+    c.b = sc.b + (ec.b - sc.b) * factor;
+    c.a = sc.a + (ec.a - sc.a) * factor;
+  }
+
+  return c;
+}
+
+/*查找表的颜色与逐个像素计算的颜色(包括透明度)相差不超过1，混合后不超过2*/
+static bool color_near(const agge::pixel32_bgra& p, const agge::pixel32_bgra& e) {
+  return tk_abs(p.r - e.r) <= 2 && tk_abs(p.g - e.g) <= 2 && tk_abs(p.b - e.b) <= 2 &&
+         p.a == e.a;
+}
+
+TEST(VGCanvas, agge_gradients) {
+  agge::gradient_lut_cache<2> cache;
+  agge::pixel32_rgba sc(0xff, 0x10, 0, 0xff);
+  agge::pixel32_rgba ec(0, 0x80, 0xf0, 0x60);
+  const agge::gradient_lut& lut = cache.get(sc, ec);
+  agge::blender_linear_gradient<agge::pixel32_bgra> linear(10, 0, 50, 0, lut);
+  agge::blender_linear_gradient<agge::pixel32_bgra> diagonal(-20, -10, 60, 50, lut);
+  agge::blender_radial_gradient<agge::pixel32_bgra> radial(32, 20, 5, 25, lut);
+  agge::pixel32_bgra pixels[VG_W];
+  uint8_t covers[VG_W];
+
+  /*相同的颜色共用一个查找表，只保留最近使用的两个*/
+  ASSERT_EQ(&cache.get(sc, ec), &lut);
+  ASSERT_NE(&cache.get(ec, sc), &lut);
+  ASSERT_EQ(&cache.get(sc, ec), &lut);
+  cache.get(sc, sc);
+  ASSERT_EQ(&cache.get(sc, ec), &lut);
+  ASSERT_EQ(lut[0].r, sc.r);
+  ASSERT_EQ(lut[255].b, ec.b);
+
+  for (int i = 0; i < VG_W; i++) {
+    covers[i] = (i * 37) & 0xff;
+  }
+
+  /*32位像素一次混合两个通道，结果与pixel_blend完全相同*/
+  for (int j = 0; j < 4; j++) {
+    uint8_t indices[VG_W];
+    agge::pixel32_bgra expected[VG_W];
+
+    for (int i = 0; i < VG_W; i++) {
+      indices[i] = (i * 5 + j * 64) & 0xff;
+      pixels[i] = agge::pixel32_bgra(i * 3, 0x40 + j, 0xff - i, i);
+      expected[i] = pixels[i];
+    }
+    agge::gradient_span_blender<agge::pixel32_bgra>::blend(pixels, lut, indices, covers, VG_W);
+    agge::gradient_span_blender<agge::pixel32_bgra, false>::blend(expected, lut, indices, covers,
+                                                                  VG_W);
+    ASSERT_EQ(memcmp(pixels, expected, sizeof(pixels)), 0);
+  }
+
+  for (int y = 0; y < 40; y += 3) {
+    for (int k = 0; k < 3; k++) {
+      for (int i = 0; i < VG_W; i++) {
+        pixels[i] = agge::pixel32_bgra(i * 3, 0x40, 0xff - i, 0x7f);
+      }
+
+      if (k == 0) {
+        linear(pixels, 0, y, VG_W, covers);
+      } else if (k == 1) {
+        diagonal(pixels, 0, y, VG_W, covers);
+      } else {
+        radial(pixels, 0, y, VG_W, covers);
+      }
+
+      for (int x = 0; x < VG_W; x++) {
+        float factor = 0;
+        agge::pixel32_bgra e(x * 3, 0x40, 0xff - x, 0x7f);
+
+        if (k == 0) {
+          factor = (x - 10) / 40.0f;
+        } else if (k == 1) {
+          factor = ((x + 20) * 80.0f + (y + 10) * 60.0f) / (80.0f * 80 + 60 * 60);
+          factor = (x > 60 || y > 50) ? 1 : factor;
+        } else {
+          factor = (sqrt((x - 32) * (x - 32) + (y - 20) * (y - 20)) - 5) / 20;
+        }
+
+        agge::pixel32_rgba c = gradient_color(sc, ec, factor);
+        agge::pixel_blend<agge::pixel32_bgra, agge::pixel32_rgba>(e, c, (covers[x] * c.a) >> 8);
+        ASSERT_TRUE(color_near(pixels[x], e)) << "k=" << k << " x=" << x << " y=" << y;
+      }
+    }
+  }
+}
+#endif /*WITH_NANOVG_AGGE*/
+
+#define PAR_W 200
+#define PAR_H 160
+
+static void draw_shapes(vgcanvas_t* vg, uint32_t* buff) {
+  rect_t r = rect_init(0, 0, PAR_W, PAR_H);
+
+  memset(buff, 0xff, PAR_W * PAR_H * 4);
+  vgcanvas_begin_frame(vg, &r);
+
+  vgcanvas_set_fill_linear_gradient(vg, 0, 0, PAR_W, PAR_H, color_init(0xff, 0, 0, 0xff),
+                                    color_init(0, 0, 0xff, 0x80));
+  vgcanvas_begin_path(vg);
+  vgcanvas_rect(vg, 0, 0, PAR_W, PAR_H);
+  vgcanvas_fill(vg);
+
+  vgcanvas_set_fill_radial_gradient(vg, 100, 80, 10, 70, color_init(0xff, 0xff, 0, 0xff),
+                                    color_init(0, 0xff, 0, 0x40));
+  vgcanvas_begin_path(vg);
+  vgcanvas_ellipse(vg, 100, 80, 90, 70);
+  vgcanvas_fill(vg);
+
+  vgcanvas_set_fill_color(vg, color_init(0x20, 0x40, 0x80, 0xc0));
+  vgcanvas_begin_path(vg);
+  vgcanvas_move_to(vg, 3.5f, 2.25f);
+  vgcanvas_line_to(vg, 190.3f, 40.7f);
+  vgcanvas_line_to(vg, 90.1f, 157.9f);
+  vgcanvas_close_path(vg);
+  vgcanvas_fill(vg);
+
+  vgcanvas_set_line_width(vg, 5);
+  vgcanvas_set_stroke_color(vg, color_init(0, 0x80, 0, 0xff));
+  vgcanvas_begin_path(vg);
+  vgcanvas_move_to(vg, 5, 5);
+  vgcanvas_bezier_to(vg, 20, 150, 180, 10, 195, 155);
+  vgcanvas_arc(vg, 100, 80, 60, 0, 3.14, TRUE);
+  vgcanvas_stroke(vg);
+
+  vgcanvas_end_frame(vg);
+}
+
+/*agge后端在支持线程的平台上实现多线程渲染，其它后端返回RET_NOT_IMPL，仍然单线程渲染*/
+#if defined(WITH_NANOVG_AGGE) && (defined(HAS_PTHREAD) || defined(WIN32))
+#define RENDER_THREADS_RET RET_OK
+#else
+#define RENDER_THREADS_RET RET_NOT_IMPL
+#endif /*WITH_NANOVG_AGGE && (HAS_PTHREAD || WIN32)*/
+
+TEST(VGCanvas, render_threads) {
+  uint32_t* buff = TKMEM_ZALLOCN(uint32_t, PAR_W * PAR_H);
+  uint32_t* expected = TKMEM_ZALLOCN(uint32_t, PAR_W * PAR_H);
+  vgcanvas_t* vg = vgcanvas_create(PAR_W, PAR_H, PAR_W * 4, BITMAP_FMT_BGRA8888, buff);
+
+  draw_shapes(vg, buff);
+  memcpy(expected, buff, PAR_W * PAR_H * 4);
+
+  /*多线程渲染的结果与单线程完全一致*/
+  ASSERT_EQ(vgcanvas_set_render_threads(vg, 3), RENDER_THREADS_RET);
+  draw_shapes(vg, buff);
+  ASSERT_EQ(memcmp(buff, expected, PAR_W * PAR_H * 4), 0);
+
+  ASSERT_EQ(vgcanvas_set_render_threads(vg, 4), RENDER_THREADS_RET);
+  draw_shapes(vg, buff);
+  ASSERT_EQ(memcmp(buff, expected, PAR_W * PAR_H * 4), 0);
+
+  ASSERT_EQ(vgcanvas_set_render_threads(vg, 1), RENDER_THREADS_RET);
+  draw_shapes(vg, buff);
+  ASSERT_EQ(memcmp(buff, expected, PAR_W * PAR_H * 4), 0);
+
+  ASSERT_EQ(vgcanvas_set_render_threads(vg, 2), RENDER_THREADS_RET);
+  vgcanvas_destroy(vg);
+  TKMEM_FREE(buff);
+  TKMEM_FREE(expected);
+}
@@ -43,3 +43,56 @@ TEST(AnimatorManager, basic) {
   widget_destroy(WIDGET(image));
   ASSERT_EQ(widget_animator_manager_count(am), 0);
 }
+
+TEST(AnimatorManager, tick) {
+  widget_animator_manager_t* old = widget_animator_manager();
+  widget_animator_manager_t* am = widget_animator_manager_create();
+  ASSERT_EQ(widget_animator_manager_set(am), RET_OK);
+
+  widget_t* widget = image_create(NULL, 0, 0, 100, 30);
+  widget_animator_t* wa = widget_animator_rotation_create(widget, 1000, 0, EASING_LINEAR);
+  widget_animator_rotation_set_params(wa, 0, 100);
+
+  ASSERT_EQ(am->frame_period, 1000 / TK_MAX_FPS);
+  ASSERT_EQ(widget_animator_manager_set_frame_period(am, 10), RET_OK);
+  ASSERT_EQ(widget_animator_manager_is_animating(am), FALSE);
+
+  ASSERT_EQ(widget_animator_manager_tick(am, 1000), RET_OK);
+  ASSERT_EQ(widget_animator_start(wa), RET_OK);
+  ASSERT_EQ(widget_animator_manager_is_animating(am), TRUE);
+
+  /*动画在两帧之间开始，不统计为丢帧*/
+  ASSERT_EQ(widget_animator_manager_tick(am, 1010), RET_OK);
+  ASSERT_FLOAT_EQ(IMAGE_BASE(widget)->rotation, 1);
+  ASSERT_EQ(am->frames, 0);
+
+  /*同一帧只更新一次*/
+  ASSERT_EQ(widget_animator_manager_tick(am, 1010), RET_OK);
+  ASSERT_FLOAT_EQ(IMAGE_BASE(widget)->rotation, 1);
+
+  ASSERT_EQ(widget_animator_manager_tick(am, 1020), RET_OK);
+  ASSERT_FLOAT_EQ(IMAGE_BASE(widget)->rotation, 2);
+  ASSERT_EQ(am->frames, 1);
+  ASSERT_EQ(am->dropped_frames, 0);
+
+  ASSERT_EQ(widget_animator_manager_tick(am, 1050), RET_OK);
+  ASSERT_FLOAT_EQ(IMAGE_BASE(widget)->rotation, 5);
+  ASSERT_EQ(am->frames, 2);
+  ASSERT_EQ(am->dropped_frames, 2);
+
+  ASSERT_EQ(widget_animator_manager_tick(am, 2010), RET_OK);
+  ASSERT_FLOAT_EQ(IMAGE_BASE(widget)->rotation, 100);
+  ASSERT_EQ(widget_animator_manager_count(am), 0);
+  ASSERT_EQ(widget_animator_manager_is_animating(am), FALSE);
+  ASSERT_EQ(am->frames, 3);
+  ASSERT_EQ(am->dropped_frames, 2 + 95);
+
+  /*动画结束之后的空闲时间不统计为丢帧*/
+  ASSERT_EQ(widget_animator_manager_tick(am, 3000), RET_OK);
+  ASSERT_EQ(am->frames, 3);
+  ASSERT_EQ(am->dropped_frames, 2 + 95);
+
+  widget_destroy(widget);
+  widget_animator_manager_set(old);
+  widget_animator_manager_destroy(am);
+}
@@ -1,6 +1,8 @@
 ﻿#include "widgets/window.h"
 #include "base/canvas.h"
 #include "base/widget.h"
+#include "base/window_manager.h"
+#include "lcd/lcd_mem_bgra8888.h"
 #include "font_dummy.h"
 #include "lcd_log.h"
 #include "gtest/gtest.h"
@@ -109,6 +111,69 @@ TEST(Window, image_manager) {
   widget_destroy(w);
 }
 
+static ret_t on_window_paint(void* ctx, event_t* e) {
+  int32_t* count = (int32_t*)ctx;
+  *count = *count + 1;
+
+  return RET_OK;
+}
+
+TEST(Window, snapshot) {
+  bitmap_t img1;
+  bitmap_t img2;
+  canvas_t canvas;
+  int32_t paints = 0;
+  const uint8_t* data = NULL;
+  framebuffer_object_t fbo;
+  font_manager_t font_manager;
+  widget_t* wm = window_manager();
+  wh_t save_w = wm->w;
+  wh_t save_h = wm->h;
+  canvas_t* save_canvas = WINDOW_MANAGER(wm)->canvas;
+  lcd_t* lcd = lcd_mem_bgra8888_create(64, 48, TRUE);
+  widget_t* prev = NULL;
+  widget_t* curr = NULL;
+
+  widget_resize(wm, 64, 48);
+  prev = window_create(NULL, 0, 0, 0, 0);
+  curr = window_create(NULL, 0, 0, 0, 0);
+
+  font_manager_init(&font_manager, NULL);
+  WINDOW_MANAGER(wm)->canvas = canvas_init(&canvas, lcd, &font_manager);
+  widget_on(prev, EVT_BEFORE_PAINT, on_window_paint, &paints);
+
+  ASSERT_EQ(window_manager_snap_prev_window(wm, prev, &img1, &fbo, FALSE), RET_OK);
+  ASSERT_EQ(paints, 1);
+  data = img1.data;
+  bitmap_destroy(&img1);
+
+  /*窗口没有变化，直接使用缓存的快照*/
+  ASSERT_EQ(window_manager_snap_prev_window(wm, prev, &img1, &fbo, FALSE), RET_OK);
+  ASSERT_EQ(paints, 1);
+  ASSERT_EQ(img1.data, data);
+
+  /*正在使用的快照不会被其它窗口使用*/
+  ASSERT_EQ(window_manager_snap_curr_window(wm, curr, &img2, &fbo, FALSE), RET_OK);
+  ASSERT_NE(img2.data, img1.data);
+  bitmap_destroy(&img1);
+  bitmap_destroy(&img2);
+
+  /*窗口变化之后重新绘制，但是继续使用之前的内存*/
+  widget_invalidate(prev, NULL);
+  ASSERT_EQ(window_manager_snap_prev_window(wm, prev, &img1, &fbo, FALSE), RET_OK);
+  ASSERT_EQ(paints, 2);
+  ASSERT_TRUE(img1.data == data || img1.data == img2.data);
+  bitmap_destroy(&img1);
+
+  widget_off_by_func(prev, EVT_BEFORE_PAINT, on_window_paint, &paints);
+  window_manager_close_window_force(wm, curr);
+  window_manager_close_window_force(wm, prev);
+  WINDOW_MANAGER(wm)->canvas = save_canvas;
+  widget_resize(wm, save_w, save_h);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
+
 TEST(Window, assets_manager) {
   widget_t* w = window_create(NULL, 10, 20, 30, 40);
 
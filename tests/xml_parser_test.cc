@@ -89,3 +89,47 @@ TEST(XmlParser, basic) {
 
   xml_parser_destroy(p);
 }
+
+static void xml_gen_on_start_attrs(XmlBuilder* thiz, const char* tag, const char** attrs) {
+  s_log += "<" + string(tag);
+  for (uint32_t i = 0; attrs[i] != NULL; i += 2) {
+    s_log += " " + string(attrs[i]) + "=\"" + string(attrs[i + 1]) + "\"";
+  }
+  s_log += ">";
+
+  return;
+}
+
+static void test_insitu(XmlParser* p, const char* str, const char* expected) {
+  string xml = str;
+
+  s_log = "";
+  xml_parser_parse_insitu(p, (char*)xml.c_str(), xml.size());
+  ASSERT_EQ(s_log, expected);
+  /*解析完成后文档的内容保持不变*/
+  ASSERT_EQ(xml, str);
+}
+
+TEST(XmlParser, insitu) {
+  XmlBuilder b;
+  XmlParser* p = xml_parser_create();
+  memset(&b, 0x00, sizeof(b));
+  xml_parser_set_builder(p, builder_init(b));
+  b.on_start = xml_gen_on_start_attrs;
+
+  test_insitu(p, "<a></a>", "<a></a>");
+  test_insitu(p, "<a/>", "<a></a>");
+  test_insitu(p, "<a />", "<a></a>");
+  test_insitu(p, "<a><b>test</b></a>", "<a><b>test</b></a>");
+  test_insitu(p, "<a x=\"1\" y='2'/>", "<a x=\"1\" y=\"2\"></a>");
+  test_insitu(p, "<a  x = \" 1 \"\ny=\"\"></a >", "<a x=\"1\" y=\"\"></a>");
+  test_insitu(p, "<a text=\"&lt;b&gt;\"><b c=\"3\">t</b></a>",
+              "<a text=\"&lt;b&gt;\"><b c=\"3\">t</b></a>");
+  test_insitu(p, "<?xml version=\"1.0\"?><a x=\"1\"/>", "<a x=\"1\"></a>");
+  test_insitu(p, "<a><![CDATA[<abc>]]></a>", "<a><abc></a>");
+
+  /*和复制模式的结果一致*/
+  test_str_ex(p, "<a  x = \" 1 \"\ny=\"\"></a >", "<a x=\"1\" y=\"\"></a>");
+
+  xml_parser_destroy(p);
+}
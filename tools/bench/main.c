@@ -0,0 +1,909 @@
+/**
+ * File:   main.c
+ * Author: AWTK Develop Team
+ * Brief:  headless benchmark for paint, layout and window open
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#include "awtk.h"
+#include "tkc/fs.h"
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "tkc/time_now.h"
+#include "tkc/perf_trace.h"
+#include "base/idle.h"
+#include "base/timer.h"
+#include "base/layout.h"
+#include "base/system_info.h"
+#include "base/window_manager.h"
+#include "base/widget_animator_manager.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "font_gen/font_gen.h"
+#include "font_loader/font_loader_sdf.h"
+#include "font_loader/font_loader_bitmap.h"
+#include "input_methods/input_method_null.h"
+#include "ext_widgets/ext_widgets.h"
+#include "slide_view/slide_view.h"
+#include "scroll_view/scroll_view.h"
+#include "mledit/mledit.h"
+#include "rich_text/rich_text.h"
+#include "guage/guage_pointer.h"
+#include "svg_image/svg_image.h"
+#include "progress_circle/progress_circle.h"
+#include "demos/assets.h"
+
+/*模拟时钟每帧前进的时间(毫秒)*/
+#define BENCH_FRAME_TIME 16
+
+typedef enum _bench_phase_t {
+  BENCH_PHASE_TIMER = 0,
+  BENCH_PHASE_ACTION,
+  BENCH_PHASE_IDLE,
+  BENCH_PHASE_PAINT,
+  BENCH_PHASE_NR
+} bench_phase_t;
+
+static const char* s_phase_names[BENCH_PHASE_NR] = {"timer", "action", "idle", "paint"};
+
+typedef struct _bench_t bench_t;
+typedef ret_t (*bench_prepare_t)(bench_t* b);
+typedef ret_t (*bench_action_t)(bench_t* b, uint32_t frame);
+typedef ret_t (*bench_paint_t)(bench_t* b, uint32_t frame);
+typedef ret_t (*bench_cleanup_t)(bench_t* b);
+
+typedef struct _bench_scenario_t {
+  const char* name;
+  bench_prepare_t prepare;
+  bench_action_t action;
+  bench_paint_t paint;
+  bench_cleanup_t cleanup;
+} bench_scenario_t;
+
+struct _bench_t {
+  lcd_t* lcd;
+  uint8_t* online_fb;
+  uint8_t* offline_fb;
+  canvas_t canvas;
+  widget_t* wm;
+  widget_t* win;
+  widget_t* target;
+  uint32_t frames;
+  const char* font_name;
+  uint8_t* font_buff;
+  bitmap_t image;
+  image_quality_t image_quality;
+  uint32_t render_threads;
+
+  /*stats of current scenario*/
+  uint64_t prepare_us;
+  uint64_t phases_us[BENCH_PHASE_NR];
+  uint64_t max_frame_us;
+  uint64_t pixels;
+  uint32_t paint_frames;
+  uint32_t alloc_times;
+  layout_stat_t layout;
+  int32_t blocks;
+  uint32_t bytes;
+};
+
+static uint32_t s_now_ms = 0;
+static uint32_t bench_now_ms(void) {
+  return s_now_ms;
+}
+
+static ret_t bench_close_window(bench_t* b) {
+  if (b->win != NULL) {
+    window_manager_close_window_force(b->wm, b->win);
+    b->win = NULL;
+    b->target = NULL;
+  }
+  idle_dispatch();
+
+  return RET_OK;
+}
+
+static ret_t bench_open_window(bench_t* b, const char* name, const char* target_type) {
+  bench_close_window(b);
+
+  b->win = window_open(name);
+  return_value_if_fail(b->win != NULL, RET_NOT_FOUND);
+
+  if (target_type != NULL) {
+    b->target = widget_lookup_by_type(b->win, target_type, TRUE);
+    return_value_if_fail(b->target != NULL, RET_NOT_FOUND);
+  }
+
+  return RET_OK;
+}
+
+/*open_window: 每帧关闭当前窗口并打开下一个窗口，测量加载、布局和首帧绘制。*/
+static const char* s_open_window_names[] = {"basic",       "button",       "edit",
+                                            "label",       "list_view_m",  "slide_view_h",
+                                            "rich_text",   "progress_circle"};
+
+static ret_t bench_open_window_action(bench_t* b, uint32_t frame) {
+  const char* name = s_open_window_names[frame % ARRAY_SIZE(s_open_window_names)];
+
+  return bench_open_window(b, name, NULL);
+}
+
+/*list_view_scroll: 在list_view中来回滚动。*/
+static ret_t bench_list_view_prepare(bench_t* b) {
+  return bench_open_window(b, "list_view_m", WIDGET_TYPE_SCROLL_VIEW);
+}
+
+static ret_t bench_list_view_action(bench_t* b, uint32_t frame) {
+  scroll_view_t* scroll_view = SCROLL_VIEW(b->target);
+  int32_t range = tk_max(scroll_view->virtual_h - b->target->h, 1);
+  int32_t yoffset = (frame * 10) % (2 * range);
+
+  if (yoffset > range) {
+    yoffset = 2 * range - yoffset;
+  }
+
+  return scroll_view_set_offset(b->target, 0, yoffset);
+}
+
+/*slide_view: 自动播放，由模拟时钟驱动滚动动画。*/
+static ret_t bench_slide_view_prepare(bench_t* b) {
+  return_value_if_fail(bench_open_window(b, "slide_view_h", WIDGET_TYPE_SLIDE_VIEW) == RET_OK,
+                       RET_FAIL);
+
+  return slide_view_set_auto_play(b->target, 500);
+}
+
+/*edit_typing: 向edit提交字符，每32个字符清空一次。*/
+static ret_t bench_edit_prepare(bench_t* b) {
+  return_value_if_fail(bench_open_window(b, "edit", WIDGET_TYPE_EDIT) == RET_OK, RET_FAIL);
+
+  return widget_set_focused(b->target, TRUE);
+}
+
+static ret_t bench_edit_action(bench_t* b, uint32_t frame) {
+  im_commit_event_t e;
+  bool_t replace = (frame % 32) == 0;
+
+  return widget_dispatch(b->target, im_commit_event_init(&e, "8", replace));
+}
+
+/*mledit_typing: 在一段约20k字符的多行日志中间输入字符，每16个字符输入一个换行。*/
+#define BENCH_MLEDIT_LINES 300
+
+static ret_t bench_mledit_prepare(bench_t* b) {
+  str_t text;
+  uint32_t i = 0;
+  char line[64];
+
+  bench_close_window(b);
+  b->win = window_create(NULL, 0, 0, b->wm->w, b->wm->h);
+  return_value_if_fail(b->win != NULL, RET_OOM);
+  b->target = mledit_create(b->win, 0, 0, b->wm->w, b->wm->h);
+  return_value_if_fail(b->target != NULL, RET_OOM);
+
+  str_init(&text, BENCH_MLEDIT_LINES * sizeof(line));
+  for (i = 0; i < BENCH_MLEDIT_LINES; i++) {
+    tk_snprintf(line, sizeof(line), "[%04u] The quick brown fox jumps over the lazy dog\n", i);
+    str_append(&text, line);
+  }
+  widget_set_text_utf8(b->target, text.str);
+  str_reset(&text);
+
+  widget_set_focused(b->target, TRUE);
+
+  return text_edit_set_cursor(MLEDIT(b->target)->model, 5 * strlen(line) + 20);
+}
+
+static ret_t bench_mledit_action(bench_t* b, uint32_t frame) {
+  im_commit_event_t e;
+  const char* str = (frame % 16) == 15 ? "\n" : "8";
+
+  return widget_dispatch(b->target, im_commit_event_init(&e, str, FALSE));
+}
+
+/*rich_text_reflow: 滚动一个很长的rich_text，每8帧在两个宽度之间切换，每32帧在末尾追加一段文本。*/
+#define BENCH_RICH_TEXT_PARAS 60
+#define BENCH_RICH_TEXT_H 6000
+
+static ret_t bench_rich_text_set_text(bench_t* b, uint32_t paras) {
+  str_t text;
+  uint32_t i = 0;
+  char para[256];
+
+  /*每10个段落放在一个font中(XML解析时会去掉文本首尾的换行符，段落只在文本节点内部)。*/
+  str_init(&text, paras * sizeof(para));
+  for (i = 0; i < paras; i++) {
+    if ((i % 10) == 0) {
+      tk_snprintf(para, sizeof(para), "%s<font size=\"%u\">", i > 0 ? "</font>" : "",
+                  ((i / 10) % 2) ? 20 : 16);
+      str_append(&text, para);
+    }
+    tk_snprintf(para, sizeof(para),
+                "%u. The quick brown fox jumps over the lazy dog. Pack my box with five dozen "
+                "liquor jugs, how vexingly quick daft zebras jump!\n",
+                i);
+    str_append(&text, para);
+  }
+  str_append(&text, "</font>");
+  rich_text_set_text(b->target, text.str);
+  str_reset(&text);
+
+  return widget_invalidate(b->target, NULL);
+}
+
+static ret_t bench_rich_text_prepare(bench_t* b) {
+  bench_close_window(b);
+  b->win = window_create(NULL, 0, 0, b->wm->w, b->wm->h);
+  return_value_if_fail(b->win != NULL, RET_OOM);
+  b->target = rich_text_create(b->win, 0, 0, b->wm->w, BENCH_RICH_TEXT_H);
+  return_value_if_fail(b->target != NULL, RET_OOM);
+
+  return bench_rich_text_set_text(b, BENCH_RICH_TEXT_PARAS);
+}
+
+static ret_t bench_rich_text_action(bench_t* b, uint32_t frame) {
+  int32_t range = BENCH_RICH_TEXT_H - b->wm->h;
+  int32_t w = ((frame / 8) % 2) ? b->wm->w - 40 : b->wm->w;
+
+  if ((frame % 32) == 31) {
+    bench_rich_text_set_text(b, BENCH_RICH_TEXT_PARAS + (frame + 1) / 32);
+  }
+
+  widget_move_resize(b->target, 0, -(int32_t)((frame * 10) % range), w, BENCH_RICH_TEXT_H);
+
+  return widget_invalidate(b->win, NULL);
+}
+
+/*image_rotate: 每帧旋转几个图片控件和使用图片的仪表指针。*/
+#define BENCH_ROTATE_NR 4
+
+static ret_t bench_image_rotate_prepare(bench_t* b) {
+  uint32_t i = 0;
+
+  bench_close_window(b);
+  b->win = window_create(NULL, 0, 0, b->wm->w, b->wm->h);
+  return_value_if_fail(b->win != NULL, RET_OOM);
+
+  for (i = 0; i < BENCH_ROTATE_NR; i++) {
+    widget_t* image = image_create(b->win, 20 + i * 190, 20, 160, 160);
+    widget_t* pointer = guage_pointer_create(b->win, 88 + i * 190, 240, 24, 140);
+
+    image_set_image(image, "earth");
+    guage_pointer_set_image(pointer, "guage_pointer");
+  }
+
+  return RET_OK;
+}
+
+static ret_t bench_image_rotate_action(bench_t* b, uint32_t frame) {
+  WIDGET_FOR_EACH_CHILD_BEGIN(b->win, iter, i)
+  int32_t angle = (frame * 3 + i * 20) % 360;
+
+  if (tk_str_eq(widget_get_type(iter), WIDGET_TYPE_IMAGE)) {
+    image_set_rotation(iter, TK_D2R(angle));
+  } else {
+    guage_pointer_set_angle(iter, angle);
+  }
+  WIDGET_FOR_EACH_CHILD_END();
+
+  return RET_OK;
+}
+
+/*progress_circle/svg_image: 每帧移动一组矢量图形控件(只有平移变化)，偶尔修改进度的值。*/
+#define BENCH_VECTOR_COLS 5
+#define BENCH_VECTOR_ROWS 3
+#define BENCH_VECTOR_SIZE 140
+
+static ret_t bench_vector_prepare(bench_t* b, bool_t svg) {
+  uint32_t i = 0;
+  static const char* s_svg_names[] = {"girl", "ball", "china"};
+
+  bench_close_window(b);
+  b->win = window_create(NULL, 0, 0, b->wm->w, b->wm->h);
+  return_value_if_fail(b->win != NULL, RET_OOM);
+  b->target = view_create(b->win, 0, 0, b->wm->w, b->wm->h);
+  return_value_if_fail(b->target != NULL, RET_OOM);
+
+  for (i = 0; i < BENCH_VECTOR_COLS * BENCH_VECTOR_ROWS; i++) {
+    xy_t x = 20 + (i % BENCH_VECTOR_COLS) * (BENCH_VECTOR_SIZE + 10);
+    xy_t y = 20 + (i / BENCH_VECTOR_COLS) * (BENCH_VECTOR_SIZE + 10);
+
+    if (svg) {
+      widget_t* image = svg_image_create(b->target, x, y, BENCH_VECTOR_SIZE, BENCH_VECTOR_SIZE);
+      image_set_image(image, s_svg_names[i % ARRAY_SIZE(s_svg_names)]);
+    } else {
+      widget_t* progress = progress_circle_create(b->target, x, y, BENCH_VECTOR_SIZE,
+                                                  BENCH_VECTOR_SIZE);
+      progress_circle_set_line_width(progress, 12);
+      progress_circle_set_value(progress, 10 + i * 6);
+      widget_set_prop_bool(progress, WIDGET_PROP_SHOW_TEXT, FALSE);
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t bench_progress_circle_prepare(bench_t* b) {
+  return bench_vector_prepare(b, FALSE);
+}
+
+static ret_t bench_svg_image_prepare(bench_t* b) {
+  return bench_vector_prepare(b, TRUE);
+}
+
+static ret_t bench_vector_action(bench_t* b, uint32_t frame) {
+  int32_t offset = (int32_t)(frame % 40) - 20;
+
+  widget_move(b->target, offset, offset / 2);
+  if ((frame % 30) == 0 && tk_str_eq(widget_get_type(widget_get_child(b->target, 0)),
+                                     WIDGET_TYPE_PROGRESS_CIRCLE)) {
+    WIDGET_FOR_EACH_CHILD_BEGIN(b->target, iter, i)
+    progress_circle_set_value(iter, (frame / 30 + i * 6) % 100);
+    WIDGET_FOR_EACH_CHILD_END();
+  }
+
+  return widget_invalidate(b->win, NULL);
+}
+
+/*text_blocks: 直接在canvas上绘制大段文本。*/
+#define BENCH_FONT_SIZE 18
+#define BENCH_FONT_NAME "bench_glyph"
+#define BENCH_FONT_BUFF_SIZE (512 * 1024)
+#define BENCH_SDF_FONT_SIZE 32
+static const wchar_t* s_bench_text = L"The quick brown fox jumps over the lazy dog 0123456789";
+
+static ret_t bench_text_blocks_prepare(bench_t* b) {
+  b->font_name = NULL;
+
+  return bench_close_window(b);
+}
+
+/*glyph_*: 用font_gen把缺省字体转换成指定格式的点阵字体，再绘制大段文本。bytes为字体数据的大小。*/
+static ret_t bench_glyph_prepare(bench_t* b, glyph_format_t format) {
+  str_t str;
+  font_t* font = NULL;
+  font_t* ttf = font_manager_get_font(font_manager(), NULL, BENCH_FONT_SIZE);
+  return_value_if_fail(ttf != NULL, RET_NOT_FOUND);
+
+  bench_close_window(b);
+  b->font_buff = TKMEM_ALLOC(BENCH_FONT_BUFF_SIZE);
+  return_value_if_fail(b->font_buff != NULL, RET_OOM);
+
+  str_init(&str, 0);
+  str_from_wstr(&str, s_bench_text);
+  if (format == GLYPH_FMT_SDF) {
+    b->bytes = font_gen_sdf_buff(ttf, BENCH_SDF_FONT_SIZE, FONT_GEN_SDF_SPREAD, str.str,
+                                 b->font_buff, BENCH_FONT_BUFF_SIZE);
+  } else {
+    b->bytes = font_gen_buff_ex(ttf, BENCH_FONT_SIZE, format, str.str, b->font_buff,
+                                BENCH_FONT_BUFF_SIZE);
+  }
+  str_reset(&str);
+  return_value_if_fail(b->bytes > 0, RET_FAIL);
+
+  if (format == GLYPH_FMT_SDF) {
+    font = font_sdf_create(BENCH_FONT_NAME, b->font_buff, b->bytes);
+  } else {
+    font = font_bitmap_create(BENCH_FONT_NAME, b->font_buff, b->bytes);
+  }
+  return_value_if_fail(font != NULL, RET_OOM);
+  font_manager_add_font(font_manager(), font);
+  b->font_name = BENCH_FONT_NAME;
+
+  return RET_OK;
+}
+
+static ret_t bench_glyph_a8_prepare(bench_t* b) {
+  return bench_glyph_prepare(b, GLYPH_FMT_ALPHA);
+}
+
+static ret_t bench_glyph_a4_prepare(bench_t* b) {
+  return bench_glyph_prepare(b, GLYPH_FMT_ALPHA4);
+}
+
+static ret_t bench_glyph_a2_prepare(bench_t* b) {
+  return bench_glyph_prepare(b, GLYPH_FMT_ALPHA2);
+}
+
+static ret_t bench_glyph_a1_prepare(bench_t* b) {
+  return bench_glyph_prepare(b, GLYPH_FMT_ALPHA1);
+}
+
+static ret_t bench_glyph_rle_prepare(bench_t* b) {
+  return bench_glyph_prepare(b, GLYPH_FMT_RLE);
+}
+
+/*font_zoom_*: 每帧用不同的字体大小绘制文本，模拟字体大小的动画。*/
+static ret_t bench_font_zoom_sdf_prepare(bench_t* b) {
+  return bench_glyph_prepare(b, GLYPH_FMT_SDF);
+}
+
+static ret_t bench_glyph_cleanup(bench_t* b) {
+  canvas_set_font(&(b->canvas), NULL, BENCH_FONT_SIZE);
+  font_manager_unload_font(font_manager(), BENCH_FONT_NAME, BENCH_FONT_SIZE);
+  TKMEM_FREE(b->font_buff);
+  b->font_name = NULL;
+
+  return RET_OK;
+}
+
+static ret_t bench_text_blocks_paint(bench_t* b, uint32_t frame) {
+  uint32_t i = 0;
+  canvas_t* c = &(b->canvas);
+  color_t bg = color_init(0xff, 0xff, 0xff, 0xff);
+  color_t fg = color_init(0x20, 0x20, 0x20, 0xff);
+  const wchar_t* text = s_bench_text;
+  uint32_t len = wcslen(text);
+
+  canvas_begin_frame(c, NULL, LCD_DRAW_NORMAL);
+  canvas_set_fill_color(c, bg);
+  canvas_fill_rect(c, 0, 0, b->lcd->w, b->lcd->h);
+  canvas_set_font(c, b->font_name, BENCH_FONT_SIZE);
+  canvas_set_text_color(c, fg);
+  for (i = 0; i * 20 < b->lcd->h; i++) {
+    canvas_draw_text(c, text, len, (frame + i) % 10, i * 20);
+  }
+  canvas_end_frame(c);
+
+  return RET_OK;
+}
+
+static ret_t bench_font_zoom_paint(bench_t* b, uint32_t frame) {
+  uint32_t y = 0;
+  canvas_t* c = &(b->canvas);
+  font_size_t font_size = 12 + (frame * 2) % 40;
+  color_t bg = color_init(0xff, 0xff, 0xff, 0xff);
+  color_t fg = color_init(0x20, 0x20, 0x20, 0xff);
+  uint32_t len = wcslen(s_bench_text);
+
+  canvas_begin_frame(c, NULL, LCD_DRAW_NORMAL);
+  canvas_set_fill_color(c, bg);
+  canvas_fill_rect(c, 0, 0, b->lcd->w, b->lcd->h);
+  canvas_set_font(c, b->font_name, font_size);
+  canvas_set_text_color(c, fg);
+  for (y = 0; y + font_size < b->lcd->h; y += font_size + 4) {
+    canvas_draw_text(c, s_bench_text, len, 0, y);
+  }
+  canvas_end_frame(c);
+
+  return RET_OK;
+}
+
+/*image_scale_*: 每帧把一张图片放大和缩小绘制多次，比较不同缩放质量的开销。*/
+#define BENCH_IMAGE_NAME "earth"
+
+static ret_t bench_image_scale_prepare(bench_t* b, image_quality_t quality) {
+  bench_close_window(b);
+  b->image_quality = quality;
+
+  return image_manager_get_bitmap(image_manager(), BENCH_IMAGE_NAME, &(b->image));
+}
+
+static ret_t bench_image_scale_nearest_prepare(bench_t* b) {
+  return bench_image_scale_prepare(b, IMAGE_QUALITY_NEAREST);
+}
+
+static ret_t bench_image_scale_smooth_prepare(bench_t* b) {
+  return bench_image_scale_prepare(b, IMAGE_QUALITY_SMOOTH);
+}
+
+static ret_t bench_image_scale_paint(bench_t* b, uint32_t frame) {
+  uint32_t i = 0;
+  canvas_t* c = &(b->canvas);
+  bitmap_t* img = &(b->image);
+  rect_t src = rect_init(0, 0, img->w, img->h);
+  color_t bg = color_init(0xff, 0xff, 0xff, 0xff);
+  uint32_t h = b->lcd->h;
+
+  canvas_begin_frame(c, NULL, LCD_DRAW_NORMAL);
+  canvas_set_fill_color(c, bg);
+  canvas_fill_rect(c, 0, 0, b->lcd->w, h);
+  canvas_set_image_quality(c, b->image_quality);
+  for (i = 0; i < 8; i++) {
+    /*目标大小在16到LCD的高度之间变化，同时覆盖缩小和放大。*/
+    uint32_t size = 16 + ((frame + i * 37) * 7) % (h - 16);
+    rect_t dst = rect_init((i * 97) % (b->lcd->w - size), 0, size, size);
+
+    canvas_draw_image(c, img, &src, &dst);
+  }
+  canvas_end_frame(c);
+
+  return RET_OK;
+}
+
+/*
+ * vg_fill/vg_stroke/vg_gradient: 每帧用vgcanvas绘制覆盖全屏的填充、描边和渐变
+ * (和3rd/nanovg/demos中的fill/stroke一样的图形，按屏幕大小放大)，用于比较光栅化使用的线程数。
+ */
+static vgcanvas_t* bench_vg_begin(bench_t* b, uint32_t frame) {
+  canvas_t* c = &(b->canvas);
+  vgcanvas_t* vg = canvas_get_vgcanvas(c);
+  float_t s = tk_min(b->lcd->w, b->lcd->h) / 400.0f;
+
+  canvas_begin_frame(c, NULL, LCD_DRAW_NORMAL);
+  canvas_set_fill_color(c, color_init(0xff, 0xff, 0xff, 0xff));
+  canvas_fill_rect(c, 0, 0, b->lcd->w, b->lcd->h);
+
+  vgcanvas_save(vg);
+  vgcanvas_translate(vg, frame % 8, 0);
+  vgcanvas_scale(vg, s, s);
+
+  return vg;
+}
+
+static ret_t bench_vg_end(bench_t* b, vgcanvas_t* vg) {
+  vgcanvas_restore(vg);
+  canvas_end_frame(&(b->canvas));
+
+  return RET_OK;
+}
+
+static ret_t bench_vg_fill_paint(bench_t* b, uint32_t frame) {
+  vgcanvas_t* vg = bench_vg_begin(b, frame);
+
+  vgcanvas_set_fill_color(vg, color_init(0xff, 0, 0, 0xff));
+  vgcanvas_begin_path(vg);
+  vgcanvas_move_to(vg, 10, 10);
+  vgcanvas_line_to(vg, 390, 40);
+  vgcanvas_line_to(vg, 200, 390);
+  vgcanvas_close_path(vg);
+  vgcanvas_fill(vg);
+
+  vgcanvas_set_fill_color(vg, color_init(0, 0, 0xff, 0x80));
+  vgcanvas_begin_path(vg);
+  vgcanvas_rect(vg, 128, 20, 100, 360);
+  vgcanvas_fill(vg);
+
+  vgcanvas_set_fill_color(vg, color_init(0, 0xff, 0, 0xc0));
+  vgcanvas_begin_path(vg);
+  vgcanvas_move_to(vg, 200, 200);
+  vgcanvas_arc(vg, 200, 200, 180, 0, 3.14, TRUE);
+  vgcanvas_close_path(vg);
+  vgcanvas_fill(vg);
+
+  return bench_vg_end(b, vg);
+}
+
+static ret_t bench_vg_stroke_paint(bench_t* b, uint32_t frame) {
+  vgcanvas_t* vg = bench_vg_begin(b, frame);
+
+  vgcanvas_set_line_width(vg, 8);
+  vgcanvas_set_stroke_color(vg, color_init(0xff, 0, 0, 0xff));
+  vgcanvas_begin_path(vg);
+  vgcanvas_move_to(vg, 0, 0);
+  vgcanvas_line_to(vg, 200, 390);
+  vgcanvas_line_to(vg, 400, 0);
+  vgcanvas_stroke(vg);
+
+  vgcanvas_set_line_width(vg, 12);
+  vgcanvas_begin_path(vg);
+  vgcanvas_rect(vg, 20, 20, 360, 360);
+  vgcanvas_stroke(vg);
+
+  vgcanvas_set_line_width(vg, 6);
+  vgcanvas_set_stroke_color(vg, color_init(0, 0xff, 0, 0xff));
+  vgcanvas_begin_path(vg);
+  vgcanvas_move_to(vg, 10, 10);
+  vgcanvas_bezier_to(vg, 40, 300, 300, 40, 390, 390);
+  vgcanvas_arc(vg, 200, 200, 150, 0, 3.14, TRUE);
+  vgcanvas_stroke(vg);
+
+  return bench_vg_end(b, vg);
+}
+
+static ret_t bench_vg_gradient_paint(bench_t* b, uint32_t frame) {
+  vgcanvas_t* vg = bench_vg_begin(b, frame);
+
+  vgcanvas_set_fill_linear_gradient(vg, 0, 0, 400, 400, color_init(0xff, 0, 0, 0xff),
+                                    color_init(0, 0, 0xff, 0xff));
+  vgcanvas_begin_path(vg);
+  vgcanvas_rect(vg, 0, 0, 400, 400);
+  vgcanvas_fill(vg);
+
+  vgcanvas_set_fill_radial_gradient(vg, 200, 200, 20, 180, color_init(0xff, 0xff, 0, 0xff),
+                                    color_init(0, 0xff, 0, 0x40));
+  vgcanvas_begin_path(vg);
+  vgcanvas_ellipse(vg, 200, 200, 180, 180);
+  vgcanvas_fill(vg);
+
+  return bench_vg_end(b, vg);
+}
+
+static const bench_scenario_t s_scenarios[] = {
+    {"open_window", NULL, bench_open_window_action, NULL, NULL},
+    {"list_view_scroll", bench_list_view_prepare, bench_list_view_action, NULL, NULL},
+    {"slide_view", bench_slide_view_prepare, NULL, NULL, NULL},
+    {"edit_typing", bench_edit_prepare, bench_edit_action, NULL, NULL},
+    {"mledit_typing", bench_mledit_prepare, bench_mledit_action, NULL, NULL},
+    {"rich_text_reflow", bench_rich_text_prepare, bench_rich_text_action, NULL, NULL},
+    {"image_rotate", bench_image_rotate_prepare, bench_image_rotate_action, NULL, NULL},
+    {"progress_circle", bench_progress_circle_prepare, bench_vector_action, NULL, NULL},
+    {"svg_image", bench_svg_image_prepare, bench_vector_action, NULL, NULL},
+    {"text_blocks", bench_text_blocks_prepare, NULL, bench_text_blocks_paint, NULL},
+    {"glyph_a8", bench_glyph_a8_prepare, NULL, bench_text_blocks_paint, bench_glyph_cleanup},
+    {"glyph_a4", bench_glyph_a4_prepare, NULL, bench_text_blocks_paint, bench_glyph_cleanup},
+    {"glyph_a2", bench_glyph_a2_prepare, NULL, bench_text_blocks_paint, bench_glyph_cleanup},
+    {"glyph_a1", bench_glyph_a1_prepare, NULL, bench_text_blocks_paint, bench_glyph_cleanup},
+    {"glyph_rle", bench_glyph_rle_prepare, NULL, bench_text_blocks_paint, bench_glyph_cleanup},
+    {"font_zoom_ttf", bench_text_blocks_prepare, NULL, bench_font_zoom_paint, NULL},
+    {"font_zoom_sdf", bench_font_zoom_sdf_prepare, NULL, bench_font_zoom_paint,
+     bench_glyph_cleanup},
+    {"image_scale_nearest", bench_image_scale_nearest_prepare, NULL, bench_image_scale_paint,
+     NULL},
+    {"image_scale_smooth", bench_image_scale_smooth_prepare, NULL, bench_image_scale_paint,
+     NULL},
+    {"vg_fill", bench_close_window, NULL, bench_vg_fill_paint, NULL},
+    {"vg_stroke", bench_close_window, NULL, bench_vg_stroke_paint, NULL},
+    {"vg_gradient", bench_close_window, NULL, bench_vg_gradient_paint, NULL}};
+
+static ret_t bench_run_frame(bench_t* b, const bench_scenario_t* s, uint32_t frame) {
+  uint32_t i = 0;
+  uint64_t t[BENCH_PHASE_NR + 1];
+  rect_t* dr = &(b->lcd->dirty_rect);
+
+  s_now_ms += BENCH_FRAME_TIME;
+  *dr = rect_init(0, 0, 0, 0);
+
+  t[BENCH_PHASE_TIMER] = time_now_us();
+  timer_dispatch();
+
+  t[BENCH_PHASE_ACTION] = time_now_us();
+  if (s->action != NULL) {
+    s->action(b, frame);
+  }
+
+  t[BENCH_PHASE_IDLE] = time_now_us();
+  idle_dispatch();
+  widget_animator_manager_tick(widget_animator_manager(), s_now_ms);
+
+  t[BENCH_PHASE_PAINT] = time_now_us();
+  if (s->paint != NULL) {
+    s->paint(b, frame);
+  } else {
+    window_manager_paint(b->wm, &(b->canvas));
+  }
+  t[BENCH_PHASE_NR] = time_now_us();
+
+  for (i = 0; i < BENCH_PHASE_NR; i++) {
+    b->phases_us[i] += t[i + 1] - t[i];
+  }
+
+  b->max_frame_us = tk_max(b->max_frame_us, t[BENCH_PHASE_NR] - t[BENCH_PHASE_TIMER]);
+  if (dr->w > 0 && dr->h > 0) {
+    b->pixels += (uint64_t)(dr->w) * (dr->h);
+    b->paint_frames++;
+  }
+
+  return RET_OK;
+}
+
+static ret_t bench_run_scenario(bench_t* b, const bench_scenario_t* s, str_t* json) {
+  char buff[256];
+  uint32_t i = 0;
+  uint64_t total = 0;
+  mem_stat_t st;
+  uint64_t start = 0;
+
+  memset(b->phases_us, 0x00, sizeof(b->phases_us));
+  b->max_frame_us = 0;
+  b->pixels = 0;
+  b->paint_frames = 0;
+  b->bytes = 0;
+
+  start = time_now_us();
+  if (s->prepare != NULL && s->prepare(b) != RET_OK) {
+    log_warn("%s: prepare failed\n", s->name);
+    if (s->cleanup != NULL) {
+      s->cleanup(b);
+    }
+    return RET_FAIL;
+  }
+  window_manager_paint(b->wm, &(b->canvas));
+  b->prepare_us = time_now_us() - start;
+
+  st = tk_mem_stat();
+  b->alloc_times = st.alloc_times;
+  b->blocks = st.used_block_nr;
+  widget_layout_stat_reset();
+
+  for (i = 0; i < b->frames; i++) {
+    bench_run_frame(b, s, i);
+  }
+
+  st = tk_mem_stat();
+  b->alloc_times = st.alloc_times - b->alloc_times;
+  b->blocks = (int32_t)(st.used_block_nr) - b->blocks;
+  b->layout = widget_layout_stat();
+
+  for (i = 0; i < BENCH_PHASE_NR; i++) {
+    total += b->phases_us[i];
+  }
+
+  tk_snprintf(buff, sizeof(buff),
+              "{\"name\":\"%s\",\"frames\":%u,\"prepare_us\":%llu,\"phases_us\":{", s->name,
+              b->frames, (unsigned long long)(b->prepare_us));
+  str_append(json, buff);
+  for (i = 0; i < BENCH_PHASE_NR; i++) {
+    tk_snprintf(buff, sizeof(buff), "%s\"%s\":%llu", i > 0 ? "," : "", s_phase_names[i],
+                (unsigned long long)(b->phases_us[i]));
+    str_append(json, buff);
+  }
+  tk_snprintf(buff, sizeof(buff),
+              "},\"total_us\":%llu,\"avg_frame_us\":%llu,\"max_frame_us\":%llu,"
+              "\"paint_frames\":%u,\"pixels\":%llu,\"allocs\":%u,\"blocks\":%d,\"bytes\":%u",
+              (unsigned long long)total, (unsigned long long)(total / b->frames),
+              (unsigned long long)(b->max_frame_us), b->paint_frames,
+              (unsigned long long)(b->pixels), b->alloc_times, b->blocks, b->bytes);
+  str_append(json, buff);
+  tk_snprintf(buff, sizeof(buff), ",\"layouts\":%u,\"layouts_skipped\":%u}",
+              b->layout.self_layouts + b->layout.children_layouts,
+              b->layout.self_skipped + b->layout.children_skipped);
+  str_append(json, buff);
+
+  printf("%-18s avg=%6lluus max=%6lluus pixels=%10llu allocs=%8u bytes=%u layouts=%u/frame\n",
+         s->name, (unsigned long long)(total / b->frames), (unsigned long long)(b->max_frame_us),
+         (unsigned long long)(b->pixels), b->alloc_times, b->bytes,
+         (b->layout.self_layouts + b->layout.children_layouts) / b->frames);
+
+  if (s->cleanup != NULL) {
+    s->cleanup(b);
+  }
+  bench_close_window(b);
+
+  return RET_OK;
+}
+
+static bool_t bench_is_selected(const char* name, int argc, char** argv, int first) {
+  int i = 0;
+
+  if (first >= argc) {
+    return TRUE;
+  }
+
+  for (i = first; i < argc; i++) {
+    if (tk_str_eq(argv[i], name)) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+static void show_usage(const char* app) {
+  printf("Usage: %s [-n frames] [-w width] [-h height] [-r app_root] [-o out.json]", app);
+  printf(" [-t trace.json] [-j render_threads] [scenario ...]\n");
+  printf("  scenarios: open_window list_view_scroll slide_view edit_typing mledit_typing\n");
+  printf("             rich_text_reflow image_rotate progress_circle svg_image text_blocks\n");
+  printf("             glyph_a8 glyph_a4 glyph_a2 glyph_a1 glyph_rle font_zoom_ttf font_zoom_sdf\n");
+  printf("             image_scale_nearest image_scale_smooth vg_fill vg_stroke vg_gradient\n");
+}
+
+int main(int argc, char** argv) {
+  str_t json;
+  bench_t bench;
+  uint32_t i = 0;
+  int first = 1;
+  wh_t w = 800;
+  wh_t h = 480;
+  const char* app_root = "./demos";
+  const char* out = "bench.json";
+  const char* trace = NULL;
+  bench_t* b = &bench;
+
+  memset(b, 0x00, sizeof(bench));
+  b->frames = 300;
+
+  while (first + 1 < argc && argv[first][0] == '-') {
+    const char* opt = argv[first];
+    const char* arg = argv[first + 1];
+
+    if (tk_str_eq(opt, "-n")) {
+      b->frames = tk_max(tk_atoi(arg), 1);
+    } else if (tk_str_eq(opt, "-w")) {
+      w = tk_atoi(arg);
+    } else if (tk_str_eq(opt, "-h")) {
+      h = tk_atoi(arg);
+    } else if (tk_str_eq(opt, "-r")) {
+      app_root = arg;
+    } else if (tk_str_eq(opt, "-o")) {
+      out = arg;
+    } else if (tk_str_eq(opt, "-t")) {
+      trace = arg;
+    } else if (tk_str_eq(opt, "-j")) {
+      b->render_threads = tk_atoi(arg);
+    } else {
+      show_usage(argv[0]);
+      return 0;
+    }
+    first += 2;
+  }
+
+  if (first < argc && argv[first][0] == '-') {
+    show_usage(argv[0]);
+    return 0;
+  }
+
+  TKMEM_INIT(8 * 1024 * 1024);
+  system_info_init(APP_SIMULATOR, "bench", app_root);
+  tk_init_internal();
+
+  /*用模拟时钟驱动定时器和控件动画，保证每次运行的结果可比较。*/
+  s_now_ms = time_now_ms();
+  timer_manager()->get_time = bench_now_ms;
+
+  /*软键盘以动画方式打开，会干扰测量，这里不使用软键盘。*/
+  input_method_destroy(input_method());
+  input_method_set(input_method_null_create());
+
+  assets_init();
+  tk_init_assets();
+  tk_ext_widgets_init();
+
+  if (trace != NULL) {
+    perf_trace_init(TK_PERF_TRACE_CAPACITY * 16);
+  }
+
+  /*和大多数设备一样使用双缓冲，flush的开销也计入绘制时间。*/
+  b->online_fb = TKMEM_ALLOC(w * h * 4);
+  b->offline_fb = TKMEM_ALLOC(w * h * 4);
+  b->lcd = lcd_mem_bgra8888_create_double_fb(w, h, b->online_fb, b->offline_fb);
+  canvas_init(&(b->canvas), b->lcd, font_manager());
+  b->wm = window_manager();
+  window_manager_resize(b->wm, w, h);
+  WINDOW_MANAGER(b->wm)->canvas = &(b->canvas);
+  if (b->render_threads > 1 &&
+      vgcanvas_set_render_threads(canvas_get_vgcanvas(&(b->canvas)), b->render_threads) != RET_OK) {
+    log_warn("render threads are not supported\n");
+  }
+
+  str_init(&json, 4096);
+  tk_snprintf(json.str, json.capacity,
+              "{\"width\":%d,\"height\":%d,\"frames\":%u,\"frame_time_ms\":%d,"
+              "\"render_threads\":%u,\"scenarios\":[",
+              (int)w, (int)h, b->frames, BENCH_FRAME_TIME, tk_max(b->render_threads, 1));
+  json.size = strlen(json.str);
+
+  for (i = 0; i < ARRAY_SIZE(s_scenarios); i++) {
+    const bench_scenario_t* s = s_scenarios + i;
+
+    if (bench_is_selected(s->name, argc, argv, first)) {
+      if (json.str[json.size - 1] == '}') {
+        str_append_char(&json, ',');
+      }
+      str_append(&json, "\n");
+      bench_run_scenario(b, s, &json);
+    }
+  }
+  str_append(&json, "\n]}\n");
+
+  if (file_write(out, json.str, json.size) != RET_OK) {
+    log_warn("write %s failed\n", out);
+  }
+  str_reset(&json);
+
+  if (trace != NULL) {
+    perf_trace_save(trace);
+    perf_trace_deinit();
+  }
+
+  canvas_reset(&(b->canvas));
+  lcd_destroy(b->lcd);
+  TKMEM_FREE(b->online_fb);
+  TKMEM_FREE(b->offline_fb);
+  tk_deinit_internal();
+
+  return 0;
+}
@@ -19,6 +19,7 @@
  *
  */
 
+#include <math.h>
 #include <wctype.h>
 #include "tkc/mem.h"
 #include "tkc/utf8.h"
@@ -27,6 +28,7 @@
 #include "font_gen/font_gen.h"
 #include "base/assets_manager.h"
 #include "font_loader/font_loader_stb.h"
+#include "font_loader/font_loader_sdf.h"
 #include "font_loader/font_loader_bitmap.h"
 
 #define MAX_CHARS 100 * 1024
@@ -40,8 +42,13 @@ static int char_cmp(const void* a, const void* b) {
 }
 
 ret_t font_gen(font_t* font, uint16_t font_size, const char* str, const char* output_filename) {
+  return font_gen_ex(font, font_size, GLYPH_FMT_ALPHA, str, output_filename);
+}
+
+ret_t font_gen_ex(font_t* font, uint16_t font_size, glyph_format_t format, const char* str,
+                  const char* output_filename) {
   uint8_t* buff = (uint8_t*)TKMEM_ALLOC(MAX_BUFF_SIZE);
-  uint32_t size = font_gen_buff(font, font_size, str, buff, MAX_BUFF_SIZE);
+  uint32_t size = font_gen_buff_ex(font, font_size, format, str, buff, MAX_BUFF_SIZE);
 
   output_res_c_source(output_filename, ASSET_TYPE_FONT, ASSET_TYPE_FONT_BMP, buff, size);
 
@@ -50,8 +57,92 @@ ret_t font_gen(font_t* font, uint16_t font_size, const char* str, const char* ou
   return RET_OK;
 }
 
+static uint32_t glyph_encode_bits(glyph_t* g, uint32_t bpp, uint8_t* out, uint32_t out_size) {
+  uint32_t x = 0;
+  uint32_t y = 0;
+  uint32_t stride = (g->w * bpp + 7) >> 3;
+  uint32_t size = stride * g->h;
+  return_value_if_fail(out_size >= size, 0);
+
+  memset(out, 0x00, size);
+  for (y = 0; y < g->h; y++) {
+    const uint8_t* s = g->data + y * g->w;
+    uint8_t* d = out + y * stride;
+
+    for (x = 0; x < g->w; x++) {
+      uint32_t bit = x * bpp;
+      uint32_t v = s[x] >> (8 - bpp);
+
+      d[bit >> 3] |= v << (8 - bpp - (bit & 7));
+    }
+  }
+
+  return size;
+}
+
+static uint32_t glyph_encode_rle(glyph_t* g, uint8_t* out, uint32_t out_size) {
+  uint32_t x = 0;
+  uint32_t y = 0;
+  uint8_t* d = out;
+
+  for (y = 0; y < g->h; y++) {
+    const uint8_t* s = g->data + y * g->w;
+
+    for (x = 0; x < g->w;) {
+      uint32_t n = 1;
+      uint8_t v = s[x] >> 4;
+
+      while (n < 16 && (x + n) < g->w && (s[x + n] >> 4) == v) {
+        n++;
+      }
+
+      return_value_if_fail((uint32_t)(d - out) < out_size, 0);
+      *d++ = (v << 4) | (n - 1);
+      x += n;
+    }
+  }
+
+  return d - out;
+}
+
+uint32_t font_gen_encode_glyph(glyph_t* g, glyph_format_t format, uint8_t* out,
+                               uint32_t out_size) {
+  return_value_if_fail(g != NULL && g->data != NULL && out != NULL, 0);
+
+  switch (format) {
+    case GLYPH_FMT_ALPHA: {
+      uint32_t size = g->w * g->h;
+      return_value_if_fail(out_size >= size, 0);
+      memcpy(out, g->data, size);
+
+      return size;
+    }
+    case GLYPH_FMT_ALPHA1: {
+      return glyph_encode_bits(g, 1, out, out_size);
+    }
+    case GLYPH_FMT_ALPHA2: {
+      return glyph_encode_bits(g, 2, out, out_size);
+    }
+    case GLYPH_FMT_ALPHA4: {
+      return glyph_encode_bits(g, 4, out, out_size);
+    }
+    case GLYPH_FMT_RLE: {
+      return glyph_encode_rle(g, out, out_size);
+    }
+    default:
+      break;
+  }
+
+  return 0;
+}
+
 uint32_t font_gen_buff(font_t* font, uint16_t font_size, const char* str, uint8_t* output_buff,
                        uint32_t buff_size) {
+  return font_gen_buff_ex(font, font_size, GLYPH_FMT_ALPHA, str, output_buff, buff_size);
+}
+
+uint32_t font_gen_buff_ex(font_t* font, uint16_t font_size, glyph_format_t format,
+                          const char* str, uint8_t* output_buff, uint32_t buff_size) {
   int i = 0;
   glyph_t g;
   int size = 0;
@@ -83,18 +174,25 @@ uint32_t font_gen_buff(font_t* font, uint16_t font_size, const char* str, uint8_
     if (iswspace(c)) {
       continue;
     }
-    printf("%d/%d: 0x%04x\n", i, size, c);
+
     if (font_get_glyph(font, c, font_size, &g) == RET_OK) {
-      uint32_t data_size = g.w * g.h;
-      return_value_if_fail(buff_size > (iter->offset + data_size + 4), 0);
+      uint32_t data_size = 0;
+      uint32_t left = buff_size - (p - output_buff);
+      glyph_format_t fmt = (g.w > 0 && g.h > 0) ? format : GLYPH_FMT_ALPHA;
+      return_value_if_fail(left > FONT_BITMAP_GLYPH_HEADER_SIZE, 0);
 
       save_uint8(p, g.x);
       save_uint8(p, g.y);
       save_uint8(p, g.w);
       save_uint8(p, g.h);
-      save_uint32(p, g.advance);
+      save_uint16(p, g.advance);
+      save_uint8(p, 0);
+      save_uint8(p, fmt);
 
-      memcpy(p, g.data, data_size);
+      if (g.w > 0 && g.h > 0) {
+        data_size = font_gen_encode_glyph(&g, fmt, p, left - FONT_BITMAP_GLYPH_HEADER_SIZE);
+        return_value_if_fail(data_size > 0, 0);
+      }
       p += data_size;
     } else if (c > 32) {
       printf("not found %d\n", c);
@@ -106,3 +204,131 @@ uint32_t font_gen_buff(font_t* font, uint16_t font_size, const char* str, uint8_
 
   return p - output_buff;
 }
+
+ret_t font_gen_sdf(font_t* font, uint16_t font_size, const char* str,
+                   const char* output_filename) {
+  uint8_t* buff = (uint8_t*)TKMEM_ALLOC(MAX_BUFF_SIZE * 4);
+  uint32_t size =
+      font_gen_sdf_buff(font, font_size, FONT_GEN_SDF_SPREAD, str, buff, MAX_BUFF_SIZE * 4);
+
+  output_res_c_source(output_filename, ASSET_TYPE_FONT, ASSET_TYPE_FONT_SDF, buff, size);
+
+  TKMEM_FREE(buff);
+
+  return RET_OK;
+}
+
+static uint8_t glyph_alpha_at(glyph_t* g, int32_t x, int32_t y) {
+  if (x < 0 || y < 0 || x >= g->w || y >= g->h) {
+    return 0;
+  }
+
+  return g->data[y * g->w + x];
+}
+
+/*边缘像素用覆盖率估算到边缘的距离，其它像素用到最近的相反像素的距离。*/
+static float_t glyph_sdf_distance(glyph_t* g, int32_t x, int32_t y, int32_t spread) {
+  int32_t i = 0;
+  int32_t j = 0;
+  int32_t min = (spread + 1) * (spread + 1);
+  uint8_t a = glyph_alpha_at(g, x, y);
+  bool_t inside = a >= 0x80;
+
+  if (a > 0 && a < 0xff) {
+    return (a - 127.5f) / 255.0f;
+  }
+
+  for (j = -spread; j <= spread; j++) {
+    for (i = -spread; i <= spread; i++) {
+      int32_t d = i * i + j * j;
+      if (d < min && (glyph_alpha_at(g, x + i, y + j) >= 0x80) != inside) {
+        min = d;
+      }
+    }
+  }
+
+  return (inside ? 1 : -1) * (sqrtf((float_t)min) - 0.5f);
+}
+
+static uint32_t glyph_encode_sdf(glyph_t* g, uint32_t spread, uint8_t* out, uint32_t out_size) {
+  int32_t x = 0;
+  int32_t y = 0;
+  uint8_t* d = out;
+  uint32_t w = g->w + 2 * spread;
+  uint32_t h = g->h + 2 * spread;
+  return_value_if_fail(w <= 0xff && h <= 0xff, 0);
+  return_value_if_fail(out_size >= w * h + FONT_SDF_GLYPH_HEADER_SIZE, 0);
+
+  save_uint8(d, w);
+  save_uint8(d, h);
+  save_uint8(d, spread);
+  save_uint8(d, 0);
+
+  for (y = 0; y < (int32_t)h; y++) {
+    for (x = 0; x < (int32_t)w; x++) {
+      float_t dist = glyph_sdf_distance(g, x - spread, y - spread, spread);
+      int32_t v = tk_roundi(128 + dist * 127 / spread);
+
+      *d++ = v < 0 ? 0 : (v > 0xff ? 0xff : v);
+    }
+  }
+
+  return d - out;
+}
+
+uint32_t font_gen_sdf_buff(font_t* font, uint16_t font_size, uint8_t spread, const char* str,
+                           uint8_t* output_buff, uint32_t buff_size) {
+  int i = 0;
+  glyph_t g;
+  int size = 0;
+  uint8_t* p = NULL;
+  wchar_t wstr[MAX_CHARS];
+  font_sdf_header_t* header = (font_sdf_header_t*)output_buff;
+  return_value_if_fail(font != NULL && str != NULL && output_buff != NULL, 0);
+  return_value_if_fail(spread > 0 && buff_size > sizeof(font_sdf_header_t), 0);
+
+  utf8_to_utf16(str, wstr, MAX_CHARS);
+  size = wcslen(wstr);
+
+  qsort(wstr, size, sizeof(wchar_t), char_cmp);
+  size = unique(wstr, size);
+  return_value_if_fail(buff_size > sizeof(font_sdf_header_t) + size * sizeof(font_sdf_index_t),
+                       0);
+
+  memset(header, 0x00, sizeof(font_sdf_header_t));
+  header->char_nr = size;
+  header->font_size = (uint8_t)font_size;
+  header->baseline = (uint8_t)font_get_baseline(font, font_size);
+  header->spread = spread;
+
+  p = (uint8_t*)(header->index + size);
+  for (i = 0; i < size; i++) {
+    wchar_t c = wstr[i];
+    font_sdf_index_t* iter = header->index + i;
+
+    iter->c = c;
+    iter->offset = 0;
+
+    if (iswspace(c) || font_get_glyph(font, c, font_size, &g) != RET_OK) {
+      continue;
+    }
+
+    iter->offset = p - output_buff;
+    return_value_if_fail(buff_size - iter->offset > FONT_SDF_GLYPH_HEADER_SIZE * 2, 0);
+
+    save_uint8(p, g.x - spread);
+    save_uint8(p, g.y - spread);
+    save_uint16(p, g.advance);
+
+    if (g.w > 0 && g.h > 0) {
+      uint32_t data_size = glyph_encode_sdf(&g, spread, p, buff_size - (p - output_buff));
+      return_value_if_fail(data_size > 0, 0);
+      p += data_size;
+    } else {
+      memset(p, 0x00, FONT_SDF_GLYPH_HEADER_SIZE);
+      p += FONT_SDF_GLYPH_HEADER_SIZE;
+    }
+  }
+
+  return p - output_buff;
+}
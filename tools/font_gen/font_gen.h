@@ -30,6 +30,21 @@ ret_t font_gen(font_t* font, uint16_t font_size, const char* str, const char* ou
 uint32_t font_gen_buff(font_t* font, uint16_t font_size, const char* str, uint8_t* output_buff,
                        uint32_t buff_size);
 
+ret_t font_gen_ex(font_t* font, uint16_t font_size, glyph_format_t format, const char* str,
+                  const char* output_filename);
+uint32_t font_gen_buff_ex(font_t* font, uint16_t font_size, glyph_format_t format,
+                          const char* str, uint8_t* output_buff, uint32_t buff_size);
+uint32_t font_gen_encode_glyph(glyph_t* g, glyph_format_t format, uint8_t* out,
+                               uint32_t out_size);
+
+/*距离场的范围(像素)。越大边缘之外可用的距离越远，但每一级距离的精度越低。*/
+#define FONT_GEN_SDF_SPREAD 4
+
+ret_t font_gen_sdf(font_t* font, uint16_t font_size, const char* str,
+                   const char* output_filename);
+uint32_t font_gen_sdf_buff(font_t* font, uint16_t font_size, uint8_t spread, const char* str,
+                           uint8_t* output_buff, uint32_t buff_size);
+
 END_C_DECLS
 
 #endif /*FONT_GEN_H*/
@@ -20,25 +20,44 @@
  */
 
 #include "tkc/mem.h"
+#include "tkc/utils.h"
 #include "common/utils.h"
 #include "font_gen.h"
 #include "font_loader/font_loader_bitmap.h"
 #include "font_loader/font_loader_truetype.h"
 
+static glyph_format_t glyph_format_from_name(const char* name) {
+  if (tk_str_eq(name, "a1")) {
+    return GLYPH_FMT_ALPHA1;
+  } else if (tk_str_eq(name, "a2")) {
+    return GLYPH_FMT_ALPHA2;
+  } else if (tk_str_eq(name, "a4")) {
+    return GLYPH_FMT_ALPHA4;
+  } else if (tk_str_eq(name, "rle")) {
+    return GLYPH_FMT_RLE;
+  } else if (tk_str_eq(name, "sdf")) {
+    return GLYPH_FMT_SDF;
+  } else {
+    return GLYPH_FMT_ALPHA;
+  }
+}
+
 int main(int argc, char** argv) {
   uint32_t size = 0;
   font_t* font = NULL;
   char* str_buff = NULL;
   uint8_t* ttf_buff = NULL;
   uint32_t font_size = 20;
+  glyph_format_t format = GLYPH_FMT_ALPHA;
   const char* ttf_filename = NULL;
   const char* str_filename = NULL;
   const char* out_filename = NULL;
 
   TKMEM_INIT(4 * 1024 * 1024);
 
-  if (argc != 5) {
-    printf("Usage: %s ttf_filename str_filename out_filename font_size\n", argv[0]);
+  if (argc != 5 && argc != 6) {
+    printf("Usage: %s ttf_filename str_filename out_filename font_size [a8|a4|a2|a1|rle|sdf]\n",
+           argv[0]);
 
     return 0;
   }
@@ -47,6 +66,9 @@ int main(int argc, char** argv) {
   str_filename = argv[2];
   out_filename = argv[3];
   font_size = atoi(argv[4]);
+  if (argc > 5) {
+    format = glyph_format_from_name(argv[5]);
+  }
 
   exit_if_need_not_update(ttf_filename, out_filename);
   exit_if_need_not_update(str_filename, out_filename);
@@ -60,7 +82,11 @@ int main(int argc, char** argv) {
   return_value_if_fail(str_buff != NULL, 0);
 
   if (font != NULL) {
-    font_gen(font, (uint16_t)font_size, str_buff, out_filename);
+    if (format == GLYPH_FMT_SDF) {
+      font_gen_sdf(font, (uint16_t)font_size, str_buff, out_filename);
+    } else {
+      font_gen_ex(font, (uint16_t)font_size, format, str_buff, out_filename);
+    }
   }
 
   TKMEM_FREE(ttf_buff);
@@ -43,19 +43,32 @@ ret_t image_gen(bitmap_t* image, const char* output_filename) {
 
 uint32_t image_gen_buff(bitmap_t* image, uint8_t* output_buff, uint32_t buff_size) {
   size_t size = 0;
+  size_t spans_size = 0;
   uint32_t bpp = bitmap_get_bpp(image);
   bitmap_header_t* header = (bitmap_header_t*)output_buff;
   return_value_if_fail(image != NULL && output_buff != NULL, 0);
 
   size = bpp * image->w * image->h;
-  return_value_if_fail((size + sizeof(bitmap_header_t)) < buff_size, RET_BAD_PARAMS);
+  if (bpp == 4 && !(image->flags & BITMAP_FLAG_OPAQUE)) {
+    spans_size = sizeof(bitmap_span_t) * image->h;
+  }
+  return_value_if_fail((size + spans_size + sizeof(bitmap_header_t)) < buff_size, RET_BAD_PARAMS);
 
   header->w = image->w;
   header->h = image->h;
-  header->flags = image->flags;
+  header->flags = image->flags & ~BITMAP_FLAG_SPANS;
   header->format = image->format;
 
   memcpy(header->data, image->data, size);
 
-  return size + sizeof(bitmap_header_t);
+  /*附带每一行的透明/不透明范围，贴图时跳过透明的像素，直接拷贝不透明的像素*/
+  if (spans_size > 0) {
+    if (bitmap_calc_spans(image, (bitmap_span_t*)(header->data + size)) == RET_OK) {
+      header->flags |= BITMAP_FLAG_SPANS;
+    } else {
+      spans_size = 0;
+    }
+  }
+
+  return size + spans_size + sizeof(bitmap_header_t);
 }
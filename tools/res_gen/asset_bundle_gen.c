@@ -0,0 +1,301 @@
+/**
+ * File:   asset_bundle_gen.c
+ * Author: AWTK Develop Team
+ * Brief:  pack all assets into one bundle file
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/fs.h"
+#include "tkc/mem.h"
+#include "tkc/path.h"
+#include "tkc/utils.h"
+#include "tkc/darray.h"
+#include "common/utils.h"
+#include "asset_bundle_gen.h"
+
+#define ASSET_BUNDLE_ALIGN 8
+
+typedef struct _bundle_ext_t {
+  const char* extname;
+  uint16_t subtype;
+} bundle_ext_t;
+
+typedef struct _bundle_dir_t {
+  const char* subpath;
+  const char* prefix;
+  asset_type_t type;
+  bool_t keep_extname;
+  const bundle_ext_t* exts;
+} bundle_dir_t;
+
+typedef struct _bundle_item_t {
+  asset_bundle_entry_t entry;
+  char name[TK_NAME_LEN + 1];
+  char path[MAX_PATH + 1];
+} bundle_item_t;
+
+/*same order as assets_manager_load_asset tries them.*/
+static const bundle_ext_t s_font_exts[] = {{".ttf", ASSET_TYPE_FONT_TTF},
+                                           {".bin", ASSET_TYPE_FONT_BMP},
+                                           {".sdf", ASSET_TYPE_FONT_SDF},
+                                           {NULL, 0}};
+static const bundle_ext_t s_script_exts[] = {{".js", ASSET_TYPE_SCRIPT_JS},
+                                             {".lua", ASSET_TYPE_SCRIPT_LUA},
+                                             {".py", ASSET_TYPE_SCRIPT_PYTHON},
+                                             {NULL, 0}};
+static const bundle_ext_t s_image_exts[] = {{".png", ASSET_TYPE_IMAGE_PNG},
+                                            {".jpg", ASSET_TYPE_IMAGE_JPG},
+                                            {".gif", ASSET_TYPE_IMAGE_GIF},
+                                            {NULL, 0}};
+static const bundle_ext_t s_svg_exts[] = {{".bsvg", ASSET_TYPE_IMAGE_BSVG}, {NULL, 0}};
+static const bundle_ext_t s_style_exts[] = {{".bin", ASSET_TYPE_STYLE}, {NULL, 0}};
+static const bundle_ext_t s_strings_exts[] = {{".bin", ASSET_TYPE_STRINGS}, {NULL, 0}};
+static const bundle_ext_t s_ui_exts[] = {{".bin", ASSET_TYPE_UI}, {NULL, 0}};
+static const bundle_ext_t s_xml_exts[] = {{".xml", ASSET_TYPE_XML}, {NULL, 0}};
+static const bundle_ext_t s_data_exts[] = {{"", ASSET_TYPE_DATA}, {NULL, 0}};
+
+static const bundle_dir_t s_bundle_dirs[] = {
+    {"fonts", NULL, ASSET_TYPE_FONT, FALSE, s_font_exts},
+    {"scripts", NULL, ASSET_TYPE_SCRIPT, FALSE, s_script_exts},
+    {"styles", NULL, ASSET_TYPE_STYLE, FALSE, s_style_exts},
+    {"strings", NULL, ASSET_TYPE_STRINGS, FALSE, s_strings_exts},
+    {"ui", NULL, ASSET_TYPE_UI, FALSE, s_ui_exts},
+    {"xml", NULL, ASSET_TYPE_XML, FALSE, s_xml_exts},
+    {"data", NULL, ASSET_TYPE_DATA, TRUE, s_data_exts},
+    {"images/x1", "x1", ASSET_TYPE_IMAGE, FALSE, s_image_exts},
+    {"images/x2", "x2", ASSET_TYPE_IMAGE, FALSE, s_image_exts},
+    {"images/x3", "x3", ASSET_TYPE_IMAGE, FALSE, s_image_exts},
+    {"images/xx", "xx", ASSET_TYPE_IMAGE, FALSE, s_image_exts},
+    {"images/svg", "svg", ASSET_TYPE_IMAGE, FALSE, s_svg_exts}};
+
+static int bundle_item_cmp(const void* a, const void* b) {
+  const asset_bundle_entry_t* aa = &(((const bundle_item_t*)a)->entry);
+  const asset_bundle_entry_t* bb = &(((const bundle_item_t*)b)->entry);
+
+  if (aa->type != bb->type) {
+    return (int)(aa->type) - (int)(bb->type);
+  }
+
+  return strcmp(aa->key, bb->key);
+}
+
+static int bundle_item_ptr_cmp(const void* a, const void* b) {
+  return bundle_item_cmp(*(const bundle_item_t**)a, *(const bundle_item_t**)b);
+}
+
+static const bundle_ext_t* bundle_dir_match(const bundle_dir_t* dir, const char* filename,
+                                            uint32_t* ext_index) {
+  uint32_t i = 0;
+
+  for (i = 0; dir->exts[i].extname != NULL; i++) {
+    const char* extname = dir->exts[i].extname;
+
+    if (*extname == '\0' || end_with(filename, extname)) {
+      *ext_index = i;
+      return dir->exts + i;
+    }
+  }
+
+  return NULL;
+}
+
+static ret_t bundle_scan_dir(darray_t* items, const char* raw_dir, const bundle_dir_t* dir) {
+  fs_item_t item;
+  fs_dir_t* d = NULL;
+  char dir_path[MAX_PATH + 1];
+
+  return_value_if_fail(path_build(dir_path, MAX_PATH, raw_dir, dir->subpath, NULL) == RET_OK,
+                       RET_FAIL);
+  if (!path_exist(dir_path)) {
+    return RET_OK;
+  }
+
+  d = fs_open_dir(os_fs(), dir_path);
+  return_value_if_fail(d != NULL, RET_FAIL);
+
+  while (fs_dir_read(d, &item) == RET_OK) {
+    uint32_t i = 0;
+    uint32_t ext_index = 0;
+    bundle_item_t* iter = NULL;
+    const bundle_ext_t* ext = NULL;
+
+    if (item.name[0] == '.') {
+      continue;
+    }
+
+    ext = bundle_dir_match(dir, item.name, &ext_index);
+    if (ext == NULL) {
+      continue;
+    }
+
+    iter = TKMEM_ZALLOC(bundle_item_t);
+    return_value_if_fail(iter != NULL, RET_OOM);
+
+    path_build(iter->path, MAX_PATH, dir_path, item.name, NULL);
+    if (!file_exist(iter->path)) {
+      TKMEM_FREE(iter);
+      continue;
+    }
+
+    tk_strncpy(iter->name, item.name, TK_NAME_LEN);
+    if (!dir->keep_extname) {
+      char* p = strrchr(iter->name, '.');
+      if (p != NULL) {
+        *p = '\0';
+      }
+    }
+
+    iter->entry.type = dir->type;
+    iter->entry.subtype = ext->subtype;
+    iter->entry.reserved = ext_index;
+    iter->entry.size = file_get_size(iter->path);
+    if (dir->prefix != NULL) {
+      tk_snprintf(iter->entry.key, ASSET_BUNDLE_KEY_LEN, "%s/%s", dir->prefix, iter->name);
+    } else {
+      tk_strncpy(iter->entry.key, iter->name, ASSET_BUNDLE_KEY_LEN);
+    }
+
+    /*keep the one has higher priority when names are duplicated(such as earth.png/earth.jpg)*/
+    for (i = 0; i < items->size; i++) {
+      bundle_item_t* old = (bundle_item_t*)(items->elms[i]);
+      if (bundle_item_cmp(old, iter) == 0) {
+        if (old->entry.reserved > iter->entry.reserved) {
+          items->elms[i] = iter;
+          iter = old;
+        }
+        TKMEM_FREE(iter);
+        break;
+      }
+    }
+
+    if (iter != NULL) {
+      darray_push(items, iter);
+    }
+  }
+
+  fs_dir_close(d);
+
+  return RET_OK;
+}
+
+static ret_t bundle_write_items(darray_t* items, fs_file_t* fp) {
+  uint32_t i = 0;
+  uint32_t offset = 0;
+  asset_bundle_header_t header;
+  uint32_t nr = items->size;
+  bundle_item_t** all = (bundle_item_t**)(items->elms);
+  uint8_t padding[2 * ASSET_BUNDLE_ALIGN];
+  int32_t info_size = sizeof(asset_info_t) - sizeof(((asset_info_t*)NULL)->data);
+
+  memset(padding, 0x00, sizeof(padding));
+  offset = sizeof(asset_bundle_header_t) + nr * sizeof(asset_bundle_entry_t);
+  offset = TK_ROUND_TO(offset, ASSET_BUNDLE_ALIGN);
+
+  for (i = 0; i < nr; i++) {
+    all[i]->entry.reserved = 0;
+    all[i]->entry.offset = offset;
+    offset += TK_ROUND_TO(sizeof(asset_info_t) + all[i]->entry.size, ASSET_BUNDLE_ALIGN);
+  }
+
+  memset(&header, 0x00, sizeof(header));
+  header.nr = nr;
+  header.size = offset;
+  header.magic = ASSET_BUNDLE_MAGIC;
+  header.version = ASSET_BUNDLE_VERSION;
+
+  offset = sizeof(header);
+  return_value_if_fail(fs_file_write(fp, &header, sizeof(header)) == sizeof(header), RET_FAIL);
+  for (i = 0; i < nr; i++) {
+    return_value_if_fail(fs_file_write(fp, &(all[i]->entry), sizeof(asset_bundle_entry_t)) ==
+                             sizeof(asset_bundle_entry_t),
+                         RET_FAIL);
+    offset += sizeof(asset_bundle_entry_t);
+  }
+
+  for (i = 0; i < nr; i++) {
+    asset_info_t info;
+    uint32_t size = 0;
+    uint8_t* data = NULL;
+    bundle_item_t* iter = all[i];
+
+    if (offset < iter->entry.offset) {
+      fs_file_write(fp, padding, iter->entry.offset - offset);
+      offset = iter->entry.offset;
+    }
+
+    memset(&info, 0x00, sizeof(info));
+    info.type = iter->entry.type;
+    info.subtype = iter->entry.subtype;
+    info.is_in_rom = TRUE;
+    info.refcount = 0;
+    info.size = iter->entry.size;
+    tk_strncpy(info.name, iter->name, TK_NAME_LEN);
+
+    /*asset_info_t.data is the start of the asset data.*/
+    return_value_if_fail(fs_file_write(fp, &info, info_size) == info_size, RET_FAIL);
+    offset += info_size;
+
+    if (iter->entry.size > 0) {
+      data = (uint8_t*)file_read(iter->path, &size);
+      return_value_if_fail(data != NULL && size == iter->entry.size, RET_FAIL);
+      fs_file_write(fp, data, size);
+      offset += size;
+      TKMEM_FREE(data);
+    }
+  }
+
+  /*asset_info_t has 4 bytes data inside, make sure the last one is complete.*/
+  if (offset < header.size) {
+    fs_file_write(fp, padding, header.size - offset);
+  }
+
+  return RET_OK;
+}
+
+static ret_t bundle_item_destroy(void* data) {
+  TKMEM_FREE(data);
+
+  return RET_OK;
+}
+
+ret_t asset_bundle_gen(const char* raw_dir, const char* output_filename) {
+  uint32_t i = 0;
+  ret_t ret = RET_OK;
+  darray_t items;
+  fs_file_t* fp = NULL;
+  return_value_if_fail(raw_dir != NULL && output_filename != NULL, RET_BAD_PARAMS);
+
+  darray_init(&items, 100, bundle_item_destroy, NULL);
+  for (i = 0; i < ARRAY_SIZE(s_bundle_dirs) && ret == RET_OK; i++) {
+    ret = bundle_scan_dir(&items, raw_dir, s_bundle_dirs + i);
+  }
+
+  if (ret == RET_OK) {
+    qsort(items.elms, items.size, sizeof(void*), bundle_item_ptr_cmp);
+    fp = fs_open_file(os_fs(), output_filename, "wb+");
+    if (fp != NULL) {
+      ret = bundle_write_items(&items, fp);
+      fs_file_close(fp);
+    } else {
+      ret = RET_FAIL;
+    }
+  }
+
+  darray_deinit(&items);
+
+  return ret;
+}
@@ -0,0 +1,34 @@
+/**
+ * File:   asset_bundle_gen.h
+ * Author: AWTK Develop Team
+ * Brief:  pack all assets into one bundle file
+ *
+ * Copyright (c) 2018 - 2019  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2026-10-19 AWTK Develop Team created
+ *
+ */
+
+#ifndef ASSET_BUNDLE_GEN_H
+#define ASSET_BUNDLE_GEN_H
+
+#include "base/asset_bundle.h"
+
+BEGIN_C_DECLS
+
+/*raw_dir is the directory contains fonts/images/styles/strings/ui/xml/data/scripts.*/
+ret_t asset_bundle_gen(const char* raw_dir, const char* output_filename);
+
+END_C_DECLS
+
+#endif /*ASSET_BUNDLE_GEN_H*/
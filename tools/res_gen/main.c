@@ -22,6 +22,7 @@
 #include "tkc/mem.h"
 #include "common/utils.h"
 #include "base/assets_manager.h"
+#include "asset_bundle_gen.h"
 
 int main(int argc, char** argv) {
   uint32_t size = 0;
@@ -31,8 +32,19 @@ int main(int argc, char** argv) {
 
   TKMEM_INIT(4 * 1024 * 1024);
 
+  if (argc == 4 && strcmp(argv[1], "--bundle") == 0) {
+    if (asset_bundle_gen(argv[2], argv[3]) != RET_OK) {
+      printf("generate bundle failed\n");
+      return 1;
+    }
+
+    printf("done\n");
+    return 0;
+  }
+
   if (argc != 3) {
     printf("Usage: %s in_filename out_filename\n", argv[0]);
+    printf("Usage: %s --bundle raw_dir out_filename\n", argv[0]);
     return 0;
   }
 
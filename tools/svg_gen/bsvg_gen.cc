@@ -25,19 +25,21 @@
 #include "base/assets_manager.h"
 #include "svg/svg_to_bsvg.h"
 
-static ret_t bsvg_gen(const char* input_file, const char* output_file, bool_t bin) {
+static ret_t bsvg_gen(const char* input_file, const char* output_file, bool_t bin,
+                      float_t tolerance) {
   uint32_t* out = NULL;
   uint32_t size = 0;
   uint32_t out_size = 0;
   char* xml = (char*)file_read(input_file, &size);
 
-  if (svg_to_bsvg(xml, size, &out, &out_size) == RET_OK) {
+  if (svg_to_bsvg_ex(xml, size, tolerance, &out, &out_size) == RET_OK) {
     if (bin) {
       write_file(output_file, out, out_size);
     } else {
       output_res_c_source(output_file, ASSET_TYPE_IMAGE, ASSET_TYPE_IMAGE_BSVG, (uint8_t*)out,
                           out_size);
     }
+    TKMEM_FREE(out);
   }
 
   TKMEM_FREE(xml);
@@ -46,22 +48,33 @@ static ret_t bsvg_gen(const char* input_file, const char* output_file, bool_t bi
 }
 
 int main(int argc, char* argv[]) {
-  bool_t output_bin = argc > 3;
+  int i = 0;
+  float_t tolerance = 0;
+  bool_t output_bin = FALSE;
   const char* in_filename = NULL;
   const char* out_filename = NULL;
 
   TKMEM_INIT(4 * 1024 * 1024)
 
   if (argc < 3) {
-    printf("Usage: %s svg_filename bsvg_filename [bin]\n", argv[0]);
+    printf("Usage: %s svg_filename bsvg_filename [bin] [flat[=tolerance]]\n", argv[0]);
     return 0;
   }
 
+  for (i = 3; i < argc; i++) {
+    if (strncmp(argv[i], "flat", 4) == 0) {
+      /*flat=0.5：生成预先细分的BSVG v2，误差为0.5像素*/
+      tolerance = argv[i][4] == '=' ? tk_atof(argv[i] + 5) : 0.25f;
+    } else {
+      output_bin = TRUE;
+    }
+  }
+
   in_filename = argv[1];
   out_filename = argv[2];
 
   exit_if_need_not_update(in_filename, out_filename);
-  bsvg_gen(in_filename, out_filename, output_bin);
+  bsvg_gen(in_filename, out_filename, output_bin, tolerance);
 
   return 0;
 }
@@ -109,6 +109,8 @@ static void xml_gen_style(xml_builder_t* b, Style& s, const char** attrs) {
     } else if (strcmp(name, "icon_at") == 0) {
       uint32_t icon_at = to_icon_at(value);
       s.AddInt(name, icon_at);
+    } else if (strcmp(name, "image_quality") == 0) {
+      s.AddInt(name, strcmp(value, "smooth") == 0 ? IMAGE_QUALITY_SMOOTH : IMAGE_QUALITY_NEAREST);
     } else if (strstr(name, "color") != NULL) {
       s.AddInt(name, parse_color(value).color);
     } else if (strstr(name, "image") != NULL || strstr(name, "name") != NULL ||